@@ -0,0 +1,1158 @@
+/**
+ * @file replay.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+/**
+ * Replay plays back a capture file that was recorded through Device::beginCapture().
+ *
+ * Usage: replay <file> [--loops <count>] [--skip-gpu]
+ *
+ * --loops replays the capture multiple times, objects that are still alive at the end of a loop are destroyed before the next loop begins.
+ * --skip-gpu skips Queue::submit(), Device::waitFences() and Device::waitSemaphores() so that only the CPU cost of the captured calls is measured.
+ *
+ * Commands that use an object which wasn't captured are reported and skipped, except for rendering scopes and bound Pipelines, which stop the replay because the commands that follow them depend on them.
+ */
+
+void callback(llri::message_severity severity, llri::message_source source, const char* message, [[maybe_unused]] void* userData)
+{
+    if (severity <= llri::message_severity::Info)
+        return;
+
+    std::cout << "LLRI " << to_string(source) << " " << to_string(severity) << ": " << message << "\n";
+}
+
+struct capture_header
+{
+    bool resourceStateTracking;
+    std::vector<llri::queue_desc> queues;
+};
+
+/**
+ * @brief A decoded record. Every value in the record is stored as uint32_t, 64 bit values take up two values (low, high), and byte data takes up its size followed by the bytes packed into values.
+*/
+struct capture_record
+{
+    llri::capture_opcode opcode;
+    std::vector<uint32_t> args;
+};
+
+class capture_reader
+{
+public:
+    explicit capture_reader(std::vector<uint8_t> data) : m_data(std::move(data)) { }
+
+    [[nodiscard]] bool atEnd() const { return m_offset >= m_data.size(); }
+    [[nodiscard]] bool failed() const { return m_failed; }
+
+    uint8_t readByte()
+    {
+        if (m_offset + 1 > m_data.size())
+        {
+            m_failed = true;
+            return 0;
+        }
+
+        return m_data[m_offset++];
+    }
+
+    uint32_t readUint()
+    {
+        uint32_t value = 0;
+        for (size_t i = 0; i < sizeof(value); i++)
+            value |= static_cast<uint32_t>(readByte()) << (i * 8);
+        return value;
+    }
+
+    // reads numValues values into args
+    void read(uint32_t numValues, std::vector<uint32_t>& args)
+    {
+        for (uint32_t i = 0; i < numValues && !m_failed; i++)
+            args.push_back(readUint());
+    }
+
+    // reads a count followed by count * stride values into args
+    void readArray(uint32_t stride, std::vector<uint32_t>& args)
+    {
+        const uint32_t count = readUint();
+        args.push_back(count);
+
+        // guard against corrupted counts before reading
+        if (static_cast<uint64_t>(count) * stride * sizeof(uint32_t) > m_data.size() - m_offset)
+        {
+            m_failed = true;
+            return;
+        }
+
+        read(count * stride, args);
+    }
+
+    // reads a size in bytes followed by the bytes, which are padded to a multiple of four, into args
+    void readBytes(std::vector<uint32_t>& args)
+    {
+        const uint32_t size = readUint();
+        args.push_back(size);
+
+        const uint64_t numValues = (static_cast<uint64_t>(size) + 3) / 4;
+        if (numValues * sizeof(uint32_t) > m_data.size() - m_offset)
+        {
+            m_failed = true;
+            return;
+        }
+
+        read(static_cast<uint32_t>(numValues), args);
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+    size_t m_offset = 0;
+    bool m_failed = false;
+};
+
+bool decodeCapture(capture_reader& reader, capture_header* header, std::vector<capture_record>* records)
+{
+    if (reader.readUint() != llri::captureMagic)
+    {
+        std::cout << "The file is not an LLRI capture file\n";
+        return false;
+    }
+
+    const uint32_t version = reader.readUint();
+    if (version != llri::captureVersion)
+    {
+        std::cout << "The capture file has version " << version << " but this replay supports version " << llri::captureVersion << "\n";
+        return false;
+    }
+
+    header->resourceStateTracking = reader.readByte() != 0;
+    const uint32_t numQueues = reader.readUint();
+    for (uint32_t i = 0; i < numQueues && !reader.failed(); i++)
+    {
+        const auto type = static_cast<llri::queue_type>(reader.readByte());
+        const auto priority = static_cast<llri::queue_priority>(reader.readByte());
+        header->queues.push_back({ type, priority, llri::queue_submit_mode::Immediate });
+    }
+
+    while (!reader.atEnd() && !reader.failed())
+    {
+        capture_record record { static_cast<llri::capture_opcode>(reader.readByte()), {} };
+        switch (record.opcode)
+        {
+            case llri::capture_opcode::CreateResource:
+                reader.read(14, record.args);
+                break;
+            case llri::capture_opcode::DestroyResource:
+            case llri::capture_opcode::DestroyFence:
+            case llri::capture_opcode::DestroySemaphore:
+            case llri::capture_opcode::DestroyCommandGroup:
+            case llri::capture_opcode::DestroyQueryPool:
+            case llri::capture_opcode::DestroyPipeline:
+            case llri::capture_opcode::EndCommandList:
+            case llri::capture_opcode::EndRendering:
+            case llri::capture_opcode::EndLabel:
+                reader.read(1, record.args);
+                break;
+            case llri::capture_opcode::CreateFence:
+            case llri::capture_opcode::CreateCommandGroup:
+            case llri::capture_opcode::ResetCommandGroup:
+            case llri::capture_opcode::FreeCommandList:
+            case llri::capture_opcode::SetStencilReference:
+            case llri::capture_opcode::BindPipeline:
+                reader.read(2, record.args);
+                break;
+            case llri::capture_opcode::BeginCommandList:
+                reader.read(3, record.args);
+                if (record.args.size() == 3 && record.args[2] != 0)
+                {
+                    reader.read(4, record.args); // area
+                    reader.readArray(1, record.args); // color formats
+                    reader.read(3, record.args); // depthStencilFormat, sampleCount, stencilReference
+                }
+                break;
+            case llri::capture_opcode::WriteTimestamp:
+            case llri::capture_opcode::BeginQuery:
+            case llri::capture_opcode::EndQuery:
+                reader.read(3, record.args);
+                break;
+            case llri::capture_opcode::ResetQueries:
+                reader.read(4, record.args);
+                break;
+            case llri::capture_opcode::CreateQueryPool:
+            case llri::capture_opcode::SetScissor:
+            case llri::capture_opcode::BindIndexBuffer:
+            case llri::capture_opcode::Draw:
+                reader.read(5, record.args);
+                break;
+            case llri::capture_opcode::DrawIndexed:
+                reader.read(6, record.args);
+                break;
+            case llri::capture_opcode::SetViewport:
+            case llri::capture_opcode::ResolveQueries:
+                reader.read(7, record.args);
+                break;
+            case llri::capture_opcode::CopyBuffer:
+                reader.read(9, record.args);
+                break;
+            case llri::capture_opcode::PushConstants:
+                reader.read(3, record.args);
+                reader.readBytes(record.args);
+                break;
+            case llri::capture_opcode::BeginRendering:
+                reader.read(6, record.args); // list, area, contents
+                reader.readArray(7, record.args); // color attachments
+                reader.readArray(7, record.args); // depth stencil attachment
+                break;
+            case llri::capture_opcode::ExecuteIndirectLists:
+                reader.read(1, record.args);
+                reader.readArray(1, record.args);
+                break;
+            case llri::capture_opcode::BindVertexBuffers:
+                reader.read(2, record.args); // list, firstBinding
+                reader.readArray(3, record.args); // buffers and offsets
+                break;
+            case llri::capture_opcode::CreateGraphicsPipeline:
+                reader.read(2, record.args); // id, pushConstantStages
+                for (size_t i = 0; i < 4; i++)
+                    reader.readBytes(record.args); // vertex and fragment shader bytecode and entry points
+                reader.read(1, record.args); // topology
+                reader.readArray(3, record.args); // vertex bindings
+                reader.readArray(4, record.args); // vertex attributes
+                reader.read(18, record.args); // rasterizer, depthStencil
+                reader.readArray(9, record.args); // color attachments
+                reader.read(2, record.args); // depthStencilFormat, sampleCount
+                break;
+            case llri::capture_opcode::BeginLabel:
+            case llri::capture_opcode::InsertLabel:
+                reader.read(5, record.args); // list, color
+                reader.readBytes(record.args);
+                break;
+            case llri::capture_opcode::AllocateCommandList:
+            case llri::capture_opcode::CreateSemaphore:
+                reader.read(4, record.args);
+                break;
+            case llri::capture_opcode::ResourceBarrier:
+                reader.read(1, record.args);
+                reader.readArray(13, record.args);
+                break;
+            case llri::capture_opcode::RequireResourceState:
+                reader.read(7, record.args);
+                break;
+            case llri::capture_opcode::Submit:
+                reader.read(2, record.args);
+                reader.readArray(1, record.args); // command lists
+                reader.readArray(4, record.args); // wait semaphores, values and stages
+                reader.readArray(3, record.args); // signal semaphores and values
+                reader.read(1, record.args); // fence
+                break;
+            case llri::capture_opcode::WaitFences:
+                reader.readArray(1, record.args);
+                reader.read(3, record.args); // timeout, waitAny
+                break;
+            case llri::capture_opcode::ResetFences:
+                reader.readArray(1, record.args);
+                break;
+            case llri::capture_opcode::SignalSemaphore:
+                reader.read(3, record.args);
+                break;
+            case llri::capture_opcode::WaitSemaphores:
+                reader.readArray(3, record.args);
+                reader.read(3, record.args); // timeout, waitAny
+                break;
+            default:
+                std::cout << "The capture file contains an unknown record type (" << static_cast<uint32_t>(record.opcode) << ")\n";
+                return false;
+        }
+
+        records->push_back(std::move(record));
+    }
+
+    if (reader.failed())
+    {
+        std::cout << "The capture file ended unexpectedly\n";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Replays the records in a Device. Objects are stored by their capture id, the first ids are occupied by the Device's Queues.
+*/
+class capture_player
+{
+public:
+    capture_player(llri::Device* device, const capture_header& header, bool skipGpu) : m_device(device), m_skipGpu(skipGpu)
+    {
+        // Queue ids are assigned in the order of their type
+        std::array<uint8_t, static_cast<size_t>(llri::queue_type::MaxEnum) + 1> indices {};
+        m_objects.push_back({ nullptr, llri::capture_opcode::MaxEnum });
+        for (const auto& queue : header.queues)
+            m_objects.push_back({ device->getQueue(queue.type, indices[static_cast<size_t>(queue.type)]++), llri::capture_opcode::MaxEnum });
+        m_numQueues = m_objects.size();
+    }
+
+    llri::result play(const std::vector<capture_record>& records)
+    {
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            m_recordIndex = i;
+            const llri::result r = playRecord(records[i]);
+            if (r != llri::result::Success)
+            {
+                std::cout << "Record " << i << " (" << to_string(records[i].opcode) << ") returned " << to_string(r) << "\n";
+                return r;
+            }
+        }
+
+        return llri::result::Success;
+    }
+
+    // destroys the objects that the capture didn't destroy, so that the next loop starts from the same state
+    void destroyLiveObjects()
+    {
+        for (size_t i = 1; i < m_numQueues; i++)
+            static_cast<llri::Queue*>(m_objects[i].object)->waitIdle();
+
+        for (size_t i = m_numQueues; i < m_objects.size(); i++)
+        {
+            auto& [object, creator] = m_objects[i];
+            if (object == nullptr)
+                continue;
+
+            switch (creator)
+            {
+                case llri::capture_opcode::CreateResource:
+                    m_device->destroyResource(static_cast<llri::Resource*>(object));
+                    break;
+                case llri::capture_opcode::CreateFence:
+                    m_device->destroyFence(static_cast<llri::Fence*>(object));
+                    break;
+                case llri::capture_opcode::CreateSemaphore:
+                    m_device->destroySemaphore(static_cast<llri::Semaphore*>(object));
+                    break;
+                case llri::capture_opcode::CreateCommandGroup:
+                    m_device->destroyCommandGroup(static_cast<llri::CommandGroup*>(object));
+                    break;
+                case llri::capture_opcode::CreateQueryPool:
+                    m_device->destroyQueryPool(static_cast<llri::QueryPool*>(object));
+                    break;
+                case llri::capture_opcode::CreateGraphicsPipeline:
+                    m_device->destroyPipeline(static_cast<llri::Pipeline*>(object));
+                    break;
+                default:
+                    // CommandLists are freed through their CommandGroup
+                    break;
+            }
+        }
+
+        m_objects.resize(m_numQueues);
+    }
+
+private:
+    struct captured_object
+    {
+        void* object;
+        llri::capture_opcode creator;
+    };
+
+    template<typename T>
+    T* get(uint32_t id) const
+    {
+        return id < m_objects.size() ? static_cast<T*>(m_objects[id].object) : nullptr;
+    }
+
+    // objects that weren't captured can't be replayed, so the commands that use them are reported and skipped
+    template<typename T>
+    T* require(const capture_record& record, uint32_t id, const char* type) const
+    {
+        T* object = get<T>(id);
+        if (object == nullptr)
+            std::cout << "Record " << m_recordIndex << " (" << to_string(record.opcode) << ") uses a " << type << " that wasn't captured (id " << id << "), skipping it\n";
+        return object;
+    }
+
+    void set(uint32_t id, void* object, llri::capture_opcode creator)
+    {
+        if (id >= m_objects.size())
+            m_objects.resize(static_cast<size_t>(id) + 1, { nullptr, llri::capture_opcode::MaxEnum });
+        m_objects[id] = { object, creator };
+    }
+
+    static uint64_t readValue(const uint32_t* values)
+    {
+        return values[0] | (static_cast<uint64_t>(values[1]) << 32);
+    }
+
+    static llri::texture_subresource_range range(const uint32_t* values)
+    {
+        return { values[0], values[1], values[2], values[3] };
+    }
+
+    static llri::rect_2d rect(const uint32_t* values)
+    {
+        return { { static_cast<int32_t>(values[0]), static_cast<int32_t>(values[1]) }, { values[2], values[3] } };
+    }
+
+    static float readFloat(uint32_t value)
+    {
+        float f;
+        std::memcpy(&f, &value, sizeof(f));
+        return f;
+    }
+
+    // unpacks byte data (size followed by the packed bytes) into bytes, and returns the number of values that the byte data took up
+    static size_t readBytes(const uint32_t* values, std::vector<uint8_t>& bytes)
+    {
+        bytes.resize(values[0]);
+        for (size_t i = 0; i < bytes.size(); i++)
+            bytes[i] = static_cast<uint8_t>(values[1 + i / 4] >> (i % 4 * 8));
+        return 1 + (bytes.size() + 3) / 4;
+    }
+
+    void readBytes(const uint32_t* values)
+    {
+        readBytes(values, m_bytes);
+    }
+
+    llri::rendering_attachment_desc attachment(const uint32_t* values, bool depthStencil) const
+    {
+        llri::rendering_attachment_desc desc {};
+        desc.texture = get<llri::Resource>(values[0]);
+        desc.loadOp = static_cast<llri::attachment_load_op>(values[1]);
+        desc.storeOp = static_cast<llri::attachment_store_op>(values[2]);
+        if (depthStencil)
+            desc.clearValue.depthStencil = { readFloat(values[3]), static_cast<uint8_t>(values[4]) };
+        else
+            desc.clearValue.color = { readFloat(values[3]), readFloat(values[4]), readFloat(values[5]), readFloat(values[6]) };
+        return desc;
+    }
+
+    llri::result playRecord(const capture_record& record)
+    {
+        const auto& a = record.args;
+
+        switch (record.opcode)
+        {
+            case llri::capture_opcode::CreateResource:
+            {
+                llri::resource_desc desc {};
+                desc.createNodeMask = a[1];
+                desc.visibleNodeMask = a[2];
+                desc.type = static_cast<llri::resource_type>(a[3]);
+                desc.usage = static_cast<llri::resource_usage_flag_bits>(a[4]);
+                desc.memoryType = static_cast<llri::memory_type>(a[5]);
+                desc.initialState = static_cast<llri::resource_state>(a[6]);
+                desc.width = a[7];
+                desc.height = a[8];
+                desc.depthOrArrayLayers = static_cast<uint16_t>(a[9]);
+                desc.mipLevels = static_cast<uint16_t>(a[10]);
+                desc.sampleCount = static_cast<llri::sample_count>(a[11]);
+                desc.textureFormat = static_cast<llri::format>(a[12]);
+                desc.sharingMode = static_cast<llri::resource_sharing_mode>(a[13]);
+
+                llri::Resource* resource;
+                const llri::result r = m_device->createResource(desc, &resource);
+                if (r == llri::result::Success)
+                    set(a[0], resource, record.opcode);
+                return r;
+            }
+            case llri::capture_opcode::DestroyResource:
+                if (auto* resource = get<llri::Resource>(a[0]))
+                    m_device->destroyResource(resource);
+                set(a[0], nullptr, record.opcode);
+                return llri::result::Success;
+            case llri::capture_opcode::CreateFence:
+            {
+                llri::Fence* fence;
+                const llri::result r = m_device->createFence(static_cast<llri::fence_flag_bits>(a[1]), &fence);
+                if (r == llri::result::Success)
+                    set(a[0], fence, record.opcode);
+                return r;
+            }
+            case llri::capture_opcode::DestroyFence:
+                if (auto* fence = get<llri::Fence>(a[0]))
+                    m_device->destroyFence(fence);
+                set(a[0], nullptr, record.opcode);
+                return llri::result::Success;
+            case llri::capture_opcode::CreateSemaphore:
+            {
+                const llri::semaphore_desc desc { static_cast<llri::semaphore_type>(a[1]), readValue(&a[2]) };
+
+                llri::Semaphore* semaphore;
+                const llri::result r = m_device->createSemaphore(desc, &semaphore);
+                if (r == llri::result::Success)
+                    set(a[0], semaphore, record.opcode);
+                return r;
+            }
+            case llri::capture_opcode::DestroySemaphore:
+                if (auto* semaphore = get<llri::Semaphore>(a[0]))
+                    m_device->destroySemaphore(semaphore);
+                set(a[0], nullptr, record.opcode);
+                return llri::result::Success;
+            case llri::capture_opcode::CreateCommandGroup:
+            {
+                llri::CommandGroup* group;
+                const llri::result r = m_device->createCommandGroup(static_cast<llri::queue_type>(a[1]), &group);
+                if (r == llri::result::Success)
+                    set(a[0], group, record.opcode);
+                return r;
+            }
+            case llri::capture_opcode::DestroyCommandGroup:
+                if (auto* group = get<llri::CommandGroup>(a[0]))
+                    m_device->destroyCommandGroup(group);
+                set(a[0], nullptr, record.opcode);
+                return llri::result::Success;
+            case llri::capture_opcode::ResetCommandGroup:
+                if (auto* group = get<llri::CommandGroup>(a[0]))
+                    return group->reset(static_cast<llri::command_group_reset_mode>(a[1]));
+                return llri::result::Success;
+            case llri::capture_opcode::AllocateCommandList:
+            {
+                auto* group = get<llri::CommandGroup>(a[0]);
+                if (group == nullptr)
+                    return llri::result::Success;
+
+                llri::CommandList* list;
+                const llri::result r = group->allocate({ a[2], static_cast<llri::command_list_usage>(a[3]) }, &list);
+                if (r == llri::result::Success)
+                    set(a[1], list, record.opcode);
+                return r;
+            }
+            case llri::capture_opcode::FreeCommandList:
+            {
+                auto* group = get<llri::CommandGroup>(a[0]);
+                auto* list = get<llri::CommandList>(a[1]);
+                set(a[1], nullptr, record.opcode);
+                if (group == nullptr || list == nullptr)
+                    return llri::result::Success;
+                return group->free(list);
+            }
+            case llri::capture_opcode::BeginCommandList:
+            {
+                // the commands of a CommandList that wasn't captured are skipped along with it
+                auto* list = require<llri::CommandList>(record, a[0], "CommandList");
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                llri::command_list_begin_desc desc {};
+                desc.submitMode = static_cast<llri::command_list_submit_mode>(a[1]);
+
+                llri::command_list_inheritance_desc inheritance {};
+                if (a[2] != 0)
+                {
+                    const uint32_t numColorAttachments = a[7];
+                    m_formats.resize(numColorAttachments);
+                    for (uint32_t i = 0; i < numColorAttachments; i++)
+                        m_formats[i] = static_cast<llri::format>(a[8 + i]);
+
+                    const uint32_t* end = &a[8 + numColorAttachments];
+                    inheritance.area = rect(&a[3]);
+                    inheritance.numColorAttachments = numColorAttachments;
+                    inheritance.colorFormats = m_formats.data();
+                    inheritance.depthStencilFormat = static_cast<llri::format>(end[0]);
+                    inheritance.sampleCount = static_cast<llri::sample_count>(end[1]);
+                    inheritance.stencilReference = static_cast<uint8_t>(end[2]);
+                    desc.inheritance = &inheritance;
+                }
+
+                return list->begin(desc);
+            }
+            case llri::capture_opcode::EndCommandList:
+                if (auto* list = get<llri::CommandList>(a[0]))
+                    return list->end();
+                return llri::result::Success;
+            case llri::capture_opcode::ResourceBarrier:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                m_barriers.clear();
+                for (uint32_t i = 0; i < a[1]; i++)
+                {
+                    // only the barriers of Resources that weren't captured are skipped, the others are still recorded
+                    const uint32_t* b = &a[2 + i * 13];
+                    auto* resource = require<llri::Resource>(record, b[1], "Resource");
+                    if (resource == nullptr)
+                        continue;
+
+                    llri::resource_barrier barrier {};
+                    barrier.type = static_cast<llri::resource_barrier_type>(b[0]);
+                    if (barrier.type == llri::resource_barrier_type::Transition)
+                        barrier.trans = { resource, static_cast<llri::resource_state>(b[2]), static_cast<llri::resource_state>(b[3]), range(&b[4]) };
+                    else
+                        barrier.rw = { resource };
+                    barrier.srcStages = static_cast<llri::pipeline_stage_flag_bits>(b[8]);
+                    barrier.dstStages = static_cast<llri::pipeline_stage_flag_bits>(b[9]);
+                    barrier.split = static_cast<llri::resource_barrier_split>(b[10]);
+                    barrier.ownershipTransfer = static_cast<llri::queue_ownership_transfer>(b[11]);
+                    barrier.ownershipQueue = static_cast<llri::queue_type>(b[12]);
+                    m_barriers.push_back(barrier);
+                }
+
+                if (m_barriers.empty())
+                    return llri::result::Success;
+
+                return list->resourceBarrier(static_cast<uint32_t>(m_barriers.size()), m_barriers.data());
+            }
+            case llri::capture_opcode::RequireResourceState:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                auto* resource = require<llri::Resource>(record, a[1], "Resource");
+                if (resource == nullptr)
+                    return llri::result::Success;
+                return list->requireResourceState(resource, static_cast<llri::resource_state>(a[2]), range(&a[3]));
+            }
+            case llri::capture_opcode::Submit:
+            {
+                auto* queue = get<llri::Queue>(a[0]);
+                if (queue == nullptr || m_skipGpu)
+                    return llri::result::Success;
+
+                size_t i = 2;
+                m_lists.resize(a[i]);
+                for (auto*& list : m_lists)
+                    list = get<llri::CommandList>(a[++i]);
+
+                m_waitSemaphores.resize(a[++i]);
+                m_waitValues.resize(m_waitSemaphores.size());
+                m_waitStages.resize(m_waitSemaphores.size());
+                for (size_t j = 0; j < m_waitSemaphores.size(); j++, i += 4)
+                {
+                    m_waitSemaphores[j] = get<llri::Semaphore>(a[i + 1]);
+                    m_waitValues[j] = readValue(&a[i + 2]);
+                    m_waitStages[j] = static_cast<llri::pipeline_stage_flag_bits>(a[i + 4]);
+                }
+
+                m_signalSemaphores.resize(a[++i]);
+                m_signalValues.resize(m_signalSemaphores.size());
+                for (size_t j = 0; j < m_signalSemaphores.size(); j++, i += 3)
+                {
+                    m_signalSemaphores[j] = get<llri::Semaphore>(a[i + 1]);
+                    m_signalValues[j] = readValue(&a[i + 2]);
+                }
+
+                llri::submit_desc desc {};
+                desc.nodeMask = a[1];
+                desc.numCommandLists = static_cast<uint32_t>(m_lists.size());
+                desc.commandLists = m_lists.data();
+                desc.numWaitSemaphores = static_cast<uint32_t>(m_waitSemaphores.size());
+                desc.waitSemaphores = m_waitSemaphores.data();
+                desc.waitSemaphoreValues = m_waitValues.data();
+                desc.waitSemaphoreStages = m_waitStages.data();
+                desc.numSignalSemaphores = static_cast<uint32_t>(m_signalSemaphores.size());
+                desc.signalSemaphores = m_signalSemaphores.data();
+                desc.signalSemaphoreValues = m_signalValues.data();
+                desc.fence = get<llri::Fence>(a[++i]);
+                return queue->submit(desc);
+            }
+            case llri::capture_opcode::WaitFences:
+            {
+                if (m_skipGpu)
+                    return llri::result::Success;
+
+                m_fences.clear();
+                for (uint32_t i = 0; i < a[0]; i++)
+                {
+                    if (auto* fence = get<llri::Fence>(a[1 + i]))
+                        m_fences.push_back(fence);
+                }
+
+                if (m_fences.empty())
+                    return llri::result::Success;
+
+                return m_device->waitFences(static_cast<uint32_t>(m_fences.size()), m_fences.data(), readValue(&a[1 + a[0]]), a[3 + a[0]] != 0);
+            }
+            case llri::capture_opcode::ResetFences:
+            {
+                if (m_skipGpu)
+                    return llri::result::Success;
+
+                // the application only reset fences that had completed, which isn't guaranteed at the same point in the replay
+                m_fences.clear();
+                for (uint32_t i = 0; i < a[0]; i++)
+                {
+                    auto* fence = get<llri::Fence>(a[1 + i]);
+                    if (fence != nullptr && fence->getStatus() != llri::result::NotReady)
+                        m_fences.push_back(fence);
+                    else if (fence != nullptr && m_device->waitFence(fence, LLRI_TIMEOUT_MAX) != llri::result::Success)
+                        return llri::result::ErrorUnknown;
+                }
+
+                if (m_fences.empty())
+                    return llri::result::Success;
+
+                return m_device->resetFences(static_cast<uint32_t>(m_fences.size()), m_fences.data());
+            }
+            case llri::capture_opcode::SignalSemaphore:
+                if (auto* semaphore = get<llri::Semaphore>(a[0]))
+                    return semaphore->signal(readValue(&a[1]));
+                return llri::result::Success;
+            case llri::capture_opcode::WaitSemaphores:
+            {
+                if (m_skipGpu)
+                    return llri::result::Success;
+
+                m_waitSemaphores.clear();
+                m_waitValues.clear();
+                for (uint32_t i = 0; i < a[0]; i++)
+                {
+                    if (auto* semaphore = get<llri::Semaphore>(a[1 + i * 3]))
+                    {
+                        m_waitSemaphores.push_back(semaphore);
+                        m_waitValues.push_back(readValue(&a[2 + i * 3]));
+                    }
+                }
+
+                if (m_waitSemaphores.empty())
+                    return llri::result::Success;
+
+                const uint32_t* end = &a[1 + a[0] * 3];
+                return m_device->waitSemaphores(static_cast<uint32_t>(m_waitSemaphores.size()), m_waitSemaphores.data(), m_waitValues.data(), readValue(end), end[2] != 0);
+            }
+            case llri::capture_opcode::CreateQueryPool:
+            {
+                const llri::query_pool_desc desc { static_cast<llri::query_type>(a[1]), a[2], a[3], static_cast<llri::pipeline_statistic_flag_bits>(a[4]) };
+
+                llri::QueryPool* queryPool;
+                const llri::result r = m_device->createQueryPool(desc, &queryPool);
+                if (r == llri::result::Success)
+                    set(a[0], queryPool, record.opcode);
+                return r;
+            }
+            case llri::capture_opcode::DestroyQueryPool:
+                if (auto* queryPool = get<llri::QueryPool>(a[0]))
+                    m_device->destroyQueryPool(queryPool);
+                set(a[0], nullptr, record.opcode);
+                return llri::result::Success;
+            case llri::capture_opcode::PushConstants:
+                if (auto* list = get<llri::CommandList>(a[0]))
+                {
+                    readBytes(&a[3]);
+                    return list->pushConstants(static_cast<llri::shader_stage_flag_bits>(a[1]), a[2], static_cast<uint32_t>(m_bytes.size()), m_bytes.data());
+                }
+                return llri::result::Success;
+            case llri::capture_opcode::BeginRendering:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                m_attachments.clear();
+                for (uint32_t i = 0; i < a[6]; i++)
+                    m_attachments.push_back(attachment(&a[7 + i * 7], false));
+
+                const uint32_t* depthStencil = &a[7 + a[6] * 7];
+                if (depthStencil[0] > 0)
+                    m_attachments.push_back(attachment(&depthStencil[1], true));
+
+                // skipping the scope would make the commands inside of it invalid, so a missing attachment stops the replay
+                for (const auto& desc : m_attachments)
+                {
+                    if (desc.texture == nullptr)
+                    {
+                        std::cout << "Record " << m_recordIndex << " (" << to_string(record.opcode) << ") renders to a texture that wasn't captured\n";
+                        return llri::result::ErrorInvalidUsage;
+                    }
+                }
+
+                llri::rendering_desc desc {};
+                desc.area = rect(&a[1]);
+                desc.contents = static_cast<llri::rendering_contents>(a[5]);
+                desc.numColorAttachments = a[6];
+                desc.colorAttachments = m_attachments.data();
+                desc.depthStencilAttachment = depthStencil[0] > 0 ? &m_attachments.back() : nullptr;
+                return list->beginRendering(desc);
+            }
+            case llri::capture_opcode::EndRendering:
+                if (auto* list = get<llri::CommandList>(a[0]))
+                    return list->endRendering();
+                return llri::result::Success;
+            case llri::capture_opcode::SetViewport:
+                if (auto* list = get<llri::CommandList>(a[0]))
+                    return list->setViewport({ readFloat(a[1]), readFloat(a[2]), readFloat(a[3]), readFloat(a[4]), readFloat(a[5]), readFloat(a[6]) });
+                return llri::result::Success;
+            case llri::capture_opcode::SetScissor:
+                if (auto* list = get<llri::CommandList>(a[0]))
+                    return list->setScissor(rect(&a[1]));
+                return llri::result::Success;
+            case llri::capture_opcode::SetStencilReference:
+                if (auto* list = get<llri::CommandList>(a[0]))
+                    return list->setStencilReference(static_cast<uint8_t>(a[1]));
+                return llri::result::Success;
+            case llri::capture_opcode::ExecuteIndirectLists:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                m_lists.clear();
+                for (uint32_t i = 0; i < a[1]; i++)
+                {
+                    if (auto* indirect = require<llri::CommandList>(record, a[2 + i], "CommandList"))
+                        m_lists.push_back(indirect);
+                }
+
+                if (m_lists.empty())
+                    return llri::result::Success;
+
+                return list->executeIndirectLists(static_cast<uint32_t>(m_lists.size()), m_lists.data());
+            }
+            case llri::capture_opcode::ResetQueries:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                auto* queryPool = require<llri::QueryPool>(record, a[1], "QueryPool");
+                if (queryPool == nullptr)
+                    return llri::result::Success;
+                return list->resetQueries(queryPool, a[2], a[3]);
+            }
+            case llri::capture_opcode::WriteTimestamp:
+            case llri::capture_opcode::BeginQuery:
+            case llri::capture_opcode::EndQuery:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                auto* queryPool = require<llri::QueryPool>(record, a[1], "QueryPool");
+                if (queryPool == nullptr)
+                    return llri::result::Success;
+
+                if (record.opcode == llri::capture_opcode::WriteTimestamp)
+                    return list->writeTimestamp(queryPool, a[2]);
+                if (record.opcode == llri::capture_opcode::BeginQuery)
+                    return list->beginQuery(queryPool, a[2]);
+                return list->endQuery(queryPool, a[2]);
+            }
+            case llri::capture_opcode::CopyBuffer:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                auto* src = require<llri::Resource>(record, a[1], "Resource");
+                auto* dst = require<llri::Resource>(record, a[4], "Resource");
+                if (src == nullptr || dst == nullptr)
+                    return llri::result::Success;
+                return list->copyBuffer(src, readValue(&a[2]), dst, readValue(&a[5]), readValue(&a[7]));
+            }
+            case llri::capture_opcode::ResolveQueries:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                auto* queryPool = require<llri::QueryPool>(record, a[1], "QueryPool");
+                auto* buffer = require<llri::Resource>(record, a[4], "Resource");
+                if (queryPool == nullptr || buffer == nullptr)
+                    return llri::result::Success;
+                return list->resolveQueries(queryPool, a[2], a[3], buffer, readValue(&a[5]));
+            }
+            case llri::capture_opcode::BeginLabel:
+            case llri::capture_opcode::InsertLabel:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                readBytes(&a[5]);
+                const std::string name(m_bytes.begin(), m_bytes.end());
+                const llri::label_color color { readFloat(a[1]), readFloat(a[2]), readFloat(a[3]), readFloat(a[4]) };
+
+                if (record.opcode == llri::capture_opcode::BeginLabel)
+                    return list->beginLabel(name.c_str(), color);
+                return list->insertLabel(name.c_str(), color);
+            }
+            case llri::capture_opcode::EndLabel:
+                if (auto* list = get<llri::CommandList>(a[0]))
+                    return list->endLabel();
+                return llri::result::Success;
+            case llri::capture_opcode::CreateGraphicsPipeline:
+            {
+                llri::graphics_pipeline_desc desc {};
+                desc.cache = nullptr;
+                desc.pushConstantStages = static_cast<llri::shader_stage_flag_bits>(a[1]);
+
+                size_t i = 2;
+                for (size_t stage = 0; stage < 2; stage++)
+                {
+                    i += readBytes(&a[i], m_shaders[stage]);
+                    i += readBytes(&a[i], m_bytes);
+                    m_entryPoints[stage].assign(m_bytes.begin(), m_bytes.end());
+                }
+                desc.vertexShader = { m_shaders[0].size(), m_shaders[0].data(), m_entryPoints[0].empty() ? nullptr : m_entryPoints[0].c_str() };
+                desc.fragmentShader = { m_shaders[1].size(), m_shaders[1].data(), m_entryPoints[1].empty() ? nullptr : m_entryPoints[1].c_str() };
+                desc.topology = static_cast<llri::primitive_topology>(a[i++]);
+
+                m_vertexBindings.resize(a[i++]);
+                for (auto& binding : m_vertexBindings)
+                {
+                    binding = { a[i], a[i + 1], static_cast<llri::vertex_input_rate>(a[i + 2]) };
+                    i += 3;
+                }
+
+                m_vertexAttributes.resize(a[i++]);
+                for (auto& attribute : m_vertexAttributes)
+                {
+                    attribute = { a[i], a[i + 1], static_cast<llri::format>(a[i + 2]), a[i + 3] };
+                    i += 4;
+                }
+
+                desc.numVertexBindings = static_cast<uint32_t>(m_vertexBindings.size());
+                desc.vertexBindings = m_vertexBindings.data();
+                desc.numVertexAttributes = static_cast<uint32_t>(m_vertexAttributes.size());
+                desc.vertexAttributes = m_vertexAttributes.data();
+                desc.rasterizer = { static_cast<llri::cull_mode>(a[i]), static_cast<llri::front_face>(a[i + 1]), static_cast<int32_t>(a[i + 2]), readFloat(a[i + 3]) };
+                i += 4;
+
+                const auto stencilOps = [&a](size_t j) {
+                    return llri::stencil_op_desc { static_cast<llri::stencil_op>(a[j]), static_cast<llri::stencil_op>(a[j + 1]), static_cast<llri::stencil_op>(a[j + 2]), static_cast<llri::compare_op>(a[j + 3]) };
+                };
+
+                desc.depthStencil.depthTestEnable = a[i] != 0;
+                desc.depthStencil.depthWriteEnable = a[i + 1] != 0;
+                desc.depthStencil.depthCompareOp = static_cast<llri::compare_op>(a[i + 2]);
+                desc.depthStencil.stencilTestEnable = a[i + 3] != 0;
+                desc.depthStencil.stencilReadMask = static_cast<uint8_t>(a[i + 4]);
+                desc.depthStencil.stencilWriteMask = static_cast<uint8_t>(a[i + 5]);
+                desc.depthStencil.front = stencilOps(i + 6);
+                desc.depthStencil.back = stencilOps(i + 10);
+                i += 14;
+
+                m_colorAttachments.resize(a[i++]);
+                for (auto& attachment : m_colorAttachments)
+                {
+                    attachment.format = static_cast<llri::format>(a[i]);
+                    attachment.blendEnable = a[i + 1] != 0;
+                    attachment.srcColorFactor = static_cast<llri::blend_factor>(a[i + 2]);
+                    attachment.dstColorFactor = static_cast<llri::blend_factor>(a[i + 3]);
+                    attachment.colorOp = static_cast<llri::blend_op>(a[i + 4]);
+                    attachment.srcAlphaFactor = static_cast<llri::blend_factor>(a[i + 5]);
+                    attachment.dstAlphaFactor = static_cast<llri::blend_factor>(a[i + 6]);
+                    attachment.alphaOp = static_cast<llri::blend_op>(a[i + 7]);
+                    attachment.writeMask = static_cast<llri::color_component_flag_bits>(a[i + 8]);
+                    i += 9;
+                }
+
+                desc.numColorAttachments = static_cast<uint32_t>(m_colorAttachments.size());
+                desc.colorAttachments = m_colorAttachments.data();
+                desc.depthStencilFormat = static_cast<llri::format>(a[i]);
+                desc.sampleCount = static_cast<llri::sample_count>(a[i + 1]);
+
+                llri::Pipeline* pipeline;
+                const llri::result r = m_device->createGraphicsPipeline(desc, &pipeline);
+                if (r == llri::result::Success)
+                    set(a[0], pipeline, record.opcode);
+                return r;
+            }
+            case llri::capture_opcode::DestroyPipeline:
+                if (auto* pipeline = get<llri::Pipeline>(a[0]))
+                    m_device->destroyPipeline(pipeline);
+                set(a[0], nullptr, record.opcode);
+                return llri::result::Success;
+            case llri::capture_opcode::BindPipeline:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                // skipping the bind would make the draws that follow it invalid, so a missing Pipeline stops the replay
+                auto* pipeline = get<llri::Pipeline>(a[1]);
+                if (pipeline == nullptr)
+                {
+                    std::cout << "Record " << m_recordIndex << " (" << to_string(record.opcode) << ") binds a Pipeline that wasn't captured\n";
+                    return llri::result::ErrorInvalidUsage;
+                }
+
+                return list->bindPipeline(pipeline);
+            }
+            case llri::capture_opcode::BindVertexBuffers:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                // the buffers are bound as a contiguous range, so a missing buffer skips the whole command
+                m_buffers.resize(a[2]);
+                m_offsets.resize(a[2]);
+                for (uint32_t i = 0; i < a[2]; i++)
+                {
+                    m_buffers[i] = require<llri::Resource>(record, a[3 + i * 3], "Resource");
+                    m_offsets[i] = readValue(&a[4 + i * 3]);
+                    if (m_buffers[i] == nullptr)
+                        return llri::result::Success;
+                }
+
+                return list->bindVertexBuffers(a[1], a[2], m_buffers.data(), m_offsets.data());
+            }
+            case llri::capture_opcode::BindIndexBuffer:
+            {
+                auto* list = get<llri::CommandList>(a[0]);
+                if (list == nullptr)
+                    return llri::result::Success;
+
+                auto* buffer = require<llri::Resource>(record, a[1], "Resource");
+                if (buffer == nullptr)
+                    return llri::result::Success;
+                return list->bindIndexBuffer(buffer, readValue(&a[2]), static_cast<llri::index_type>(a[4]));
+            }
+            case llri::capture_opcode::Draw:
+                if (auto* list = get<llri::CommandList>(a[0]))
+                    return list->draw(a[1], a[2], a[3], a[4]);
+                return llri::result::Success;
+            case llri::capture_opcode::DrawIndexed:
+                if (auto* list = get<llri::CommandList>(a[0]))
+                    return list->drawIndexed(a[1], a[2], a[3], static_cast<int32_t>(a[4]), a[5]);
+                return llri::result::Success;
+        }
+
+        return llri::result::ErrorInvalidUsage;
+    }
+
+    llri::Device* m_device;
+    bool m_skipGpu;
+
+    std::vector<captured_object> m_objects;
+    size_t m_numQueues;
+    size_t m_recordIndex = 0;
+
+    // scratch memory that is reused across records
+    std::vector<llri::resource_barrier> m_barriers;
+    std::vector<llri::CommandList*> m_lists;
+    std::vector<llri::Semaphore*> m_waitSemaphores;
+    std::vector<uint64_t> m_waitValues;
+    std::vector<llri::pipeline_stage_flags> m_waitStages;
+    std::vector<llri::Semaphore*> m_signalSemaphores;
+    std::vector<uint64_t> m_signalValues;
+    std::vector<llri::Fence*> m_fences;
+    std::vector<llri::format> m_formats;
+    std::vector<llri::rendering_attachment_desc> m_attachments;
+    std::vector<uint8_t> m_bytes;
+    std::array<std::vector<uint8_t>, 2> m_shaders;
+    std::array<std::string, 2> m_entryPoints;
+    std::vector<llri::vertex_binding_desc> m_vertexBindings;
+    std::vector<llri::vertex_attribute_desc> m_vertexAttributes;
+    std::vector<llri::pipeline_color_attachment_desc> m_colorAttachments;
+    std::vector<llri::Resource*> m_buffers;
+    std::vector<uint64_t> m_offsets;
+};
+
+int main(int argc, char** argv)
+{
+    const char* path = nullptr;
+    uint32_t loops = 1;
+    bool skipGpu = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--loops") == 0 && i + 1 < argc)
+            loops = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else if (std::strcmp(argv[i], "--skip-gpu") == 0)
+            skipGpu = true;
+        else
+            path = argv[i];
+    }
+
+    if (path == nullptr || loops == 0)
+    {
+        std::cout << "Usage: replay <file> [--loops <count>] [--skip-gpu]\n";
+        return 1;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cout << "Failed to open " << path << "\n";
+        return 1;
+    }
+
+    // the whole file is decoded up front so that the timings only contain the LLRI calls
+    capture_reader reader({ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() });
+    capture_header header;
+    std::vector<capture_record> records;
+    if (!decodeCapture(reader, &header, &records))
+        return 1;
+
+    llri::setMessageCallback(&callback);
+
+    llri::Instance* instance;
+    const llri::instance_desc instanceDesc = { 0, nullptr, "replay" };
+    if (llri::createInstance(instanceDesc, &instance) != llri::result::Success)
+    {
+        std::cout << "Failed to create an Instance\n";
+        return 1;
+    }
+
+    std::vector<llri::Adapter*> adapters;
+    if (instance->enumerateAdapters(&adapters) != llri::result::Success || adapters.empty())
+    {
+        std::cout << "No Adapters are available\n";
+        llri::destroyInstance(instance);
+        return 1;
+    }
+
+    const llri::device_desc deviceDesc {
+        adapters[0],
+        llri::adapter_features {},
+        0, nullptr,
+        static_cast<uint32_t>(header.queues.size()), header.queues.data(),
+        header.resourceStateTracking
+    };
+
+    llri::Device* device;
+    if (instance->createDevice(deviceDesc, &device) != llri::result::Success)
+    {
+        std::cout << "Failed to create a Device with the captured queues\n";
+        llri::destroyInstance(instance);
+        return 1;
+    }
+
+    std::cout << "Replaying " << records.size() << " records from " << path << (skipGpu ? " without GPU work" : "") << "\n";
+
+    capture_player player(device, header, skipGpu);
+    double totalMs = 0.0;
+    double minMs = 0.0;
+    int exitCode = 0;
+
+    for (uint32_t loop = 0; loop < loops; loop++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const llri::result r = player.play(records);
+        const auto end = std::chrono::steady_clock::now();
+
+        player.destroyLiveObjects();
+
+        if (r != llri::result::Success)
+        {
+            exitCode = 1;
+            break;
+        }
+
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        totalMs += ms;
+        minMs = loop == 0 ? ms : std::min(minMs, ms);
+        std::cout << "Loop " << loop << ": " << ms << " ms\n";
+    }
+
+    if (exitCode == 0)
+        std::cout << "Min: " << minMs << " ms, average: " << totalMs / loops << " ms\n";
+
+    instance->destroyDevice(device);
+    llri::destroyInstance(instance);
+    return exitCode;
+}
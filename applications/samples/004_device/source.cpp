@@ -38,7 +38,7 @@ int main()
     // A device **must** have at least one queue added to its queue desc.
     // No queue of any type is guaranteed to be supported, use Adapter::queryQueueCount() to figure out how many queues are available of a certain type.
     std::array<llri::queue_desc, 1> queues {
-        llri::queue_desc { llri::queue_type::Graphics, llri::queue_priority::Normal } // Graphics queues aren't always guaranteed to be available, but in selectAdapter() this sample skips adapters that don't support at least one graphics queue. You may choose for yourself what queues your application will require and select an adapter based on that.
+        llri::queue_desc { llri::queue_type::Graphics, llri::queue_priority::Normal, llri::queue_submit_mode::Immediate } // Graphics queues aren't always guaranteed to be available, but in selectAdapter() this sample skips adapters that don't support at least one graphics queue. You may choose for yourself what queues your application will require and select an adapter based on that.
     };
 
     // Gather all the information from above.
@@ -46,7 +46,8 @@ int main()
         adapter,
         enabledFeatures,
         0, nullptr, // Similar to Instance extensions, this may be a size and array.
-        static_cast<uint32_t>(queues.size()), queues.data()
+        static_cast<uint32_t>(queues.size()), queues.data(),
+        false // Automatic resource state tracking is disabled, see device_desc::resourceStateTracking.
     };
 
     // Finally, create the device through Instance::createDevice().
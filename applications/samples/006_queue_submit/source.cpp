@@ -112,14 +112,15 @@ llri::Device* createDevice(llri::Instance* instance, llri::Adapter* adapter)
     std::array<llri::queue_desc, 1> queues{
         // This sample requires/picks an Adapter with a Graphics queue, but you may choose
         // to use different queues in your use case.
-        llri::queue_desc { llri::queue_type::Graphics, llri::queue_priority::Normal }
+        llri::queue_desc { llri::queue_type::Graphics, llri::queue_priority::Normal, llri::queue_submit_mode::Immediate }
     };
 
     llri::device_desc desc{
         adapter,
         enabledFeatures,
         0, nullptr,
-        static_cast<uint32_t>(queues.size()), queues.data()
+        static_cast<uint32_t>(queues.size()), queues.data(),
+        false
     };
 
     llri::Device* device;
@@ -131,7 +131,7 @@ int main()
         }, m_commandList));
 
         // submit
-        const llri::submit_desc submitDesc { 0, 1, &m_commandList, 0, nullptr, 0, nullptr, m_fence };
+        const llri::submit_desc submitDesc { 0, 1, &m_commandList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, m_fence };
         THROW_IF_FAILED(m_graphicsQueue->submit(submitDesc));
     }
     
@@ -295,14 +295,15 @@ void createDevice()
     std::vector<llri::adapter_extension> adapterExtensions;
 
     std::array<llri::queue_desc, 1> adapterQueues {
-        llri::queue_desc { llri::queue_type::Graphics, llri::queue_priority::High } // We can give one or more queues a higher priority
+        llri::queue_desc { llri::queue_type::Graphics, llri::queue_priority::High, llri::queue_submit_mode::Immediate } // We can give one or more queues a higher priority
     };
 
     // Create device
     const llri::device_desc deviceDesc{
         m_adapter, selectedFeatures,
         static_cast<uint32_t>(adapterExtensions.size()), adapterExtensions.data(),
-        static_cast<uint32_t>(adapterQueues.size()), adapterQueues.data()
+        static_cast<uint32_t>(adapterQueues.size()), adapterQueues.data(),
+        false
     };
 
     THROW_IF_FAILED(m_instance->createDevice(deviceDesc, &m_device));
@@ -343,6 +344,7 @@ void createResources()
     textureDesc.mipLevels = 1;
     textureDesc.sampleCount = llri::sample_count::Count1;
     textureDesc.textureFormat = llri::format::RGBA8sRGB;
+    textureDesc.sharingMode = llri::resource_sharing_mode::Concurrent;
 
     THROW_IF_FAILED(m_device->createResource(textureDesc, &m_texture));
 }
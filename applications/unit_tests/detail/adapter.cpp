@@ -49,6 +49,25 @@ TEST_CASE("Adapter")
             }
         }
 
+        SUBCASE("Adapter::queryQueueFamilyType()")
+        {
+            SUBCASE("[Incorrect usage] invalid queue_type value")
+            {
+                const auto invalidType = static_cast<llri::queue_type>(std::numeric_limits<uint8_t>::max());
+                CHECK_EQ(adapter->queryQueueFamilyType(invalidType), invalidType);
+            }
+
+            SUBCASE("[Correct usage] queue types fall back to a more general type with the same queue count")
+            {
+                for (uint8_t type = 0; type <= static_cast<uint8_t>(llri::queue_type::MaxEnum); type++)
+                {
+                    const auto familyType = adapter->queryQueueFamilyType(static_cast<llri::queue_type>(type));
+                    CHECK_LE(static_cast<uint8_t>(familyType), type);
+                    CHECK_EQ(adapter->queryQueueCount(familyType), adapter->queryQueueCount(static_cast<llri::queue_type>(type)));
+                }
+            }
+        }
+
         SUBCASE("Adapter::queryFormatProperties()")
         {
             auto props = adapter->queryFormatProperties();
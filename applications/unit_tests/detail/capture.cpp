@@ -0,0 +1,188 @@
+/**
+ * @file capture.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+#include <cstdio>
+
+TEST_CASE("Device capture")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+        const char* path = "llri_unit_test_capture.bin";
+
+        SUBCASE("Device::beginCapture()")
+        {
+            SUBCASE("[Incorrect usage] path == nullptr")
+            {
+                CHECK_EQ(device->beginCapture(nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] already capturing")
+            {
+                REQUIRE_EQ(device->beginCapture(path), llri::result::Success);
+                CHECK_EQ(device->beginCapture(path), llri::result::ErrorInvalidState);
+                device->endCapture();
+            }
+
+            SUBCASE("[Correct usage] capturing commands")
+            {
+                REQUIRE_EQ(device->beginCapture(path), llri::result::Success);
+
+                auto* fence = detail::defaultFence(device, false);
+                auto* group = detail::defaultCommandGroup(device, detail::availableQueueType(adapter));
+                auto* list = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+
+                const llri::resource_desc bufferDesc = llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferSrc | llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::TransferDst, 64);
+                llri::Resource* buffer;
+                llri::Resource* copy;
+                REQUIRE_EQ(device->createResource(bufferDesc, &buffer), llri::result::Success);
+                REQUIRE_EQ(device->createResource(bufferDesc, &copy), llri::result::Success);
+
+                REQUIRE_EQ(list->begin({}), llri::result::Success);
+                CHECK_EQ(list->beginLabel("capture"), llri::result::Success);
+                CHECK_EQ(list->resourceBarrier(llri::resource_barrier::transition(buffer, llri::resource_state::TransferDst, llri::resource_state::TransferSrc)), llri::result::Success);
+                CHECK_EQ(list->copyBuffer(buffer, 0, copy, 0, 64), llri::result::Success);
+                CHECK_EQ(list->endLabel(), llri::result::Success);
+                REQUIRE_EQ(list->end(), llri::result::Success);
+
+                device->destroyResource(copy);
+                device->destroyResource(buffer);
+                device->destroyCommandGroup(group);
+                device->destroyFence(fence);
+                device->endCapture();
+
+                std::ifstream file(path, std::ios::binary);
+                REQUIRE(file.good());
+
+                uint8_t header[8] {};
+                file.read(reinterpret_cast<char*>(header), sizeof(header));
+                CHECK_EQ(static_cast<uint32_t>(header[0] | header[1] << 8 | header[2] << 16 | header[3] << 24), llri::captureMagic);
+                CHECK_EQ(static_cast<uint32_t>(header[4] | header[5] << 8 | header[6] << 16 | header[7] << 24), llri::captureVersion);
+            }
+
+            SUBCASE("[Correct usage] capturing a draw")
+            {
+                if (llri::getImplementation() == llri::implementation::Vulkan && adapter->queryQueueCount(llri::queue_type::Graphics) > 0)
+                {
+                    // an empty vertex shader, hand-assembled as SPIR-V because DirectX12 only accepts signed DXIL, which can't be embedded here
+                    const std::array<uint32_t, 29> shader {
+                        0x07230203, 0x00010000, 0, 5, 0,
+                        0x00020011, 1, // OpCapability Shader
+                        0x0003000E, 0, 1, // OpMemoryModel Logical GLSL450
+                        0x0005000F, 0, 1, 0x6E69616D, 0, // OpEntryPoint Vertex %1 "main"
+                        0x00020013, 2, // %2 = OpTypeVoid
+                        0x00030021, 3, 2, // %3 = OpTypeFunction %2
+                        0x00050036, 2, 1, 0, 3, // %1 = OpFunction %2 None %3
+                        0x000200F8, 4, // %4 = OpLabel
+                        0x000100FD, // OpReturn
+                        0x00010038 // OpFunctionEnd
+                    };
+
+                    const llri::vertex_binding_desc binding { 0, 16, llri::vertex_input_rate::Vertex };
+
+                    llri::pipeline_color_attachment_desc colorAttachment {};
+                    colorAttachment.format = llri::format::RGBA8UNorm;
+                    colorAttachment.writeMask = llri::color_component_flag_bits::All;
+
+                    llri::graphics_pipeline_desc pipelineDesc {};
+                    pipelineDesc.vertexShader = llri::shader_bytecode { sizeof(shader), shader.data(), "main" };
+                    pipelineDesc.fragmentShader = llri::shader_bytecode { 0, nullptr, nullptr };
+                    pipelineDesc.topology = llri::primitive_topology::TriangleList;
+                    pipelineDesc.numVertexBindings = 1;
+                    pipelineDesc.vertexBindings = &binding;
+                    pipelineDesc.rasterizer = llri::rasterizer_desc { llri::cull_mode::None, llri::front_face::CounterClockwise, 0, 0.0f };
+                    pipelineDesc.numColorAttachments = 1;
+                    pipelineDesc.colorAttachments = &colorAttachment;
+                    pipelineDesc.depthStencilFormat = llri::format::Undefined;
+                    pipelineDesc.sampleCount = llri::sample_count::Count1;
+
+                    llri::resource_desc textureDesc;
+                    textureDesc.createNodeMask = 0;
+                    textureDesc.visibleNodeMask = 0;
+                    textureDesc.type = llri::resource_type::Texture2D;
+                    textureDesc.usage = llri::resource_usage_flag_bits::ColorAttachment;
+                    textureDesc.memoryType = llri::memory_type::Local;
+                    textureDesc.initialState = llri::resource_state::ColorAttachment;
+                    textureDesc.width = 64;
+                    textureDesc.height = 64;
+                    textureDesc.depthOrArrayLayers = 1;
+                    textureDesc.mipLevels = 1;
+                    textureDesc.sampleCount = llri::sample_count::Count1;
+                    textureDesc.textureFormat = llri::format::RGBA8UNorm;
+                    textureDesc.sharingMode = llri::resource_sharing_mode::Concurrent;
+
+                    llri::Resource* texture;
+                    llri::Resource* vertices;
+                    llri::Resource* indices;
+                    REQUIRE_EQ(device->createResource(textureDesc, &texture), llri::result::Success);
+                    REQUIRE_EQ(device->createResource(llri::resource_desc::buffer(llri::resource_usage_flag_bits::None, llri::memory_type::Local, llri::resource_state::VertexBuffer, 48), &vertices), llri::result::Success);
+                    REQUIRE_EQ(device->createResource(llri::resource_desc::buffer(llri::resource_usage_flag_bits::None, llri::memory_type::Local, llri::resource_state::IndexBuffer, 12), &indices), llri::result::Success);
+
+                    REQUIRE_EQ(device->beginCapture(path), llri::result::Success);
+
+                    auto* group = detail::defaultCommandGroup(device, llri::queue_type::Graphics);
+                    auto* list = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+
+                    llri::Pipeline* pipeline;
+                    REQUIRE_EQ(device->createGraphicsPipeline(pipelineDesc, &pipeline), llri::result::Success);
+
+                    llri::rendering_attachment_desc attachment {};
+                    attachment.texture = texture;
+                    attachment.loadOp = llri::attachment_load_op::Clear;
+                    attachment.storeOp = llri::attachment_store_op::Store;
+                    attachment.clearValue.color = llri::clear_color_value { 0.0f, 0.0f, 0.0f, 1.0f };
+
+                    llri::rendering_desc renderingDesc {};
+                    renderingDesc.area = llri::rect_2d { { 0, 0 }, { 64, 64 } };
+                    renderingDesc.numColorAttachments = 1;
+                    renderingDesc.colorAttachments = &attachment;
+
+                    REQUIRE_EQ(list->begin({}), llri::result::Success);
+                    REQUIRE_EQ(list->beginRendering(renderingDesc), llri::result::Success);
+                    CHECK_EQ(list->bindPipeline(pipeline), llri::result::Success);
+                    CHECK_EQ(list->setViewport({ 0.0f, 0.0f, 64.0f, 64.0f, 0.0f, 1.0f }), llri::result::Success);
+                    CHECK_EQ(list->setScissor({ { 0, 0 }, { 64, 64 } }), llri::result::Success);
+                    CHECK_EQ(list->bindVertexBuffers(0, 1, &vertices, nullptr), llri::result::Success);
+                    CHECK_EQ(list->bindIndexBuffer(indices, 0, llri::index_type::UInt32), llri::result::Success);
+                    CHECK_EQ(list->draw(3, 1, 0, 0), llri::result::Success);
+                    CHECK_EQ(list->drawIndexed(3, 1, 0, 0, 0), llri::result::Success);
+                    CHECK_EQ(list->endRendering(), llri::result::Success);
+                    REQUIRE_EQ(list->end(), llri::result::Success);
+
+                    device->destroyCommandGroup(group);
+                    device->destroyPipeline(pipeline);
+                    device->endCapture();
+
+                    device->destroyResource(indices);
+                    device->destroyResource(vertices);
+                    device->destroyResource(texture);
+
+                    std::ifstream file(path, std::ios::binary);
+                    REQUIRE(file.good());
+                    const std::vector<char> contents { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+                    // the shader bytecode is serialized into the CreateGraphicsPipeline record
+                    const auto* shaderBytes = reinterpret_cast<const char*>(shader.data());
+                    CHECK_NE(std::search(contents.begin(), contents.end(), shaderBytes, shaderBytes + sizeof(shader)), contents.end());
+                }
+            }
+
+            SUBCASE("[Correct usage] endCapture() without beginCapture()")
+            {
+                device->endCapture();
+            }
+        }
+
+        std::remove(path);
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file command_context_pool.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+TEST_CASE("CommandContextPool")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+        const auto type = detail::availableQueueType(adapter);
+
+        const llri::command_context_pool_desc desc { type, 2, 2, llri::command_group_reset_mode::KeepMemory };
+
+        SUBCASE("Device::createCommandContextPool()")
+        {
+            llri::CommandContextPool* pool;
+
+            SUBCASE("[Incorrect usage] pool == nullptr")
+            {
+                CHECK_EQ(device->createCommandContextPool(desc, nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] type > queue_type::MaxEnum")
+            {
+                CHECK_EQ(device->createCommandContextPool({ static_cast<llri::queue_type>(UINT8_MAX), 2, 2, llri::command_group_reset_mode::KeepMemory }, &pool), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] numThreads == 0 or numFramesInFlight == 0")
+            {
+                CHECK_EQ(device->createCommandContextPool({ type, 0, 2, llri::command_group_reset_mode::KeepMemory }, &pool), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(device->createCommandContextPool({ type, 2, 0, llri::command_group_reset_mode::KeepMemory }, &pool), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] resetMode > command_group_reset_mode::MaxEnum")
+            {
+                CHECK_EQ(device->createCommandContextPool({ type, 2, 2, static_cast<llri::command_group_reset_mode>(UINT8_MAX) }, &pool), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] valid desc")
+            {
+                REQUIRE_EQ(device->createCommandContextPool(desc, &pool), llri::result::Success);
+                CHECK_EQ(pool->getFrameFence(), nullptr);
+                device->destroyCommandContextPool(pool);
+            }
+        }
+
+        SUBCASE("CommandContextPool usage")
+        {
+            llri::CommandContextPool* pool;
+            REQUIRE_EQ(device->createCommandContextPool(desc, &pool), llri::result::Success);
+
+            SUBCASE("[Incorrect usage] beginFrame() wasn't called")
+            {
+                llri::CommandGroup* group;
+                CHECK_EQ(pool->getCommandGroup(0, &group), llri::result::ErrorInvalidState);
+            }
+
+            SUBCASE("[Incorrect usage] threadIndex >= numThreads")
+            {
+                REQUIRE_EQ(pool->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                llri::CommandGroup* group;
+                CHECK_EQ(pool->getCommandGroup(2, &group), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] every thread has its own CommandGroup in every frame")
+            {
+                llri::CommandGroup* groups[2][2];
+                for (uint32_t frame = 0; frame < 2; frame++)
+                {
+                    REQUIRE_EQ(pool->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+                    CHECK_EQ(pool->getFrameIndex(), frame);
+                    CHECK_NE(pool->getFrameFence(), nullptr);
+
+                    for (uint32_t thread = 0; thread < 2; thread++)
+                        REQUIRE_EQ(pool->getCommandGroup(thread, &groups[frame][thread]), llri::result::Success);
+                }
+
+                CHECK_NE(groups[0][0], groups[0][1]);
+                CHECK_NE(groups[0][0], groups[1][0]);
+
+                // frames are reused round-robin
+                REQUIRE_EQ(pool->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+                CHECK_EQ(pool->getFrameIndex(), 0u);
+            }
+
+            SUBCASE("[Correct usage] acquired CommandLists are recycled")
+            {
+                const llri::command_list_alloc_desc listDesc { 0, llri::command_list_usage::Direct };
+
+                REQUIRE_EQ(pool->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                llri::CommandList* first;
+                llri::CommandList* second;
+                REQUIRE_EQ(pool->acquireCommandList(0, listDesc, &first), llri::result::Success);
+                REQUIRE_EQ(pool->acquireCommandList(0, listDesc, &second), llri::result::Success);
+                CHECK_NE(first, second);
+
+                REQUIRE_EQ(first->record({}, [](){}), llri::result::Success);
+
+                // submit the list with the frame fence so that the next use of this frame waits for it
+                auto* queue = device->getQueue(type, 0);
+                llri::submit_desc submitDesc { 0, 1, &first, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, pool->getFrameFence() };
+                REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+
+                // move around to the same frame again
+                REQUIRE_EQ(pool->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+                REQUIRE_EQ(pool->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                llri::CommandList* recycled;
+                REQUIRE_EQ(pool->acquireCommandList(0, listDesc, &recycled), llri::result::Success);
+                CHECK((recycled == first || recycled == second));
+                CHECK_EQ(recycled->getState(), llri::command_list_state::Empty);
+            }
+
+            device->destroyCommandContextPool(pool);
+        }
+
+        SUBCASE("Device::destroyCommandContextPool()")
+        {
+            // nullptr is allowed
+            CHECK_NOTHROW(device->destroyCommandContextPool(nullptr));
+        }
+
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
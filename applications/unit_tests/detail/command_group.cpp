@@ -30,6 +30,16 @@ TEST_CASE("CommandGroup")
                         CHECK_EQ(group->reset(), llri::result::Success);
                     }
 
+                    SUBCASE("[Correct usage] command_group_reset_mode::KeepMemory")
+                    {
+                        CHECK_EQ(group->reset(llri::command_group_reset_mode::KeepMemory), llri::result::Success);
+                    }
+
+                    SUBCASE("[Incorrect usage] mode > command_group_reset_mode::MaxEnum")
+                    {
+                        CHECK_EQ(group->reset(static_cast<llri::command_group_reset_mode>(UINT8_MAX)), llri::result::ErrorInvalidUsage);
+                    }
+
                     SUBCASE("[Incorrect usage] CommandList still recording")
                     {
                         llri::CommandList* cmdList;
@@ -0,0 +1,205 @@
+/**
+ * @file command_stream.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+TEST_CASE("CommandStream")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+
+        SUBCASE("Device::createCommandStream()")
+        {
+            llri::CommandStream* stream;
+
+            SUBCASE("[Incorrect usage] stream == nullptr")
+            {
+                CHECK_EQ(device->createCommandStream({ 1024 }, nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] blockSize == 0")
+            {
+                CHECK_EQ(device->createCommandStream({ 0 }, &stream), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] valid desc")
+            {
+                REQUIRE_EQ(device->createCommandStream({ 1024 }, &stream), llri::result::Success);
+                CHECK_EQ(stream->getNumCommands(), 0);
+                CHECK_EQ(stream->getAllocatedSize(), 0);
+                device->destroyCommandStream(stream);
+            }
+        }
+
+        llri::CommandStream* stream;
+        REQUIRE_EQ(device->createCommandStream({ 256 }, &stream), llri::result::Success);
+
+        llri::Resource* buffers[2];
+        for (auto*& buffer : buffers)
+            REQUIRE_EQ(device->createResource(llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferSrc | llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::TransferDst, 64), &buffer), llri::result::Success);
+
+        const auto barrierA = llri::resource_barrier::transition(buffers[0], llri::resource_state::TransferDst, llri::resource_state::TransferSrc);
+        const auto barrierB = llri::resource_barrier::transition(buffers[1], llri::resource_state::TransferDst, llri::resource_state::TransferSrc);
+
+        SUBCASE("Recording")
+        {
+            stream->resourceBarrier(barrierA);
+            stream->setStencilReference(1);
+            stream->draw(3, 1, 0, 0);
+            stream->insertLabel("label");
+
+            REQUIRE_EQ(stream->getNumCommands(), 4);
+            CHECK_EQ(stream->getOpcode(0), llri::command_stream_opcode::ResourceBarrier);
+            CHECK_EQ(stream->getOpcode(1), llri::command_stream_opcode::SetStencilReference);
+            CHECK_EQ(stream->getOpcode(2), llri::command_stream_opcode::Draw);
+            CHECK_EQ(stream->getOpcode(3), llri::command_stream_opcode::InsertLabel);
+
+            SUBCASE("[Correct usage] reset() keeps the arena's memory")
+            {
+                const size_t allocated = stream->getAllocatedSize();
+                stream->reset();
+                CHECK_EQ(stream->getNumCommands(), 0);
+                CHECK_EQ(stream->getAllocatedSize(), allocated);
+            }
+
+            SUBCASE("[Correct usage] data larger than blockSize")
+            {
+                const std::array<uint8_t, 1024> data {};
+                stream->pushConstants(llri::shader_stage_flag_bits::Vertex, 0, data);
+                CHECK_EQ(stream->getNumCommands(), 5);
+                CHECK_GE(stream->getAllocatedSize(), data.size());
+            }
+        }
+
+        SUBCASE("CommandStream::optimize()")
+        {
+            SUBCASE("[Correct usage] barriers separated by state commands are merged")
+            {
+                stream->resourceBarrier(barrierA);
+                stream->setViewport({ 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f });
+                stream->setStencilReference(1);
+                stream->resourceBarrier(barrierB);
+                stream->optimize();
+
+                REQUIRE_EQ(stream->getNumCommands(), 3);
+                CHECK_EQ(stream->getOpcode(0), llri::command_stream_opcode::ResourceBarrier);
+                CHECK_EQ(stream->getOpcode(1), llri::command_stream_opcode::SetViewport);
+                CHECK_EQ(stream->getOpcode(2), llri::command_stream_opcode::SetStencilReference);
+            }
+
+            SUBCASE("[Correct usage] barriers for the same Resource aren't merged")
+            {
+                stream->resourceBarrier(barrierA);
+                stream->resourceBarrier(llri::resource_barrier::transition(buffers[0], llri::resource_state::TransferSrc, llri::resource_state::TransferDst));
+                stream->optimize();
+                CHECK_EQ(stream->getNumCommands(), 2);
+            }
+
+            SUBCASE("[Correct usage] barriers aren't hoisted over commands that access resources")
+            {
+                stream->resourceBarrier(barrierA);
+                stream->draw(3, 1, 0, 0);
+                stream->resourceBarrier(barrierB);
+                stream->optimize();
+                CHECK_EQ(stream->getNumCommands(), 3);
+            }
+        }
+
+        SUBCASE("CommandStream::translate()")
+        {
+            auto* group = detail::defaultCommandGroup(device, detail::availableQueueType(adapter));
+            auto* list = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+
+            stream->beginLabel("barriers");
+            stream->resourceBarrier(barrierA);
+            stream->resourceBarrier(barrierB);
+            stream->endLabel();
+            stream->optimize();
+
+            SUBCASE("[Incorrect usage] cmdList == nullptr")
+            {
+                CHECK_EQ(stream->translate(nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] cmdList isn't recording")
+            {
+                CHECK_EQ(stream->translate(list), llri::result::ErrorInvalidState);
+            }
+
+            SUBCASE("[Incorrect usage] invalid commands are reported by the CommandList")
+            {
+                stream->resourceBarrier(0, nullptr);
+
+                REQUIRE_EQ(list->begin({}), llri::result::Success);
+                CHECK_EQ(stream->translate(list), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] translate()")
+            {
+                REQUIRE_EQ(list->begin({}), llri::result::Success);
+                CHECK_EQ(stream->translate(list), llri::result::Success);
+                CHECK_EQ(list->end(), llri::result::Success);
+            }
+
+            SUBCASE("[Incorrect usage] translateCommandStreams() with invalid arrays")
+            {
+                const llri::CommandStream* streams[] = { stream };
+                CHECK_EQ(llri::translateCommandStreams(1, nullptr, &list), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(llri::translateCommandStreams(1, streams, nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] translateCommandStreams()")
+            {
+                llri::CommandStream* secondStream;
+                REQUIRE_EQ(device->createCommandStream({ 256 }, &secondStream), llri::result::Success);
+                secondStream->insertLabel("second stream");
+
+                auto* secondList = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+                REQUIRE_EQ(list->begin({}), llri::result::Success);
+                REQUIRE_EQ(secondList->begin({}), llri::result::Success);
+
+                const llri::CommandStream* streams[] = { stream, secondStream };
+                llri::CommandList* lists[] = { list, secondList };
+
+                SUBCASE("on the calling thread")
+                {
+                    CHECK_EQ(llri::translateCommandStreams(2, streams, lists), llri::result::Success);
+                }
+
+                SUBCASE("with an executor")
+                {
+                    const auto executor = [](uint32_t numJobs, const std::function<void(uint32_t)>& job) {
+                        std::vector<std::thread> threads;
+                        for (uint32_t i = 1; i < numJobs; i++)
+                            threads.emplace_back(job, i);
+
+                        job(0);
+                        for (auto& thread : threads)
+                            thread.join();
+                    };
+                    CHECK_EQ(llri::translateCommandStreams(2, streams, lists, executor), llri::result::Success);
+                }
+
+                CHECK_EQ(list->end(), llri::result::Success);
+                CHECK_EQ(secondList->end(), llri::result::Success);
+                device->destroyCommandStream(secondStream);
+            }
+
+            device->destroyCommandGroup(group);
+        }
+
+        for (auto* buffer : buffers)
+            device->destroyResource(buffer);
+        device->destroyCommandStream(stream);
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
@@ -9,6 +9,12 @@
 #include <doctest/doctest.h>
 
 #include <detail/commands/resource_barrier.hpp>
+#include <detail/commands/push_constants.hpp>
+#include <detail/commands/rendering.hpp>
+#include <detail/commands/indirect_lists.hpp>
+#include <detail/commands/queries.hpp>
+#include <detail/commands/labels.hpp>
+#include <detail/commands/copy_buffer.hpp>
 
 TEST_CASE("CommandList:: commands")
 {
@@ -21,6 +27,24 @@ TEST_CASE("CommandList:: commands")
 
         SUBCASE("resourceBarrier()")
             testCommandListResourceBarrier(device, group, list);
+
+        SUBCASE("pushConstants()")
+            testCommandListPushConstants(device, group, list);
+
+        SUBCASE("rendering")
+            testCommandListRendering(device, group, list);
+
+        SUBCASE("executeIndirectLists()")
+            testCommandListExecuteIndirectLists(device, group, list);
+
+        SUBCASE("queries")
+            testCommandListQueries(device, group, list);
+
+        SUBCASE("labels")
+            testCommandListLabels(device, group, list);
+
+        SUBCASE("copyBuffer()")
+            testCommandListCopyBuffer(device, group, list);
         
         device->destroyCommandGroup(group);
         instance->destroyDevice(device);
@@ -0,0 +1,61 @@
+/**
+ * @file copy_buffer.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <helpers.hpp>
+#include <doctest/doctest.h>
+
+inline void testCommandListCopyBuffer(llri::Device* device, llri::CommandGroup* group, llri::CommandList* list)
+{
+    REQUIRE_EQ(group->reset(), llri::result::Success);
+
+    llri::Resource* src;
+    REQUIRE_EQ(device->createResource(llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferSrc | llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::TransferSrc, 64), &src), llri::result::Success);
+
+    llri::Resource* dst;
+    REQUIRE_EQ(device->createResource(llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::TransferDst, 64), &dst), llri::result::Success);
+
+    SUBCASE("[Incorrect usage] CommandList isn't recording")
+    {
+        CHECK_EQ(list->copyBuffer(src, 0, dst, 0, 64), llri::result::ErrorInvalidState);
+    }
+
+    REQUIRE_EQ(list->begin({}), llri::result::Success);
+
+    SUBCASE("[Incorrect usage] src or dst == nullptr")
+    {
+        CHECK_EQ(list->copyBuffer(nullptr, 0, dst, 0, 64), llri::result::ErrorInvalidUsage);
+        CHECK_EQ(list->copyBuffer(src, 0, nullptr, 0, 64), llri::result::ErrorInvalidUsage);
+    }
+
+    SUBCASE("[Incorrect usage] src or dst doesn't have the necessary resource_usage_flags")
+    {
+        CHECK_EQ(list->copyBuffer(dst, 0, dst, 32, 16), llri::result::ErrorInvalidUsage);
+    }
+
+    SUBCASE("[Incorrect usage] size == 0 or the range exceeds a buffer")
+    {
+        CHECK_EQ(list->copyBuffer(src, 0, dst, 0, 0), llri::result::ErrorInvalidUsage);
+        CHECK_EQ(list->copyBuffer(src, 32, dst, 0, 64), llri::result::ErrorInvalidUsage);
+        CHECK_EQ(list->copyBuffer(src, 0, dst, 32, 64), llri::result::ErrorInvalidUsage);
+    }
+
+    SUBCASE("[Incorrect usage] overlapping ranges in the same buffer")
+    {
+        CHECK_EQ(list->copyBuffer(src, 0, src, 16, 32), llri::result::ErrorInvalidUsage);
+    }
+
+    SUBCASE("[Correct usage] valid parameters")
+    {
+        CHECK_EQ(list->copyBuffer(src, 0, dst, 0, 64), llri::result::Success);
+        CHECK_EQ(list->copyBuffer(src, 16, dst, 32, 16), llri::result::Success);
+    }
+
+    CHECK_EQ(list->end(), llri::result::Success);
+
+    device->destroyResource(dst);
+    device->destroyResource(src);
+}
@@ -0,0 +1,186 @@
+/**
+ * @file indirect_lists.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <helpers.hpp>
+#include <doctest/doctest.h>
+
+inline void testCommandListExecuteIndirectLists(llri::Device* device, llri::CommandGroup* group, llri::CommandList* list)
+{
+    REQUIRE_EQ(group->reset(), llri::result::Success);
+
+    const bool graphics = group->getType() == llri::queue_type::Graphics;
+    auto* indirect = detail::defaultCommandList(group, 0, llri::command_list_usage::Indirect);
+
+    const llri::format colorFormat = llri::format::RGBA8UNorm;
+    llri::command_list_inheritance_desc inheritance {};
+    inheritance.area = llri::rect_2d { { 0, 0 }, { 64, 64 } };
+    inheritance.numColorAttachments = 1;
+    inheritance.colorFormats = &colorFormat;
+    inheritance.depthStencilFormat = llri::format::Undefined;
+    inheritance.sampleCount = llri::sample_count::Count1;
+    inheritance.stencilReference = 0;
+
+    SUBCASE("[Incorrect usage] Direct CommandList with a command_list_inheritance_desc")
+    {
+        CHECK_EQ(list->begin({ &inheritance, llri::command_list_submit_mode::OneTime }), llri::result::ErrorInvalidUsage);
+    }
+
+    SUBCASE("[Incorrect usage] CommandList isn't recording")
+    {
+        CHECK_EQ(list->executeIndirectLists(1, &indirect), llri::result::ErrorInvalidState);
+    }
+
+    if (!graphics)
+    {
+        SUBCASE("[Incorrect usage] Indirect CommandList inherits a rendering scope in a non-Graphics CommandGroup")
+        {
+            CHECK_EQ(indirect->begin({ &inheritance, llri::command_list_submit_mode::OneTime }), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] CommandList wasn't allocated through a Graphics CommandGroup")
+        {
+            REQUIRE_EQ(indirect->record({}, [](){}), llri::result::Success);
+            REQUIRE_EQ(list->begin({}), llri::result::Success);
+            CHECK_EQ(list->executeIndirectLists(1, &indirect), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->end(), llri::result::Success);
+        }
+    }
+    else
+    {
+        SUBCASE("[Incorrect usage] inheritance without attachments")
+        {
+            llri::command_list_inheritance_desc invalid = inheritance;
+            invalid.numColorAttachments = 0;
+            CHECK_EQ(indirect->begin({ &invalid, llri::command_list_submit_mode::OneTime }), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] inheritance with an invalid color format")
+        {
+            const llri::format depthFormat = llri::format::D32Float;
+
+            llri::command_list_inheritance_desc invalid = inheritance;
+            invalid.colorFormats = &depthFormat;
+            CHECK_EQ(indirect->begin({ &invalid, llri::command_list_submit_mode::OneTime }), llri::result::ErrorInvalidFormat);
+        }
+
+        SUBCASE("[Incorrect usage] Indirect CommandLists can't record barriers, rendering scopes or dynamic state")
+        {
+            REQUIRE_EQ(indirect->begin({}), llri::result::Success);
+
+            const llri::resource_barrier barrier = llri::resource_barrier::read_write(nullptr);
+            CHECK_EQ(indirect->resourceBarrier(1, &barrier), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(indirect->setViewport({ 0.0f, 0.0f, 64.0f, 64.0f, 0.0f, 1.0f }), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(indirect->setScissor({ { 0, 0 }, { 64, 64 } }), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(indirect->setStencilReference(0), llri::result::ErrorInvalidUsage);
+
+            CHECK_EQ(indirect->end(), llri::result::Success);
+        }
+
+        SUBCASE("[Incorrect usage] numLists == 0 or lists == nullptr")
+        {
+            REQUIRE_EQ(list->begin({}), llri::result::Success);
+            CHECK_EQ(list->executeIndirectLists(0, &indirect), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->executeIndirectLists(1, nullptr), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->end(), llri::result::Success);
+        }
+
+        SUBCASE("[Incorrect usage] lists contains a Direct CommandList")
+        {
+            REQUIRE_EQ(list->begin({}), llri::result::Success);
+            CHECK_EQ(list->executeIndirectLists(1, &list), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->end(), llri::result::Success);
+        }
+
+        SUBCASE("[Incorrect usage] Indirect CommandList isn't ready")
+        {
+            REQUIRE_EQ(list->begin({}), llri::result::Success);
+            CHECK_EQ(list->executeIndirectLists(1, &indirect), llri::result::ErrorInvalidState);
+            CHECK_EQ(list->end(), llri::result::Success);
+        }
+
+        SUBCASE("[Incorrect usage] Indirect CommandList inherits a rendering scope but is executed outside of one")
+        {
+            REQUIRE_EQ(indirect->record({ &inheritance, llri::command_list_submit_mode::OneTime }, [](){}), llri::result::Success);
+
+            REQUIRE_EQ(list->begin({}), llri::result::Success);
+            CHECK_EQ(list->executeIndirectLists(1, &indirect), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->end(), llri::result::Success);
+        }
+
+        SUBCASE("[Incorrect usage] Indirect CommandList with command_list_submit_mode::OneTime is executed multiple times")
+        {
+            REQUIRE_EQ(indirect->record({}, [](){}), llri::result::Success);
+
+            REQUIRE_EQ(list->begin({}), llri::result::Success);
+            CHECK_EQ(list->executeIndirectLists(1, &indirect), llri::result::Success);
+            CHECK_EQ(list->executeIndirectLists(1, &indirect), llri::result::ErrorInvalidState);
+            CHECK_EQ(list->end(), llri::result::Success);
+        }
+
+        SUBCASE("[Correct usage] Indirect CommandList with command_list_submit_mode::Simultaneous is executed multiple times")
+        {
+            REQUIRE_EQ(indirect->record({ nullptr, llri::command_list_submit_mode::Simultaneous }, [](){}), llri::result::Success);
+
+            REQUIRE_EQ(list->begin({}), llri::result::Success);
+            CHECK_EQ(list->executeIndirectLists(1, &indirect), llri::result::Success);
+            CHECK_EQ(list->executeIndirectLists(1, &indirect), llri::result::Success);
+            CHECK_EQ(list->end(), llri::result::Success);
+        }
+
+        SUBCASE("[Correct usage] Indirect CommandList is executed inside of a rendering scope")
+        {
+            llri::resource_desc textureDesc;
+            textureDesc.createNodeMask = 0;
+            textureDesc.visibleNodeMask = 0;
+            textureDesc.type = llri::resource_type::Texture2D;
+            textureDesc.usage = llri::resource_usage_flag_bits::ColorAttachment;
+            textureDesc.memoryType = llri::memory_type::Local;
+            textureDesc.initialState = llri::resource_state::ColorAttachment;
+            textureDesc.width = 64;
+            textureDesc.height = 64;
+            textureDesc.depthOrArrayLayers = 1;
+            textureDesc.mipLevels = 1;
+            textureDesc.sampleCount = llri::sample_count::Count1;
+            textureDesc.textureFormat = colorFormat;
+            textureDesc.sharingMode = llri::resource_sharing_mode::Concurrent;
+
+            llri::Resource* texture;
+            REQUIRE_EQ(device->createResource(textureDesc, &texture), llri::result::Success);
+
+            // Indirect CommandLists with an inherited rendering scope end without calling endRendering()
+            REQUIRE_EQ(indirect->begin({ &inheritance, llri::command_list_submit_mode::OneTime }), llri::result::Success);
+            CHECK_EQ(indirect->draw(3, 1, 0, 0), llri::result::ErrorInvalidState); // no pipeline bound
+            REQUIRE_EQ(indirect->end(), llri::result::Success);
+
+            llri::rendering_attachment_desc attachment {};
+            attachment.texture = texture;
+            attachment.loadOp = llri::attachment_load_op::DontCare;
+            attachment.storeOp = llri::attachment_store_op::Store;
+
+            llri::rendering_desc desc {};
+            desc.area = inheritance.area;
+            desc.numColorAttachments = 1;
+            desc.colorAttachments = &attachment;
+            desc.depthStencilAttachment = nullptr;
+            desc.contents = llri::rendering_contents::IndirectLists;
+
+            REQUIRE_EQ(list->begin({}), llri::result::Success);
+            REQUIRE_EQ(list->beginRendering(desc), llri::result::Success);
+
+            // inline commands can't be recorded in scopes with rendering_contents::IndirectLists
+            CHECK_EQ(list->setStencilReference(0), llri::result::ErrorInvalidState);
+
+            CHECK_EQ(list->executeIndirectLists(1, &indirect), llri::result::Success);
+            CHECK_EQ(list->endRendering(), llri::result::Success);
+            CHECK_EQ(list->end(), llri::result::Success);
+
+            device->destroyResource(texture);
+        }
+    }
+
+    REQUIRE_EQ(group->free(indirect), llri::result::Success);
+}
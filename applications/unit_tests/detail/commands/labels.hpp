@@ -0,0 +1,61 @@
+/**
+ * @file labels.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <helpers.hpp>
+#include <doctest/doctest.h>
+
+inline void testCommandListLabels(llri::Device* device, llri::CommandGroup* group, llri::CommandList* list)
+{
+    REQUIRE_EQ(group->reset(), llri::result::Success);
+
+    SUBCASE("setName()")
+    {
+        CHECK_EQ(list->setName(nullptr), llri::result::ErrorInvalidUsage);
+        CHECK_EQ(list->setName("unit test command list"), llri::result::Success);
+        CHECK_EQ(group->setName("unit test command group"), llri::result::Success);
+        CHECK_EQ(device->setName("unit test device"), llri::result::Success);
+        CHECK_EQ(device->getQueue(group->getType(), 0)->setName("unit test queue"), llri::result::Success);
+    }
+
+    SUBCASE("[Incorrect usage] CommandList isn't recording")
+    {
+        CHECK_EQ(list->beginLabel("label"), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->endLabel(), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->insertLabel("label"), llri::result::ErrorInvalidState);
+    }
+
+    REQUIRE_EQ(list->begin({}), llri::result::Success);
+
+    SUBCASE("[Incorrect usage] name == nullptr")
+    {
+        CHECK_EQ(list->beginLabel(nullptr), llri::result::ErrorInvalidUsage);
+        CHECK_EQ(list->insertLabel(nullptr), llri::result::ErrorInvalidUsage);
+    }
+
+    SUBCASE("[Incorrect usage] endLabel() without a matching beginLabel()")
+    {
+        CHECK_EQ(list->endLabel(), llri::result::ErrorInvalidState);
+    }
+
+    SUBCASE("[Incorrect usage] end() with an open label")
+    {
+        CHECK_EQ(list->beginLabel("label"), llri::result::Success);
+        CHECK_EQ(list->end(), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->endLabel(), llri::result::Success);
+    }
+
+    SUBCASE("[Correct usage] nested labels")
+    {
+        CHECK_EQ(list->beginLabel("outer", { 1.0f, 0.0f, 0.0f, 1.0f }), llri::result::Success);
+        CHECK_EQ(list->insertLabel("marker"), llri::result::Success);
+        CHECK_EQ(list->beginLabel("inner"), llri::result::Success);
+        CHECK_EQ(list->endLabel(), llri::result::Success);
+        CHECK_EQ(list->endLabel(), llri::result::Success);
+    }
+
+    CHECK_EQ(list->end(), llri::result::Success);
+}
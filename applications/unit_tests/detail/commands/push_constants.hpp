@@ -0,0 +1,86 @@
+/**
+ * @file push_constants.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <helpers.hpp>
+#include <doctest/doctest.h>
+
+inline void testCommandListPushConstants(llri::Device* device, llri::CommandGroup* group, llri::CommandList* list)
+{
+    REQUIRE_EQ(group->reset(), llri::result::Success);
+
+    const uint32_t maxSize = device->getAdapter()->queryLimits().maxPushConstantSize;
+    CHECK_GE(maxSize, 128u);
+
+    const std::array<uint32_t, 4> data { 0, 1, 2, 3 };
+    const bool graphics = group->getType() == llri::queue_type::Graphics;
+    const bool transfer = group->getType() == llri::queue_type::Transfer;
+
+    SUBCASE("[Incorrect usage] CommandList isn't recording")
+    {
+        CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, 0, 16, data.data()), llri::result::ErrorInvalidState);
+    }
+
+    REQUIRE_EQ(list->begin({}), llri::result::Success);
+
+    if (transfer)
+    {
+        SUBCASE("[Incorrect usage] CommandList was allocated through a Transfer CommandGroup")
+        {
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, 0, 16, data.data()), llri::result::ErrorInvalidUsage);
+        }
+    }
+    else
+    {
+        SUBCASE("[Incorrect usage] stageMask == shader_stage_flag_bits::None")
+        {
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::None, 0, 16, data.data()), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] stageMask > shader_stage_flag_bits::All")
+        {
+            CHECK_EQ(list->pushConstants(static_cast<llri::shader_stage_flag_bits>(UINT_MAX), 0, 16, data.data()), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] offset or size aren't a multiple of 4")
+        {
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, 2, 12, data.data()), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, 0, 15, data.data()), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] size == 0")
+        {
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, 0, 0, data.data()), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] data == nullptr")
+        {
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, 0, 16, nullptr), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] offset + size > adapter_limits::maxPushConstantSize")
+        {
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, maxSize - 12, 16, data.data()), llri::result::ErrorExceededLimit);
+        }
+
+        SUBCASE("[Correct usage] compute stage")
+        {
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, 0, 16, data.data()), llri::result::Success);
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, maxSize - 16, 16, data.data()), llri::result::Success);
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Compute, 0, data), llri::result::Success);
+        }
+
+        SUBCASE("graphics stages")
+        {
+            const llri::result expected = graphics ? llri::result::Success : llri::result::ErrorInvalidUsage;
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Vertex, 0, 16, data.data()), expected);
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::Fragment, 16, 16, data.data()), expected);
+            CHECK_EQ(list->pushConstants(llri::shader_stage_flag_bits::All, 0, 16, data.data()), expected);
+        }
+    }
+
+    CHECK_EQ(list->end(), llri::result::Success);
+}
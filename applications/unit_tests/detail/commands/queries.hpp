@@ -0,0 +1,108 @@
+/**
+ * @file queries.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <helpers.hpp>
+#include <doctest/doctest.h>
+
+inline void testCommandListQueries(llri::Device* device, llri::CommandGroup* group, llri::CommandList* list)
+{
+    REQUIRE_EQ(group->reset(), llri::result::Success);
+
+    const bool transfer = group->getType() == llri::queue_type::Transfer;
+    const bool timestamps = device->getQueue(group->getType(), 0)->queryTimestampPeriod() > 0.0;
+
+    llri::QueryPool* queryPool;
+    REQUIRE_EQ(device->createQueryPool({ llri::query_type::Timestamp, 4, 0, llri::pipeline_statistic_flag_bits::None }, &queryPool), llri::result::Success);
+
+    llri::Resource* buffer;
+    REQUIRE_EQ(device->createResource(llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::TransferDst, 32), &buffer), llri::result::Success);
+
+    SUBCASE("[Incorrect usage] CommandList isn't recording")
+    {
+        CHECK_EQ(list->resetQueries(queryPool, 0, 4), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->writeTimestamp(queryPool, 0), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->beginQuery(queryPool, 0), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->endQuery(queryPool, 0), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->resolveQueries(queryPool, 0, 4, buffer, 0), llri::result::ErrorInvalidState);
+    }
+
+    REQUIRE_EQ(list->begin({}), llri::result::Success);
+
+    if (transfer)
+    {
+        SUBCASE("[Incorrect usage] CommandList was allocated through a Transfer CommandGroup")
+        {
+            CHECK_EQ(list->resetQueries(queryPool, 0, 4), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->writeTimestamp(queryPool, 0), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->resolveQueries(queryPool, 0, 4, buffer, 0), llri::result::ErrorInvalidUsage);
+        }
+    }
+    else
+    {
+        SUBCASE("[Incorrect usage] queryPool == nullptr")
+        {
+            CHECK_EQ(list->resetQueries(nullptr, 0, 4), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->resolveQueries(nullptr, 0, 4, buffer, 0), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->beginQuery(nullptr, 0), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->endQuery(nullptr, 0), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] beginQuery() and endQuery() with a Timestamp QueryPool")
+        {
+            CHECK_EQ(list->beginQuery(queryPool, 0), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->endQuery(queryPool, 0), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] numQueries == 0 or the range exceeds the QueryPool")
+        {
+            CHECK_EQ(list->resetQueries(queryPool, 0, 0), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->resetQueries(queryPool, 2, 3), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->resolveQueries(queryPool, 4, 1, buffer, 0), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] buffer is nullptr, the offset isn't a multiple of 8 or the buffer is too small")
+        {
+            CHECK_EQ(list->resolveQueries(queryPool, 0, 4, nullptr, 0), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->resolveQueries(queryPool, 0, 2, buffer, 4), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->resolveQueries(queryPool, 0, 4, buffer, 8), llri::result::ErrorInvalidUsage);
+        }
+
+        if (timestamps)
+        {
+            SUBCASE("[Incorrect usage] query >= query_pool_desc::count")
+            {
+                CHECK_EQ(list->writeTimestamp(queryPool, 4), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] timestamps are written and resolved")
+            {
+                CHECK_EQ(list->resetQueries(queryPool, 0, 4), llri::result::Success);
+                CHECK_EQ(list->writeTimestamp(queryPool, 0), llri::result::Success);
+                CHECK_EQ(list->writeTimestamp(queryPool, 1), llri::result::Success);
+                CHECK_EQ(list->resolveQueries(queryPool, 0, 2, buffer, 0), llri::result::Success);
+                REQUIRE_EQ(list->end(), llri::result::Success);
+
+                auto* fence = detail::defaultFence(device, false);
+                llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, fence };
+                REQUIRE_EQ(device->getQueue(group->getType(), 0)->submit(submitDesc), llri::result::Success);
+                REQUIRE_EQ(device->waitFence(fence, LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                std::array<uint64_t, 2> results {};
+                CHECK_EQ(queryPool->getResults(0, 2, results.data()), llri::result::Success);
+                CHECK_LE(results[0], results[1]);
+
+                device->destroyFence(fence);
+            }
+        }
+    }
+
+    if (list->getState() == llri::command_list_state::Recording)
+        CHECK_EQ(list->end(), llri::result::Success);
+
+    device->destroyResource(buffer);
+    device->destroyQueryPool(queryPool);
+}
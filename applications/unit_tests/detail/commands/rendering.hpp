@@ -0,0 +1,170 @@
+/**
+ * @file rendering.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <helpers.hpp>
+#include <doctest/doctest.h>
+
+inline void testCommandListRendering(llri::Device* device, llri::CommandGroup* group, llri::CommandList* list)
+{
+    REQUIRE_EQ(group->reset(), llri::result::Success);
+
+    const bool graphics = group->getType() == llri::queue_type::Graphics;
+
+    llri::resource_desc textureDesc;
+    textureDesc.createNodeMask = 0;
+    textureDesc.visibleNodeMask = 0;
+    textureDesc.type = llri::resource_type::Texture2D;
+    textureDesc.usage = llri::resource_usage_flag_bits::ColorAttachment;
+    textureDesc.memoryType = llri::memory_type::Local;
+    textureDesc.initialState = llri::resource_state::ColorAttachment;
+    textureDesc.width = 64;
+    textureDesc.height = 64;
+    textureDesc.depthOrArrayLayers = 1;
+    textureDesc.mipLevels = 1;
+    textureDesc.sampleCount = llri::sample_count::Count1;
+    textureDesc.textureFormat = llri::format::RGBA8UNorm;
+    textureDesc.sharingMode = llri::resource_sharing_mode::Concurrent;
+
+    llri::Resource* texture;
+    REQUIRE_EQ(device->createResource(textureDesc, &texture), llri::result::Success);
+
+    llri::resource_desc bufferDesc = llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::General, 1024);
+    llri::Resource* buffer;
+    REQUIRE_EQ(device->createResource(bufferDesc, &buffer), llri::result::Success);
+
+    llri::rendering_attachment_desc attachment {};
+    attachment.texture = texture;
+    attachment.loadOp = llri::attachment_load_op::Clear;
+    attachment.storeOp = llri::attachment_store_op::Store;
+    attachment.clearValue.color = llri::clear_color_value { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    llri::rendering_desc desc {};
+    desc.area = llri::rect_2d { { 0, 0 }, { 64, 64 } };
+    desc.numColorAttachments = 1;
+    desc.colorAttachments = &attachment;
+    desc.depthStencilAttachment = nullptr;
+
+    SUBCASE("[Incorrect usage] CommandList isn't recording")
+    {
+        CHECK_EQ(list->beginRendering(desc), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->endRendering(), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->draw(3, 1, 0, 0), llri::result::ErrorInvalidState);
+    }
+
+    REQUIRE_EQ(list->begin({}), llri::result::Success);
+
+    SUBCASE("[Incorrect usage] endRendering() outside of a rendering scope")
+    {
+        CHECK_EQ(list->endRendering(), llri::result::ErrorInvalidState);
+    }
+
+    SUBCASE("[Incorrect usage] draw() outside of a rendering scope")
+    {
+        CHECK_EQ(list->draw(3, 1, 0, 0), llri::result::ErrorInvalidState);
+        CHECK_EQ(list->drawIndexed(3, 1, 0, 0, 0), llri::result::ErrorInvalidState);
+    }
+
+    SUBCASE("[Incorrect usage] bindVertexBuffers() without a bound Pipeline")
+    {
+        CHECK_EQ(list->bindVertexBuffers(0, 1, &buffer, nullptr), llri::result::ErrorInvalidState);
+    }
+
+    if (!graphics)
+    {
+        SUBCASE("[Incorrect usage] CommandList wasn't allocated through a Graphics CommandGroup")
+        {
+            CHECK_EQ(list->beginRendering(desc), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->bindPipeline(nullptr), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->setViewport({ 0.0f, 0.0f, 64.0f, 64.0f, 0.0f, 1.0f }), llri::result::ErrorInvalidUsage);
+        }
+    }
+    else
+    {
+        SUBCASE("[Incorrect usage] numColorAttachments == 0 and depthStencilAttachment == nullptr")
+        {
+            llri::rendering_desc empty = desc;
+            empty.numColorAttachments = 0;
+            CHECK_EQ(list->beginRendering(empty), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] numColorAttachments > adapter_limits::maxColorAttachments")
+        {
+            llri::rendering_desc tooMany = desc;
+            tooMany.numColorAttachments = device->getAdapter()->queryLimits().maxColorAttachments + 1;
+            CHECK_EQ(list->beginRendering(tooMany), llri::result::ErrorExceededLimit);
+        }
+
+        SUBCASE("[Incorrect usage] area is empty")
+        {
+            llri::rendering_desc empty = desc;
+            empty.area.extent = { 0, 64 };
+            CHECK_EQ(list->beginRendering(empty), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] colorAttachments[0].texture == nullptr")
+        {
+            llri::rendering_attachment_desc invalid = attachment;
+            invalid.texture = nullptr;
+
+            llri::rendering_desc invalidDesc = desc;
+            invalidDesc.colorAttachments = &invalid;
+            CHECK_EQ(list->beginRendering(invalidDesc), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] colorAttachments[0].texture is a buffer")
+        {
+            llri::rendering_attachment_desc invalid = attachment;
+            invalid.texture = buffer;
+
+            llri::rendering_desc invalidDesc = desc;
+            invalidDesc.colorAttachments = &invalid;
+            CHECK_EQ(list->beginRendering(invalidDesc), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] area exceeds the texture's size")
+        {
+            llri::rendering_desc invalidDesc = desc;
+            invalidDesc.area.offset = { 32, 32 };
+            CHECK_EQ(list->beginRendering(invalidDesc), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] bindPipeline(nullptr)")
+        {
+            CHECK_EQ(list->bindPipeline(nullptr), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] viewport is empty or has invalid depth values")
+        {
+            CHECK_EQ(list->setViewport({ 0.0f, 0.0f, 0.0f, 64.0f, 0.0f, 1.0f }), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->setViewport({ 0.0f, 0.0f, 64.0f, 64.0f, -1.0f, 1.0f }), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->setViewport({ 0.0f, 0.0f, 64.0f, 64.0f, 0.0f, 2.0f }), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Correct usage] rendering scope")
+        {
+            CHECK_EQ(list->beginRendering(desc), llri::result::Success);
+
+            // nested scopes aren't allowed and the list can't end inside of a scope
+            CHECK_EQ(list->beginRendering(desc), llri::result::ErrorInvalidState);
+            CHECK_EQ(list->end(), llri::result::ErrorInvalidState);
+
+            CHECK_EQ(list->setViewport({ 0.0f, 0.0f, 32.0f, 32.0f, 0.0f, 1.0f }), llri::result::Success);
+            CHECK_EQ(list->setScissor({ { 0, 0 }, { 32, 32 } }), llri::result::Success);
+            CHECK_EQ(list->setStencilReference(0), llri::result::Success);
+
+            // no pipeline is bound
+            CHECK_EQ(list->draw(3, 1, 0, 0), llri::result::ErrorInvalidState);
+
+            CHECK_EQ(list->endRendering(), llri::result::Success);
+        }
+    }
+
+    CHECK_EQ(list->end(), llri::result::Success);
+
+    device->destroyResource(buffer);
+    device->destroyResource(texture);
+}
@@ -32,7 +32,12 @@ inline void testCommandListResourceBarrier(llri::Device* device, llri::CommandGr
             // barriers[0].type is invalid
             llri::resource_barrier invalidType {
                 static_cast<llri::resource_barrier_type>(std::numeric_limits<uint8_t>::max()),
-                { llri::resource_barrier_read_write { nullptr } }
+                { llri::resource_barrier_read_write { nullptr } },
+                llri::pipeline_stage_flag_bits::None,
+                llri::pipeline_stage_flag_bits::None,
+                llri::resource_barrier_split::None,
+                llri::queue_ownership_transfer::None,
+                llri::queue_type::Graphics
             };
             CHECK_EQ(cmd->resourceBarrier(1, &invalidType), llri::result::ErrorInvalidUsage);
             
@@ -60,6 +65,7 @@ inline void testCommandListResourceBarrier(llri::Device* device, llri::CommandGr
     textureDesc.mipLevels = 1;
     textureDesc.sampleCount = llri::sample_count::Count1;
     textureDesc.textureFormat = llri::format::RGBA8UNorm;
+    textureDesc.sharingMode = llri::resource_sharing_mode::Concurrent;
     
     llri::resource_desc bufferDesc = llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::General, 1024);
     
@@ -89,6 +95,124 @@ inline void testCommandListResourceBarrier(llri::Device* device, llri::CommandGr
         }
     }
     
+    SUBCASE("resource_barrier stages")
+    {
+        current = &resources.emplace_back(nullptr);
+        REQUIRE_EQ(device->createResource(bufferDesc, current), llri::result::Success);
+
+        SUBCASE("[Incorrect usage] srcStages or dstStages contain invalid bits")
+        {
+            const auto invalidStages = static_cast<llri::pipeline_stage_flag_bits>(1u << 31);
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::transition(*current, llri::resource_state::General, llri::resource_state::TransferDst, llri::texture_subresource_range::all(), invalidStages, llri::pipeline_stage_flag_bits::Transfer)), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::transition(*current, llri::resource_state::General, llri::resource_state::TransferDst, llri::texture_subresource_range::all(), llri::pipeline_stage_flag_bits::Transfer, invalidStages)), llri::result::ErrorInvalidUsage);
+        }
+
+        if (group->getType() != llri::queue_type::Graphics)
+        {
+            SUBCASE("[Incorrect usage] graphics stages in a non-Graphics CommandList")
+            {
+                CHECK_EQ(list->resourceBarrier(llri::resource_barrier::transition(*current, llri::resource_state::General, llri::resource_state::TransferDst, llri::texture_subresource_range::all(), llri::pipeline_stage_flag_bits::VertexShader, llri::pipeline_stage_flag_bits::Transfer)), llri::result::ErrorInvalidUsage);
+            }
+        }
+
+        SUBCASE("[Correct usage] explicit stages")
+        {
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::transition(*current, llri::resource_state::General, llri::resource_state::TransferDst, llri::texture_subresource_range::all(), llri::pipeline_stage_flag_bits::Transfer | llri::pipeline_stage_flag_bits::Host, llri::pipeline_stage_flag_bits::Transfer)), llri::result::Success);
+        }
+    }
+
+    SUBCASE("split barriers")
+    {
+        current = &resources.emplace_back(nullptr);
+        REQUIRE_EQ(device->createResource(bufferDesc, current), llri::result::Success);
+
+        SUBCASE("[Incorrect usage] split ReadWrite barrier")
+        {
+            llri::resource_barrier barrier = llri::resource_barrier::read_write(*current);
+            barrier.split = llri::resource_barrier_split::BeginOnly;
+            CHECK_EQ(list->resourceBarrier(barrier), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] split > resource_barrier_split::MaxEnum")
+        {
+            llri::resource_barrier barrier = llri::resource_barrier::transition(*current, llri::resource_state::General, llri::resource_state::TransferDst);
+            barrier.split = static_cast<llri::resource_barrier_split>(UINT8_MAX);
+            CHECK_EQ(list->resourceBarrier(barrier), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] split barrier is ended without being begun")
+        {
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::end_transition(*current, llri::resource_state::General, llri::resource_state::TransferDst)), llri::result::ErrorInvalidState);
+        }
+
+        SUBCASE("[Incorrect usage] split barrier is begun twice or ended with a different transition")
+        {
+            REQUIRE_EQ(list->resourceBarrier(llri::resource_barrier::begin_transition(*current, llri::resource_state::General, llri::resource_state::TransferDst)), llri::result::Success);
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::begin_transition(*current, llri::resource_state::General, llri::resource_state::TransferDst)), llri::result::ErrorInvalidState);
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::end_transition(*current, llri::resource_state::General, llri::resource_state::TransferSrc)), llri::result::ErrorInvalidState);
+
+            // CommandList::end() requires every split barrier to have ended
+            CHECK_EQ(list->end(), llri::result::ErrorInvalidState);
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::end_transition(*current, llri::resource_state::General, llri::resource_state::TransferDst)), llri::result::Success);
+        }
+
+        SUBCASE("[Correct usage] split barrier is begun and ended")
+        {
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::begin_transition(*current, llri::resource_state::General, llri::resource_state::TransferDst)), llri::result::Success);
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::end_transition(*current, llri::resource_state::General, llri::resource_state::TransferDst)), llri::result::Success);
+        }
+
+        SUBCASE("[Correct usage] full and split barriers on the same resource in a single call")
+        {
+            // the full barriers must be recorded in order with the split barriers around them
+            const std::array<llri::resource_barrier, 2> begin {
+                llri::resource_barrier::transition(*current, llri::resource_state::General, llri::resource_state::TransferDst),
+                llri::resource_barrier::begin_transition(*current, llri::resource_state::TransferDst, llri::resource_state::TransferSrc)
+            };
+            CHECK_EQ(list->resourceBarrier(static_cast<uint32_t>(begin.size()), begin.data()), llri::result::Success);
+
+            const std::array<llri::resource_barrier, 2> end {
+                llri::resource_barrier::end_transition(*current, llri::resource_state::TransferDst, llri::resource_state::TransferSrc),
+                llri::resource_barrier::transition(*current, llri::resource_state::TransferSrc, llri::resource_state::General)
+            };
+            CHECK_EQ(list->resourceBarrier(static_cast<uint32_t>(end.size()), end.data()), llri::result::Success);
+        }
+    }
+
+    SUBCASE("queue ownership transfers")
+    {
+        SUBCASE("[Incorrect usage] ownership transfer of a Concurrent resource")
+        {
+            current = &resources.emplace_back(nullptr);
+            REQUIRE_EQ(device->createResource(bufferDesc, current), llri::result::Success);
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::release(*current, llri::resource_state::General, llri::resource_state::TransferDst, llri::queue_type::Graphics)), llri::result::ErrorInvalidUsage);
+        }
+
+        bufferDesc.sharingMode = llri::resource_sharing_mode::Exclusive;
+        current = &resources.emplace_back(nullptr);
+        REQUIRE_EQ(device->createResource(bufferDesc, current), llri::result::Success);
+
+        SUBCASE("[Incorrect usage] ownershipTransfer > queue_ownership_transfer::MaxEnum")
+        {
+            llri::resource_barrier barrier = llri::resource_barrier::release(*current, llri::resource_state::General, llri::resource_state::TransferDst, llri::queue_type::Graphics);
+            barrier.ownershipTransfer = static_cast<llri::queue_ownership_transfer>(UINT8_MAX);
+            CHECK_EQ(list->resourceBarrier(barrier), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Incorrect usage] split ownership transfer")
+        {
+            llri::resource_barrier barrier = llri::resource_barrier::release(*current, llri::resource_state::General, llri::resource_state::TransferDst, llri::queue_type::Graphics);
+            barrier.split = llri::resource_barrier_split::BeginOnly;
+            CHECK_EQ(list->resourceBarrier(barrier), llri::result::ErrorInvalidUsage);
+        }
+
+        SUBCASE("[Correct usage] release and acquire")
+        {
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::release(*current, llri::resource_state::General, llri::resource_state::TransferDst, llri::queue_type::Graphics)), llri::result::Success);
+            CHECK_EQ(list->resourceBarrier(llri::resource_barrier::acquire(*current, llri::resource_state::General, llri::resource_state::TransferDst, llri::queue_type::Graphics)), llri::result::Success);
+        }
+    }
+
     SUBCASE("resource_barrier_type::Transition")
     {
 		SUBCASE("[Incorrect usage] barrier.trans.oldState is the same as barrier.trans.newState")
@@ -663,7 +787,7 @@ inline void testCommandListResourceBarrier(llri::Device* device, llri::CommandGr
 	llri::Fence* fence;
 	REQUIRE_EQ(device->createFence({}, &fence), llri::result::Success);
 	
-	const llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, 0, nullptr, fence };
+	const llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, fence };
 	CHECK_EQ(queue->submit(submitDesc), llri::result::Success);
 	
 	queue->waitIdle();
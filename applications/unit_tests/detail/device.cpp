@@ -39,6 +39,21 @@ TEST_CASE("Device")
                 }
             }
 
+            SUBCASE("Device::queryPeerMemoryFeatures()")
+            {
+                SUBCASE("[Incorrect usage] node index >= Adapter::queryNodeCount()")
+                {
+                    CHECK_EQ(device->queryPeerMemoryFeatures(adapter->queryNodeCount(), 0), llri::peer_memory_feature_flag_bits::None);
+                    CHECK_EQ(device->queryPeerMemoryFeatures(0, adapter->queryNodeCount()), llri::peer_memory_feature_flag_bits::None);
+                }
+
+                SUBCASE("[Correct usage] a node has full access to its own memory")
+                {
+                    for (uint8_t node = 0; node < adapter->queryNodeCount(); node++)
+                        CHECK_EQ(device->queryPeerMemoryFeatures(node, node), llri::peer_memory_feature_flag_bits::All);
+                }
+            }
+
             SUBCASE("Device::createCommandGroup()")
             {
                 SUBCASE("[Incorrect usage] cmdGroup == nullptr")
@@ -185,6 +200,38 @@ TEST_CASE("Device")
                     CHECK_EQ(device->waitFences(1, &signaledFence, LLRI_TIMEOUT_MAX), llri::result::Success);
                 }
 
+                SUBCASE("[Correct usage] waitAny doesn't reset the fences")
+                {
+                    CHECK_EQ(device->waitFences(1, &signaledFence, LLRI_TIMEOUT_MAX, true), llri::result::Success);
+                    CHECK_EQ(signaledFence->getStatus(), llri::result::Success);
+                }
+
+                device->destroyFence(signaledFence);
+            }
+
+            SUBCASE("Device::resetFences()")
+            {
+                llri::Fence* signaledFence;
+                REQUIRE_EQ(device->createFence(llri::fence_flag_bits::Signaled, &signaledFence), llri::result::Success);
+
+                SUBCASE("[Incorrect usage] numFences == 0")
+                {
+                    CHECK_EQ(device->resetFences(0, &signaledFence), llri::result::ErrorInvalidUsage);
+                }
+
+                SUBCASE("[Incorrect usage] fences == nullptr")
+                {
+                    CHECK_EQ(device->resetFences(1, nullptr), llri::result::ErrorInvalidUsage);
+                }
+
+                SUBCASE("[Correct usage] valid")
+                {
+                    REQUIRE_EQ(signaledFence->getStatus(), llri::result::Success);
+                    CHECK_EQ(device->resetFences(1, &signaledFence), llri::result::Success);
+                    CHECK_EQ(signaledFence->getStatus(), llri::result::NotReady);
+                    CHECK_EQ(device->waitFences(1, &signaledFence, LLRI_TIMEOUT_MAX), llri::result::ErrorNotSignaled);
+                }
+
                 device->destroyFence(signaledFence);
             }
 
@@ -0,0 +1,192 @@
+/**
+ * @file frame_graph.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+#include <atomic>
+
+TEST_CASE("FrameGraph")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+        const auto type = detail::availableQueueType(adapter);
+
+        const llri::frame_graph_desc desc { 2, 2 };
+        const llri::resource_desc bufferDesc = llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferSrc | llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::TransferDst, 64);
+
+        SUBCASE("Device::createFrameGraph()")
+        {
+            llri::FrameGraph* frameGraph;
+
+            SUBCASE("[Incorrect usage] frameGraph == nullptr")
+            {
+                CHECK_EQ(device->createFrameGraph(desc, nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] numThreads == 0 or numFramesInFlight == 0")
+            {
+                CHECK_EQ(device->createFrameGraph({ 0, 2 }, &frameGraph), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(device->createFrameGraph({ 2, 0 }, &frameGraph), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] valid desc")
+            {
+                REQUIRE_EQ(device->createFrameGraph(desc, &frameGraph), llri::result::Success);
+                device->destroyFrameGraph(frameGraph);
+            }
+        }
+
+        SUBCASE("FrameGraph usage")
+        {
+            llri::FrameGraph* frameGraph;
+            REQUIRE_EQ(device->createFrameGraph(desc, &frameGraph), llri::result::Success);
+
+            llri::Resource* buffer;
+            REQUIRE_EQ(device->createResource(bufferDesc, &buffer), llri::result::Success);
+
+            SUBCASE("[Incorrect usage] beginFrame() wasn't called")
+            {
+                llri::frame_graph_resource handle;
+                CHECK_EQ(frameGraph->importResource(buffer, llri::resource_state::TransferDst, &handle), llri::result::ErrorInvalidState);
+                CHECK_EQ(frameGraph->execute(), llri::result::ErrorInvalidState);
+            }
+
+            SUBCASE("[Incorrect usage] invalid passes")
+            {
+                REQUIRE_EQ(frameGraph->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                llri::frame_graph_resource handle;
+                REQUIRE_EQ(frameGraph->importResource(buffer, llri::resource_state::TransferDst, &handle), llri::result::Success);
+
+                const auto record = [](llri::CommandList*) {};
+
+                const llri::frame_graph_resource_access invalidHandle { handle + 1, llri::resource_state::TransferSrc };
+                CHECK_EQ(frameGraph->addPass({ type, 1, &invalidHandle, record }), llri::result::ErrorInvalidUsage);
+
+                const llri::frame_graph_resource_access unsupportedState { handle, llri::resource_state::ColorAttachment };
+                CHECK_EQ(frameGraph->addPass({ type, 1, &unsupportedState, record }), llri::result::ErrorInvalidState);
+
+                const llri::frame_graph_resource_access duplicates[] = { { handle, llri::resource_state::TransferSrc }, { handle, llri::resource_state::TransferDst } };
+                CHECK_EQ(frameGraph->addPass({ type, 2, duplicates, record }), llri::result::ErrorInvalidUsage);
+
+                CHECK_EQ(frameGraph->addPass({ type, 0, nullptr, nullptr }), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] execute() was already called this frame")
+            {
+                REQUIRE_EQ(frameGraph->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+                CHECK_EQ(frameGraph->execute(), llri::result::Success);
+                CHECK_EQ(frameGraph->execute(), llri::result::ErrorInvalidState);
+            }
+
+            SUBCASE("[Correct usage] passes are recorded and resources are transitioned")
+            {
+                std::atomic<uint32_t> numRecorded = 0;
+                const auto record = [&numRecorded](llri::CommandList*) { numRecorded++; };
+
+                for (uint32_t frame = 0; frame < 3; frame++)
+                {
+                    REQUIRE_EQ(frameGraph->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                    llri::frame_graph_resource imported;
+                    const llri::resource_state importedState = frame == 0 ? llri::resource_state::TransferDst : llri::resource_state::TransferSrc;
+                    REQUIRE_EQ(frameGraph->importResource(buffer, importedState, &imported), llri::result::Success);
+
+                    llri::frame_graph_resource first, second;
+                    REQUIRE_EQ(frameGraph->createTransientResource(bufferDesc, &first), llri::result::Success);
+                    REQUIRE_EQ(frameGraph->createTransientResource(bufferDesc, &second), llri::result::Success);
+                    CHECK_EQ(frameGraph->getResource(first), nullptr);
+
+                    const llri::frame_graph_resource_access writeFirst[] = { { first, llri::resource_state::TransferDst }, { imported, llri::resource_state::TransferDst } };
+                    const llri::frame_graph_resource_access readFirst[] = { { first, llri::resource_state::TransferSrc } };
+                    const llri::frame_graph_resource_access writeSecond[] = { { second, llri::resource_state::TransferDst }, { imported, llri::resource_state::TransferSrc } };
+
+                    REQUIRE_EQ(frameGraph->addPass({ type, 2, writeFirst, record }), llri::result::Success);
+                    REQUIRE_EQ(frameGraph->addPass({ type, 1, readFirst, record }), llri::result::Success);
+                    REQUIRE_EQ(frameGraph->addPass({ type, 2, writeSecond, record }), llri::result::Success);
+                    REQUIRE_EQ(frameGraph->execute(), llri::result::Success);
+
+                    CHECK_EQ(frameGraph->getResource(imported), buffer);
+                    CHECK_EQ(frameGraph->getResourceState(imported), llri::resource_state::TransferSrc);
+
+                    // the lifetimes of the transient resources don't overlap, so the second reuses the first
+                    CHECK_NE(frameGraph->getResource(first), nullptr);
+                    CHECK_EQ(frameGraph->getResource(first), frameGraph->getResource(second));
+                }
+
+                CHECK_EQ(numRecorded, 9u);
+                CHECK_EQ(device->getQueue(type, 0)->waitIdle(), llri::result::Success);
+            }
+
+            SUBCASE("[Correct usage] resources are transitioned between passes on different queues")
+            {
+                REQUIRE_EQ(frameGraph->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                llri::frame_graph_resource imported;
+                REQUIRE_EQ(frameGraph->importResource(buffer, llri::resource_state::TransferDst, &imported), llri::result::Success);
+
+                // queues that the Device doesn't have fall back to a more capable queue
+                const auto record = [](llri::CommandList*) {};
+                const llri::frame_graph_resource_access write[] = { { imported, llri::resource_state::TransferDst } };
+                const llri::frame_graph_resource_access read[] = { { imported, llri::resource_state::TransferSrc } };
+                REQUIRE_EQ(frameGraph->addPass({ llri::queue_type::Graphics, 1, write, record }), llri::result::Success);
+                REQUIRE_EQ(frameGraph->addPass({ llri::queue_type::Transfer, 1, read, record }), llri::result::Success);
+                REQUIRE_EQ(frameGraph->addPass({ llri::queue_type::Graphics, 1, write, record }), llri::result::Success);
+                REQUIRE_EQ(frameGraph->execute(), llri::result::Success);
+
+                CHECK_EQ(frameGraph->getResourceState(imported), llri::resource_state::TransferDst);
+                for (uint8_t queueType = 0; queueType <= static_cast<uint8_t>(llri::queue_type::MaxEnum); queueType++)
+                {
+                    if (device->queryQueueCount(static_cast<llri::queue_type>(queueType)) > 0)
+                        CHECK_EQ(device->getQueue(static_cast<llri::queue_type>(queueType), 0)->waitIdle(), llri::result::Success);
+                }
+            }
+
+            SUBCASE("[Correct usage] graphics states are transitioned on the graphics queue after a compute pass")
+            {
+                if (device->queryQueueCount(llri::queue_type::Graphics) > 0)
+                {
+                    REQUIRE_EQ(frameGraph->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                    llri::frame_graph_resource imported;
+                    REQUIRE_EQ(frameGraph->importResource(buffer, llri::resource_state::TransferDst, &imported), llri::result::Success);
+
+                    // compute queues can't transition to VertexBuffer, so the transition must be recorded by the graphics pass
+                    const auto record = [](llri::CommandList*) {};
+                    const llri::frame_graph_resource_access write[] = { { imported, llri::resource_state::TransferDst } };
+                    const llri::frame_graph_resource_access read[] = { { imported, llri::resource_state::VertexBuffer } };
+                    REQUIRE_EQ(frameGraph->addPass({ llri::queue_type::Compute, 1, write, record }), llri::result::Success);
+                    REQUIRE_EQ(frameGraph->addPass({ llri::queue_type::Graphics, 1, read, record }), llri::result::Success);
+                    REQUIRE_EQ(frameGraph->execute(), llri::result::Success);
+
+                    CHECK_EQ(frameGraph->getResourceState(imported), llri::resource_state::VertexBuffer);
+                    for (uint8_t queueType = 0; queueType <= static_cast<uint8_t>(llri::queue_type::MaxEnum); queueType++)
+                    {
+                        if (device->queryQueueCount(static_cast<llri::queue_type>(queueType)) > 0)
+                            CHECK_EQ(device->getQueue(static_cast<llri::queue_type>(queueType), 0)->waitIdle(), llri::result::Success);
+                    }
+                }
+            }
+
+            device->destroyResource(buffer);
+            device->destroyFrameGraph(frameGraph);
+        }
+
+        SUBCASE("Device::destroyFrameGraph()")
+        {
+            // nullptr is allowed
+            CHECK_NOTHROW(device->destroyFrameGraph(nullptr));
+        }
+
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file frame_scheduler.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+TEST_CASE("FrameScheduler")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+        const auto type = detail::availableQueueType(adapter);
+
+        const llri::frame_scheduler_desc desc { type, 1, 2 };
+
+        SUBCASE("Device::createFrameScheduler()")
+        {
+            llri::FrameScheduler* scheduler;
+
+            SUBCASE("[Incorrect usage] scheduler == nullptr")
+            {
+                CHECK_EQ(device->createFrameScheduler(desc, nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] type > queue_type::MaxEnum")
+            {
+                CHECK_EQ(device->createFrameScheduler({ static_cast<llri::queue_type>(UINT8_MAX), 1, 2 }, &scheduler), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] numThreads == 0 or numFramesInFlight == 0")
+            {
+                CHECK_EQ(device->createFrameScheduler({ type, 0, 2 }, &scheduler), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(device->createFrameScheduler({ type, 1, 0 }, &scheduler), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] valid desc")
+            {
+                REQUIRE_EQ(device->createFrameScheduler(desc, &scheduler), llri::result::Success);
+                CHECK_NE(scheduler->getCommandContextPool(), nullptr);
+                CHECK_EQ(scheduler->getFrameFence(), nullptr);
+                device->destroyFrameScheduler(scheduler);
+            }
+        }
+
+        SUBCASE("FrameScheduler usage")
+        {
+            llri::FrameScheduler* scheduler;
+            REQUIRE_EQ(device->createFrameScheduler(desc, &scheduler), llri::result::Success);
+
+            SUBCASE("[Incorrect usage] beginFrame() wasn't called")
+            {
+                CHECK_EQ(scheduler->endFrame(), llri::result::ErrorInvalidState);
+                CHECK_EQ(scheduler->defer([]() {}), llri::result::ErrorInvalidState);
+            }
+
+            SUBCASE("[Incorrect usage] beginFrame() twice without endFrame()")
+            {
+                REQUIRE_EQ(scheduler->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+                CHECK_EQ(scheduler->beginFrame(LLRI_TIMEOUT_MAX), llri::result::ErrorInvalidState);
+            }
+
+            SUBCASE("[Incorrect usage] empty callback")
+            {
+                REQUIRE_EQ(scheduler->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+                CHECK_EQ(scheduler->defer({}), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] deferred callbacks are called once their frame comes around again")
+            {
+                auto* queue = device->getQueue(type, 0);
+                const llri::command_list_alloc_desc listDesc { 0, llri::command_list_usage::Direct };
+
+                uint32_t numCalls = 0;
+                for (uint64_t frame = 0; frame < 4; frame++)
+                {
+                    REQUIRE_EQ(scheduler->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+                    CHECK_EQ(scheduler->getFrameNumber(), frame);
+                    CHECK_EQ(scheduler->getFrameIndex(), frame % 3);
+
+                    // with 2 frames in flight, the callback of frame 0 is called when frame 3 reuses its frame index
+                    CHECK_EQ(numCalls, frame == 3 ? 1u : 0u);
+
+                    if (frame == 0)
+                        REQUIRE_EQ(scheduler->defer([&numCalls]() { numCalls++; }), llri::result::Success);
+
+                    llri::CommandList* list;
+                    REQUIRE_EQ(scheduler->getCommandContextPool()->acquireCommandList(0, listDesc, &list), llri::result::Success);
+                    REQUIRE_EQ(list->record({}, [](){}), llri::result::Success);
+
+                    llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, scheduler->getFrameFence() };
+                    REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+
+                    REQUIRE_EQ(scheduler->endFrame(), llri::result::Success);
+
+                    const auto& timings = scheduler->getTimings();
+                    CHECK_EQ(timings.frameNumber, frame);
+                    CHECK_GE(timings.waitMilliseconds, 0.0);
+                    CHECK_GE(timings.cpuMilliseconds, 0.0);
+                }
+
+                queue->waitIdle();
+            }
+
+            SUBCASE("[Correct usage] pending callbacks are called on destruction")
+            {
+                uint32_t numCalls = 0;
+                REQUIRE_EQ(scheduler->beginFrame(LLRI_TIMEOUT_MAX), llri::result::Success);
+                REQUIRE_EQ(scheduler->defer([&numCalls]() { numCalls++; }), llri::result::Success);
+
+                device->destroyFrameScheduler(scheduler);
+                scheduler = nullptr;
+                CHECK_EQ(numCalls, 1u);
+            }
+
+            device->destroyFrameScheduler(scheduler);
+        }
+
+        SUBCASE("Device::destroyFrameScheduler()")
+        {
+            // nullptr is allowed
+            CHECK_NOTHROW(device->destroyFrameScheduler(nullptr));
+        }
+
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
@@ -0,0 +1,206 @@
+/**
+ * @file gpu_profiler.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+TEST_CASE("GpuProfiler")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+        const auto type = detail::availableQueueType(adapter);
+
+        const llri::gpu_profiler_desc desc { type, 2, 2, llri::pipeline_statistic_flag_bits::None };
+        const bool timestamps = device->getQueue(type, 0)->queryTimestampPeriod() > 0.0;
+
+        SUBCASE("Device::createGpuProfiler()")
+        {
+            llri::GpuProfiler* profiler;
+
+            SUBCASE("[Incorrect usage] profiler == nullptr")
+            {
+                CHECK_EQ(device->createGpuProfiler(desc, nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] queue > queue_type::MaxEnum")
+            {
+                CHECK_EQ(device->createGpuProfiler({ static_cast<llri::queue_type>(UINT8_MAX), 2, 2, llri::pipeline_statistic_flag_bits::None }, &profiler), llri::result::ErrorInvalidUsage);
+            }
+
+            if (!timestamps)
+            {
+                SUBCASE("[Incorrect usage] the Queue doesn't support timestamps")
+                {
+                    CHECK_EQ(device->createGpuProfiler(desc, &profiler), llri::result::ErrorFeatureNotSupported);
+                }
+            }
+            else
+            {
+                SUBCASE("[Incorrect usage] maxScopes == 0 or numFramesInFlight == 0")
+                {
+                    CHECK_EQ(device->createGpuProfiler({ type, 0, 2, llri::pipeline_statistic_flag_bits::None }, &profiler), llri::result::ErrorInvalidUsage);
+                    CHECK_EQ(device->createGpuProfiler({ type, 2, 0, llri::pipeline_statistic_flag_bits::None }, &profiler), llri::result::ErrorInvalidUsage);
+                }
+
+                SUBCASE("[Incorrect usage] pipelineStatistics without the pipelineStatisticsQuery feature")
+                {
+                    CHECK_EQ(device->createGpuProfiler({ llri::queue_type::Graphics, 2, 2, llri::pipeline_statistic_flag_bits::All }, &profiler), llri::result::ErrorFeatureNotSupported);
+                }
+
+                SUBCASE("[Correct usage] valid desc")
+                {
+                    REQUIRE_EQ(device->createGpuProfiler(desc, &profiler), llri::result::Success);
+                    CHECK(profiler->getResults().empty());
+                    device->destroyGpuProfiler(profiler);
+                }
+            }
+        }
+
+        if (timestamps)
+        {
+            SUBCASE("GpuProfiler usage")
+            {
+                llri::GpuProfiler* profiler;
+                REQUIRE_EQ(device->createGpuProfiler(desc, &profiler), llri::result::Success);
+
+                auto* group = detail::defaultCommandGroup(device, type);
+                auto* list = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+                auto* fence = detail::defaultFence(device, false);
+
+                SUBCASE("[Incorrect usage] beginFrame() wasn't called")
+                {
+                    REQUIRE_EQ(list->begin({}), llri::result::Success);
+
+                    uint32_t scope;
+                    CHECK_EQ(profiler->beginScope(list, "scope", &scope), llri::result::ErrorInvalidState);
+                    CHECK_EQ(list->end(), llri::result::Success);
+                }
+
+                SUBCASE("[Incorrect usage] more than maxScopes scopes")
+                {
+                    REQUIRE_EQ(list->begin({}), llri::result::Success);
+                    REQUIRE_EQ(profiler->beginFrame(list), llri::result::Success);
+
+                    uint32_t scopes[3];
+                    CHECK_EQ(profiler->beginScope(list, "first", &scopes[0]), llri::result::Success);
+                    CHECK_EQ(profiler->beginScope(list, "second", &scopes[1]), llri::result::Success);
+                    CHECK_EQ(profiler->beginScope(list, "third", &scopes[2]), llri::result::ErrorExceededLimit);
+                    CHECK_EQ(profiler->endScope(list, 2), llri::result::ErrorInvalidUsage);
+
+                    CHECK_EQ(profiler->endScope(list, scopes[1]), llri::result::Success);
+                    CHECK_EQ(profiler->endScope(list, scopes[0]), llri::result::Success);
+                    CHECK_EQ(list->end(), llri::result::Success);
+                }
+
+                SUBCASE("[Correct usage] results are read back numFramesInFlight frames later")
+                {
+                    auto* queue = device->getQueue(type, 0);
+
+                    for (uint32_t frame = 0; frame < 3; frame++)
+                    {
+                        REQUIRE_EQ(group->reset(), llri::result::Success);
+                        REQUIRE_EQ(list->begin({}), llri::result::Success);
+                        REQUIRE_EQ(profiler->beginFrame(list), llri::result::Success);
+
+                        // the first frame is read back when its frame index is used again
+                        CHECK_EQ(profiler->getResults().size(), frame == 2 ? 1u : 0u);
+                        if (frame == 2)
+                        {
+                            CHECK_EQ(profiler->getResults()[0].name, "frame");
+                            CHECK_GE(profiler->getResults()[0].milliseconds, 0.0);
+                        }
+
+                        {
+                            llri::GpuProfileScope scope(profiler, list, "frame");
+                        }
+                        REQUIRE_EQ(list->end(), llri::result::Success);
+
+                        llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, fence };
+                        REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+                        REQUIRE_EQ(device->waitFence(fence, LLRI_TIMEOUT_MAX), llri::result::Success);
+                    }
+                }
+
+                device->destroyFence(fence);
+                device->destroyCommandGroup(group);
+                device->destroyGpuProfiler(profiler);
+            }
+        }
+
+        if (adapter->queryFeatures().pipelineStatisticsQuery && adapter->queryQueueCount(llri::queue_type::Graphics) > 0)
+        {
+            SUBCASE("GpuProfiler pipeline statistics")
+            {
+                llri::adapter_features features {};
+                features.pipelineStatisticsQuery = true;
+                auto* statisticsDevice = detail::defaultDevice(instance, adapter, false, features);
+                auto* queue = statisticsDevice->getQueue(llri::queue_type::Graphics, 0);
+
+                if (queue->queryTimestampPeriod() > 0.0)
+                {
+                    llri::GpuProfiler* profiler;
+
+                    SUBCASE("[Incorrect usage] pipelineStatistics on a non-Graphics queue")
+                    {
+                        if (statisticsDevice->queryQueueCount(llri::queue_type::Compute) > 0)
+                            CHECK_EQ(statisticsDevice->createGpuProfiler({ llri::queue_type::Compute, 2, 2, llri::pipeline_statistic_flag_bits::All }, &profiler), llri::result::ErrorInvalidUsage);
+                    }
+
+                    SUBCASE("[Correct usage] statistics are attached to the scope results")
+                    {
+                        REQUIRE_EQ(statisticsDevice->createGpuProfiler({ llri::queue_type::Graphics, 2, 2, llri::pipeline_statistic_flag_bits::All }, &profiler), llri::result::Success);
+
+                        auto* group = detail::defaultCommandGroup(statisticsDevice, llri::queue_type::Graphics);
+                        auto* list = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+                        auto* fence = detail::defaultFence(statisticsDevice, false);
+
+                        for (uint32_t frame = 0; frame < 3; frame++)
+                        {
+                            REQUIRE_EQ(group->reset(), llri::result::Success);
+                            REQUIRE_EQ(list->begin({}), llri::result::Success);
+                            REQUIRE_EQ(profiler->beginFrame(list), llri::result::Success);
+
+                            if (frame == 2)
+                            {
+                                REQUIRE_EQ(profiler->getResults().size(), 1u);
+                                // no work was recorded inside of the scope
+                                CHECK_EQ(profiler->getResults()[0].statistics.vertexShaderInvocations, 0u);
+                            }
+
+                            {
+                                llri::GpuProfileScope scope(profiler, list, "frame");
+                            }
+                            REQUIRE_EQ(list->end(), llri::result::Success);
+
+                            llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, fence };
+                            REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+                            REQUIRE_EQ(statisticsDevice->waitFence(fence, LLRI_TIMEOUT_MAX), llri::result::Success);
+                        }
+
+                        statisticsDevice->destroyFence(fence);
+                        statisticsDevice->destroyCommandGroup(group);
+                        statisticsDevice->destroyGpuProfiler(profiler);
+                    }
+                }
+
+                instance->destroyDevice(statisticsDevice);
+            }
+        }
+
+        SUBCASE("Device::destroyGpuProfiler()")
+        {
+            // nullptr is allowed
+            CHECK_NOTHROW(device->destroyGpuProfiler(nullptr));
+        }
+
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
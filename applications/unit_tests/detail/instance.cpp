@@ -159,9 +159,9 @@ TEST_SUITE("Instance")
         
         detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
             llri::Device* device = nullptr;
-            llri::device_desc ddesc{ adapter, llri::adapter_features{}, 0, nullptr, 0, nullptr };
+            llri::device_desc ddesc{ adapter, llri::adapter_features{}, 0, nullptr, 0, nullptr, false };
 
-            llri::queue_desc queue { llri::queue_type::Graphics, llri::queue_priority::Normal };
+            llri::queue_desc queue { llri::queue_type::Graphics, llri::queue_priority::Normal, llri::queue_submit_mode::Immediate };
 
             SUBCASE("[Incorrect usage] numExtensions > 0 && extensions == nullptr")
             {
@@ -221,7 +221,7 @@ TEST_SUITE("Instance")
 
             SUBCASE("[Correct usage] high priority queue")
             {
-                llri::queue_desc queueDesc { llri::queue_type::Graphics, llri::queue_priority::High };
+                llri::queue_desc queueDesc { llri::queue_type::Graphics, llri::queue_priority::High, llri::queue_submit_mode::Immediate };
 
                 ddesc.numQueues = 1;
                 ddesc.queues = &queueDesc;
@@ -231,7 +231,7 @@ TEST_SUITE("Instance")
 
             SUBCASE("[Incorrect usage] invalid queue_type")
             {
-                llri::queue_desc queueDesc { static_cast<llri::queue_type>(std::numeric_limits<uint8_t>::max()), llri::queue_priority::Normal };
+                llri::queue_desc queueDesc { static_cast<llri::queue_type>(std::numeric_limits<uint8_t>::max()), llri::queue_priority::Normal, llri::queue_submit_mode::Immediate };
                 ddesc.numQueues = 1;
                 ddesc.queues = &queueDesc;
                 CHECK_EQ(instance->createDevice(ddesc, &device), llri::result::ErrorInvalidUsage);
@@ -239,7 +239,15 @@ TEST_SUITE("Instance")
 
             SUBCASE("[Incorrect usage] invalid queue_priority")
             {
-                llri::queue_desc queueDesc { llri::queue_type::Graphics, static_cast<llri::queue_priority>(std::numeric_limits<uint8_t>::max()) };
+                llri::queue_desc queueDesc { llri::queue_type::Graphics, static_cast<llri::queue_priority>(std::numeric_limits<uint8_t>::max()), llri::queue_submit_mode::Immediate };
+                ddesc.numQueues = 1;
+                ddesc.queues = &queueDesc;
+                CHECK_EQ(instance->createDevice(ddesc, &device), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] invalid queue_submit_mode")
+            {
+                llri::queue_desc queueDesc { llri::queue_type::Graphics, llri::queue_priority::Normal, static_cast<llri::queue_submit_mode>(std::numeric_limits<uint8_t>::max()) };
                 ddesc.numQueues = 1;
                 ddesc.queues = &queueDesc;
                 CHECK_EQ(instance->createDevice(ddesc, &device), llri::result::ErrorInvalidUsage);
@@ -253,7 +261,7 @@ TEST_SUITE("Instance")
                     uint8_t count = adapter->queryQueueCount(static_cast<llri::queue_type>(type));
 
                     // Create more queues than supported
-                    std::vector<llri::queue_desc> queues(count + 1, llri::queue_desc{ static_cast<llri::queue_type>(type), llri::queue_priority::Normal });
+                    std::vector<llri::queue_desc> queues(count + 1, llri::queue_desc{ static_cast<llri::queue_type>(type), llri::queue_priority::Normal, llri::queue_submit_mode::Immediate });
                     ddesc.numQueues = static_cast<uint32_t>(queues.size());
                     ddesc.queues = queues.data();
 
@@ -262,6 +270,18 @@ TEST_SUITE("Instance")
                 }
             }
 
+            if (!adapter->queryFeatures().pipelineStatisticsQuery)
+            {
+                SUBCASE("[Incorrect usage] enabled feature isn't supported")
+                {
+                    llri::queue_desc queueDesc { llri::queue_type::Graphics, llri::queue_priority::Normal, llri::queue_submit_mode::Immediate };
+                    ddesc.numQueues = 1;
+                    ddesc.queues = &queueDesc;
+                    ddesc.features.pipelineStatisticsQuery = true;
+                    CHECK_EQ(instance->createDevice(ddesc, &device), llri::result::ErrorFeatureNotSupported);
+                }
+            }
+
             SUBCASE("[Correct usage] maximum number of queues")
             {
                 std::vector<llri::queue_desc> queues;
@@ -275,7 +295,7 @@ TEST_SUITE("Instance")
                 for (uint8_t type = 0; type <= static_cast<uint8_t>(llri::queue_type::MaxEnum); type++)
                 {
                     for (uint8_t i = 0; i < maxQueueCounts[static_cast<llri::queue_type>(type)]; i++)
-                        queues.push_back(llri::queue_desc { static_cast<llri::queue_type>(type), llri::queue_priority::High });
+                        queues.push_back(llri::queue_desc { static_cast<llri::queue_type>(type), llri::queue_priority::High, llri::queue_submit_mode::Immediate });
                 }
 
                 ddesc.numQueues = static_cast<uint32_t>(queues.size());
@@ -301,8 +321,8 @@ TEST_SUITE("Instance")
             SUBCASE("[Correct usage] device != nullptr")
             {
                 llri::Device* device = nullptr;
-                llri::queue_desc queue { llri::queue_type::Graphics, llri::queue_priority::Normal }; // at least one graphics queue is practically always available
-                llri::device_desc ddesc{ adapter, llri::adapter_features{}, 0, nullptr, 1, &queue};
+                llri::queue_desc queue { llri::queue_type::Graphics, llri::queue_priority::Normal, llri::queue_submit_mode::Immediate }; // at least one graphics queue is practically always available
+                llri::device_desc ddesc{ adapter, llri::adapter_features{}, 0, nullptr, 1, &queue, false };
 
                 REQUIRE_EQ(instance->createDevice(ddesc, &device), llri::result::Success);
                 CHECK_NOTHROW(instance->destroyDevice(device));
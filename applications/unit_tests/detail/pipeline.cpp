@@ -0,0 +1,127 @@
+/**
+ * @file pipeline.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+TEST_CASE("Pipeline")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+
+        // the contents of the bytecode aren't inspected by the validation layer
+        const std::array<uint32_t, 4> bytecode { 0x07230203, 0, 0, 0 };
+
+        llri::pipeline_color_attachment_desc colorAttachment {};
+        colorAttachment.format = llri::format::RGBA8UNorm;
+        colorAttachment.blendEnable = false;
+        colorAttachment.writeMask = llri::color_component_flag_bits::All;
+
+        llri::graphics_pipeline_desc desc {};
+        desc.cache = nullptr;
+        desc.pushConstantStages = llri::shader_stage_flag_bits::None;
+        desc.vertexShader = llri::shader_bytecode { sizeof(bytecode), bytecode.data(), "main" };
+        desc.fragmentShader = llri::shader_bytecode { 0, nullptr, nullptr };
+        desc.topology = llri::primitive_topology::TriangleList;
+        desc.numVertexBindings = 0;
+        desc.vertexBindings = nullptr;
+        desc.numVertexAttributes = 0;
+        desc.vertexAttributes = nullptr;
+        desc.rasterizer = llri::rasterizer_desc { llri::cull_mode::None, llri::front_face::CounterClockwise, 0, 0.0f };
+        desc.numColorAttachments = 1;
+        desc.colorAttachments = &colorAttachment;
+        desc.depthStencilFormat = llri::format::Undefined;
+        desc.sampleCount = llri::sample_count::Count1;
+
+        SUBCASE("Device::createGraphicsPipeline()")
+        {
+            llri::Pipeline* pipeline;
+
+            SUBCASE("[Incorrect usage] pipeline == nullptr")
+            {
+                CHECK_EQ(device->createGraphicsPipeline(desc, nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] pushConstantStages contains the compute stage")
+            {
+                llri::graphics_pipeline_desc invalid = desc;
+                invalid.pushConstantStages = llri::shader_stage_flag_bits::All;
+                CHECK_EQ(device->createGraphicsPipeline(invalid, &pipeline), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] vertexShader is empty")
+            {
+                llri::graphics_pipeline_desc invalid = desc;
+                invalid.vertexShader = llri::shader_bytecode { 0, nullptr, nullptr };
+                CHECK_EQ(device->createGraphicsPipeline(invalid, &pipeline), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] fragmentShader.size > 0 and fragmentShader.bytecode == nullptr")
+            {
+                llri::graphics_pipeline_desc invalid = desc;
+                invalid.fragmentShader = llri::shader_bytecode { 16, nullptr, nullptr };
+                CHECK_EQ(device->createGraphicsPipeline(invalid, &pipeline), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] numVertexBindings > adapter_limits::maxVertexInputBindings")
+            {
+                llri::graphics_pipeline_desc invalid = desc;
+                invalid.numVertexBindings = adapter->queryLimits().maxVertexInputBindings + 1;
+                CHECK_EQ(device->createGraphicsPipeline(invalid, &pipeline), llri::result::ErrorExceededLimit);
+            }
+
+            SUBCASE("[Incorrect usage] a vertex attribute references a binding that doesn't exist")
+            {
+                const llri::vertex_binding_desc binding { 0, 16, llri::vertex_input_rate::Vertex };
+                const llri::vertex_attribute_desc attribute { 0, 1, llri::format::RGBA32Float, 0 };
+
+                llri::graphics_pipeline_desc invalid = desc;
+                invalid.numVertexBindings = 1;
+                invalid.vertexBindings = &binding;
+                invalid.numVertexAttributes = 1;
+                invalid.vertexAttributes = &attribute;
+                CHECK_EQ(device->createGraphicsPipeline(invalid, &pipeline), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] no color or depth stencil attachments")
+            {
+                llri::graphics_pipeline_desc invalid = desc;
+                invalid.numColorAttachments = 0;
+                CHECK_EQ(device->createGraphicsPipeline(invalid, &pipeline), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] colorAttachments[0].format has no color component")
+            {
+                llri::pipeline_color_attachment_desc invalidAttachment = colorAttachment;
+                invalidAttachment.format = llri::format::D32Float;
+
+                llri::graphics_pipeline_desc invalid = desc;
+                invalid.colorAttachments = &invalidAttachment;
+                CHECK_EQ(device->createGraphicsPipeline(invalid, &pipeline), llri::result::ErrorInvalidFormat);
+            }
+
+            SUBCASE("[Incorrect usage] depthStencilFormat has no depth or stencil component")
+            {
+                llri::graphics_pipeline_desc invalid = desc;
+                invalid.depthStencilFormat = llri::format::RGBA8UNorm;
+                CHECK_EQ(device->createGraphicsPipeline(invalid, &pipeline), llri::result::ErrorInvalidFormat);
+            }
+        }
+
+        SUBCASE("Device::destroyPipeline()")
+        {
+            // nullptr is allowed
+            CHECK_NOTHROW(device->destroyPipeline(nullptr));
+        }
+
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file pipeline_cache.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+TEST_CASE("PipelineCache")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+
+        SUBCASE("Device::createPipelineCache()")
+        {
+            SUBCASE("[Incorrect usage] cache == nullptr")
+            {
+                CHECK_EQ(device->createPipelineCache({ 0, nullptr }, nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] dataSize > 0 and data == nullptr")
+            {
+                llri::PipelineCache* cache;
+                CHECK_EQ(device->createPipelineCache({ 16, nullptr }, &cache), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] empty cache")
+            {
+                llri::PipelineCache* cache;
+                REQUIRE_EQ(device->createPipelineCache({ 0, nullptr }, &cache), llri::result::Success);
+                CHECK_FALSE(cache->isInitialDataUsed());
+                device->destroyPipelineCache(cache);
+            }
+
+            SUBCASE("[Correct usage] data that wasn't created by LLRI is discarded")
+            {
+                const std::vector<uint8_t> garbage(256, 0xAB);
+
+                llri::PipelineCache* cache;
+                REQUIRE_EQ(device->createPipelineCache({ garbage.size(), garbage.data() }, &cache), llri::result::Success);
+                CHECK_FALSE(cache->isInitialDataUsed());
+                device->destroyPipelineCache(cache);
+            }
+        }
+
+        SUBCASE("PipelineCache::serialize()")
+        {
+            llri::PipelineCache* cache;
+            REQUIRE_EQ(device->createPipelineCache({ 0, nullptr }, &cache), llri::result::Success);
+
+            SUBCASE("[Incorrect usage] data == nullptr")
+            {
+                CHECK_EQ(cache->serialize(nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] round trip")
+            {
+                std::vector<uint8_t> data;
+                REQUIRE_EQ(cache->serialize(&data), llri::result::Success);
+                CHECK_GE(data.size(), sizeof(llri::detail::pipeline_cache_header));
+
+                llri::PipelineCache* loaded;
+                REQUIRE_EQ(device->createPipelineCache({ data.size(), data.data() }, &loaded), llri::result::Success);
+                device->destroyPipelineCache(loaded);
+
+                // a corrupted payload is discarded
+                data.back() ^= 0xFF;
+                REQUIRE_EQ(device->createPipelineCache({ data.size(), data.data() }, &loaded), llri::result::Success);
+                CHECK_FALSE(loaded->isInitialDataUsed());
+                device->destroyPipelineCache(loaded);
+            }
+
+            device->destroyPipelineCache(cache);
+        }
+
+        SUBCASE("Device::destroyPipelineCache()")
+        {
+            // nullptr is allowed
+            CHECK_NOTHROW(device->destroyPipelineCache(nullptr));
+        }
+
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
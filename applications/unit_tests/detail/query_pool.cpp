@@ -0,0 +1,118 @@
+/**
+ * @file query_pool.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+TEST_CASE("QueryPool")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+
+        SUBCASE("Device::createQueryPool()")
+        {
+            llri::QueryPool* queryPool;
+
+            SUBCASE("[Incorrect usage] queryPool == nullptr")
+            {
+                CHECK_EQ(device->createQueryPool({ llri::query_type::Timestamp, 4, 0, llri::pipeline_statistic_flag_bits::None }, nullptr), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] type > query_type::MaxEnum")
+            {
+                CHECK_EQ(device->createQueryPool({ static_cast<llri::query_type>(UINT8_MAX), 4, 0, llri::pipeline_statistic_flag_bits::None }, &queryPool), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] count == 0")
+            {
+                CHECK_EQ(device->createQueryPool({ llri::query_type::Timestamp, 0, 0, llri::pipeline_statistic_flag_bits::None }, &queryPool), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] nodeMask has multiple bits or exceeds the node count")
+            {
+                CHECK_EQ(device->createQueryPool({ llri::query_type::Timestamp, 4, 0b11, llri::pipeline_statistic_flag_bits::None }, &queryPool), llri::result::ErrorInvalidNodeMask);
+                CHECK_EQ(device->createQueryPool({ llri::query_type::Timestamp, 4, 1u << adapter->queryNodeCount(), llri::pipeline_statistic_flag_bits::None }, &queryPool), llri::result::ErrorInvalidNodeMask);
+            }
+
+            SUBCASE("[Incorrect usage] PipelineStatistics without the pipelineStatisticsQuery feature")
+            {
+                CHECK_EQ(device->createQueryPool({ llri::query_type::PipelineStatistics, 4, 0, llri::pipeline_statistic_flag_bits::All }, &queryPool), llri::result::ErrorFeatureNotSupported);
+            }
+
+            SUBCASE("[Correct usage] valid desc")
+            {
+                REQUIRE_EQ(device->createQueryPool({ llri::query_type::Timestamp, 4, 0, llri::pipeline_statistic_flag_bits::None }, &queryPool), llri::result::Success);
+                CHECK_NE(queryPool->getNative(), nullptr);
+                CHECK_EQ(queryPool->getDesc().count, 4u);
+                device->destroyQueryPool(queryPool);
+            }
+        }
+
+        SUBCASE("QueryPool::getResults()")
+        {
+            llri::QueryPool* queryPool;
+            REQUIRE_EQ(device->createQueryPool({ llri::query_type::Timestamp, 4, 0, llri::pipeline_statistic_flag_bits::None }, &queryPool), llri::result::Success);
+
+            std::array<uint64_t, 4> results {};
+            CHECK_EQ(queryPool->getResults(0, 0, results.data()), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(queryPool->getResults(2, 3, results.data()), llri::result::ErrorInvalidUsage);
+            CHECK_EQ(queryPool->getResults(0, 4, static_cast<uint64_t*>(nullptr)), llri::result::ErrorInvalidUsage);
+
+            // pipeline_statistics can only be read from PipelineStatistics QueryPools
+            std::array<llri::pipeline_statistics, 4> statistics {};
+            CHECK_EQ(queryPool->getResults(0, 4, statistics.data()), llri::result::ErrorInvalidUsage);
+
+            device->destroyQueryPool(queryPool);
+        }
+
+        if (adapter->queryFeatures().pipelineStatisticsQuery)
+        {
+            SUBCASE("PipelineStatistics QueryPool")
+            {
+                llri::adapter_features features {};
+                features.pipelineStatisticsQuery = true;
+                auto* statisticsDevice = detail::defaultDevice(instance, adapter, false, features);
+
+                llri::QueryPool* queryPool;
+
+                SUBCASE("[Incorrect usage] pipelineStatistics is None or invalid")
+                {
+                    CHECK_EQ(statisticsDevice->createQueryPool({ llri::query_type::PipelineStatistics, 4, 0, llri::pipeline_statistic_flag_bits::None }, &queryPool), llri::result::ErrorInvalidUsage);
+                    CHECK_EQ(statisticsDevice->createQueryPool({ llri::query_type::PipelineStatistics, 4, 0, static_cast<llri::pipeline_statistic_flag_bits>(UINT32_MAX) }, &queryPool), llri::result::ErrorInvalidUsage);
+                }
+
+                SUBCASE("[Correct usage] valid desc")
+                {
+                    const llri::pipeline_statistic_flags selected = llri::pipeline_statistic_flag_bits::VertexShaderInvocations | llri::pipeline_statistic_flag_bits::FragmentShaderInvocations;
+                    REQUIRE_EQ(statisticsDevice->createQueryPool({ llri::query_type::PipelineStatistics, 4, 0, selected }, &queryPool), llri::result::Success);
+                    CHECK_EQ(queryPool->getDesc().pipelineStatistics, selected);
+                    CHECK_GE(queryPool->getResultSize(), 2 * sizeof(uint64_t));
+
+                    // timestamps can only be read from Timestamp QueryPools
+                    std::array<uint64_t, 4> results {};
+                    CHECK_EQ(queryPool->getResults(0, 4, results.data()), llri::result::ErrorInvalidUsage);
+
+                    statisticsDevice->destroyQueryPool(queryPool);
+                }
+
+                instance->destroyDevice(statisticsDevice);
+            }
+        }
+
+        SUBCASE("Device::destroyQueryPool()")
+        {
+            // nullptr is allowed
+            CHECK_NOTHROW(device->destroyQueryPool(nullptr));
+        }
+
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
@@ -71,7 +71,7 @@ TEST_CASE("Queue")
                                 constexpr uint32_t multipleBits = 1 << 0 | 1 << 1; // more than 1 bit set
                                 constexpr uint32_t exceedsNodes = std::numeric_limits<uint32_t>::max();
 
-                                llri::submit_desc submitDesc{ 0, 1, &readyCmdList, 0, nullptr, 0, nullptr, nullptr };
+                                llri::submit_desc submitDesc{ 0, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
 
                                 submitDesc.nodeMask = multipleBits;
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidNodeMask);
@@ -84,7 +84,7 @@ TEST_CASE("Queue")
                             {
                                 SUBCASE("[Incorrect usage] node mask mismatch between desc.nodeMask and CommandList(s)")
                                 {
-                                    llri::submit_desc submitDesc{ 0, 1, &readyCmdList, 0, nullptr, 0, nullptr, nullptr };
+                                    llri::submit_desc submitDesc{ 0, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
 
                                     // node - 1, loop around if node == 0
                                     submitDesc.nodeMask = 1 << ((node + adapter->queryNodeCount() -1) % adapter->queryNodeCount());
@@ -94,7 +94,7 @@ TEST_CASE("Queue")
 
                             SUBCASE("[Incorrect usage] CommandList not ready")
                             {
-                                llri::submit_desc submitDesc{ nodeMask, 1, nullptr, 0, nullptr, 0, nullptr, nullptr };
+                                llri::submit_desc submitDesc{ nodeMask, 1, nullptr, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
 
                                 submitDesc.commandLists = &emptyCmdList;
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidState);
@@ -105,13 +105,13 @@ TEST_CASE("Queue")
 
                             SUBCASE("[Incorrect usage] desc.numCommandLists == 0")
                             {
-                                llri::submit_desc submitDesc{ nodeMask, 0, &readyCmdList, 0, nullptr, 0, nullptr, nullptr };
+                                llri::submit_desc submitDesc{ nodeMask, 0, &readyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
                             }
 
                             SUBCASE("[Incorrect usage] desc.commandLists == nullptr")
                             {
-                                llri::submit_desc submitDesc{ nodeMask, 1, nullptr, 0, nullptr, 0, nullptr, nullptr };
+                                llri::submit_desc submitDesc{ nodeMask, 1, nullptr, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
                             }
 
@@ -122,13 +122,13 @@ TEST_CASE("Queue")
                                     nullptr
                                 };
 
-                                llri::submit_desc submitDesc{ nodeMask, static_cast<uint32_t>(cmdLists.size()), cmdLists.data(), 0, nullptr, 0, nullptr, nullptr };
+                                llri::submit_desc submitDesc{ nodeMask, static_cast<uint32_t>(cmdLists.size()), cmdLists.data(), 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
                             }
 
                             SUBCASE("[Incorrect usage] desc.numWaitSemaphores > 0 and desc.waitSemaphores == nullptr")
                             {
-                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 1, nullptr, 0, nullptr, nullptr };
+                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 1, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
                             }
 
@@ -137,13 +137,54 @@ TEST_CASE("Queue")
                                 std::array<llri::Semaphore*, 1> semaphores {
                                     nullptr
                                 };
-                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, static_cast<uint32_t>(semaphores.size()), semaphores.data(), 0, nullptr, nullptr };
+                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, static_cast<uint32_t>(semaphores.size()), semaphores.data(), nullptr, nullptr, 0, nullptr, nullptr, nullptr };
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
                             }
 
+                            SUBCASE("waitSemaphoreStages")
+                            {
+                                llri::Semaphore* semaphore;
+                                REQUIRE_EQ(device->createSemaphore(&semaphore), llri::result::Success);
+
+                                SUBCASE("[Incorrect usage] invalid pipeline_stage_flags")
+                                {
+                                    const llri::pipeline_stage_flags stages = static_cast<llri::pipeline_stage_flag_bits>(1u << 31);
+                                    llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 1, &semaphore, nullptr, &stages, 0, nullptr, nullptr, nullptr };
+                                    CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
+                                }
+
+                                if (wrapper.type != llri::queue_type::Graphics)
+                                {
+                                    SUBCASE("[Incorrect usage] stages that the queue_type doesn't support")
+                                    {
+                                        const llri::pipeline_stage_flags stages = llri::pipeline_stage_flag_bits::FragmentShader;
+                                        llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 1, &semaphore, nullptr, &stages, 0, nullptr, nullptr, nullptr };
+                                        CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
+                                    }
+                                }
+
+                                SUBCASE("[Correct usage] only the Transfer stage waits")
+                                {
+                                    llri::submit_desc signalDesc{ nodeMask, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 1, &semaphore, nullptr, nullptr };
+                                    REQUIRE_EQ(queue->submit(signalDesc), llri::result::Success);
+
+                                    llri::command_list_begin_desc resubmitDesc {};
+                                    resubmitDesc.submitMode = llri::command_list_submit_mode::Resubmit;
+                                    REQUIRE_EQ(emptyCmdList->record(resubmitDesc, [](){}), llri::result::Success);
+
+                                    const llri::pipeline_stage_flags stages = llri::pipeline_stage_flag_bits::Transfer;
+                                    llri::submit_desc waitDesc{ nodeMask, 1, &emptyCmdList, 1, &semaphore, nullptr, &stages, 0, nullptr, nullptr, defaultFence };
+                                    REQUIRE_EQ(queue->submit(waitDesc), llri::result::Success);
+                                    CHECK_EQ(device->waitFence(defaultFence, LLRI_TIMEOUT_MAX), llri::result::Success);
+                                }
+
+                                CHECK_EQ(queue->waitIdle(), llri::result::Success);
+                                device->destroySemaphore(semaphore);
+                            }
+
                             SUBCASE("[Incorrect usage] desc.numSignalSemaphores > 0 and desc.signalSemaphores == nullptr")
                             {
-                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 0, nullptr, 1, nullptr, nullptr };
+                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 1, nullptr, nullptr, nullptr };
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
                             }
 
@@ -152,15 +193,106 @@ TEST_CASE("Queue")
                                 std::array<llri::Semaphore*, 1> semaphores{
                                     nullptr
                                 };
-                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 0, nullptr, static_cast<uint32_t>(semaphores.size()), semaphores.data(), nullptr };
+                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, static_cast<uint32_t>(semaphores.size()), semaphores.data(), nullptr, nullptr };
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
                             }
 
                             SUBCASE("[Incorrect usage] fence was already signaled")
                             {
-                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 0, nullptr, 0, nullptr, signaledFence };
+                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, signaledFence };
                                 CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorAlreadySignaled);
                             }
+
+                            SUBCASE("[Incorrect usage] CommandList with command_list_submit_mode::OneTime is submitted twice")
+                            {
+                                llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, defaultFence };
+                                REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+                                REQUIRE_EQ(device->waitFence(defaultFence, LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                                CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidState);
+                            }
+
+                            SUBCASE("command_list_submit_mode::Resubmit")
+                            {
+                                llri::command_list_begin_desc resubmitDesc {};
+                                resubmitDesc.submitMode = llri::command_list_submit_mode::Resubmit;
+                                REQUIRE_EQ(emptyCmdList->record(resubmitDesc, [](){}), llri::result::Success);
+
+                                llri::submit_desc submitDesc{ nodeMask, 1, &emptyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, defaultFence };
+                                REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+
+                                SUBCASE("[Incorrect usage] CommandList is still in flight")
+                                {
+                                    submitDesc.fence = nullptr;
+                                    CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidState);
+                                    CHECK_EQ(group->reset(), llri::result::ErrorInvalidState);
+                                    CHECK_EQ(device->waitFence(defaultFence, LLRI_TIMEOUT_MAX), llri::result::Success);
+                                }
+
+                                SUBCASE("[Correct usage] CommandList is submitted again after its Fence was waited upon")
+                                {
+                                    REQUIRE_EQ(device->waitFence(defaultFence, LLRI_TIMEOUT_MAX), llri::result::Success);
+                                    REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+                                    CHECK_EQ(device->waitFence(defaultFence, LLRI_TIMEOUT_MAX), llri::result::Success);
+                                }
+                            }
+
+                            SUBCASE("[Correct usage] CommandList with command_list_submit_mode::Simultaneous is submitted while in flight")
+                            {
+                                llri::command_list_begin_desc simultaneousDesc {};
+                                simultaneousDesc.submitMode = llri::command_list_submit_mode::Simultaneous;
+                                REQUIRE_EQ(emptyCmdList->record(simultaneousDesc, [](){}), llri::result::Success);
+
+                                llri::submit_desc submitDesc{ nodeMask, 1, &emptyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, defaultFence };
+                                REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+
+                                submitDesc.fence = nullptr;
+                                CHECK_EQ(queue->submit(submitDesc), llri::result::Success);
+                                CHECK_EQ(queue->waitIdle(), llri::result::Success);
+                            }
+                        }
+
+                        SUBCASE("Queue::submit() with multiple descs")
+                        {
+                            SUBCASE("[Incorrect usage] numDescs == 0")
+                            {
+                                const llri::submit_desc submitDesc{ nodeMask, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
+                                CHECK_EQ(queue->submit(0, &submitDesc), llri::result::ErrorInvalidUsage);
+                            }
+
+                            SUBCASE("[Incorrect usage] descs == nullptr")
+                            {
+                                CHECK_EQ(queue->submit(1, nullptr), llri::result::ErrorInvalidUsage);
+                            }
+
+                            SUBCASE("[Incorrect usage] a Fence is used by multiple descs")
+                            {
+                                const llri::submit_desc submitDescs[] = {
+                                    { nodeMask, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, defaultFence },
+                                    { nodeMask, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, defaultFence }
+                                };
+                                CHECK_EQ(queue->submit(2, submitDescs), llri::result::ErrorAlreadySignaled);
+                            }
+
+                            SUBCASE("[Correct usage] batches with semaphore dependencies")
+                            {
+                                llri::Semaphore* semaphore;
+                                REQUIRE_EQ(device->createSemaphore(&semaphore), llri::result::Success);
+
+                                llri::command_list_begin_desc resubmitDesc {};
+                                resubmitDesc.submitMode = llri::command_list_submit_mode::Resubmit;
+                                REQUIRE_EQ(emptyCmdList->record(resubmitDesc, [](){}), llri::result::Success);
+
+                                const llri::submit_desc submitDescs[] = {
+                                    { nodeMask, 1, &readyCmdList, 0, nullptr, nullptr, nullptr, 1, &semaphore, nullptr, nullptr },
+                                    { nodeMask, 1, &emptyCmdList, 1, &semaphore, nullptr, nullptr, 0, nullptr, nullptr, defaultFence }
+                                };
+                                REQUIRE_EQ(queue->submit(2, submitDescs), llri::result::Success);
+                                CHECK_EQ(device->waitFence(defaultFence, LLRI_TIMEOUT_MAX), llri::result::Success);
+                                CHECK_EQ(queue->waitIdle(), llri::result::Success);
+
+                                device->destroySemaphore(semaphore);
+                            }
                         }
 
                         SUBCASE("Queue::waitIdle()")
@@ -197,3 +329,133 @@ TEST_CASE("Queue")
     
     llri::destroyInstance(instance);
 }
+
+TEST_CASE("Background Queue")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter, false, {}, llri::queue_submit_mode::Background);
+
+        const auto type = detail::availableQueueType(adapter);
+        auto* queue = device->getQueue(type, 0);
+        REQUIRE_EQ(queue->getDesc().submitMode, llri::queue_submit_mode::Background);
+
+        auto* group = detail::defaultCommandGroup(device, type);
+        auto* list = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+        REQUIRE_EQ(list->record({}, [](){}), llri::result::Success);
+
+        llri::Fence* fence = detail::defaultFence(device, false);
+
+        SUBCASE("[Correct usage] flush() with no submissions")
+        {
+            CHECK_EQ(queue->flush(), llri::result::Success);
+        }
+
+        SUBCASE("[Correct usage] the Fence of a queued submission can be waited on")
+        {
+            const llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, fence };
+            REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+
+            const auto status = fence->getStatus();
+            CHECK_UNARY((status == llri::result::Success || status == llri::result::NotReady));
+            CHECK_EQ(device->waitFence(fence, LLRI_TIMEOUT_MAX), llri::result::Success);
+            CHECK_EQ(queue->flush(), llri::result::Success);
+        }
+
+        SUBCASE("[Correct usage] adjacent submissions that signal and wait on a binary Semaphore")
+        {
+            llri::Semaphore* semaphore;
+            REQUIRE_EQ(device->createSemaphore(&semaphore), llri::result::Success);
+
+            llri::command_list_begin_desc resubmitDesc {};
+            resubmitDesc.submitMode = llri::command_list_submit_mode::Resubmit;
+            auto* second = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+            REQUIRE_EQ(second->record(resubmitDesc, [](){}), llri::result::Success);
+
+            const llri::submit_desc signalDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 1, &semaphore, nullptr, nullptr };
+            const llri::submit_desc waitDesc { 0, 1, &second, 1, &semaphore, nullptr, nullptr, 0, nullptr, nullptr, fence };
+            REQUIRE_EQ(queue->submit(signalDesc), llri::result::Success);
+            REQUIRE_EQ(queue->submit(waitDesc), llri::result::Success);
+
+            CHECK_EQ(device->waitFence(fence, LLRI_TIMEOUT_MAX), llri::result::Success);
+            CHECK_EQ(queue->waitIdle(), llri::result::Success);
+
+            device->destroySemaphore(semaphore);
+        }
+
+        SUBCASE("[Correct usage] a binary Semaphore is signaled again after it was waited on")
+        {
+            llri::Semaphore* semaphore;
+            REQUIRE_EQ(device->createSemaphore(&semaphore), llri::result::Success);
+
+            llri::command_list_begin_desc resubmitDesc {};
+            resubmitDesc.submitMode = llri::command_list_submit_mode::Resubmit;
+            auto* resubmittable = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+            REQUIRE_EQ(resubmittable->record(resubmitDesc, [](){}), llri::result::Success);
+
+            const llri::submit_desc signalDesc { 0, 1, &resubmittable, 0, nullptr, nullptr, nullptr, 1, &semaphore, nullptr, nullptr };
+            const llri::submit_desc waitDesc { 0, 1, &resubmittable, 1, &semaphore, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
+            for (size_t i = 0; i < 2; i++)
+            {
+                REQUIRE_EQ(queue->submit(signalDesc), llri::result::Success);
+                REQUIRE_EQ(queue->submit(waitDesc), llri::result::Success);
+            }
+
+            CHECK_EQ(queue->waitIdle(), llri::result::Success);
+            CHECK_EQ(queue->flush(), llri::result::Success);
+
+            device->destroySemaphore(semaphore);
+        }
+
+        SUBCASE("[Correct usage] Resources are created while submissions are queued")
+        {
+            llri::resource_desc textureDesc {};
+            textureDesc.createNodeMask = 0;
+            textureDesc.visibleNodeMask = 0;
+            textureDesc.type = llri::resource_type::Texture2D;
+            textureDesc.usage = llri::resource_usage_flag_bits::TransferDst;
+            textureDesc.memoryType = llri::memory_type::Local;
+            textureDesc.initialState = llri::resource_state::TransferDst;
+            textureDesc.width = 64;
+            textureDesc.height = 64;
+            textureDesc.depthOrArrayLayers = 1;
+            textureDesc.mipLevels = 1;
+            textureDesc.sampleCount = llri::sample_count::Count1;
+            textureDesc.textureFormat = llri::format::RGBA8UNorm;
+            textureDesc.sharingMode = llri::resource_sharing_mode::Concurrent;
+
+            llri::command_list_begin_desc resubmitDesc {};
+            resubmitDesc.submitMode = llri::command_list_submit_mode::Resubmit;
+            auto* resubmittable = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+            REQUIRE_EQ(resubmittable->record(resubmitDesc, [](){}), llri::result::Success);
+
+            // the implementation may initialize the texture's layout through the same native queue that the submission thread submits to
+            const llri::submit_desc submitDesc { 0, 1, &resubmittable, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
+            for (size_t i = 0; i < 4; i++)
+            {
+                REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+
+                llri::Resource* texture;
+                REQUIRE_EQ(device->createResource(textureDesc, &texture), llri::result::Success);
+                device->destroyResource(texture);
+            }
+
+            CHECK_EQ(queue->waitIdle(), llri::result::Success);
+            CHECK_EQ(queue->flush(), llri::result::Success);
+        }
+
+        SUBCASE("[Correct usage] waitIdle() waits for queued submissions")
+        {
+            const llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
+            REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+            CHECK_EQ(queue->waitIdle(), llri::result::Success);
+        }
+
+        device->destroyFence(fence);
+        device->destroyCommandGroup(group);
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
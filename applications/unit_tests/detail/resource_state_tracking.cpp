@@ -0,0 +1,207 @@
+/**
+ * @file resource_state_tracking.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+TEST_CASE("Resource state tracking")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        const auto type = detail::availableQueueType(adapter);
+
+        SUBCASE("[Incorrect usage] device_desc::resourceStateTracking is disabled")
+        {
+            auto* device = detail::defaultDevice(instance, adapter);
+            auto* group = detail::defaultCommandGroup(device, type);
+            auto* list = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+
+            llri::Resource* buffer;
+            REQUIRE_EQ(device->createResource(llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferSrc | llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::TransferDst, 64), &buffer), llri::result::Success);
+
+            REQUIRE_EQ(list->begin({}), llri::result::Success);
+            CHECK_EQ(list->requireResourceState(buffer, llri::resource_state::TransferSrc), llri::result::ErrorInvalidState);
+            CHECK_EQ(list->end(), llri::result::Success);
+
+            llri::resource_state state;
+            CHECK_EQ(buffer->queryTrackedState(0, 0, &state), llri::result::ErrorInvalidState);
+
+            device->destroyResource(buffer);
+            device->destroyCommandGroup(group);
+            instance->destroyDevice(device);
+        }
+
+        SUBCASE("device_desc::resourceStateTracking is enabled")
+        {
+            auto* device = detail::defaultDevice(instance, adapter, true);
+            auto* group = detail::defaultCommandGroup(device, type);
+            auto* list = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+            auto* queue = device->getQueue(type, 0);
+            auto* fence = detail::defaultFence(device, false);
+
+            llri::Resource* buffer;
+            REQUIRE_EQ(device->createResource(llri::resource_desc::buffer(llri::resource_usage_flag_bits::TransferSrc | llri::resource_usage_flag_bits::TransferDst, llri::memory_type::Local, llri::resource_state::TransferDst, 64), &buffer), llri::result::Success);
+
+            llri::resource_desc textureDesc;
+            textureDesc.createNodeMask = 0;
+            textureDesc.visibleNodeMask = 0;
+            textureDesc.type = llri::resource_type::Texture2D;
+            textureDesc.usage = llri::resource_usage_flag_bits::TransferSrc | llri::resource_usage_flag_bits::TransferDst;
+            textureDesc.memoryType = llri::memory_type::Local;
+            textureDesc.initialState = llri::resource_state::TransferDst;
+            textureDesc.width = 64;
+            textureDesc.height = 64;
+            textureDesc.depthOrArrayLayers = 2;
+            textureDesc.mipLevels = 2;
+            textureDesc.sampleCount = llri::sample_count::Count1;
+            textureDesc.textureFormat = llri::format::RGBA8UNorm;
+            textureDesc.sharingMode = llri::resource_sharing_mode::Concurrent;
+
+            llri::Resource* texture;
+            REQUIRE_EQ(device->createResource(textureDesc, &texture), llri::result::Success);
+
+            SUBCASE("[Incorrect usage] CommandList isn't recording")
+            {
+                CHECK_EQ(list->requireResourceState(buffer, llri::resource_state::TransferSrc), llri::result::ErrorInvalidState);
+            }
+
+            SUBCASE("[Incorrect usage] invalid parameters")
+            {
+                REQUIRE_EQ(list->begin({}), llri::result::Success);
+                CHECK_EQ(list->requireResourceState(nullptr, llri::resource_state::TransferSrc), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(list->requireResourceState(buffer, static_cast<llri::resource_state>(UINT8_MAX)), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(list->requireResourceState(texture, llri::resource_state::TransferSrc, llri::texture_subresource_range { 2, 1, 0, 1 }), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(list->requireResourceState(texture, llri::resource_state::TransferSrc, llri::texture_subresource_range { 0, 1, 0, 3 }), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(list->requireResourceState(buffer, llri::resource_state::ColorAttachment), llri::result::ErrorInvalidState);
+                CHECK_EQ(list->end(), llri::result::Success);
+            }
+
+            SUBCASE("[Incorrect usage] Resource::queryTrackedState()")
+            {
+                llri::resource_state state;
+                CHECK_EQ(buffer->queryTrackedState(0, 0, nullptr), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(buffer->queryTrackedState(1, 0, &state), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(texture->queryTrackedState(2, 0, &state), llri::result::ErrorInvalidUsage);
+                CHECK_EQ(texture->queryTrackedState(0, 2, &state), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Correct usage] Resources start out in their initial state")
+            {
+                llri::resource_state state;
+                REQUIRE_EQ(buffer->queryTrackedState(0, 0, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferDst);
+                REQUIRE_EQ(texture->queryTrackedState(1, 1, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferDst);
+            }
+
+            SUBCASE("[Correct usage] transitions without the current state")
+            {
+                REQUIRE_EQ(list->begin({}), llri::result::Success);
+
+                // the first use is resolved at submission, the rest is recorded in the CommandList
+                CHECK_EQ(list->requireResourceState(buffer, llri::resource_state::TransferSrc), llri::result::Success);
+                CHECK_EQ(list->requireResourceState(buffer, llri::resource_state::TransferSrc), llri::result::Success);
+                CHECK_EQ(list->requireResourceState(buffer, llri::resource_state::TransferDst), llri::result::Success);
+
+                // subresources are tracked separately
+                CHECK_EQ(list->requireResourceState(texture, llri::resource_state::TransferSrc, llri::texture_subresource_range { 1, 1, 0, 2 }), llri::result::Success);
+                CHECK_EQ(list->requireResourceState(texture, llri::resource_state::TransferSrc), llri::result::Success);
+                CHECK_EQ(list->requireResourceState(texture, llri::resource_state::TransferDst, llri::texture_subresource_range { 0, 2, 1, 1 }), llri::result::Success);
+
+                // explicit barriers are tracked too
+                CHECK_EQ(list->resourceBarrier(llri::resource_barrier::transition(texture, llri::resource_state::TransferDst, llri::resource_state::TransferSrc, llri::texture_subresource_range { 0, 2, 1, 1 })), llri::result::Success);
+                REQUIRE_EQ(list->end(), llri::result::Success);
+
+                // recording doesn't change the tracked states, only submitting does
+                llri::resource_state state;
+                REQUIRE_EQ(texture->queryTrackedState(1, 0, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferDst);
+
+                llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, fence };
+                CHECK_EQ(queue->submit(submitDesc), llri::result::Success);
+                CHECK_EQ(device->waitFence(fence, LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                REQUIRE_EQ(buffer->queryTrackedState(0, 0, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferDst);
+                REQUIRE_EQ(texture->queryTrackedState(0, 0, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferSrc);
+                REQUIRE_EQ(texture->queryTrackedState(1, 1, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferSrc);
+            }
+
+            SUBCASE("[Correct usage] a failed submission doesn't change the tracked states")
+            {
+                REQUIRE_EQ(list->record({}, [=]() {
+                    CHECK_EQ(list->requireResourceState(buffer, llri::resource_state::TransferSrc), llri::result::Success);
+                }), llri::result::Success);
+
+                // the Fence is already signaled, so the submission is rejected
+                auto* signaled = detail::defaultFence(device, true);
+                llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, signaled };
+                CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorAlreadySignaled);
+
+                llri::resource_state state;
+                REQUIRE_EQ(buffer->queryTrackedState(0, 0, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferDst);
+
+                submitDesc.fence = fence;
+                CHECK_EQ(queue->submit(submitDesc), llri::result::Success);
+                CHECK_EQ(device->waitFence(fence, LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                REQUIRE_EQ(buffer->queryTrackedState(0, 0, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferSrc);
+
+                device->destroyFence(signaled);
+            }
+
+            SUBCASE("[Correct usage] submitted CommandLists fix up the states of earlier submissions")
+            {
+                auto* second = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+
+                REQUIRE_EQ(list->record({}, [=]() {
+                    CHECK_EQ(list->requireResourceState(buffer, llri::resource_state::TransferSrc), llri::result::Success);
+                }), llri::result::Success);
+
+                REQUIRE_EQ(second->record({}, [=]() {
+                    CHECK_EQ(second->requireResourceState(buffer, llri::resource_state::TransferDst), llri::result::Success);
+                    CHECK_EQ(second->requireResourceState(texture, llri::resource_state::TransferSrc), llri::result::Success);
+                }), llri::result::Success);
+
+                llri::CommandList* lists[] = { list, second };
+                llri::submit_desc submitDesc { 0, 2, lists, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, fence };
+                CHECK_EQ(queue->submit(submitDesc), llri::result::Success);
+                CHECK_EQ(device->waitFence(fence, LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                // the next submission starts from the states that the previous submission left the resources in
+                CHECK_EQ(group->reset(), llri::result::Success);
+
+                REQUIRE_EQ(list->record({}, [=]() {
+                    CHECK_EQ(list->requireResourceState(texture, llri::resource_state::TransferDst), llri::result::Success);
+                }), llri::result::Success);
+
+                submitDesc.numCommandLists = 1;
+                CHECK_EQ(queue->submit(submitDesc), llri::result::Success);
+                CHECK_EQ(device->waitFence(fence, LLRI_TIMEOUT_MAX), llri::result::Success);
+
+                llri::resource_state state;
+                REQUIRE_EQ(buffer->queryTrackedState(0, 0, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferDst);
+                REQUIRE_EQ(texture->queryTrackedState(1, 1, &state), llri::result::Success);
+                CHECK_EQ(state, llri::resource_state::TransferDst);
+            }
+
+            device->destroyResource(texture);
+            device->destroyResource(buffer);
+            device->destroyFence(fence);
+            device->destroyCommandGroup(group);
+            instance->destroyDevice(device);
+        }
+    });
+
+    llri::destroyInstance(instance);
+}
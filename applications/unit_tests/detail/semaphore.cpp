@@ -0,0 +1,174 @@
+/**
+ * @file semaphore.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <doctest/doctest.h>
+#include <helpers.hpp>
+
+TEST_CASE("Semaphore")
+{
+    auto* instance = detail::defaultInstance();
+
+    detail::iterateAdapters(instance, [instance](llri::Adapter* adapter) {
+        auto* device = detail::defaultDevice(instance, adapter);
+
+        SUBCASE("Device::createSemaphore()")
+        {
+            llri::Semaphore* semaphore;
+
+            SUBCASE("[Incorrect usage] invalid type")
+            {
+                CHECK_EQ(device->createSemaphore({ static_cast<llri::semaphore_type>(UINT8_MAX), 0 }, &semaphore), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] Binary with an initialValue")
+            {
+                CHECK_EQ(device->createSemaphore({ llri::semaphore_type::Binary, 1 }, &semaphore), llri::result::ErrorInvalidUsage);
+            }
+
+            SUBCASE("[Incorrect usage] Timeline without the timelineSemaphores feature")
+            {
+                CHECK_EQ(device->createSemaphore({ llri::semaphore_type::Timeline, 0 }, &semaphore), llri::result::ErrorFeatureNotSupported);
+            }
+
+            SUBCASE("[Correct usage] Binary")
+            {
+                REQUIRE_EQ(device->createSemaphore({ llri::semaphore_type::Binary, 0 }, &semaphore), llri::result::Success);
+                CHECK_EQ(semaphore->getType(), llri::semaphore_type::Binary);
+
+                uint64_t value = 0;
+                CHECK_EQ(semaphore->signal(1), llri::result::ErrorInvalidState);
+                CHECK_EQ(semaphore->getValue(&value), llri::result::ErrorInvalidState);
+                CHECK_EQ(device->waitSemaphores(1, &semaphore, &value, 0, false), llri::result::ErrorInvalidState);
+                device->destroySemaphore(semaphore);
+            }
+        }
+
+        if (adapter->queryFeatures().timelineSemaphores)
+        {
+            SUBCASE("Timeline Semaphore")
+            {
+                llri::adapter_features features {};
+                features.timelineSemaphores = true;
+                auto* timelineDevice = detail::defaultDevice(instance, adapter, false, features);
+
+                llri::Semaphore* semaphore;
+                REQUIRE_EQ(timelineDevice->createSemaphore({ llri::semaphore_type::Timeline, 5 }, &semaphore), llri::result::Success);
+                CHECK_EQ(semaphore->getType(), llri::semaphore_type::Timeline);
+
+                uint64_t value = 0;
+                REQUIRE_EQ(semaphore->getValue(&value), llri::result::Success);
+                CHECK_EQ(value, 5);
+
+                SUBCASE("[Incorrect usage] Semaphore::getValue() with value == nullptr")
+                {
+                    CHECK_EQ(semaphore->getValue(nullptr), llri::result::ErrorInvalidUsage);
+                }
+
+                SUBCASE("[Incorrect usage] Semaphore::signal() with a value that isn't more than the current value")
+                {
+                    CHECK_EQ(semaphore->signal(5), llri::result::ErrorInvalidUsage);
+                }
+
+                SUBCASE("[Incorrect usage] Device::waitSemaphores() with invalid parameters")
+                {
+                    const uint64_t waitValue = 5;
+                    CHECK_EQ(timelineDevice->waitSemaphores(0, &semaphore, &waitValue, 0, false), llri::result::ErrorInvalidUsage);
+                    CHECK_EQ(timelineDevice->waitSemaphores(1, nullptr, &waitValue, 0, false), llri::result::ErrorInvalidUsage);
+                    CHECK_EQ(timelineDevice->waitSemaphores(1, &semaphore, nullptr, 0, false), llri::result::ErrorInvalidUsage);
+                }
+
+                SUBCASE("[Correct usage] host signal and wait")
+                {
+                    uint64_t waitValue = 6;
+                    CHECK_EQ(timelineDevice->waitSemaphores(1, &semaphore, &waitValue, 0, false), llri::result::Timeout);
+
+                    REQUIRE_EQ(semaphore->signal(6), llri::result::Success);
+                    CHECK_EQ(timelineDevice->waitSemaphores(1, &semaphore, &waitValue, 0, false), llri::result::Success);
+
+                    REQUIRE_EQ(semaphore->getValue(&value), llri::result::Success);
+                    CHECK_EQ(value, 6);
+                }
+
+                SUBCASE("[Correct usage] waitAny")
+                {
+                    llri::Semaphore* second;
+                    REQUIRE_EQ(timelineDevice->createSemaphore({ llri::semaphore_type::Timeline, 0 }, &second), llri::result::Success);
+
+                    llri::Semaphore* semaphores[] = { semaphore, second };
+                    const uint64_t waitValues[] = { 5, 1 };
+                    CHECK_EQ(timelineDevice->waitSemaphores(2, semaphores, waitValues, 0, true), llri::result::Success);
+                    CHECK_EQ(timelineDevice->waitSemaphores(2, semaphores, waitValues, 0, false), llri::result::Timeout);
+
+                    timelineDevice->destroySemaphore(second);
+                }
+
+                SUBCASE("Queue::submit() with timeline values")
+                {
+                    auto type = detail::availableQueueType(adapter);
+                    auto* queue = timelineDevice->getQueue(type, 0);
+                    auto* group = detail::defaultCommandGroup(timelineDevice, type);
+                    auto* list = detail::defaultCommandList(group, 0, llri::command_list_usage::Direct);
+                    REQUIRE_EQ(list->begin({}), llri::result::Success);
+                    REQUIRE_EQ(list->end(), llri::result::Success);
+
+                    SUBCASE("[Incorrect usage] missing signalSemaphoreValues")
+                    {
+                        const llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 1, &semaphore, nullptr, nullptr };
+                        CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
+                    }
+
+                    SUBCASE("[Incorrect usage] signal value isn't more than the current value")
+                    {
+                        const uint64_t signalValue = 5;
+                        const llri::submit_desc submitDesc { 0, 1, &list, 0, nullptr, nullptr, nullptr, 1, &semaphore, &signalValue, nullptr };
+                        CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
+                    }
+
+                    SUBCASE("[Incorrect usage] signal value isn't more than a value signaled earlier in the batch")
+                    {
+                        const uint64_t signalValues[] = { 10, 7 };
+                        const llri::submit_desc submitDescs[] = {
+                            { 0, 1, &list, 0, nullptr, nullptr, nullptr, 1, &semaphore, &signalValues[0], nullptr },
+                            { 0, 1, &list, 0, nullptr, nullptr, nullptr, 1, &semaphore, &signalValues[1], nullptr }
+                        };
+                        CHECK_EQ(queue->submit(2, submitDescs), llri::result::ErrorInvalidUsage);
+
+                        uint64_t value;
+                        REQUIRE_EQ(semaphore->getValue(&value), llri::result::Success);
+                        CHECK_EQ(value, 5u);
+                    }
+
+                    SUBCASE("[Incorrect usage] missing waitSemaphoreValues")
+                    {
+                        const llri::submit_desc submitDesc { 0, 1, &list, 1, &semaphore, nullptr, nullptr, 0, nullptr, nullptr, nullptr };
+                        CHECK_EQ(queue->submit(submitDesc), llri::result::ErrorInvalidUsage);
+                    }
+
+                    SUBCASE("[Correct usage] wait and signal values")
+                    {
+                        const uint64_t waitValue = 5;
+                        const uint64_t signalValue = 10;
+                        const llri::submit_desc submitDesc { 0, 1, &list, 1, &semaphore, &waitValue, nullptr, 1, &semaphore, &signalValue, nullptr };
+                        REQUIRE_EQ(queue->submit(submitDesc), llri::result::Success);
+
+                        CHECK_EQ(timelineDevice->waitSemaphores(1, &semaphore, &signalValue, LLRI_TIMEOUT_MAX, false), llri::result::Success);
+                    }
+
+                    queue->waitIdle();
+                    timelineDevice->destroyCommandGroup(group);
+                }
+
+                timelineDevice->destroySemaphore(semaphore);
+                instance->destroyDevice(timelineDevice);
+            }
+        }
+
+        instance->destroyDevice(device);
+    });
+
+    llri::destroyInstance(instance);
+}
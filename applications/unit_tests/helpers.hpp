@@ -72,6 +72,8 @@ namespace detail
         std::vector<llri::instance_extension> extensions;
         if (llri::queryInstanceExtensionSupport(llri::instance_extension::DriverValidation))
             extensions.push_back(llri::instance_extension::DriverValidation);
+        if (llri::queryInstanceExtensionSupport(llri::instance_extension::DebugLabels))
+            extensions.push_back(llri::instance_extension::DebugLabels);
 
         const llri::instance_desc desc{ static_cast<uint32_t>(extensions.size()), extensions.data(), "unit test instance"};
         REQUIRE_EQ(llri::createInstance(desc, &instance), llri::result::Success);
@@ -135,7 +137,7 @@ namespace detail
         }
     }
 
-    inline llri::Device* defaultDevice(llri::Instance* instance, llri::Adapter* adapter)
+    inline llri::Device* defaultDevice(llri::Instance* instance, llri::Adapter* adapter, bool resourceStateTracking = false, const llri::adapter_features& features = {}, llri::queue_submit_mode submitMode = llri::queue_submit_mode::Immediate)
     {
         llri::Device* device = nullptr;
 
@@ -146,13 +148,13 @@ namespace detail
         std::vector<llri::queue_desc> queues;
 
         if (graphicsQueueCount > 0)
-            queues.push_back(llri::queue_desc{ llri::queue_type::Graphics, llri::queue_priority::Normal });
+            queues.push_back(llri::queue_desc{ llri::queue_type::Graphics, llri::queue_priority::Normal, submitMode });
         if (computeQueueCount > 0)
-            queues.push_back(llri::queue_desc{ llri::queue_type::Compute, llri::queue_priority::Normal });
+            queues.push_back(llri::queue_desc{ llri::queue_type::Compute, llri::queue_priority::Normal, submitMode });
         if (transferQueueCount > 0)
-            queues.push_back(llri::queue_desc{ llri::queue_type::Transfer, llri::queue_priority::Normal });
+            queues.push_back(llri::queue_desc{ llri::queue_type::Transfer, llri::queue_priority::Normal, submitMode });
 
-        const llri::device_desc ddesc{ adapter, llri::adapter_features{}, 0, nullptr, static_cast<uint32_t>(queues.size()), queues.data() };
+        const llri::device_desc ddesc{ adapter, features, 0, nullptr, static_cast<uint32_t>(queues.size()), queues.data(), resourceStateTracking };
         REQUIRE_EQ(instance->createDevice(ddesc, &device), llri::result::Success);
         return device;
     }
@@ -17,6 +17,14 @@ namespace llri
         adapter_info info;
         info.vendorId = desc.VendorId;
         info.adapterId = desc.DeviceId;
+
+        // the user mode driver version is only exposed through CheckInterfaceSupport
+        LARGE_INTEGER driverVersion {};
+        if (SUCCEEDED(static_cast<IDXGIAdapter1*>(m_ptr)->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion)))
+            info.driverVersion = static_cast<uint64_t>(driverVersion.QuadPart);
+        else
+            info.driverVersion = 0;
+
         const auto description = std::string(reinterpret_cast<char*>(desc.Description), reinterpret_cast<char*>(desc.Description + 128));
         info.adapterName = description.substr(0, description.find_last_not_of(' '));
 
@@ -33,12 +41,19 @@ namespace llri
     adapter_features Adapter::impl_queryFeatures() const
     {
         adapter_features features{};
+        features.pipelineStatisticsQuery = true; // pipeline statistics query heaps are supported on all feature levels
+        features.timelineSemaphores = true; // ID3D12Fences are timelines by design
         return features;
     }
 
     adapter_limits Adapter::impl_queryLimits() const
     {
         adapter_limits output{};
+        // root signatures are limited to 64 DWORDs, half of which are reserved for the push constants
+        output.maxPushConstantSize = detail::maxPushConstantSize;
+        output.maxColorAttachments = D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT;
+        output.maxVertexInputBindings = D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT;
+        output.maxVertexInputAttributes = D3D12_IA_VERTEX_INPUT_STRUCTURE_ELEMENT_COUNT;
         return output;
     }
 
@@ -106,6 +121,12 @@ namespace llri
         return 0;
     }
 
+    queue_type Adapter::impl_queryQueueFamilyType(queue_type type) const
+    {
+        // DirectX creates every queue type directly and doesn't expose how they map to hardware
+        return type;
+    }
+
     std::unordered_map<format, format_properties> Adapter::impl_queryFormatProperties() const
     {
         std::unordered_map<format, format_properties> result;
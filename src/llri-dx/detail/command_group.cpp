@@ -9,9 +9,14 @@
 
 namespace llri
 {
-    result CommandGroup::impl_reset()
+    result CommandGroup::impl_reset([[maybe_unused]] command_group_reset_mode mode)
     {
-        const auto r = static_cast<ID3D12CommandAllocator*>(m_ptr)->Reset();
+        // command allocators always keep their memory for reuse, so mode has no effect
+        auto r = static_cast<ID3D12CommandAllocator*>(m_ptr)->Reset();
+        if (FAILED(r))
+            return detail::mapHRESULT(r);
+
+        r = static_cast<ID3D12CommandAllocator*>(m_indirectPtr)->Reset();
         if (FAILED(r))
             return detail::mapHRESULT(r);
 
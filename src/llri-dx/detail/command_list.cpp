@@ -6,23 +6,56 @@
 
 #include <llri/llri.hpp>
 #include <llri-dx/directx.hpp>
+#include <cstring>
 
 namespace llri
 {
     result CommandList::impl_begin([[maybe_unused]] const command_list_begin_desc& desc)
     {
         // TODO: Handle node mask
-        // TODO: Handle inheritance/indirect
-        const auto r = static_cast<ID3D12GraphicsCommandList*>(m_ptr)->Reset(static_cast<ID3D12CommandAllocator*>(m_group->m_ptr), nullptr);
+        // D3D12 CommandLists can always be submitted multiple times, so desc.submitMode has no equivalent
+        // Indirect CommandLists are bundles, which inherit the render targets, viewport, scissor and stencil reference from the list that executes them
+        auto* allocator = m_desc.usage == command_list_usage::Direct ? m_group->m_ptr : m_group->m_indirectPtr;
+        const auto r = static_cast<ID3D12GraphicsCommandList*>(m_ptr)->Reset(static_cast<ID3D12CommandAllocator*>(allocator), nullptr);
         if (FAILED(r))
             return detail::mapHRESULT(r);
 
+        // bind the root signature that holds the push constants
+        auto* rootSignature = static_cast<ID3D12RootSignature*>(m_group->m_device->m_pushConstantLayouts[static_cast<size_t>(shader_stage_flag_bits::All)]);
+        if (m_group->m_type == queue_type::Graphics)
+            static_cast<ID3D12GraphicsCommandList*>(m_ptr)->SetGraphicsRootSignature(rootSignature);
+        if (m_group->m_type != queue_type::Transfer)
+            static_cast<ID3D12GraphicsCommandList*>(m_ptr)->SetComputeRootSignature(rootSignature);
+
+        m_queriesToResolve.clear();
         m_state = command_list_state::Recording;
         return result::Success;
     }
 
     result CommandList::impl_end()
     {
+        // resolve the written queries into their pool's readback buffer so that they can be read by QueryPool::getResults()
+        // sorting groups the queries per pool, so that every contiguous range is resolved with a single call
+        std::sort(m_queriesToResolve.begin(), m_queriesToResolve.end(), [](const auto& a, const auto& b) {
+            return std::less<QueryPool*>()(a.first, b.first) || (a.first == b.first && a.second < b.second);
+        });
+        m_queriesToResolve.erase(std::unique(m_queriesToResolve.begin(), m_queriesToResolve.end()), m_queriesToResolve.end());
+
+        auto* cmdList = static_cast<ID3D12GraphicsCommandList*>(m_ptr);
+        for (size_t first = 0; first < m_queriesToResolve.size();)
+        {
+            QueryPool* queryPool = m_queriesToResolve[first].first;
+            const uint32_t firstQuery = m_queriesToResolve[first].second;
+
+            size_t last = first + 1;
+            while (last < m_queriesToResolve.size() && m_queriesToResolve[last].first == queryPool && m_queriesToResolve[last].second == firstQuery + (last - first))
+                last++;
+
+            cmdList->ResolveQueryData(static_cast<ID3D12QueryHeap*>(queryPool->m_ptr), detail::mapQueryType(queryPool->m_desc.type), firstQuery, static_cast<UINT>(last - first), static_cast<ID3D12Resource*>(queryPool->m_readback), static_cast<UINT64>(firstQuery) * queryPool->m_resultSize);
+            first = last;
+        }
+        m_queriesToResolve.clear();
+
         const auto r = static_cast<ID3D12GraphicsCommandList*>(m_ptr)->Close();
          if (FAILED(r))
              return detail::mapHRESULT(r);
@@ -33,12 +66,49 @@ namespace llri
 
     result CommandList::impl_resourceBarrier(uint32_t numBarriers, const resource_barrier* barriers)
     {
-        std::vector<D3D12_RESOURCE_BARRIER> dx12Barriers;
+        auto* cmdList = static_cast<ID3D12GraphicsCommandList*>(m_ptr);
+
+        // barriers are translated in fixed size batches on the stack, so that no memory is allocated
+        // D3D12 barriers don't take pipeline stages, so resource_barrier::srcStages and dstStages are ignored
+        constexpr UINT batchSize = 32;
+        std::array<D3D12_RESOURCE_BARRIER, batchSize> dx12Barriers;
+        UINT numDx12Barriers = 0;
+
+        const auto add = [&](const D3D12_RESOURCE_BARRIER& dx12Barrier)
+        {
+            if (numDx12Barriers == batchSize)
+            {
+                cmdList->ResourceBarrier(numDx12Barriers, dx12Barriers.data());
+                numDx12Barriers = 0;
+            }
+
+            dx12Barriers[numDx12Barriers++] = dx12Barrier;
+        };
 
         for (size_t i = 0; i < numBarriers; i++)
         {
             auto& barrier = barriers[i];
 
+            // D3D12 resources don't have queue ownership, so an ownership transfer is a single transition on one of the two queues
+            if (barrier.ownershipTransfer != queue_ownership_transfer::None &&
+                (!detail::executesOwnershipTransition(barrier, m_group->m_type) || barrier.trans.oldState == barrier.trans.newState))
+                continue;
+
+            D3D12_RESOURCE_BARRIER_FLAGS splitFlags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            switch(barrier.split)
+            {
+                case resource_barrier_split::None:
+                    break;
+                case resource_barrier_split::BeginOnly:
+                    splitFlags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+                    m_splitBarriers.push_back(detail::split_barrier { barrier, nullptr });
+                    break;
+                case resource_barrier_split::EndOnly:
+                    splitFlags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+                    m_splitBarriers.erase(m_splitBarriers.begin() + static_cast<std::ptrdiff_t>(findSplitBarrier(barrier)));
+                    break;
+            }
+
             switch(barrier.type)
             {
                 case resource_barrier_type::ReadWrite:
@@ -47,7 +117,7 @@ namespace llri
                     dx12Barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
                     dx12Barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
                     dx12Barrier.UAV = D3D12_RESOURCE_UAV_BARRIER { static_cast<ID3D12Resource*>(barrier.rw.resource->m_resource) };
-                    dx12Barriers.push_back(dx12Barrier);
+                    add(dx12Barrier);
                     break;
                 }
                 case resource_barrier_type::Transition:
@@ -55,42 +125,292 @@ namespace llri
                     if (barrier.trans.subresourceRange == texture_subresource_range::all())
                     {
                         D3D12_RESOURCE_BARRIER dx12Barrier{};
-                        dx12Barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                        dx12Barrier.Flags = splitFlags;
                         dx12Barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
                         dx12Barrier.Transition = D3D12_RESOURCE_TRANSITION_BARRIER {
-                            static_cast<ID3D12Resource*>(barrier.rw.resource->m_resource),
+                            static_cast<ID3D12Resource*>(barrier.trans.resource->m_resource),
                             D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
                             detail::mapResourceState(barrier.trans.oldState),
                             detail::mapResourceState(barrier.trans.newState)
                         };
-                        dx12Barriers.push_back(dx12Barrier);
+                        add(dx12Barrier);
                     }
                     else
                     {
-                        const auto desc = barrier.trans.resource->getDesc();
+                        const auto& desc = barrier.trans.resource->m_desc;
                         const UINT arrayLayers = desc.type == resource_type::Texture3D ? 1u : desc.depthOrArrayLayers;
                         for (UINT a = barrier.trans.subresourceRange.baseArrayLayer; a < barrier.trans.subresourceRange.baseArrayLayer + barrier.trans.subresourceRange.numArrayLayers; a++)
                         {
                             for (UINT m = barrier.trans.subresourceRange.baseMipLevel; m < barrier.trans.subresourceRange.baseMipLevel + barrier.trans.subresourceRange.numMipLevels; m++)
                             {
                                 D3D12_RESOURCE_BARRIER dx12Barrier{};
-                                dx12Barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                                dx12Barrier.Flags = splitFlags;
                                 dx12Barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
                                 dx12Barrier.Transition = D3D12_RESOURCE_TRANSITION_BARRIER {
-                                    static_cast<ID3D12Resource*>(barrier.rw.resource->m_resource),
+                                    static_cast<ID3D12Resource*>(barrier.trans.resource->m_resource),
                                     D3D12CalcSubresource(m, a, 0, desc.mipLevels, arrayLayers),
                                     detail::mapResourceState(barrier.trans.oldState),
                                     detail::mapResourceState(barrier.trans.newState)
                                 };
-                                dx12Barriers.push_back(dx12Barrier);
+                                add(dx12Barrier);
                             }
                         }
                     }
+                    break;
                 }
             }
         }
 
-        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->ResourceBarrier(numBarriers, dx12Barriers.data());
+        if (numDx12Barriers > 0)
+            cmdList->ResourceBarrier(numDx12Barriers, dx12Barriers.data());
+        return result::Success;
+    }
+
+    result CommandList::impl_pushConstants(shader_stage_flags stageMask, uint32_t offset, uint32_t size, const void* data)
+    {
+        auto* cmdList = static_cast<ID3D12GraphicsCommandList*>(m_ptr);
+
+        // graphics and compute root arguments are stored separately so the constants are set for each of the requested pipelines
+        if (stageMask.any(shader_stage_flag_bits::AllGraphics))
+            cmdList->SetGraphicsRoot32BitConstants(0, size / 4, data, offset / 4);
+        if (stageMask.contains(shader_stage_flag_bits::Compute))
+            cmdList->SetComputeRoot32BitConstants(0, size / 4, data, offset / 4);
+
+        return result::Success;
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief Discards the contents of an attachment within an area. Depth stencil formats with a stencil component store stencil in a separate plane, which is discarded too.
+        */
+        void discardAttachment(ID3D12GraphicsCommandList* cmdList, Resource* texture, const D3D12_RECT& area)
+        {
+            const auto desc = texture->getDesc();
+            auto* resource = static_cast<ID3D12Resource*>(texture->getNative());
+
+            const D3D12_DISCARD_REGION region { 1, &area, 0, 1 };
+            cmdList->DiscardResource(resource, &region);
+
+            if (has_stencil_component(desc.textureFormat))
+            {
+                const D3D12_DISCARD_REGION stencilRegion { 1, &area, D3D12CalcSubresource(0, 0, 1, desc.mipLevels, desc.depthOrArrayLayers), 1 };
+                cmdList->DiscardResource(resource, &stencilRegion);
+            }
+        }
+    }
+
+    result CommandList::impl_beginRendering(const rendering_desc& desc)
+    {
+        auto* cmdList = static_cast<ID3D12GraphicsCommandList*>(m_ptr);
+
+        const D3D12_RECT area { desc.area.offset.x, desc.area.offset.y,
+            desc.area.offset.x + static_cast<LONG>(desc.area.extent.width), desc.area.offset.y + static_cast<LONG>(desc.area.extent.height) };
+
+        std::array<D3D12_CPU_DESCRIPTOR_HANDLE, detail::maxColorAttachments> renderTargets {};
+        D3D12_CPU_DESCRIPTOR_HANDLE depthStencil {};
+
+        // DirectX12 has no load operations, so they're applied as explicit clears and discards
+        for (size_t i = 0; i < m_numRenderingAttachments; i++)
+        {
+            const auto& attachment = m_renderingAttachments[i];
+            const bool isDepthStencil = i == desc.numColorAttachments;
+            const D3D12_CPU_DESCRIPTOR_HANDLE handle = static_cast<ID3D12DescriptorHeap*>(attachment.texture->m_attachmentView)->GetCPUDescriptorHandleForHeapStart();
+
+            if (isDepthStencil)
+                depthStencil = handle;
+            else
+                renderTargets[i] = handle;
+
+            if (attachment.loadOp == attachment_load_op::Clear)
+            {
+                if (isDepthStencil)
+                {
+                    D3D12_CLEAR_FLAGS flags = D3D12_CLEAR_FLAG_DEPTH;
+                    if (has_stencil_component(attachment.texture->m_desc.textureFormat))
+                        flags |= D3D12_CLEAR_FLAG_STENCIL;
+
+                    cmdList->ClearDepthStencilView(handle, flags, attachment.clearValue.depthStencil.depth, attachment.clearValue.depthStencil.stencil, 1, &area);
+                }
+                else
+                {
+                    const std::array<float, 4> color { attachment.clearValue.color.r, attachment.clearValue.color.g, attachment.clearValue.color.b, attachment.clearValue.color.a };
+                    cmdList->ClearRenderTargetView(handle, color.data(), 1, &area);
+                }
+            }
+            else if (attachment.loadOp == attachment_load_op::DontCare)
+            {
+                detail::discardAttachment(cmdList, attachment.texture, area);
+            }
+        }
+
+        cmdList->OMSetRenderTargets(desc.numColorAttachments, renderTargets.data(), FALSE, desc.depthStencilAttachment ? &depthStencil : nullptr);
+
+        const D3D12_VIEWPORT vp { static_cast<float>(area.left), static_cast<float>(area.top), static_cast<float>(desc.area.extent.width), static_cast<float>(desc.area.extent.height), 0.0f, 1.0f };
+        cmdList->RSSetViewports(1, &vp);
+        cmdList->RSSetScissorRects(1, &area);
+
+        return result::Success;
+    }
+
+    result CommandList::impl_endRendering()
+    {
+        auto* cmdList = static_cast<ID3D12GraphicsCommandList*>(m_ptr);
+
+        // the render area isn't stored, so the discard applies to the full subresource
+        for (size_t i = 0; i < m_numRenderingAttachments; i++)
+        {
+            const auto& attachment = m_renderingAttachments[i];
+            if (attachment.storeOp != attachment_store_op::DontCare)
+                continue;
+
+            const D3D12_RECT full { 0, 0, static_cast<LONG>(attachment.texture->m_desc.width), static_cast<LONG>(attachment.texture->m_desc.height) };
+            detail::discardAttachment(cmdList, attachment.texture, full);
+        }
+
+        return result::Success;
+    }
+
+    result CommandList::impl_bindPipeline(Pipeline* pipeline)
+    {
+        auto* cmdList = static_cast<ID3D12GraphicsCommandList*>(m_ptr);
+        cmdList->SetPipelineState(static_cast<ID3D12PipelineState*>(pipeline->m_ptr));
+        cmdList->IASetPrimitiveTopology(detail::mapPrimitiveTopology(pipeline->m_topology));
+        return result::Success;
+    }
+
+    result CommandList::impl_setViewport(const viewport& vp)
+    {
+        const D3D12_VIEWPORT viewport { vp.x, vp.y, vp.width, vp.height, vp.minDepth, vp.maxDepth };
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->RSSetViewports(1, &viewport);
+        return result::Success;
+    }
+
+    result CommandList::impl_setScissor(const rect_2d& scissor)
+    {
+        const D3D12_RECT rect { scissor.offset.x, scissor.offset.y,
+            scissor.offset.x + static_cast<LONG>(scissor.extent.width), scissor.offset.y + static_cast<LONG>(scissor.extent.height) };
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->RSSetScissorRects(1, &rect);
+        return result::Success;
+    }
+
+    result CommandList::impl_setStencilReference(uint8_t reference)
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->OMSetStencilRef(reference);
+        return result::Success;
+    }
+
+    result CommandList::impl_bindVertexBuffers(uint32_t firstBinding, uint32_t numBuffers, Resource* const* buffers, const uint64_t* offsets)
+    {
+        std::array<D3D12_VERTEX_BUFFER_VIEW, D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT> views {};
+
+        // DirectX12 stores the stride in the view instead of in the pipeline
+        for (uint32_t i = 0; i < numBuffers; i++)
+        {
+            const uint32_t binding = firstBinding + i;
+            const uint64_t offset = offsets ? offsets[i] : 0;
+            auto* resource = static_cast<ID3D12Resource*>(buffers[i]->m_resource);
+
+            views[i].BufferLocation = resource->GetGPUVirtualAddress() + offset;
+            views[i].SizeInBytes = static_cast<UINT>(buffers[i]->m_desc.width - offset);
+            views[i].StrideInBytes = binding < m_pipeline->m_vertexStrides.size() ? m_pipeline->m_vertexStrides[binding] : 0;
+        }
+
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->IASetVertexBuffers(firstBinding, numBuffers, views.data());
+        return result::Success;
+    }
+
+    result CommandList::impl_bindIndexBuffer(Resource* buffer, uint64_t offset, index_type type)
+    {
+        D3D12_INDEX_BUFFER_VIEW view;
+        view.BufferLocation = static_cast<ID3D12Resource*>(buffer->m_resource)->GetGPUVirtualAddress() + offset;
+        view.SizeInBytes = static_cast<UINT>(buffer->m_desc.width - offset);
+        view.Format = detail::mapIndexType(type);
+
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->IASetIndexBuffer(&view);
+        return result::Success;
+    }
+
+    result CommandList::impl_draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->DrawInstanced(vertexCount, instanceCount, firstVertex, firstInstance);
+        return result::Success;
+    }
+
+    result CommandList::impl_drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+        return result::Success;
+    }
+
+    result CommandList::impl_executeIndirectLists(uint32_t numLists, CommandList* const* lists)
+    {
+        auto* cmdList = static_cast<ID3D12GraphicsCommandList*>(m_ptr);
+        for (uint32_t i = 0; i < numLists; i++)
+            cmdList->ExecuteBundle(static_cast<ID3D12GraphicsCommandList*>(lists[i]->m_ptr));
+
+        return result::Success;
+    }
+
+    result CommandList::impl_resetQueries([[maybe_unused]] QueryPool* queryPool, [[maybe_unused]] uint32_t firstQuery, [[maybe_unused]] uint32_t numQueries)
+    {
+        // DirectX12 queries don't need to be reset before they're written
+        return result::Success;
+    }
+
+    result CommandList::impl_writeTimestamp(QueryPool* queryPool, uint32_t query)
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->EndQuery(static_cast<ID3D12QueryHeap*>(queryPool->m_ptr), detail::mapQueryType(queryPool->m_desc.type), query);
+
+        // resolved by end()
+        m_queriesToResolve.emplace_back(queryPool, query);
+        return result::Success;
+    }
+
+    result CommandList::impl_beginQuery(QueryPool* queryPool, uint32_t query)
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->BeginQuery(static_cast<ID3D12QueryHeap*>(queryPool->m_ptr), detail::mapQueryType(queryPool->m_desc.type), query);
+        return result::Success;
+    }
+
+    result CommandList::impl_endQuery(QueryPool* queryPool, uint32_t query)
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->EndQuery(static_cast<ID3D12QueryHeap*>(queryPool->m_ptr), detail::mapQueryType(queryPool->m_desc.type), query);
+
+        // resolved by end()
+        m_queriesToResolve.emplace_back(queryPool, query);
+        return result::Success;
+    }
+
+    result CommandList::impl_copyBuffer(Resource* src, uint64_t srcOffset, Resource* dst, uint64_t dstOffset, uint64_t size)
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->CopyBufferRegion(static_cast<ID3D12Resource*>(dst->m_resource), dstOffset, static_cast<ID3D12Resource*>(src->m_resource), srcOffset, size);
+        return result::Success;
+    }
+
+    result CommandList::impl_resolveQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries, Resource* buffer, uint64_t offset)
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->ResolveQueryData(static_cast<ID3D12QueryHeap*>(queryPool->m_ptr), detail::mapQueryType(queryPool->m_desc.type),
+            firstQuery, numQueries, static_cast<ID3D12Resource*>(buffer->m_resource), offset);
+        return result::Success;
+    }
+
+    result CommandList::impl_beginLabel(const char* name, [[maybe_unused]] const label_color& color)
+    {
+        // metadata 1 marks the data as an ANSI string, which is what PIX expects for unformatted events
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->BeginEvent(1, name, static_cast<UINT>(std::strlen(name) + 1));
+        return result::Success;
+    }
+
+    result CommandList::impl_endLabel()
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->EndEvent();
+        return result::Success;
+    }
+
+    result CommandList::impl_insertLabel(const char* name, [[maybe_unused]] const label_color& color)
+    {
+        static_cast<ID3D12GraphicsCommandList*>(m_ptr)->SetMarker(1, name, static_cast<UINT>(std::strlen(name) + 1));
         return result::Success;
     }
 }
@@ -0,0 +1,93 @@
+/**
+ * @file debug_names.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-dx/directx.hpp>
+#include <string>
+
+namespace llri
+{
+    namespace detail
+    {
+        result setObjectName(ID3D12Object* object, const char* name)
+        {
+            const int length = MultiByteToWideChar(CP_UTF8, 0, name, -1, nullptr, 0);
+            if (length == 0)
+                return result::ErrorInvalidUsage;
+
+            std::wstring wideName(static_cast<size_t>(length), L'\0');
+            MultiByteToWideChar(CP_UTF8, 0, name, -1, wideName.data(), length);
+            return mapHRESULT(object->SetName(wideName.c_str()));
+        }
+    }
+
+    result Device::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<ID3D12Device*>(m_ptr), name);
+    }
+
+    result Queue::impl_setName(const char* name)
+    {
+        // the Queue wraps an ID3D12CommandQueue per device node, they all share the name
+        for (auto* ptr : m_ptrs)
+        {
+            const result r = detail::setObjectName(static_cast<ID3D12CommandQueue*>(ptr), name);
+            if (r != result::Success)
+                return r;
+        }
+
+        return result::Success;
+    }
+
+    result CommandGroup::impl_setName(const char* name)
+    {
+        const result r = detail::setObjectName(static_cast<ID3D12CommandAllocator*>(m_ptr), name);
+        if (r != result::Success || m_indirectPtr == nullptr)
+            return r;
+
+        return detail::setObjectName(static_cast<ID3D12CommandAllocator*>(m_indirectPtr), name);
+    }
+
+    result CommandList::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<ID3D12GraphicsCommandList*>(m_ptr), name);
+    }
+
+    result Fence::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<ID3D12Fence*>(m_ptr), name);
+    }
+
+    result Semaphore::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<ID3D12Fence*>(m_ptr), name);
+    }
+
+    result Resource::impl_setName(const char* name)
+    {
+        // committed resources own their heap, so naming the resource covers its memory as well
+        return detail::setObjectName(static_cast<ID3D12Resource*>(m_resource), name);
+    }
+
+    result Pipeline::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<ID3D12PipelineState*>(m_ptr), name);
+    }
+
+    result PipelineCache::impl_setName(const char* name)
+    {
+        // without ID3D12PipelineLibrary support the cache has no native object to name
+        if (m_ptr == nullptr)
+            return result::Success;
+
+        return detail::setObjectName(static_cast<ID3D12PipelineLibrary*>(m_ptr), name);
+    }
+
+    result QueryPool::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<ID3D12QueryHeap*>(m_ptr), name);
+    }
+}
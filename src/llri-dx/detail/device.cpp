@@ -65,6 +65,7 @@ namespace llri
         output->m_counter = 0;
         output->m_event = CreateEvent(nullptr, false, false, nullptr);
         output->m_ptr = dx12Fence;
+        output->m_device = this;
 
         if ((flags & fence_flag_bits::Signaled) == fence_flag_bits::Signaled)
             output->m_signaled = true;
@@ -84,7 +85,7 @@ namespace llri
         delete fence;
     }
 
-    result Device::impl_waitFences(uint32_t numFences, Fence** fences, uint64_t timeout)
+    result Device::impl_waitFences(uint32_t numFences, Fence** fences, uint64_t timeout, bool waitAny)
     {
         std::vector<void*> events;
 
@@ -95,17 +96,24 @@ namespace llri
 
             if (dx12Fence->GetCompletedValue() < fence->m_counter)
             {
+                // an earlier wait for any fence may have left the event set
+                ResetEvent(fence->m_event);
+
                 const auto r = dx12Fence->SetEventOnCompletion(fence->m_counter, fence->m_event);
                 if (FAILED(r))
                     return detail::mapHRESULT(r);
 
                 events.push_back(fence->m_event);
             }
+            else if (waitAny)
+            {
+                return result::Success;
+            }
         }
 
         if (!events.empty())
         {
-            const auto r = WaitForMultipleObjects(static_cast<DWORD>(events.size()), events.data(), true, static_cast<DWORD>(timeout)); // windows takes the timeout in ms so we can pass it directly
+            const auto r = WaitForMultipleObjects(static_cast<DWORD>(events.size()), events.data(), !waitAny, static_cast<DWORD>(timeout)); // windows takes the timeout in ms so we can pass it directly
 
             if (r == WAIT_TIMEOUT)
                 return result::Timeout;
@@ -114,25 +122,30 @@ namespace llri
                 return result::ErrorUnknown;
         }
 
-        for (size_t i = 0; i < numFences; i++)
-            fences[i]->m_signaled = false;
+        return result::Success;
+    }
 
+    result Device::impl_resetFences([[maybe_unused]] uint32_t numFences, [[maybe_unused]] Fence** fences)
+    {
+        // DX12 fences only increase, resetting them is done by signaling the next value
         return result::Success;
     }
 
-    result Device::impl_createSemaphore(Semaphore** semaphore)
+    result Device::impl_createSemaphore(const semaphore_desc& desc, Semaphore** semaphore)
     {
         // in the DX12 implementation, Semaphores are represented by DX12 Fences
         // DX12 Fences are more general purpose than some other implementations
         // but in LLRI this behaviour is split
+        // Binary Semaphores increment their value upon each signal, Timeline Semaphores use the fence value directly
 
         ID3D12Fence* dx12Fence;
-        const auto r = static_cast<ID3D12Device*>(m_ptr)->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&dx12Fence));
+        const auto r = static_cast<ID3D12Device*>(m_ptr)->CreateFence(desc.initialValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&dx12Fence));
         if (FAILED(r))
             return detail::mapHRESULT(r);
 
         auto* output = new Semaphore();
         output->m_ptr = dx12Fence;
+        output->m_device = this;
 
         *semaphore = output;
         return result::Success;
@@ -146,6 +159,117 @@ namespace llri
         delete semaphore;
     }
 
+    result Device::impl_waitSemaphores(uint32_t numSemaphores, Semaphore** semaphores, const uint64_t* values, uint64_t timeout, bool waitAny)
+    {
+        ID3D12Device1* device1;
+        HRESULT r = static_cast<ID3D12Device*>(m_ptr)->QueryInterface(IID_PPV_ARGS(&device1));
+        if (FAILED(r))
+            return detail::mapHRESULT(r);
+
+        std::vector<ID3D12Fence*> dx12Fences(numSemaphores);
+        for (size_t i = 0; i < numSemaphores; i++)
+            dx12Fences[i] = static_cast<ID3D12Fence*>(semaphores[i]->m_ptr);
+
+        void* event = CreateEvent(nullptr, false, false, nullptr);
+        r = device1->SetEventOnMultipleFenceCompletion(dx12Fences.data(), values, numSemaphores, waitAny ? D3D12_MULTIPLE_FENCE_WAIT_FLAG_ANY : D3D12_MULTIPLE_FENCE_WAIT_FLAG_ALL, event);
+        device1->Release();
+
+        if (FAILED(r))
+        {
+            CloseHandle(event);
+            return detail::mapHRESULT(r);
+        }
+
+        const DWORD wait = WaitForSingleObject(event, static_cast<DWORD>(timeout)); // windows takes the timeout in ms so we can pass it directly
+        CloseHandle(event);
+
+        if (wait == WAIT_TIMEOUT)
+            return result::Timeout;
+
+        if (wait == WAIT_FAILED)
+            return result::ErrorUnknown;
+
+        return result::Success;
+    }
+
+    result Device::impl_createQueryPool(const query_pool_desc& desc, QueryPool** queryPool)
+    {
+        const UINT nodeMask = desc.nodeMask == 0 ? 1 : desc.nodeMask;
+        // pipeline statistics queries always write all counters, regardless of which ones were selected
+        const uint32_t resultSize = desc.type == query_type::PipelineStatistics ? static_cast<uint32_t>(sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS)) : static_cast<uint32_t>(sizeof(uint64_t));
+
+        const D3D12_QUERY_HEAP_DESC heapDesc { detail::mapQueryHeapType(desc.type), desc.count, nodeMask };
+        ID3D12QueryHeap* heap = nullptr;
+        HRESULT r = static_cast<ID3D12Device*>(m_ptr)->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&heap));
+        if (FAILED(r))
+            return detail::mapHRESULT(r);
+
+        // query heaps can't be read by the host, so the queries are also resolved into a readback buffer for QueryPool::getResults()
+        const D3D12_HEAP_PROPERTIES heapProperties { D3D12_HEAP_TYPE_READBACK, D3D12_CPU_PAGE_PROPERTY_UNKNOWN, D3D12_MEMORY_POOL_UNKNOWN, nodeMask, nodeMask };
+
+        D3D12_RESOURCE_DESC bufferDesc {};
+        bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        bufferDesc.Alignment = 0;
+        bufferDesc.Width = static_cast<UINT64>(desc.count) * resultSize;
+        bufferDesc.Height = 1;
+        bufferDesc.DepthOrArraySize = 1;
+        bufferDesc.MipLevels = 1;
+        bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+        bufferDesc.SampleDesc = { 1, 0 };
+        bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        bufferDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        ID3D12Resource* readback = nullptr;
+        r = static_cast<ID3D12Device*>(m_ptr)->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&readback));
+        if (FAILED(r))
+        {
+            heap->Release();
+            return detail::mapHRESULT(r);
+        }
+
+        auto* output = new QueryPool();
+        output->m_ptr = heap;
+        output->m_device = this;
+        output->m_deviceHandle = m_ptr;
+        output->m_desc = desc;
+        output->m_resultSize = resultSize;
+        output->m_validationCallbackMessenger = m_validationCallbackMessenger;
+        output->m_readback = readback;
+
+        *queryPool = output;
+        return result::Success;
+    }
+
+    void Device::impl_destroyQueryPool(QueryPool* queryPool)
+    {
+        if (queryPool->m_readback)
+            static_cast<ID3D12Resource*>(queryPool->m_readback)->Release();
+
+        if (queryPool->m_ptr)
+            static_cast<ID3D12QueryHeap*>(queryPool->m_ptr)->Release();
+
+        delete queryPool;
+    }
+
+    peer_memory_feature_flags Device::impl_queryPeerMemoryFeatures([[maybe_unused]] uint8_t localNode, [[maybe_unused]] uint8_t remoteNode)
+    {
+        D3D12_FEATURE_DATA_D3D12_OPTIONS options {};
+        if (FAILED(static_cast<ID3D12Device*>(m_ptr)->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options))))
+            return peer_memory_feature_flag_bits::None;
+
+        // the cross node sharing tier applies to every pair of nodes, tier 1 only allows copies
+        switch (options.CrossNodeSharingTier)
+        {
+            case D3D12_CROSS_NODE_SHARING_TIER_NOT_SUPPORTED:
+                return peer_memory_feature_flag_bits::None;
+            case D3D12_CROSS_NODE_SHARING_TIER_1_EMULATED:
+            case D3D12_CROSS_NODE_SHARING_TIER_1:
+                return peer_memory_feature_flag_bits::CopySrc | peer_memory_feature_flag_bits::CopyDst;
+            default:
+                return peer_memory_feature_flag_bits::All;
+        }
+    }
+
     result Device::impl_createResource(const resource_desc& desc, Resource** resource)
     {
         const bool isTexture = desc.type != resource_type::Buffer;
@@ -175,16 +299,284 @@ namespace llri
         if (FAILED(r))
             return detail::mapHRESULT(r);
 
+        // textures that can be rendered to get a descriptor heap with a view of their first mip level and array layer, which is used in CommandList::beginRendering()
+        ID3D12DescriptorHeap* attachmentView = nullptr;
+        if (desc.type == resource_type::Texture2D && desc.usage.any(resource_usage_flag_bits::ColorAttachment | resource_usage_flag_bits::DepthStencilAttachment))
+        {
+            const bool isDepthStencil = desc.usage.contains(resource_usage_flag_bits::DepthStencilAttachment);
+            const bool isMultisampled = desc.sampleCount > sample_count::Count1;
+            const bool isArray = desc.depthOrArrayLayers > 1;
+
+            const D3D12_DESCRIPTOR_HEAP_DESC heapDesc { isDepthStencil ? D3D12_DESCRIPTOR_HEAP_TYPE_DSV : D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 1, D3D12_DESCRIPTOR_HEAP_FLAG_NONE, desc.createNodeMask };
+            const auto hr = static_cast<ID3D12Device*>(m_ptr)->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&attachmentView));
+            if (FAILED(hr))
+            {
+                dx12Resource->Release();
+                return detail::mapHRESULT(hr);
+            }
+
+            const D3D12_CPU_DESCRIPTOR_HANDLE handle = attachmentView->GetCPUDescriptorHandleForHeapStart();
+            if (isDepthStencil)
+            {
+                D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc {};
+                dsvDesc.Format = dx12Desc.Format;
+                dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
+                if (isMultisampled && isArray)
+                {
+                    dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DMSARRAY;
+                    dsvDesc.Texture2DMSArray = D3D12_TEX2DMS_ARRAY_DSV { 0, 1 };
+                }
+                else if (isMultisampled)
+                {
+                    dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DMS;
+                }
+                else if (isArray)
+                {
+                    dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
+                    dsvDesc.Texture2DArray = D3D12_TEX2D_ARRAY_DSV { 0, 0, 1 };
+                }
+                else
+                {
+                    dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+                    dsvDesc.Texture2D = D3D12_TEX2D_DSV { 0 };
+                }
+
+                static_cast<ID3D12Device*>(m_ptr)->CreateDepthStencilView(dx12Resource, &dsvDesc, handle);
+            }
+            else
+            {
+                D3D12_RENDER_TARGET_VIEW_DESC rtvDesc {};
+                rtvDesc.Format = dx12Desc.Format;
+                if (isMultisampled && isArray)
+                {
+                    rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY;
+                    rtvDesc.Texture2DMSArray = D3D12_TEX2DMS_ARRAY_RTV { 0, 1 };
+                }
+                else if (isMultisampled)
+                {
+                    rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DMS;
+                }
+                else if (isArray)
+                {
+                    rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
+                    rtvDesc.Texture2DArray = D3D12_TEX2D_ARRAY_RTV { 0, 0, 1, 0 };
+                }
+                else
+                {
+                    rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
+                    rtvDesc.Texture2D = D3D12_TEX2D_RTV { 0, 0 };
+                }
+
+                static_cast<ID3D12Device*>(m_ptr)->CreateRenderTargetView(dx12Resource, &rtvDesc, handle);
+            }
+        }
+
         auto* output = new Resource();
         output->m_desc = desc;
         output->m_resource = dx12Resource;
+        output->m_device = this;
+        output->m_attachmentView = attachmentView;
         *resource = output;
         return result::Success;
     }
 
     void Device::impl_destroyResource(Resource* resource)
     {
+        if (resource->m_attachmentView)
+            static_cast<ID3D12DescriptorHeap*>(resource->m_attachmentView)->Release();
+
         static_cast<ID3D12Resource*>(resource->m_resource)->Release();
         delete resource;
     }
+
+    result Device::impl_createPipelineCache(const pipeline_cache_desc& desc, PipelineCache** cache)
+    {
+        auto* output = new PipelineCache();
+        output->m_device = this;
+        output->m_deviceHandle = m_ptr;
+        output->m_validationCallbackMessenger = m_validationCallbackMessenger;
+
+        // pipeline libraries require ID3D12Device1, if it's not available the cache is left empty and every pipeline is compiled
+        ID3D12Device1* device1 = nullptr;
+        if (FAILED(static_cast<ID3D12Device*>(m_ptr)->QueryInterface(IID_PPV_ARGS(&device1))))
+        {
+            *cache = output;
+            return result::Success;
+        }
+
+        // the library references the data for its entire lifetime so it must be copied
+        const auto* data = static_cast<const uint8_t*>(desc.data);
+        output->m_initialData.assign(data, data + desc.dataSize);
+
+        ID3D12PipelineLibrary* library = nullptr;
+        HRESULT r = device1->CreatePipelineLibrary(output->m_initialData.data(), output->m_initialData.size(), IID_PPV_ARGS(&library));
+
+        // the driver rejected the data (e.g. the driver or adapter changed), retry with an empty library
+        if (r == D3D12_ERROR_DRIVER_VERSION_MISMATCH || r == D3D12_ERROR_ADAPTER_NOT_FOUND || r == E_INVALIDARG)
+        {
+            output->m_initialData.clear();
+            r = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&library));
+        }
+        device1->Release();
+
+        if (r == DXGI_ERROR_UNSUPPORTED)
+        {
+            // the OS or driver doesn't support pipeline libraries
+            output->m_initialData.clear();
+            *cache = output;
+            return result::Success;
+        }
+
+        if (FAILED(r))
+        {
+            delete output;
+            return detail::mapHRESULT(r);
+        }
+
+        output->m_ptr = library;
+        output->m_initialDataUsed = !output->m_initialData.empty();
+        *cache = output;
+        return result::Success;
+    }
+
+    void Device::impl_destroyPipelineCache(PipelineCache* cache)
+    {
+        if (cache->m_ptr)
+            static_cast<ID3D12PipelineLibrary*>(cache->m_ptr)->Release();
+
+        delete cache;
+    }
+
+    result Device::impl_createGraphicsPipeline(const graphics_pipeline_desc& desc, Pipeline** pipeline)
+    {
+        // vertex input, attributes use the TEXCOORD semantic with their location as the semantic index
+        std::vector<D3D12_INPUT_ELEMENT_DESC> inputElements(desc.numVertexAttributes);
+        for (size_t i = 0; i < desc.numVertexAttributes; i++)
+        {
+            const auto& attribute = desc.vertexAttributes[i];
+
+            vertex_input_rate inputRate = vertex_input_rate::Vertex;
+            for (size_t j = 0; j < desc.numVertexBindings; j++)
+            {
+                if (desc.vertexBindings[j].binding == attribute.binding)
+                    inputRate = desc.vertexBindings[j].inputRate;
+            }
+
+            inputElements[i] = D3D12_INPUT_ELEMENT_DESC {
+                "TEXCOORD", attribute.location, detail::mapTextureFormat(attribute.format), attribute.binding, attribute.offset,
+                inputRate == vertex_input_rate::Instance ? D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA : D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
+                inputRate == vertex_input_rate::Instance ? 1u : 0u
+            };
+        }
+
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc {};
+        psoDesc.pRootSignature = static_cast<ID3D12RootSignature*>(m_pushConstantLayouts[static_cast<size_t>(shader_stage_flag_bits::All)]);
+        psoDesc.VS = D3D12_SHADER_BYTECODE { desc.vertexShader.bytecode, desc.vertexShader.size };
+        psoDesc.PS = D3D12_SHADER_BYTECODE { desc.fragmentShader.size > 0 ? desc.fragmentShader.bytecode : nullptr, desc.fragmentShader.size };
+
+        psoDesc.BlendState.AlphaToCoverageEnable = FALSE;
+        psoDesc.BlendState.IndependentBlendEnable = TRUE;
+        for (size_t i = 0; i < desc.numColorAttachments; i++)
+        {
+            const auto& attachment = desc.colorAttachments[i];
+            auto& target = psoDesc.BlendState.RenderTarget[i];
+            target.BlendEnable = attachment.blendEnable;
+            target.LogicOpEnable = FALSE;
+            target.SrcBlend = attachment.blendEnable ? detail::mapBlendFactor(attachment.srcColorFactor) : D3D12_BLEND_ONE;
+            target.DestBlend = attachment.blendEnable ? detail::mapBlendFactor(attachment.dstColorFactor) : D3D12_BLEND_ZERO;
+            target.BlendOp = attachment.blendEnable ? detail::mapBlendOp(attachment.colorOp) : D3D12_BLEND_OP_ADD;
+            target.SrcBlendAlpha = attachment.blendEnable ? detail::mapBlendFactor(attachment.srcAlphaFactor) : D3D12_BLEND_ONE;
+            target.DestBlendAlpha = attachment.blendEnable ? detail::mapBlendFactor(attachment.dstAlphaFactor) : D3D12_BLEND_ZERO;
+            target.BlendOpAlpha = attachment.blendEnable ? detail::mapBlendOp(attachment.alphaOp) : D3D12_BLEND_OP_ADD;
+            target.LogicOp = D3D12_LOGIC_OP_NOOP;
+            target.RenderTargetWriteMask = detail::mapColorComponents(attachment.writeMask);
+
+            psoDesc.RTVFormats[i] = detail::mapTextureFormat(attachment.format);
+        }
+        psoDesc.NumRenderTargets = desc.numColorAttachments;
+        psoDesc.SampleMask = UINT_MAX;
+
+        psoDesc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+        psoDesc.RasterizerState.CullMode = detail::mapCullMode(desc.rasterizer.cullMode);
+        psoDesc.RasterizerState.FrontCounterClockwise = desc.rasterizer.frontFace == front_face::CounterClockwise;
+        psoDesc.RasterizerState.DepthBias = desc.rasterizer.depthBias;
+        psoDesc.RasterizerState.DepthBiasClamp = 0.0f;
+        psoDesc.RasterizerState.SlopeScaledDepthBias = desc.rasterizer.depthBiasSlopeScale;
+        psoDesc.RasterizerState.DepthClipEnable = TRUE;
+        psoDesc.RasterizerState.MultisampleEnable = desc.sampleCount > sample_count::Count1;
+        psoDesc.RasterizerState.AntialiasedLineEnable = FALSE;
+        psoDesc.RasterizerState.ForcedSampleCount = 0;
+        psoDesc.RasterizerState.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
+
+        if (desc.depthStencilFormat != format::Undefined)
+        {
+            const auto mapStencilFace = [](const stencil_op_desc& face)
+            {
+                return D3D12_DEPTH_STENCILOP_DESC { detail::mapStencilOp(face.failOp), detail::mapStencilOp(face.depthFailOp), detail::mapStencilOp(face.passOp), detail::mapCompareOp(face.compareOp) };
+            };
+
+            psoDesc.DepthStencilState.DepthEnable = desc.depthStencil.depthTestEnable;
+            psoDesc.DepthStencilState.DepthWriteMask = desc.depthStencil.depthWriteEnable ? D3D12_DEPTH_WRITE_MASK_ALL : D3D12_DEPTH_WRITE_MASK_ZERO;
+            psoDesc.DepthStencilState.DepthFunc = detail::mapCompareOp(desc.depthStencil.depthCompareOp);
+            psoDesc.DepthStencilState.StencilEnable = desc.depthStencil.stencilTestEnable;
+            psoDesc.DepthStencilState.StencilReadMask = desc.depthStencil.stencilReadMask;
+            psoDesc.DepthStencilState.StencilWriteMask = desc.depthStencil.stencilWriteMask;
+            if (desc.depthStencil.stencilTestEnable)
+            {
+                psoDesc.DepthStencilState.FrontFace = mapStencilFace(desc.depthStencil.front);
+                psoDesc.DepthStencilState.BackFace = mapStencilFace(desc.depthStencil.back);
+            }
+            psoDesc.DSVFormat = detail::mapTextureFormat(desc.depthStencilFormat);
+        }
+
+        psoDesc.InputLayout = D3D12_INPUT_LAYOUT_DESC { inputElements.data(), desc.numVertexAttributes };
+        psoDesc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+        psoDesc.PrimitiveTopologyType = detail::mapPrimitiveTopologyType(desc.topology);
+        psoDesc.SampleDesc = DXGI_SAMPLE_DESC { static_cast<UINT>(desc.sampleCount), 0 };
+        psoDesc.NodeMask = 0;
+        psoDesc.CachedPSO = D3D12_CACHED_PIPELINE_STATE { nullptr, 0 };
+        psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+        ID3D12PipelineState* pso = nullptr;
+        HRESULT r = E_FAIL;
+
+        // pipeline libraries store pipelines by name, so the pipeline is named after a hash of its description
+        auto* library = desc.cache ? static_cast<ID3D12PipelineLibrary*>(desc.cache->m_ptr) : nullptr;
+        const std::wstring name = library ? std::to_wstring(detail::hashGraphicsPipelineDesc(desc)) : std::wstring();
+        if (library)
+            r = library->LoadGraphicsPipeline(name.c_str(), &psoDesc, IID_PPV_ARGS(&pso));
+
+        if (FAILED(r))
+        {
+            r = static_cast<ID3D12Device*>(m_ptr)->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pso));
+            if (FAILED(r))
+                return detail::mapHRESULT(r);
+
+            // failing to store the pipeline only means that it's compiled again next time
+            if (library)
+                library->StorePipeline(name.c_str(), pso);
+        }
+
+        auto* output = new Pipeline();
+        output->m_ptr = pso;
+        output->m_device = this;
+        output->m_topology = desc.topology;
+        output->m_pushConstantStages = desc.pushConstantStages;
+        for (size_t i = 0; i < desc.numVertexBindings; i++)
+        {
+            const auto& binding = desc.vertexBindings[i];
+            if (output->m_vertexStrides.size() <= binding.binding)
+                output->m_vertexStrides.resize(binding.binding + 1, 0);
+            output->m_vertexStrides[binding.binding] = binding.stride;
+        }
+
+        *pipeline = output;
+        return result::Success;
+    }
+
+    void Device::impl_destroyPipeline(Pipeline* pipeline)
+    {
+        static_cast<ID3D12PipelineState*>(pipeline->m_ptr)->Release();
+        delete pipeline;
+    }
 }
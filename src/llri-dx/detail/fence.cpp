@@ -0,0 +1,22 @@
+/**
+ * @file fence.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-dx/directx.hpp>
+
+namespace llri
+{
+    result Fence::impl_getStatus() const
+    {
+        const uint64_t completed = static_cast<ID3D12Fence*>(m_ptr)->GetCompletedValue();
+
+        // GetCompletedValue() returns UINT64_MAX when the device is removed
+        if (completed == std::numeric_limits<uint64_t>::max())
+            return result::ErrorDeviceRemoved;
+
+        return completed >= m_counter ? result::Success : result::NotReady;
+    }
+}
@@ -97,6 +97,13 @@ namespace llri
                         extensionCreateResult = result::Success;
                         break;
                     }
+                    case instance_extension::DebugLabels:
+                    {
+                        // object names and PIX events are always available
+                        output->m_debugLabels = true;
+                        extensionCreateResult = result::Success;
+                        break;
+                    }
                     default:
                     {
                         extensionCreateResult = result::ErrorExtensionNotSupported;
@@ -274,6 +281,7 @@ namespace llri
         output->m_desc = desc;
         output->m_adapter = desc.adapter;
         output->m_validationCallbackMessenger = m_validationCallbackMessenger;
+        output->m_debugLabels = m_debugLabels;
         output->m_ptr = dx12Device;
 
         if (m_shouldConstructValidationCallbackMessenger)
@@ -329,6 +337,11 @@ namespace llri
             queue->m_device = output;
             queue->m_ptrs = queues;
             queue->m_fences = fences;
+
+            // copy queues require a separate query heap type for timestamps, which LLRI doesn't expose
+            UINT64 timestampFrequency = 0;
+            if (queueDesc.type != queue_type::Transfer && SUCCEEDED(static_cast<ID3D12CommandQueue*>(queues[0])->GetTimestampFrequency(&timestampFrequency)) && timestampFrequency > 0)
+                queue->m_timestampPeriod = 1000000000.0 / static_cast<double>(timestampFrequency);
             queue->m_validationCallbackMessenger = output->m_validationCallbackMessenger;
 
             switch(queueDesc.type)
@@ -351,6 +364,33 @@ namespace llri
             }
         }
 
+        // create the root signature that is used for push constants
+        D3D12_ROOT_PARAMETER pushConstantParameter {};
+        pushConstantParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+        pushConstantParameter.Constants = D3D12_ROOT_CONSTANTS { 0, 0, detail::maxPushConstantSize / 4 };
+        pushConstantParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+        const D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc { 1, &pushConstantParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT };
+
+        ID3DBlob* rootSignatureBlob = nullptr;
+        r = detail::D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &rootSignatureBlob, nullptr);
+        if (FAILED(r))
+        {
+            destroyDevice(output);
+            return detail::mapHRESULT(r);
+        }
+
+        ID3D12RootSignature* rootSignature = nullptr;
+        const UINT allNodes = (1u << desc.adapter->m_nodeCount) - 1u;
+        r = dx12Device->CreateRootSignature(allNodes, rootSignatureBlob->GetBufferPointer(), rootSignatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature));
+        rootSignatureBlob->Release();
+        if (FAILED(r))
+        {
+            destroyDevice(output);
+            return detail::mapHRESULT(r);
+        }
+        output->m_pushConstantLayouts[static_cast<size_t>(shader_stage_flag_bits::All)] = rootSignature;
+
         *device = output;
         return result::Success;
     }
@@ -396,6 +436,9 @@ namespace llri
             delete transfer;
         }
 
+        if (device->m_pushConstantLayouts[static_cast<size_t>(shader_stage_flag_bits::All)])
+            static_cast<ID3D12RootSignature*>(device->m_pushConstantLayouts[static_cast<size_t>(shader_stage_flag_bits::All)])->Release();
+
         if (device->m_validationCallbackMessenger)
             static_cast<ID3D12InfoQueue*>(device->m_validationCallbackMessenger)->Release();
 
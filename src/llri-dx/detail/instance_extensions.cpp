@@ -41,6 +41,8 @@ namespace llri
                     return false;
                 case instance_extension::SurfaceXcb:
                     return false;
+                case instance_extension::DebugLabels:
+                    return true;
             }
 
             return false;
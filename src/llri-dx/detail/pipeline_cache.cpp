@@ -0,0 +1,29 @@
+/**
+ * @file pipeline_cache.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-dx/directx.hpp>
+
+namespace llri
+{
+    result PipelineCache::impl_serialize(std::vector<uint8_t>* data) const
+    {
+        // without a pipeline library there is nothing to serialize
+        if (!m_ptr)
+            return result::Success;
+
+        auto* library = static_cast<ID3D12PipelineLibrary*>(m_ptr);
+        const size_t offset = data->size();
+        const size_t size = library->GetSerializedSize();
+
+        data->resize(offset + size);
+        const auto r = library->Serialize(data->data() + offset, size);
+        if (FAILED(r))
+            return detail::mapHRESULT(r);
+
+        return result::Success;
+    }
+}
@@ -0,0 +1,60 @@
+/**
+ * @file query_pool.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-dx/directx.hpp>
+
+namespace llri
+{
+    result QueryPool::impl_getResults(uint32_t firstQuery, uint32_t numQueries, uint64_t* results) const
+    {
+        auto* readback = static_cast<ID3D12Resource*>(m_readback);
+
+        const D3D12_RANGE readRange { static_cast<SIZE_T>(firstQuery) * sizeof(uint64_t), static_cast<SIZE_T>(firstQuery + numQueries) * sizeof(uint64_t) };
+        void* data = nullptr;
+        const auto r = readback->Map(0, &readRange, &data);
+        if (FAILED(r))
+            return detail::mapHRESULT(r);
+
+        std::memcpy(results, static_cast<const uint64_t*>(data) + firstQuery, numQueries * sizeof(uint64_t));
+
+        // nothing was written by the host
+        const D3D12_RANGE writtenRange { 0, 0 };
+        readback->Unmap(0, &writtenRange);
+        return result::Success;
+    }
+
+    result QueryPool::impl_getResults(uint32_t firstQuery, uint32_t numQueries, pipeline_statistics* results) const
+    {
+        auto* readback = static_cast<ID3D12Resource*>(m_readback);
+
+        const D3D12_RANGE readRange { static_cast<SIZE_T>(firstQuery) * m_resultSize, static_cast<SIZE_T>(firstQuery + numQueries) * m_resultSize };
+        void* data = nullptr;
+        const auto r = readback->Map(0, &readRange, &data);
+        if (FAILED(r))
+            return detail::mapHRESULT(r);
+
+        const auto* statistics = static_cast<const D3D12_QUERY_DATA_PIPELINE_STATISTICS*>(data) + firstQuery;
+        const auto select = [this](pipeline_statistic_flag_bits bit, UINT64 value) -> uint64_t { return m_desc.pipelineStatistics.contains(bit) ? value : 0; };
+
+        // DirectX12 always collects all counters, the ones that weren't selected are cleared to match Vulkan
+        for (uint32_t i = 0; i < numQueries; i++)
+        {
+            results[i].inputAssemblyVertices = select(pipeline_statistic_flag_bits::InputAssemblyVertices, statistics[i].IAVertices);
+            results[i].inputAssemblyPrimitives = select(pipeline_statistic_flag_bits::InputAssemblyPrimitives, statistics[i].IAPrimitives);
+            results[i].vertexShaderInvocations = select(pipeline_statistic_flag_bits::VertexShaderInvocations, statistics[i].VSInvocations);
+            results[i].clippingInvocations = select(pipeline_statistic_flag_bits::ClippingInvocations, statistics[i].CInvocations);
+            results[i].clippingPrimitives = select(pipeline_statistic_flag_bits::ClippingPrimitives, statistics[i].CPrimitives);
+            results[i].fragmentShaderInvocations = select(pipeline_statistic_flag_bits::FragmentShaderInvocations, statistics[i].PSInvocations);
+            results[i].computeShaderInvocations = select(pipeline_statistic_flag_bits::ComputeShaderInvocations, statistics[i].CSInvocations);
+        }
+
+        // nothing was written by the host
+        const D3D12_RANGE writtenRange { 0, 0 };
+        readback->Unmap(0, &writtenRange);
+        return result::Success;
+    }
+}
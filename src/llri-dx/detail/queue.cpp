@@ -9,48 +9,76 @@
 
 namespace llri
 {
-    result Queue::impl_submit(const submit_desc& desc)
+    result Queue::impl_submit(uint32_t numDescs, const submit_desc* descs, const uint64_t* fenceValues)
     {
         HRESULT r;
-        unsigned long index;
 
-        if (desc.nodeMask != 0)
-            _BitScanForward64(&index, desc.nodeMask);
-        else
-            index = 0;
+        // Background Queues resolve the values of binary semaphores and fences when the submission is enqueued, because the counters are shared with the threads that submit and wait
+        const bool resolvedValues = m_desc.submitMode == queue_submit_mode::Background;
 
-        // add wait semaphores to queue
-        for (size_t i = 0; i < desc.numWaitSemaphores; i++)
+        // CommandLists are passed through a small inline buffer, only unusually large batches allocate memory
+        std::array<ID3D12CommandList*, 32> inlineLists;
+        std::vector<ID3D12CommandList*> heapLists;
+
+        for (size_t d = 0; d < numDescs; d++)
         {
-            r = static_cast<ID3D12CommandQueue*>(m_ptrs[index])->Wait(static_cast<ID3D12Fence*>(desc.waitSemaphores[i]->m_ptr), desc.waitSemaphores[i]->m_counter);
-            if (FAILED(r))
-                return detail::mapHRESULT(r);
-        }
+            const submit_desc& desc = descs[d];
 
-        // submit
-        std::vector<ID3D12CommandList*> lists(desc.numCommandLists);
-        for (size_t i = 0; i < desc.numCommandLists; i++)
-            lists[i] = static_cast<ID3D12CommandList*>(desc.commandLists[i]->m_ptr);
+            unsigned long index;
+            if (desc.nodeMask != 0)
+                _BitScanForward64(&index, desc.nodeMask);
+            else
+                index = 0;
 
-        static_cast<ID3D12CommandQueue*>(m_ptrs[index])->ExecuteCommandLists(desc.numCommandLists, lists.data());
+            auto* queue = static_cast<ID3D12CommandQueue*>(m_ptrs[index]);
 
-        // add signal semaphores to queue
-        for (size_t i = 0; i < desc.numSignalSemaphores; i++)
-        {
-            // NOTE: the convention is that we increase the counter upon signaling, all wait operations will use this counter without modifying it.
-            r = static_cast<ID3D12CommandQueue*>(m_ptrs[index])->Signal(static_cast<ID3D12Fence*>(desc.signalSemaphores[i]->m_ptr), ++desc.signalSemaphores[i]->m_counter);
-            if (FAILED(r))
-                return detail::mapHRESULT(r);
-        }
+            // add wait semaphores to queue
+            for (size_t i = 0; i < desc.numWaitSemaphores; i++)
+            {
+                auto* semaphore = desc.waitSemaphores[i];
+                const uint64_t value = semaphore->m_type == semaphore_type::Timeline || resolvedValues ? desc.waitSemaphoreValues[i] : semaphore->m_counter;
 
-        // signal fence
-        if (desc.fence)
-        {
-            r = static_cast<ID3D12CommandQueue*>(m_ptrs[index])->Signal(static_cast<ID3D12Fence*>(desc.fence->m_ptr), ++desc.fence->m_counter);
-            if (FAILED(r))
-                return detail::mapHRESULT(r);
+                r = queue->Wait(static_cast<ID3D12Fence*>(semaphore->m_ptr), value);
+                if (FAILED(r))
+                    return detail::mapHRESULT(r);
+            }
+
+            // submit
+            // resource state tracking submits without CommandLists to signal its internal fences
+            if (desc.numCommandLists > 0)
+            {
+                ID3D12CommandList** lists = inlineLists.data();
+                if (desc.numCommandLists > inlineLists.size())
+                {
+                    heapLists.resize(desc.numCommandLists);
+                    lists = heapLists.data();
+                }
+
+                for (size_t i = 0; i < desc.numCommandLists; i++)
+                    lists[i] = static_cast<ID3D12CommandList*>(desc.commandLists[i]->m_ptr);
+
+                queue->ExecuteCommandLists(desc.numCommandLists, lists);
+            }
+
+            // add signal semaphores to queue
+            for (size_t i = 0; i < desc.numSignalSemaphores; i++)
+            {
+                // NOTE: the convention is that we increase the counter of binary semaphores upon signaling, all wait operations will use this counter without modifying it.
+                auto* semaphore = desc.signalSemaphores[i];
+                const uint64_t value = semaphore->m_type == semaphore_type::Timeline || resolvedValues ? desc.signalSemaphoreValues[i] : ++semaphore->m_counter;
+
+                r = queue->Signal(static_cast<ID3D12Fence*>(semaphore->m_ptr), value);
+                if (FAILED(r))
+                    return detail::mapHRESULT(r);
+            }
 
-            desc.fence->m_signaled = true;
+            // signal fence
+            if (desc.fence)
+            {
+                r = queue->Signal(static_cast<ID3D12Fence*>(desc.fence->m_ptr), fenceValues ? fenceValues[d] : ++desc.fence->m_counter);
+                if (FAILED(r))
+                    return detail::mapHRESULT(r);
+            }
         }
 
         return result::Success;
@@ -0,0 +1,28 @@
+/**
+ * @file semaphore.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-dx/directx.hpp>
+
+namespace llri
+{
+    result Semaphore::impl_signal(uint64_t value)
+    {
+        const HRESULT r = static_cast<ID3D12Fence*>(m_ptr)->Signal(value);
+        return detail::mapHRESULT(r);
+    }
+
+    result Semaphore::impl_getValue(uint64_t* value) const
+    {
+        *value = static_cast<ID3D12Fence*>(m_ptr)->GetCompletedValue();
+
+        // GetCompletedValue() returns UINT64_MAX when the device is removed
+        if (*value == std::numeric_limits<uint64_t>::max())
+            return result::ErrorDeviceRemoved;
+
+        return result::Success;
+    }
+}
@@ -35,6 +35,7 @@ namespace llri
         inline HMODULE d3d12 = nullptr;
         inline PFN_D3D12_CREATE_DEVICE D3D12CreateDevice = nullptr;
         inline PFN_D3D12_GET_DEBUG_INTERFACE D3D12GetDebugInterface = nullptr;
+        inline PFN_D3D12_SERIALIZE_ROOT_SIGNATURE D3D12SerializeRootSignature = nullptr;
 
         inline void lazyInitializeDirectX()
         {
@@ -53,9 +54,15 @@ namespace llri
             {
                 D3D12CreateDevice = (PFN_D3D12_CREATE_DEVICE)GetProcAddress(d3d12, "D3D12CreateDevice");
                 D3D12GetDebugInterface = (PFN_D3D12_GET_DEBUG_INTERFACE)GetProcAddress(d3d12, "D3D12GetDebugInterface");
+                D3D12SerializeRootSignature = (PFN_D3D12_SERIALIZE_ROOT_SIGNATURE)GetProcAddress(d3d12, "D3D12SerializeRootSignature");
             }
         }
 
+        /**
+         * @brief The number of bytes that are reserved for push constants in the internal root signature.
+        */
+        constexpr uint32_t maxPushConstantSize = 128;
+
         /**
          * @brief Function that maps an HRESULT to an llri::result.
         */
@@ -102,6 +109,11 @@ namespace llri
             return result::ErrorUnknown;
         }
 
+        /**
+         * @brief Attaches a debug name to a DirectX12 object, the UTF-8 name is widened for ID3D12Object::SetName().
+        */
+        result setObjectName(ID3D12Object* object, const char* name);
+
         constexpr D3D12_COMMAND_LIST_TYPE mapCommandGroupType(queue_type type)
         {
             switch (type)
@@ -290,6 +302,32 @@ namespace llri
             throw;
         }
 
+        constexpr D3D12_QUERY_HEAP_TYPE mapQueryHeapType(query_type type)
+        {
+            switch(type)
+            {
+                case query_type::Timestamp:
+                    return D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+                case query_type::PipelineStatistics:
+                    return D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
+            }
+
+            throw;
+        }
+
+        constexpr D3D12_QUERY_TYPE mapQueryType(query_type type)
+        {
+            switch(type)
+            {
+                case query_type::Timestamp:
+                    return D3D12_QUERY_TYPE_TIMESTAMP;
+                case query_type::PipelineStatistics:
+                    return D3D12_QUERY_TYPE_PIPELINE_STATISTICS;
+            }
+
+            throw;
+        }
+
         constexpr D3D12_HEAP_TYPE mapResourceMemoryType(memory_type memory)
         {
             switch(memory)
@@ -304,5 +342,255 @@ namespace llri
 
             throw;
         }
+
+        constexpr D3D_PRIMITIVE_TOPOLOGY mapPrimitiveTopology(primitive_topology topology)
+        {
+            switch(topology)
+            {
+                case primitive_topology::PointList:
+                    return D3D_PRIMITIVE_TOPOLOGY_POINTLIST;
+                case primitive_topology::LineList:
+                    return D3D_PRIMITIVE_TOPOLOGY_LINELIST;
+                case primitive_topology::LineStrip:
+                    return D3D_PRIMITIVE_TOPOLOGY_LINESTRIP;
+                case primitive_topology::TriangleList:
+                    return D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+                case primitive_topology::TriangleStrip:
+                    return D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+            }
+
+            throw;
+        }
+
+        constexpr D3D12_PRIMITIVE_TOPOLOGY_TYPE mapPrimitiveTopologyType(primitive_topology topology)
+        {
+            switch(topology)
+            {
+                case primitive_topology::PointList:
+                    return D3D12_PRIMITIVE_TOPOLOGY_TYPE_POINT;
+                case primitive_topology::LineList:
+                case primitive_topology::LineStrip:
+                    return D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE;
+                case primitive_topology::TriangleList:
+                case primitive_topology::TriangleStrip:
+                    return D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+            }
+
+            throw;
+        }
+
+        constexpr D3D12_CULL_MODE mapCullMode(cull_mode mode)
+        {
+            switch(mode)
+            {
+                case cull_mode::None:
+                    return D3D12_CULL_MODE_NONE;
+                case cull_mode::Front:
+                    return D3D12_CULL_MODE_FRONT;
+                case cull_mode::Back:
+                    return D3D12_CULL_MODE_BACK;
+            }
+
+            throw;
+        }
+
+        constexpr D3D12_COMPARISON_FUNC mapCompareOp(compare_op op)
+        {
+            switch(op)
+            {
+                case compare_op::Never:
+                    return D3D12_COMPARISON_FUNC_NEVER;
+                case compare_op::Less:
+                    return D3D12_COMPARISON_FUNC_LESS;
+                case compare_op::Equal:
+                    return D3D12_COMPARISON_FUNC_EQUAL;
+                case compare_op::LessOrEqual:
+                    return D3D12_COMPARISON_FUNC_LESS_EQUAL;
+                case compare_op::Greater:
+                    return D3D12_COMPARISON_FUNC_GREATER;
+                case compare_op::NotEqual:
+                    return D3D12_COMPARISON_FUNC_NOT_EQUAL;
+                case compare_op::GreaterOrEqual:
+                    return D3D12_COMPARISON_FUNC_GREATER_EQUAL;
+                case compare_op::Always:
+                    return D3D12_COMPARISON_FUNC_ALWAYS;
+            }
+
+            throw;
+        }
+
+        constexpr D3D12_STENCIL_OP mapStencilOp(stencil_op op)
+        {
+            switch(op)
+            {
+                case stencil_op::Keep:
+                    return D3D12_STENCIL_OP_KEEP;
+                case stencil_op::Zero:
+                    return D3D12_STENCIL_OP_ZERO;
+                case stencil_op::Replace:
+                    return D3D12_STENCIL_OP_REPLACE;
+                case stencil_op::IncrementAndClamp:
+                    return D3D12_STENCIL_OP_INCR_SAT;
+                case stencil_op::DecrementAndClamp:
+                    return D3D12_STENCIL_OP_DECR_SAT;
+                case stencil_op::Invert:
+                    return D3D12_STENCIL_OP_INVERT;
+                case stencil_op::IncrementAndWrap:
+                    return D3D12_STENCIL_OP_INCR;
+                case stencil_op::DecrementAndWrap:
+                    return D3D12_STENCIL_OP_DECR;
+            }
+
+            throw;
+        }
+
+        constexpr D3D12_BLEND mapBlendFactor(blend_factor factor)
+        {
+            switch(factor)
+            {
+                case blend_factor::Zero:
+                    return D3D12_BLEND_ZERO;
+                case blend_factor::One:
+                    return D3D12_BLEND_ONE;
+                case blend_factor::SrcColor:
+                    return D3D12_BLEND_SRC_COLOR;
+                case blend_factor::OneMinusSrcColor:
+                    return D3D12_BLEND_INV_SRC_COLOR;
+                case blend_factor::DstColor:
+                    return D3D12_BLEND_DEST_COLOR;
+                case blend_factor::OneMinusDstColor:
+                    return D3D12_BLEND_INV_DEST_COLOR;
+                case blend_factor::SrcAlpha:
+                    return D3D12_BLEND_SRC_ALPHA;
+                case blend_factor::OneMinusSrcAlpha:
+                    return D3D12_BLEND_INV_SRC_ALPHA;
+                case blend_factor::DstAlpha:
+                    return D3D12_BLEND_DEST_ALPHA;
+                case blend_factor::OneMinusDstAlpha:
+                    return D3D12_BLEND_INV_DEST_ALPHA;
+            }
+
+            throw;
+        }
+
+        constexpr D3D12_BLEND_OP mapBlendOp(blend_op op)
+        {
+            switch(op)
+            {
+                case blend_op::Add:
+                    return D3D12_BLEND_OP_ADD;
+                case blend_op::Subtract:
+                    return D3D12_BLEND_OP_SUBTRACT;
+                case blend_op::ReverseSubtract:
+                    return D3D12_BLEND_OP_REV_SUBTRACT;
+                case blend_op::Min:
+                    return D3D12_BLEND_OP_MIN;
+                case blend_op::Max:
+                    return D3D12_BLEND_OP_MAX;
+            }
+
+            throw;
+        }
+
+        constexpr UINT8 mapColorComponents(color_component_flags components)
+        {
+            UINT8 output = 0;
+
+            if (components.contains(color_component_flag_bits::R))
+                output |= D3D12_COLOR_WRITE_ENABLE_RED;
+            if (components.contains(color_component_flag_bits::G))
+                output |= D3D12_COLOR_WRITE_ENABLE_GREEN;
+            if (components.contains(color_component_flag_bits::B))
+                output |= D3D12_COLOR_WRITE_ENABLE_BLUE;
+            if (components.contains(color_component_flag_bits::A))
+                output |= D3D12_COLOR_WRITE_ENABLE_ALPHA;
+
+            return output;
+        }
+
+        constexpr DXGI_FORMAT mapIndexType(index_type type)
+        {
+            return type == index_type::UInt16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+        }
+
+        /**
+         * @brief Hashes the parts of a graphics_pipeline_desc that affect compilation, which is used to name pipelines in pipeline libraries.
+         * Fields are hashed individually because the desc contains pointers and padding.
+        */
+        inline uint64_t hashGraphicsPipelineDesc(const graphics_pipeline_desc& desc)
+        {
+            uint64_t hash = 0xcbf29ce484222325;
+            constexpr uint64_t prime = 0x00000100000001b3;
+
+            const auto hashBytes = [&hash](const void* data, size_t size)
+            {
+                for (size_t i = 0; i < size; i++)
+                {
+                    hash = hash ^ static_cast<const uint8_t*>(data)[i];
+                    hash *= prime;
+                }
+            };
+            const auto hashValue = [&hashBytes](auto value) { hashBytes(&value, sizeof(value)); };
+
+            hashBytes(desc.vertexShader.bytecode, desc.vertexShader.size);
+            hashValue(desc.fragmentShader.size);
+            hashBytes(desc.fragmentShader.bytecode, desc.fragmentShader.size);
+            hashValue(desc.topology);
+
+            for (size_t i = 0; i < desc.numVertexBindings; i++)
+            {
+                hashValue(desc.vertexBindings[i].binding);
+                hashValue(desc.vertexBindings[i].inputRate);
+            }
+
+            for (size_t i = 0; i < desc.numVertexAttributes; i++)
+            {
+                hashValue(desc.vertexAttributes[i].location);
+                hashValue(desc.vertexAttributes[i].binding);
+                hashValue(desc.vertexAttributes[i].format);
+                hashValue(desc.vertexAttributes[i].offset);
+            }
+
+            hashValue(desc.rasterizer.cullMode);
+            hashValue(desc.rasterizer.frontFace);
+            hashValue(desc.rasterizer.depthBias);
+            hashValue(desc.rasterizer.depthBiasSlopeScale);
+
+            hashValue(desc.depthStencilFormat);
+            if (desc.depthStencilFormat != format::Undefined)
+            {
+                const auto& ds = desc.depthStencil;
+                hashValue(ds.depthTestEnable);
+                hashValue(ds.depthWriteEnable);
+                hashValue(ds.depthCompareOp);
+                hashValue(ds.stencilTestEnable);
+                hashValue(ds.stencilReadMask);
+                hashValue(ds.stencilWriteMask);
+                for (const auto& face : { ds.front, ds.back })
+                {
+                    hashValue(face.failOp);
+                    hashValue(face.passOp);
+                    hashValue(face.depthFailOp);
+                    hashValue(face.compareOp);
+                }
+            }
+
+            for (size_t i = 0; i < desc.numColorAttachments; i++)
+            {
+                const auto& attachment = desc.colorAttachments[i];
+                hashValue(attachment.format);
+                hashValue(attachment.blendEnable);
+                hashValue(attachment.srcColorFactor);
+                hashValue(attachment.dstColorFactor);
+                hashValue(attachment.colorOp);
+                hashValue(attachment.srcAlphaFactor);
+                hashValue(attachment.dstAlphaFactor);
+                hashValue(attachment.alphaOp);
+                hashValue(attachment.writeMask.value);
+            }
+
+            hashValue(desc.sampleCount);
+            return hash;
+        }
     }
 }
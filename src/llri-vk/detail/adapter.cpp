@@ -40,6 +40,7 @@ namespace llri
         adapter_info info{};
         info.vendorId = properties.vendorID;
         info.adapterId = properties.deviceID;
+        info.driverVersion = properties.driverVersion;
         info.adapterName = properties.deviceName;
         info.adapterType = detail::mapPhysicalDeviceType(properties.deviceType);
         return info;
@@ -53,13 +54,31 @@ namespace llri
         adapter_features features{};
 
         // Set all the information in a structured way here
+        features.pipelineStatisticsQuery = physicalFeatures.pipelineStatisticsQuery;
+
+        // timeline semaphores are core in Vulkan 1.2, LLRI uses the KHR extension so that 1.1 drivers can support them too
+        if (vkGetPhysicalDeviceFeatures2 && detail::queryDeviceExtensionSupport(static_cast<VkPhysicalDevice>(m_ptr), VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+        {
+            VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR, nullptr, VK_FALSE };
+            VkPhysicalDeviceFeatures2 features2 { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, &timelineFeatures, {} };
+            vkGetPhysicalDeviceFeatures2(static_cast<VkPhysicalDevice>(m_ptr), &features2);
+
+            features.timelineSemaphores = timelineFeatures.timelineSemaphore;
+        }
 
         return features;
     }
 
     adapter_limits Adapter::impl_queryLimits() const
     {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(static_cast<VkPhysicalDevice>(m_ptr), &properties);
+
         adapter_limits output{};
+        output.maxPushConstantSize = properties.limits.maxPushConstantsSize;
+        output.maxColorAttachments = std::min(properties.limits.maxColorAttachments, detail::maxColorAttachments);
+        output.maxVertexInputBindings = properties.limits.maxVertexInputBindings;
+        output.maxVertexInputAttributes = properties.limits.maxVertexInputAttributes;
         return output;
     }
 
@@ -143,45 +162,32 @@ namespace llri
 
     uint8_t Adapter::impl_queryQueueCount(queue_type type) const
     {
+        auto queueFamilies = detail::findQueueFamilies(static_cast<VkPhysicalDevice>(m_ptr));
+        if (queueFamilies[type] == std::numeric_limits<uint32_t>::max())
+            return 0;
+
         // Get queue family info
         uint32_t propertyCount;
         vkGetPhysicalDeviceQueueFamilyProperties(static_cast<VkPhysicalDevice>(m_ptr), &propertyCount, nullptr);
         std::vector<VkQueueFamilyProperties> properties(propertyCount);
         vkGetPhysicalDeviceQueueFamilyProperties(static_cast<VkPhysicalDevice>(m_ptr), &propertyCount, properties.data());
 
-        for (auto p : properties)
-        {
-            switch(type)
-            {
-                case queue_type::Graphics:
-                {
-                    // Only the graphics queue has the graphics bit set
-                    // it usually also has compute & transfer set, because graphics queue tends to be general purpose
-                    if ((p.queueFlags & VK_QUEUE_GRAPHICS_BIT) == VK_QUEUE_GRAPHICS_BIT)
-                        return static_cast<uint8_t>(p.queueCount);
-                    break;
-                }
-                case queue_type::Compute:
-                {
-                    // Dedicated compute family has no graphics bit but does have a compute bit
-                    if ((p.queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0 &&
-                        (p.queueFlags & VK_QUEUE_COMPUTE_BIT) == VK_QUEUE_COMPUTE_BIT)
-                        return static_cast<uint8_t>(p.queueCount);
-                    break;
-                }
-                case queue_type::Transfer:
-                {
-                    // Dedicated transfer family has no graphics bit, no compute bit, but does have a transfer bit
-                    if ((p.queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0 &&
-                        (p.queueFlags & VK_QUEUE_COMPUTE_BIT) == 0 &&
-                        (p.queueFlags & VK_QUEUE_TRANSFER_BIT) == VK_QUEUE_TRANSFER_BIT)
-                        return static_cast<uint8_t>(p.queueCount);
-                    break;
-                }
-            }
-        }
-        
-        return 0;
+        // queue types that share a family also share its queues, Instance::createDevice() spreads them across the family's queues
+        return static_cast<uint8_t>(std::min<uint32_t>(properties[queueFamilies[type]].queueCount, std::numeric_limits<uint8_t>::max()));
+    }
+
+    queue_type Adapter::impl_queryQueueFamilyType(queue_type type) const
+    {
+        auto queueFamilies = detail::findQueueFamilies(static_cast<VkPhysicalDevice>(m_ptr));
+        if (queueFamilies[type] == std::numeric_limits<uint32_t>::max())
+            return type;
+
+        // the most general queue_type that maps to the same family owns it
+        if (queueFamilies[type] == queueFamilies[queue_type::Graphics])
+            return queue_type::Graphics;
+        if (queueFamilies[type] == queueFamilies[queue_type::Compute])
+            return queue_type::Compute;
+        return type;
     }
 
     std::unordered_map<format, format_properties> Adapter::impl_queryFormatProperties() const
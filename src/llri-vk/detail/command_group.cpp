@@ -9,17 +9,25 @@
 
 namespace llri
 {
-    result CommandGroup::impl_reset()
+    result CommandGroup::impl_reset(command_group_reset_mode mode)
     {
+        const VkCommandPoolResetFlags flags = mode == command_group_reset_mode::ReleaseMemory ? VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT : 0;
         const auto r = static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
-            vkResetCommandPool(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkCommandPool>(m_ptr), VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT);
+            vkResetCommandPool(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkCommandPool>(m_ptr), flags);
 
         if (r != VK_SUCCESS)
             return detail::mapVkResult(r);
 
         for (auto* cmdList : m_cmdLists)
+        {
             cmdList->m_state = command_list_state::Empty;
 
+            // framebuffers that were created for the list's rendering scopes are no longer in use
+            for (void* framebuffer : cmdList->m_framebuffers)
+                static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkDestroyFramebuffer(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkFramebuffer>(framebuffer), nullptr);
+            cmdList->m_framebuffers.clear();
+        }
+
         return result::Success;
     }
 
@@ -99,6 +107,11 @@ namespace llri
         static_cast<VolkDeviceTable*>(m_deviceFunctionTable)
             ->vkFreeCommandBuffers(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkCommandPool>(m_ptr), 1, &buffer);
 
+        for (void* framebuffer : cmdList->m_framebuffers)
+            static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkDestroyFramebuffer(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkFramebuffer>(framebuffer), nullptr);
+        for (void* event : cmdList->m_events)
+            static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkDestroyEvent(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkEvent>(event), nullptr);
+
         // Remove from commandlist list
         m_cmdLists.erase(cmdList);
 
@@ -120,6 +133,11 @@ namespace llri
 
         for (size_t i = 0; i < numCommandLists; i++)
         {
+            for (void* framebuffer : cmdLists[i]->m_framebuffers)
+                static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkDestroyFramebuffer(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkFramebuffer>(framebuffer), nullptr);
+            for (void* event : cmdLists[i]->m_events)
+                static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkDestroyEvent(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkEvent>(event), nullptr);
+
             // Remove from commandlist list
             m_cmdLists.erase(cmdLists[i]);
 
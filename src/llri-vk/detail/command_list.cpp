@@ -10,17 +10,107 @@
 
 namespace llri
 {
-    result CommandList::impl_begin([[maybe_unused]] const command_list_begin_desc& desc)
+    namespace detail
     {
-        // TODO: Handle nodemask
-        // TODO: Handle inheritance/indirect
-        VkCommandBufferBeginInfo info { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, {}, nullptr };
-        
-        const auto r = static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
-            vkBeginCommandBuffer(static_cast<VkCommandBuffer>(m_ptr), &info);
+        /**
+         * @brief Converts a single barrier to the VkDependencyInfoKHR that VK_KHR_synchronization2 uses for split barriers.
+         * The stage and access flags of synchronization2 share their values with the original flags.
+        */
+        struct split_barrier_dependency
+        {
+            VkBufferMemoryBarrier2KHR buffer {};
+            VkImageMemoryBarrier2KHR image {};
+            VkDependencyInfoKHR info {};
+
+            split_barrier_dependency(const VkBufferMemoryBarrier* bufferBarrier, const VkImageMemoryBarrier* imageBarrier, VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages)
+            {
+                info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+
+                if (bufferBarrier)
+                {
+                    buffer = VkBufferMemoryBarrier2KHR {
+                        VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR, nullptr,
+                        srcStages, bufferBarrier->srcAccessMask,
+                        dstStages, bufferBarrier->dstAccessMask,
+                        bufferBarrier->srcQueueFamilyIndex, bufferBarrier->dstQueueFamilyIndex,
+                        bufferBarrier->buffer, bufferBarrier->offset, bufferBarrier->size
+                    };
+                    info.bufferMemoryBarrierCount = 1;
+                    info.pBufferMemoryBarriers = &buffer;
+                }
+
+                if (imageBarrier)
+                {
+                    image = VkImageMemoryBarrier2KHR {
+                        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR, nullptr,
+                        srcStages, imageBarrier->srcAccessMask,
+                        dstStages, imageBarrier->dstAccessMask,
+                        imageBarrier->oldLayout, imageBarrier->newLayout,
+                        imageBarrier->srcQueueFamilyIndex, imageBarrier->dstQueueFamilyIndex,
+                        imageBarrier->image, imageBarrier->subresourceRange
+                    };
+                    info.imageMemoryBarrierCount = 1;
+                    info.pImageMemoryBarriers = &image;
+                }
+            }
+
+            // info points into this object, so it can't be copied or moved
+            split_barrier_dependency(const split_barrier_dependency&) = delete;
+            split_barrier_dependency& operator=(const split_barrier_dependency&) = delete;
+        };
+    }
+
+    result CommandList::impl_begin(const command_list_begin_desc& desc)
+    {
+        auto* table = static_cast<VolkDeviceTable*>(m_deviceFunctionTable);
+
+        VkCommandBufferBeginInfo info { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, detail::mapCommandListSubmitMode(desc.submitMode), nullptr };
+
+        // in a device group, the CommandList only records for its own node, Queue::submit() selects the same node to execute it
+        VkDeviceGroupCommandBufferBeginInfo deviceGroupInfo { VK_STRUCTURE_TYPE_DEVICE_GROUP_COMMAND_BUFFER_BEGIN_INFO, nullptr, detail::mapNodeMask(m_desc.nodeMask) };
+        if (m_group->m_device->m_adapter->queryNodeCount() > 1)
+            info.pNext = &deviceGroupInfo;
+        m_numUsedEvents = 0;
+        VkCommandBufferInheritanceInfo inheritanceInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO, nullptr, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, VK_FALSE, {}, {} };
+
+        if (m_desc.usage == command_list_usage::Indirect)
+        {
+            info.pInheritanceInfo = &inheritanceInfo;
+
+            if (desc.inheritance)
+            {
+                // render passes are compatible regardless of their load and store operations, so any cached render pass with the same formats can be used
+                detail::render_pass_key key {};
+                key.numColorAttachments = static_cast<uint8_t>(desc.inheritance->numColorAttachments);
+                key.sampleCount = desc.inheritance->sampleCount;
+                for (size_t i = 0; i < desc.inheritance->numColorAttachments; i++)
+                    key.attachments[i] = detail::render_pass_attachment { desc.inheritance->colorFormats[i], attachment_load_op::Load, attachment_store_op::Store };
+                key.attachments[detail::maxColorAttachments] = detail::render_pass_attachment { desc.inheritance->depthStencilFormat, attachment_load_op::Load, attachment_store_op::Store };
+
+                const auto r = detail::getRenderPass(static_cast<VkDevice>(m_deviceHandle), table, static_cast<detail::render_pass_cache*>(m_group->m_device->m_renderPassCache), key, &inheritanceInfo.renderPass);
+                if (r != VK_SUCCESS)
+                    return detail::mapVkResult(r);
+
+                info.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+            }
+        }
+
+        const auto r = table->vkBeginCommandBuffer(static_cast<VkCommandBuffer>(m_ptr), &info);
         if (r != VK_SUCCESS)
             return detail::mapVkResult(r);
 
+        // dynamic state isn't inherited by secondary command buffers
+        if (desc.inheritance)
+        {
+            const rect_2d& area = desc.inheritance->area;
+            const VkRect2D scissor { { area.offset.x, area.offset.y }, { area.extent.width, area.extent.height } };
+            const VkViewport vp { static_cast<float>(area.offset.x), static_cast<float>(area.offset.y), static_cast<float>(area.extent.width), static_cast<float>(area.extent.height), 0.0f, 1.0f };
+
+            table->vkCmdSetViewport(static_cast<VkCommandBuffer>(m_ptr), 0, 1, &vp);
+            table->vkCmdSetScissor(static_cast<VkCommandBuffer>(m_ptr), 0, 1, &scissor);
+            table->vkCmdSetStencilReference(static_cast<VkCommandBuffer>(m_ptr), VK_STENCIL_FACE_FRONT_AND_BACK, desc.inheritance->stencilReference);
+        }
+
         m_state = command_list_state::Recording;
         return result::Success;
     }
@@ -38,157 +128,463 @@ namespace llri
 
     result CommandList::impl_resourceBarrier(uint32_t numBarriers, const resource_barrier* barriers)
     {
-        uint32_t numMemBarriers = 0, numBufBarriers = 0, numImgBarriers = 0;
-        
-        std::vector<VkMemoryBarrier> memoryBarriers(numBarriers);
-        std::vector<VkBufferMemoryBarrier> bufferBarriers(numBarriers);
-        std::vector<VkImageMemoryBarrier> imageBarriers(numBarriers);
+        auto* table = static_cast<VolkDeviceTable*>(m_deviceFunctionTable);
+        auto cmd = static_cast<VkCommandBuffer>(m_ptr);
+        const VkPipelineStageFlags supportedStages = detail::getSupportedPipelineStages(m_group->m_type);
+
+        // barriers are translated in fixed size batches on the stack, so that no memory is allocated
+        constexpr size_t batchSize = 32;
+        std::array<VkBufferMemoryBarrier, batchSize> bufferBarriers;
+        std::array<VkImageMemoryBarrier, batchSize> imageBarriers;
+        uint32_t numBufBarriers = 0, numImgBarriers = 0;
+        VkPipelineStageFlags srcStages = 0, dstStages = 0;
+
+        const auto flush = [&]()
+        {
+            if (numBufBarriers == 0 && numImgBarriers == 0)
+                return;
+
+            table->vkCmdPipelineBarrier(cmd,
+                                        srcStages, dstStages,
+                                        //TODO: Expose dependency for better optimization control.
+                                        VK_DEPENDENCY_BY_REGION_BIT,
+                                        0, nullptr,
+                                        numBufBarriers, bufferBarriers.data(),
+                                        numImgBarriers, imageBarriers.data());
+
+            numBufBarriers = numImgBarriers = 0;
+            srcStages = dstStages = 0;
+        };
+
+        // explicit stages are used as-is, stages derived from states are limited to the stages that the queue supports
+        const auto getStages = [supportedStages](pipeline_stage_flags stages, resource_state state) -> VkPipelineStageFlags
+        {
+            if (stages != pipeline_stage_flag_bits::None)
+                return detail::mapPipelineStages(stages);
+
+            const VkPipelineStageFlags derived = detail::mapStateToPipelineStage(state) & supportedStages;
+            return derived != 0 ? derived : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        };
         
         for (size_t i = 0; i < numBarriers; i++)
         {
-            auto& barrier = barriers[i];
-            
-            Resource* resource = nullptr;
-            switch(barrier.type)
+            if (numBufBarriers == batchSize || numImgBarriers == batchSize)
+                flush();
+
+            const auto& barrier = barriers[i];
+            const bool isTransition = barrier.type == resource_barrier_type::Transition;
+
+            // ReadWrite barriers synchronize shader access to a resource that stays in the ShaderReadWrite state
+            const Resource* resource = isTransition ? barrier.trans.resource : barrier.rw.resource;
+            const resource_state oldState = isTransition ? barrier.trans.oldState : resource_state::ShaderReadWrite;
+            const resource_state newState = isTransition ? barrier.trans.newState : resource_state::ShaderReadWrite;
+            const auto& resourceDesc = resource->m_desc;
+            const bool isBuffer = resourceDesc.type == resource_type::Buffer;
+
+            VkPipelineStageFlags barrierSrcStages = getStages(barrier.srcStages, oldState);
+            VkPipelineStageFlags barrierDstStages = getStages(barrier.dstStages, newState);
+            VkAccessFlags srcAccess = detail::mapStateToAccess(oldState);
+            VkAccessFlags dstAccess = detail::mapStateToAccess(newState);
+            uint32_t srcFamily = VK_QUEUE_FAMILY_IGNORED;
+            uint32_t dstFamily = VK_QUEUE_FAMILY_IGNORED;
+
+            if (barrier.ownershipTransfer != queue_ownership_transfer::None)
             {
-                case resource_barrier_type::Transition:
-                    resource = barrier.trans.resource;
-                    break;
-                case resource_barrier_type::ReadWrite:
-                    resource = barrier.rw.resource;
-                    break;
+                const uint32_t family = m_group->m_device->m_queueFamilies[static_cast<size_t>(m_group->m_type)];
+                const uint32_t otherFamily = m_group->m_device->m_queueFamilies[static_cast<size_t>(barrier.ownershipQueue)];
+
+                if (family == otherFamily)
+                {
+                    // queue types that share a family don't transfer ownership, the Semaphore between the two barriers already synchronizes the queues
+                    if (!detail::executesOwnershipTransition(barrier, m_group->m_type) || oldState == newState)
+                        continue;
+                }
+                else if (barrier.ownershipTransfer == queue_ownership_transfer::Release)
+                {
+                    // the destination scope of a release is ignored, it's completed by the acquire on the other family
+                    srcFamily = family;
+                    dstFamily = otherFamily;
+                    barrierDstStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+                    dstAccess = 0;
+                }
+                else
+                {
+                    // the source scope of an acquire is ignored, it's completed by the release on the other family
+                    srcFamily = otherFamily;
+                    dstFamily = family;
+                    barrierSrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+                    srcAccess = 0;
+                }
             }
-            
-            auto resourceDesc = resource->getDesc();
-            
-            if (resourceDesc.type == resource_type::Buffer)
+
+            VkBufferMemoryBarrier bufferBarrier;
+            VkImageMemoryBarrier imgBarrier;
+            if (isBuffer)
             {
-                VkBufferMemoryBarrier bufferBarrier {};
                 bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
                 bufferBarrier.pNext = nullptr;
-                
-                switch(barrier.type)
-                {
-                    case resource_barrier_type::Transition:
-                    {
-                        bufferBarrier.srcAccessMask = detail::mapStateToAccess(barrier.trans.oldState);
-                        bufferBarrier.dstAccessMask = detail::mapStateToAccess(barrier.trans.newState);
-                        break;
-                    }
-                    case resource_barrier_type::ReadWrite:
-                    {
-                        bufferBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
-                        bufferBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
-                        break;
-                    }
-                }
-                
-                bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                
+                bufferBarrier.srcAccessMask = srcAccess;
+                bufferBarrier.dstAccessMask = dstAccess;
+                bufferBarrier.srcQueueFamilyIndex = srcFamily;
+                bufferBarrier.dstQueueFamilyIndex = dstFamily;
                 bufferBarrier.buffer = static_cast<VkBuffer>(resource->m_resource);
                 bufferBarrier.offset = 0;
-                bufferBarrier.size = resourceDesc.width;
-                
-                bufferBarriers[numBufBarriers++] = bufferBarrier;
+                bufferBarrier.size = VK_WHOLE_SIZE;
             }
             else
             {
-                VkImageMemoryBarrier imgBarrier {};
                 imgBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
                 imgBarrier.pNext = nullptr;
-                imgBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                imgBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imgBarrier.srcAccessMask = srcAccess;
+                imgBarrier.dstAccessMask = dstAccess;
+                imgBarrier.oldLayout = detail::mapResourceState(oldState);
+                imgBarrier.newLayout = detail::mapResourceState(newState);
+                imgBarrier.srcQueueFamilyIndex = srcFamily;
+                imgBarrier.dstQueueFamilyIndex = dstFamily;
                 imgBarrier.image = static_cast<VkImage>(resource->m_resource);
-                
-                switch(barrier.type)
-                {
-                    case resource_barrier_type::Transition:
-                    {
-                        imgBarrier.oldLayout = detail::mapResourceState(barrier.trans.oldState);
-                        imgBarrier.newLayout = detail::mapResourceState(barrier.trans.newState);
-                        
-                        imgBarrier.srcAccessMask = detail::mapStateToAccess(barrier.trans.oldState);
-                        imgBarrier.dstAccessMask = detail::mapStateToAccess(barrier.trans.newState);
-                        break;
-                    }
-                    case resource_barrier_type::ReadWrite:
-                    {
-                        imgBarrier.oldLayout = detail::mapResourceState(resource_state::ShaderReadWrite);
-                        imgBarrier.newLayout = detail::mapResourceState(resource_state::ShaderReadWrite);
-                        
-                        imgBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
-                        imgBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
-                        break;
-                    }
-                }
-                
-                // use the texture format to detect the aspect flags
-                VkImageAspectFlags aspectFlags = {};
-                if (has_color_component(resourceDesc.textureFormat))
-                    aspectFlags |= VK_IMAGE_ASPECT_COLOR_BIT;
-                if (has_depth_component(resourceDesc.textureFormat))
-                    aspectFlags |= VK_IMAGE_ASPECT_DEPTH_BIT;
-                if (has_stencil_component(resourceDesc.textureFormat))
-                    aspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
-                
+
                 // use all subresources for readwrite barriers and if specified in transition.
-                bool allSubresources = barrier.type == resource_barrier_type::ReadWrite ||
-                    barrier.trans.subresourceRange == texture_subresource_range::all();
-                if (allSubresources)
+                if (!isTransition || barrier.trans.subresourceRange == texture_subresource_range::all())
                 {
                     // don't accidentally use depthOrArrayLayers for subresources of 3D textures
-                    if (resourceDesc.type == resource_type::Texture3D)
-                    {
-                        imgBarrier.subresourceRange = VkImageSubresourceRange {
-                            aspectFlags,
-                            0,
-                            resourceDesc.mipLevels,
-                            0,
-                            1
-                        };
-                    }
-                    else
-                    {
-                        imgBarrier.subresourceRange = VkImageSubresourceRange {
-                            aspectFlags,
-                            0,
-                            resourceDesc.mipLevels,
-                            0,
-                            resourceDesc.depthOrArrayLayers
-                        };
-                    }
+                    const uint32_t arrayLayers = resourceDesc.type == resource_type::Texture3D ? 1 : resourceDesc.depthOrArrayLayers;
+                    imgBarrier.subresourceRange = VkImageSubresourceRange { resource->m_imageAspects, 0, resourceDesc.mipLevels, 0, arrayLayers };
                 }
                 else
                 {
                     imgBarrier.subresourceRange = VkImageSubresourceRange {
-                        aspectFlags,
+                        resource->m_imageAspects,
                         barrier.trans.subresourceRange.baseMipLevel,
                         barrier.trans.subresourceRange.numMipLevels,
                         barrier.trans.subresourceRange.baseArrayLayer,
                         barrier.trans.subresourceRange.numArrayLayers
                     };
                 }
-                
-                imageBarriers[numImgBarriers++] = imgBarrier;
+            }
+
+            switch (barrier.split)
+            {
+                case resource_barrier_split::None:
+                {
+                    srcStages |= barrierSrcStages;
+                    dstStages |= barrierDstStages;
+
+                    if (isBuffer)
+                        bufferBarriers[numBufBarriers++] = bufferBarrier;
+                    else
+                        imageBarriers[numImgBarriers++] = imgBarrier;
+                    break;
+                }
+                case resource_barrier_split::BeginOnly:
+                {
+                    // events are recorded right away, so the batched barriers that precede this one in the array are recorded first to keep their order
+                    flush();
+
+                    // events are reused every time the list is recorded, they're reset when their split barrier ends
+                    if (m_numUsedEvents == m_events.size())
+                    {
+                        const VkEventCreateInfo eventInfo { VK_STRUCTURE_TYPE_EVENT_CREATE_INFO, nullptr, {} };
+                        VkEvent event;
+                        const auto r = table->vkCreateEvent(static_cast<VkDevice>(m_deviceHandle), &eventInfo, nullptr, &event);
+                        if (r != VK_SUCCESS)
+                            return detail::mapVkResult(r);
+
+                        m_events.push_back(event);
+                    }
+
+                    auto event = static_cast<VkEvent>(m_events[m_numUsedEvents++]);
+                    if (m_group->m_device->m_synchronization2)
+                    {
+                        detail::split_barrier_dependency dependency(isBuffer ? &bufferBarrier : nullptr, isBuffer ? nullptr : &imgBarrier, barrierSrcStages, barrierDstStages);
+                        table->vkCmdSetEvent2KHR(cmd, event, &dependency.info);
+                    }
+                    else
+                    {
+                        table->vkCmdSetEvent(cmd, event, barrierSrcStages);
+                    }
+
+                    m_splitBarriers.push_back(detail::split_barrier { barrier, event });
+                    break;
+                }
+                case resource_barrier_split::EndOnly:
+                {
+                    flush();
+
+                    const size_t index = findSplitBarrier(barrier);
+                    auto event = static_cast<VkEvent>(m_splitBarriers[index].event);
+
+                    if (m_group->m_device->m_synchronization2)
+                    {
+                        // the dependency must match the one that the event was set with
+                        detail::split_barrier_dependency dependency(isBuffer ? &bufferBarrier : nullptr, isBuffer ? nullptr : &imgBarrier, barrierSrcStages, barrierDstStages);
+                        table->vkCmdWaitEvents2KHR(cmd, 1, &event, &dependency.info);
+                        table->vkCmdResetEvent2KHR(cmd, event, barrierDstStages);
+                    }
+                    else
+                    {
+                        table->vkCmdWaitEvents(cmd, 1, &event, barrierSrcStages, barrierDstStages, 0, nullptr,
+                                               isBuffer ? 1 : 0, &bufferBarrier,
+                                               isBuffer ? 0 : 1, &imgBarrier);
+                        table->vkCmdResetEvent(cmd, event, barrierDstStages);
+                    }
+
+                    m_splitBarriers.erase(m_splitBarriers.begin() + static_cast<std::ptrdiff_t>(index));
+                    break;
+                }
             }
         }
-        
+
+        flush();
+        return result::Success;
+    }
+
+    result CommandList::impl_pushConstants(shader_stage_flags stageMask, uint32_t offset, uint32_t size, const void* data)
+    {
+        // push constant ranges must match the pipeline layout's stage flags exactly, so the device keeps a layout for each stage combination
+        const auto layout = static_cast<VkPipelineLayout>(m_group->m_device->m_pushConstantLayouts[static_cast<size_t>(stageMask.value)]);
+
         static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
-            vkCmdPipelineBarrier(static_cast<VkCommandBuffer>(m_ptr),
-                                 //TODO: Expose pipeline stage for better optimization control.
-                                 VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                                 VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                                 //TODO: Expose dependency for better optimization control.
-                                 VK_DEPENDENCY_BY_REGION_BIT,
-                                 numMemBarriers,
-                                 memoryBarriers.data(),
-                                 numBufBarriers,
-                                 bufferBarriers.data(),
-                                 numImgBarriers,
-                                 imageBarriers.data());
-        
+            vkCmdPushConstants(static_cast<VkCommandBuffer>(m_ptr), layout, detail::mapShaderStages(stageMask), offset, size, data);
+
         return result::Success;
     }
 
+    result CommandList::impl_beginRendering(const rendering_desc& desc)
+    {
+        auto* table = static_cast<VolkDeviceTable*>(m_deviceFunctionTable);
+        auto* device = m_group->m_device;
+
+        detail::render_pass_key key {};
+        key.numColorAttachments = static_cast<uint8_t>(desc.numColorAttachments);
+        key.sampleCount = m_renderingAttachments[0].texture->m_desc.sampleCount;
+
+        std::array<VkImageView, detail::maxColorAttachments + 1> views {};
+        std::array<VkClearValue, detail::maxColorAttachments + 1> clearValues {};
+        uint32_t width = std::numeric_limits<uint32_t>::max();
+        uint32_t height = std::numeric_limits<uint32_t>::max();
+
+        // m_renderingAttachments holds the color attachments followed by the depth stencil attachment, which matches the render pass' attachment order
+        for (size_t i = 0; i < m_numRenderingAttachments; i++)
+        {
+            const auto& attachment = m_renderingAttachments[i];
+            const bool isDepthStencil = i == desc.numColorAttachments;
+
+            key.attachments[isDepthStencil ? detail::maxColorAttachments : i] = detail::render_pass_attachment { attachment.texture->m_desc.textureFormat, attachment.loadOp, attachment.storeOp };
+            views[i] = static_cast<VkImageView>(attachment.texture->m_attachmentView);
+
+            if (isDepthStencil)
+                clearValues[i].depthStencil = VkClearDepthStencilValue { attachment.clearValue.depthStencil.depth, attachment.clearValue.depthStencil.stencil };
+            else
+                clearValues[i].color = VkClearColorValue { { attachment.clearValue.color.r, attachment.clearValue.color.g, attachment.clearValue.color.b, attachment.clearValue.color.a } };
+
+            width = std::min(width, attachment.texture->m_desc.width);
+            height = std::min(height, attachment.texture->m_desc.height);
+        }
+
+        VkRenderPass renderPass;
+        auto r = detail::getRenderPass(static_cast<VkDevice>(m_deviceHandle), table, static_cast<detail::render_pass_cache*>(device->m_renderPassCache), key, &renderPass);
+        if (r != VK_SUCCESS)
+            return detail::mapVkResult(r);
+
+        VkFramebufferCreateInfo framebufferInfo {};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.pNext = nullptr;
+        framebufferInfo.flags = {};
+        framebufferInfo.renderPass = renderPass;
+        framebufferInfo.attachmentCount = m_numRenderingAttachments;
+        framebufferInfo.pAttachments = views.data();
+        framebufferInfo.width = width;
+        framebufferInfo.height = height;
+        framebufferInfo.layers = 1;
+
+        VkFramebuffer framebuffer;
+        r = table->vkCreateFramebuffer(static_cast<VkDevice>(m_deviceHandle), &framebufferInfo, nullptr, &framebuffer);
+        if (r != VK_SUCCESS)
+            return detail::mapVkResult(r);
+        m_framebuffers.push_back(framebuffer);
+
+        const VkRect2D area { { desc.area.offset.x, desc.area.offset.y }, { desc.area.extent.width, desc.area.extent.height } };
+
+        VkRenderPassBeginInfo beginInfo {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.renderPass = renderPass;
+        beginInfo.framebuffer = framebuffer;
+        beginInfo.renderArea = area;
+        beginInfo.clearValueCount = m_numRenderingAttachments;
+        beginInfo.pClearValues = clearValues.data();
+        // scopes with indirect contents can only execute secondary command buffers, which set their own dynamic state
+        if (desc.contents == rendering_contents::IndirectLists)
+        {
+            table->vkCmdBeginRenderPass(static_cast<VkCommandBuffer>(m_ptr), &beginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            return result::Success;
+        }
+
+        table->vkCmdBeginRenderPass(static_cast<VkCommandBuffer>(m_ptr), &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+        const VkViewport vp { static_cast<float>(area.offset.x), static_cast<float>(area.offset.y), static_cast<float>(area.extent.width), static_cast<float>(area.extent.height), 0.0f, 1.0f };
+        table->vkCmdSetViewport(static_cast<VkCommandBuffer>(m_ptr), 0, 1, &vp);
+        table->vkCmdSetScissor(static_cast<VkCommandBuffer>(m_ptr), 0, 1, &area);
+
+        return result::Success;
+    }
+
+    result CommandList::impl_endRendering()
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkCmdEndRenderPass(static_cast<VkCommandBuffer>(m_ptr));
+        return result::Success;
+    }
+
+    result CommandList::impl_bindPipeline(Pipeline* pipeline)
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdBindPipeline(static_cast<VkCommandBuffer>(m_ptr), VK_PIPELINE_BIND_POINT_GRAPHICS, static_cast<VkPipeline>(pipeline->m_ptr));
+        return result::Success;
+    }
+
+    result CommandList::impl_setViewport(const viewport& vp)
+    {
+        const VkViewport viewport { vp.x, vp.y, vp.width, vp.height, vp.minDepth, vp.maxDepth };
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkCmdSetViewport(static_cast<VkCommandBuffer>(m_ptr), 0, 1, &viewport);
+        return result::Success;
+    }
+
+    result CommandList::impl_setScissor(const rect_2d& scissor)
+    {
+        const VkRect2D rect { { scissor.offset.x, scissor.offset.y }, { scissor.extent.width, scissor.extent.height } };
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkCmdSetScissor(static_cast<VkCommandBuffer>(m_ptr), 0, 1, &rect);
+        return result::Success;
+    }
+
+    result CommandList::impl_setStencilReference(uint8_t reference)
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkCmdSetStencilReference(static_cast<VkCommandBuffer>(m_ptr), VK_STENCIL_FACE_FRONT_AND_BACK, reference);
+        return result::Success;
+    }
+
+    result CommandList::impl_bindVertexBuffers(uint32_t firstBinding, uint32_t numBuffers, Resource* const* buffers, const uint64_t* offsets)
+    {
+        std::array<VkBuffer, 32> vkBuffers {};
+        std::array<VkDeviceSize, 32> vkOffsets {};
+
+        // bind in batches so that no allocations are necessary
+        for (uint32_t base = 0; base < numBuffers; base += static_cast<uint32_t>(vkBuffers.size()))
+        {
+            const uint32_t count = std::min(numBuffers - base, static_cast<uint32_t>(vkBuffers.size()));
+            for (uint32_t i = 0; i < count; i++)
+            {
+                vkBuffers[i] = static_cast<VkBuffer>(buffers[base + i]->m_resource);
+                vkOffsets[i] = offsets ? offsets[base + i] : 0;
+            }
+
+            static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+                vkCmdBindVertexBuffers(static_cast<VkCommandBuffer>(m_ptr), firstBinding + base, count, vkBuffers.data(), vkOffsets.data());
+        }
+
+        return result::Success;
+    }
+
+    result CommandList::impl_bindIndexBuffer(Resource* buffer, uint64_t offset, index_type type)
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdBindIndexBuffer(static_cast<VkCommandBuffer>(m_ptr), static_cast<VkBuffer>(buffer->m_resource), offset, detail::mapIndexType(type));
+        return result::Success;
+    }
+
+    result CommandList::impl_draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdDraw(static_cast<VkCommandBuffer>(m_ptr), vertexCount, instanceCount, firstVertex, firstInstance);
+        return result::Success;
+    }
+
+    result CommandList::impl_drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdDrawIndexed(static_cast<VkCommandBuffer>(m_ptr), indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+        return result::Success;
+    }
+
+    result CommandList::impl_executeIndirectLists(uint32_t numLists, CommandList* const* lists)
+    {
+        constexpr uint32_t batchSize = 32;
+        std::array<VkCommandBuffer, batchSize> commandBuffers;
+
+        for (uint32_t start = 0; start < numLists; start += batchSize)
+        {
+            const uint32_t count = std::min(batchSize, numLists - start);
+            for (uint32_t i = 0; i < count; i++)
+                commandBuffers[i] = static_cast<VkCommandBuffer>(lists[start + i]->m_ptr);
+
+            static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->vkCmdExecuteCommands(static_cast<VkCommandBuffer>(m_ptr), count, commandBuffers.data());
+        }
+
+        return result::Success;
+    }
+
+    result CommandList::impl_resetQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries)
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdResetQueryPool(static_cast<VkCommandBuffer>(m_ptr), static_cast<VkQueryPool>(queryPool->m_ptr), firstQuery, numQueries);
+        return result::Success;
+    }
+
+    result CommandList::impl_writeTimestamp(QueryPool* queryPool, uint32_t query)
+    {
+        // the bottom of the pipe stage is reached once all previously recorded commands have completed
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdWriteTimestamp(static_cast<VkCommandBuffer>(m_ptr), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, static_cast<VkQueryPool>(queryPool->m_ptr), query);
+        return result::Success;
+    }
+
+    result CommandList::impl_beginQuery(QueryPool* queryPool, uint32_t query)
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdBeginQuery(static_cast<VkCommandBuffer>(m_ptr), static_cast<VkQueryPool>(queryPool->m_ptr), query, {});
+        return result::Success;
+    }
+
+    result CommandList::impl_endQuery(QueryPool* queryPool, uint32_t query)
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdEndQuery(static_cast<VkCommandBuffer>(m_ptr), static_cast<VkQueryPool>(queryPool->m_ptr), query);
+        return result::Success;
+    }
+
+    result CommandList::impl_copyBuffer(Resource* src, uint64_t srcOffset, Resource* dst, uint64_t dstOffset, uint64_t size)
+    {
+        // peer memory is accessed through the create node's memory instance that the buffers were bound to in Device::createResource()
+        const VkBufferCopy region { srcOffset, dstOffset, size };
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdCopyBuffer(static_cast<VkCommandBuffer>(m_ptr), static_cast<VkBuffer>(src->m_resource), static_cast<VkBuffer>(dst->m_resource), 1, &region);
+        return result::Success;
+    }
+
+    result CommandList::impl_resolveQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries, Resource* buffer, uint64_t offset)
+    {
+        static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkCmdCopyQueryPoolResults(static_cast<VkCommandBuffer>(m_ptr), static_cast<VkQueryPool>(queryPool->m_ptr), firstQuery, numQueries,
+                static_cast<VkBuffer>(buffer->m_resource), offset, queryPool->m_resultSize, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        return result::Success;
+    }
+
+    result CommandList::impl_beginLabel(const char* name, const label_color& color)
+    {
+        const VkDebugUtilsLabelEXT label { VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT, nullptr, name, { color.r, color.g, color.b, color.a } };
+        vkCmdBeginDebugUtilsLabelEXT(static_cast<VkCommandBuffer>(m_ptr), &label);
+        return result::Success;
+    }
+
+    result CommandList::impl_endLabel()
+    {
+        vkCmdEndDebugUtilsLabelEXT(static_cast<VkCommandBuffer>(m_ptr));
+        return result::Success;
+    }
+
+    result CommandList::impl_insertLabel(const char* name, const label_color& color)
+    {
+        const VkDebugUtilsLabelEXT label { VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT, nullptr, name, { color.r, color.g, color.b, color.a } };
+        vkCmdInsertDebugUtilsLabelEXT(static_cast<VkCommandBuffer>(m_ptr), &label);
+        return result::Success;
+    }
 }
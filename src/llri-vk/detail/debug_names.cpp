@@ -0,0 +1,85 @@
+/**
+ * @file debug_names.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-vk/utils.hpp>
+#include <graphics/vulkan/volk.h>
+
+namespace llri
+{
+    namespace detail
+    {
+        result setObjectName(VkDevice device, VkObjectType type, uint64_t handle, const char* name)
+        {
+            const VkDebugUtilsObjectNameInfoEXT info { VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT, nullptr, type, handle, name };
+            return mapVkResult(vkSetDebugUtilsObjectNameEXT(device, &info));
+        }
+    }
+
+    result Device::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<VkDevice>(m_ptr), VK_OBJECT_TYPE_DEVICE, reinterpret_cast<uint64_t>(m_ptr), name);
+    }
+
+    result Queue::impl_setName(const char* name)
+    {
+        // the Queue wraps a VkQueue per device node, they all share the name
+        for (auto* ptr : m_ptrs)
+        {
+            const result r = detail::setObjectName(static_cast<VkDevice>(m_device->m_ptr), VK_OBJECT_TYPE_QUEUE, reinterpret_cast<uint64_t>(ptr), name);
+            if (r != result::Success)
+                return r;
+        }
+
+        return result::Success;
+    }
+
+    result CommandGroup::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<VkDevice>(m_device->m_ptr), VK_OBJECT_TYPE_COMMAND_POOL, reinterpret_cast<uint64_t>(m_ptr), name);
+    }
+
+    result CommandList::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<VkDevice>(m_group->m_device->m_ptr), VK_OBJECT_TYPE_COMMAND_BUFFER, reinterpret_cast<uint64_t>(m_ptr), name);
+    }
+
+    result Fence::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<VkDevice>(m_device->m_ptr), VK_OBJECT_TYPE_FENCE, reinterpret_cast<uint64_t>(m_ptr), name);
+    }
+
+    result Semaphore::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<VkDevice>(m_device->m_ptr), VK_OBJECT_TYPE_SEMAPHORE, reinterpret_cast<uint64_t>(m_ptr), name);
+    }
+
+    result Resource::impl_setName(const char* name)
+    {
+        const VkObjectType type = m_desc.type == resource_type::Buffer ? VK_OBJECT_TYPE_BUFFER : VK_OBJECT_TYPE_IMAGE;
+        const result r = detail::setObjectName(static_cast<VkDevice>(m_device->m_ptr), type, reinterpret_cast<uint64_t>(m_resource), name);
+        if (r != result::Success || m_memory == nullptr)
+            return r;
+
+        // the memory is named too so that memory captures can be traced back to their resource
+        return detail::setObjectName(static_cast<VkDevice>(m_device->m_ptr), VK_OBJECT_TYPE_DEVICE_MEMORY, reinterpret_cast<uint64_t>(m_memory), name);
+    }
+
+    result Pipeline::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<VkDevice>(m_device->m_ptr), VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(m_ptr), name);
+    }
+
+    result PipelineCache::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<VkDevice>(m_device->m_ptr), VK_OBJECT_TYPE_PIPELINE_CACHE, reinterpret_cast<uint64_t>(m_ptr), name);
+    }
+
+    result QueryPool::impl_setName(const char* name)
+    {
+        return detail::setObjectName(static_cast<VkDevice>(m_device->m_ptr), VK_OBJECT_TYPE_QUERY_POOL, reinterpret_cast<uint64_t>(m_ptr), name);
+    }
+}
@@ -17,12 +17,10 @@ namespace llri
         output->m_validationCallbackMessenger = m_validationCallbackMessenger;
         output->m_type = type;
 
-        auto families = detail::findQueueFamilies(static_cast<VkPhysicalDevice>(m_adapter->m_ptr));
-
         VkCommandPoolCreateInfo info;
         info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
         info.pNext = nullptr;
-        info.queueFamilyIndex = families[type];
+        info.queueFamilyIndex = m_queueFamilies[static_cast<size_t>(type)];
         info.flags = {};
 
         VkCommandPool pool;
@@ -75,6 +73,7 @@ namespace llri
         auto* output = new Fence();
         output->m_flags = flags;
         output->m_ptr = vkFence;
+        output->m_device = this;
         output->m_signaled = signaled;
 
         *fence = output;
@@ -92,7 +91,7 @@ namespace llri
         delete fence;
     }
 
-    result Device::impl_waitFences(uint32_t numFences, Fence** fences, uint64_t timeout)
+    result Device::impl_waitFences(uint32_t numFences, Fence** fences, uint64_t timeout, bool waitAny)
     {
         uint64_t vkTimeout = timeout;
         if (timeout != LLRI_TIMEOUT_MAX)
@@ -103,25 +102,39 @@ namespace llri
             vkFences[i] = static_cast<VkFence>(fences[i]->m_ptr);
 
         const VkResult r = static_cast<VolkDeviceTable*>(m_functionTable)->
-            vkWaitForFences(static_cast<VkDevice>(m_ptr), numFences, vkFences.data(), true, vkTimeout);
+            vkWaitForFences(static_cast<VkDevice>(m_ptr), numFences, vkFences.data(), !waitAny, vkTimeout);
 
-        if (r == VK_SUCCESS)
+        if (r == VK_SUCCESS && !waitAny)
         {
             static_cast<VolkDeviceTable*>(m_functionTable)->
                 vkResetFences(static_cast<VkDevice>(m_ptr), numFences, vkFences.data());
-
-            for (size_t i = 0; i < numFences; i++)
-                fences[i]->m_signaled = false;
         }
 
         return detail::mapVkResult(r);
     }
 
-    result Device::impl_createSemaphore(Semaphore** semaphore)
+    result Device::impl_resetFences(uint32_t numFences, Fence** fences)
+    {
+        std::vector<VkFence> vkFences(numFences);
+        for (size_t i = 0; i < numFences; i++)
+            vkFences[i] = static_cast<VkFence>(fences[i]->m_ptr);
+
+        const VkResult r = static_cast<VolkDeviceTable*>(m_functionTable)->
+            vkResetFences(static_cast<VkDevice>(m_ptr), numFences, vkFences.data());
+        return detail::mapVkResult(r);
+    }
+
+    result Device::impl_createSemaphore(const semaphore_desc& desc, Semaphore** semaphore)
     {
+        VkSemaphoreTypeCreateInfoKHR typeInfo;
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+        typeInfo.pNext = nullptr;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+        typeInfo.initialValue = desc.initialValue;
+
         VkSemaphoreCreateInfo info;
         info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-        info.pNext = nullptr;
+        info.pNext = desc.type == semaphore_type::Timeline ? &typeInfo : nullptr;
         info.flags = {};
 
         VkSemaphore vkSemaphore;
@@ -132,6 +145,7 @@ namespace llri
 
         auto* output = new Semaphore();
         output->m_ptr = vkSemaphore;
+        output->m_device = this;
 
         *semaphore = output;
         return result::Success;
@@ -148,19 +162,121 @@ namespace llri
         delete semaphore;
     }
 
+    result Device::impl_waitSemaphores(uint32_t numSemaphores, Semaphore** semaphores, const uint64_t* values, uint64_t timeout, bool waitAny)
+    {
+        uint64_t vkTimeout = timeout;
+        if (timeout != LLRI_TIMEOUT_MAX)
+            vkTimeout *= 1000000u; // milliseconds to nanoseconds
+
+        std::vector<VkSemaphore> vkSemaphores(numSemaphores);
+        for (size_t i = 0; i < numSemaphores; i++)
+            vkSemaphores[i] = static_cast<VkSemaphore>(semaphores[i]->m_ptr);
+
+        VkSemaphoreWaitInfoKHR info;
+        info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+        info.pNext = nullptr;
+        info.flags = waitAny ? VK_SEMAPHORE_WAIT_ANY_BIT_KHR : 0;
+        info.semaphoreCount = numSemaphores;
+        info.pSemaphores = vkSemaphores.data();
+        info.pValues = values;
+
+        const VkResult r = static_cast<VolkDeviceTable*>(m_functionTable)->
+            vkWaitSemaphoresKHR(static_cast<VkDevice>(m_ptr), &info, vkTimeout);
+        return detail::mapVkResult(r);
+    }
+
+    result Device::impl_createQueryPool(const query_pool_desc& desc, QueryPool** queryPool)
+    {
+        // Vulkan query pools have no node mask, they exist on every physical device in the group
+        // desc.nodeMask is still respected because the query commands only accept CommandLists with the pool's nodeMask, which only execute on that physical device
+        VkQueryPoolCreateInfo info {};
+        info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        info.pNext = nullptr;
+        info.flags = {};
+        info.queryType = detail::mapQueryType(desc.type);
+        info.queryCount = desc.count;
+        info.pipelineStatistics = desc.type == query_type::PipelineStatistics ? detail::mapPipelineStatistics(desc.pipelineStatistics) : 0;
+
+        VkQueryPool vkQueryPool;
+        const VkResult r = static_cast<VolkDeviceTable*>(m_functionTable)->
+            vkCreateQueryPool(static_cast<VkDevice>(m_ptr), &info, nullptr, &vkQueryPool);
+        if (r != VK_SUCCESS)
+            return detail::mapVkResult(r);
+
+        auto* output = new QueryPool();
+        output->m_ptr = vkQueryPool;
+        output->m_device = this;
+        output->m_deviceHandle = m_ptr;
+        output->m_deviceFunctionTable = m_functionTable;
+        output->m_desc = desc;
+        // pipeline statistics queries write one uint64_t per selected counter
+        output->m_resultSize = sizeof(uint64_t);
+        if (desc.type == query_type::PipelineStatistics)
+        {
+            output->m_resultSize = 0;
+            for (VkQueryPipelineStatisticFlags bits = info.pipelineStatistics; bits != 0; bits &= bits - 1)
+                output->m_resultSize += sizeof(uint64_t);
+        }
+        output->m_validationCallbackMessenger = m_validationCallbackMessenger;
+
+        *queryPool = output;
+        return result::Success;
+    }
+
+    void Device::impl_destroyQueryPool(QueryPool* queryPool)
+    {
+        if (queryPool->m_ptr)
+        {
+            static_cast<VolkDeviceTable*>(m_functionTable)->
+                vkDestroyQueryPool(static_cast<VkDevice>(m_ptr), static_cast<VkQueryPool>(queryPool->m_ptr), nullptr);
+        }
+
+        delete queryPool;
+    }
+
+    peer_memory_feature_flags Device::impl_queryPeerMemoryFeatures(uint8_t localNode, uint8_t remoteNode)
+    {
+        // peer memory features are queried for the heap that memory_type::Local Resources are allocated from
+        const auto physicalDevice = static_cast<VkPhysicalDevice>(m_adapter->m_ptr);
+        const uint32_t memoryTypeIndex = detail::findMemoryTypeIndex(physicalDevice, std::numeric_limits<uint32_t>::max(), detail::mapMemoryType(memory_type::Local));
+        if (memoryTypeIndex == std::numeric_limits<uint32_t>::max())
+            return peer_memory_feature_flag_bits::None;
+
+        VkPhysicalDeviceMemoryProperties memoryProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+        VkPeerMemoryFeatureFlags features = 0;
+        static_cast<VolkDeviceTable*>(m_functionTable)->
+            vkGetDeviceGroupPeerMemoryFeatures(static_cast<VkDevice>(m_ptr), memoryProperties.memoryTypes[memoryTypeIndex].heapIndex, localNode, remoteNode, &features);
+
+        peer_memory_feature_flags output = peer_memory_feature_flag_bits::None;
+        if (features & VK_PEER_MEMORY_FEATURE_COPY_SRC_BIT)
+            output |= peer_memory_feature_flag_bits::CopySrc;
+        if (features & VK_PEER_MEMORY_FEATURE_COPY_DST_BIT)
+            output |= peer_memory_feature_flag_bits::CopyDst;
+        if (features & VK_PEER_MEMORY_FEATURE_GENERIC_SRC_BIT)
+            output |= peer_memory_feature_flag_bits::GenericSrc;
+        if (features & VK_PEER_MEMORY_FEATURE_GENERIC_DST_BIT)
+            output |= peer_memory_feature_flag_bits::GenericDst;
+        return output;
+    }
+
     result Device::impl_createResource(const resource_desc& desc, Resource** resource)
     {
         auto* table = static_cast<VolkDeviceTable*>(m_functionTable);
         
         const bool isTexture = desc.type != resource_type::Buffer;
 
-        // get all valid queue families
-        const auto& families = detail::findQueueFamilies(static_cast<VkPhysicalDevice>(m_adapter->m_ptr));
-        std::vector<uint32_t> familyIndices;
-        for (const auto& [key, family] : families)
+        // concurrent resources are shared by all valid queue families, exclusive resources are owned by one family at a time
+        std::array<uint32_t, static_cast<size_t>(queue_type::MaxEnum) + 1> familyIndices;
+        uint32_t numFamilyIndices = 0;
+        if (desc.sharingMode == resource_sharing_mode::Concurrent)
         {
-            if (family != std::numeric_limits<uint32_t>::max())
-                familyIndices.push_back(family);
+            for (uint32_t family : m_queueFamilies)
+            {
+                if (family != std::numeric_limits<uint32_t>::max() && std::find(familyIndices.begin(), familyIndices.begin() + numFamilyIndices, family) == familyIndices.begin() + numFamilyIndices)
+                    familyIndices[numFamilyIndices++] = family;
+            }
         }
 
         // get memory flags
@@ -188,8 +304,8 @@ namespace llri
             imageCreate.samples = (VkSampleCountFlagBits)desc.sampleCount;
             imageCreate.tiling = VK_IMAGE_TILING_OPTIMAL;
             imageCreate.usage = detail::mapTextureUsage(desc.usage);
-            imageCreate.sharingMode = familyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
-            imageCreate.queueFamilyIndexCount = static_cast<uint32_t>(familyIndices.size());
+            imageCreate.sharingMode = numFamilyIndices > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+            imageCreate.queueFamilyIndexCount = numFamilyIndices;
             imageCreate.pQueueFamilyIndices = familyIndices.data();
             imageCreate.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
@@ -210,8 +326,8 @@ namespace llri
             bufferCreate.flags = 0;
             bufferCreate.size = desc.width;
             bufferCreate.usage = detail::mapBufferUsage(desc.usage);
-            bufferCreate.sharingMode = familyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
-            bufferCreate.queueFamilyIndexCount = static_cast<uint32_t>(familyIndices.size());
+            bufferCreate.sharingMode = numFamilyIndices > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+            bufferCreate.queueFamilyIndexCount = numFamilyIndices;
             bufferCreate.pQueueFamilyIndices = familyIndices.data();
 
             auto r = table->vkCreateBuffer(static_cast<VkDevice>(m_ptr), &bufferCreate, nullptr, &buffer);
@@ -227,7 +343,8 @@ namespace llri
         VkMemoryAllocateFlagsInfoKHR flagsInfo;
         flagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
         flagsInfo.pNext = nullptr;
-        flagsInfo.deviceMask = desc.visibleNodeMask;
+        // the memory only exists on the create node, the other visible nodes access it as peer memory
+        flagsInfo.deviceMask = detail::mapNodeMask(desc.createNodeMask);
         flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_MASK_BIT;
 
         VkMemoryAllocateInfo allocInfo;
@@ -247,7 +364,26 @@ namespace llri
             return detail::mapVkResult(r);
         }
 
-        if (isTexture)
+        if (m_adapter->queryNodeCount() > 1)
+        {
+            // every node binds the create node's instance of the memory, by default nodes would bind their own instance
+            std::array<uint32_t, VK_MAX_DEVICE_GROUP_SIZE> deviceIndices;
+            std::fill(deviceIndices.begin(), deviceIndices.end(), detail::mapNodeIndex(desc.createNodeMask));
+
+            if (isTexture)
+            {
+                const VkBindImageMemoryDeviceGroupInfo deviceGroupInfo { VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_DEVICE_GROUP_INFO, nullptr, m_adapter->queryNodeCount(), deviceIndices.data(), 0, nullptr };
+                const VkBindImageMemoryInfo bindInfo { VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_INFO, &deviceGroupInfo, image, memory, 0 };
+                r = table->vkBindImageMemory2(static_cast<VkDevice>(m_ptr), 1, &bindInfo);
+            }
+            else
+            {
+                const VkBindBufferMemoryDeviceGroupInfo deviceGroupInfo { VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_DEVICE_GROUP_INFO, nullptr, m_adapter->queryNodeCount(), deviceIndices.data() };
+                const VkBindBufferMemoryInfo bindInfo { VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO, &deviceGroupInfo, buffer, memory, 0 };
+                r = table->vkBindBufferMemory2(static_cast<VkDevice>(m_ptr), 1, &bindInfo);
+            }
+        }
+        else if (isTexture)
             r = table->vkBindImageMemory(static_cast<VkDevice>(m_ptr), image, memory, 0);
         else
             r = table->vkBindBufferMemory(static_cast<VkDevice>(m_ptr), buffer, memory, 0);
@@ -276,16 +412,15 @@ namespace llri
             beginInfo.pNext = nullptr;
             beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
             beginInfo.pInheritanceInfo = nullptr;
+
+            // in a device group, the image's layout is transitioned on the node that holds its memory
+            VkDeviceGroupCommandBufferBeginInfo deviceGroupBeginInfo { VK_STRUCTURE_TYPE_DEVICE_GROUP_COMMAND_BUFFER_BEGIN_INFO, nullptr, flagsInfo.deviceMask };
+            if (m_adapter->queryNodeCount() > 1)
+                beginInfo.pNext = &deviceGroupBeginInfo;
             table->vkBeginCommandBuffer(static_cast<VkCommandBuffer>(m_workCmdList), &beginInfo);
             
             // use the texture format to detect the aspect flags
-            VkImageAspectFlags aspectFlags = {};
-            if (has_color_component(desc.textureFormat))
-                aspectFlags |= VK_IMAGE_ASPECT_COLOR_BIT;
-            if (has_depth_component(desc.textureFormat))
-                aspectFlags |= VK_IMAGE_ASPECT_DEPTH_BIT;
-            if (has_stencil_component(desc.textureFormat))
-                aspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
+            const VkImageAspectFlags aspectFlags = detail::mapFormatAspects(desc.textureFormat);
             
             VkImageMemoryBarrier imageMemoryBarrier {};
             imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -299,8 +434,12 @@ namespace llri
             imageMemoryBarrier.image = image;
             imageMemoryBarrier.subresourceRange = VkImageSubresourceRange { aspectFlags, 0, desc.mipLevels, 0, desc.depthOrArrayLayers };
             
+            VkPipelineStageFlags dstStages = detail::mapStateToPipelineStage(desc.initialState) & detail::getSupportedPipelineStages(m_workQueueType);
+            if (dstStages == 0)
+                dstStages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
             table->vkCmdPipelineBarrier(static_cast<VkCommandBuffer>(m_workCmdList),
-                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, detail::mapStateToPipelineStage(desc.initialState), {},
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStages, {},
                 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
             
             table->vkEndCommandBuffer(static_cast<VkCommandBuffer>(m_workCmdList));
@@ -315,16 +454,54 @@ namespace llri
             submit.waitSemaphoreCount = 0;
             submit.pWaitSemaphores = nullptr;
             submit.pWaitDstStageMask = nullptr;
-            table->vkQueueSubmit(static_cast<VkQueue>(getQueue(m_workQueueType, 0)->m_ptrs[0]), 1, &submit, static_cast<VkFence>(m_workFence));
+
+            VkDeviceGroupSubmitInfo deviceGroupSubmitInfo { VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO, nullptr, 0, nullptr, 1, &flagsInfo.deviceMask, 0, nullptr };
+            if (m_adapter->queryNodeCount() > 1)
+                submit.pNext = &deviceGroupSubmitInfo;
+            Queue* workQueue = getQueue(m_workQueueType, 0);
+            auto* scratch = static_cast<detail::queue_submit_scratch*>(workQueue->m_submitScratch);
+            {
+                std::unique_lock<std::mutex> queueLock;
+                if (scratch->queueMutex)
+                    queueLock = std::unique_lock<std::mutex>(*scratch->queueMutex);
+
+                table->vkQueueSubmit(static_cast<VkQueue>(workQueue->m_ptrs[0]), 1, &submit, static_cast<VkFence>(m_workFence));
+            }
             
             table->vkWaitForFences(static_cast<VkDevice>(m_ptr), 1, reinterpret_cast<VkFence*>(&m_workFence), VK_TRUE, std::numeric_limits<uint64_t>::max());
             table->vkResetFences(static_cast<VkDevice>(m_ptr), 1, reinterpret_cast<VkFence*>(&m_workFence));
         }
 
+        // textures that can be rendered to get a view of their first mip level and array layer, which is used in CommandList::beginRendering()
+        VkImageView attachmentView = VK_NULL_HANDLE;
+        if (desc.type == resource_type::Texture2D && desc.usage.any(resource_usage_flag_bits::ColorAttachment | resource_usage_flag_bits::DepthStencilAttachment))
+        {
+            VkImageViewCreateInfo viewInfo {};
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.pNext = nullptr;
+            viewInfo.flags = {};
+            viewInfo.image = image;
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = detail::mapTextureFormat(desc.textureFormat);
+            viewInfo.components = VkComponentMapping { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+            viewInfo.subresourceRange = VkImageSubresourceRange { detail::mapFormatAspects(desc.textureFormat), 0, 1, 0, 1 };
+
+            r = table->vkCreateImageView(static_cast<VkDevice>(m_ptr), &viewInfo, nullptr, &attachmentView);
+            if (r != VK_SUCCESS)
+            {
+                table->vkDestroyImage(static_cast<VkDevice>(m_ptr), image, nullptr);
+                table->vkFreeMemory(static_cast<VkDevice>(m_ptr), memory, nullptr);
+                return detail::mapVkResult(r);
+            }
+        }
+
         auto* output = new Resource();
         output->m_desc = desc;
         output->m_resource = isTexture ? static_cast<Resource::native_resource*>(image) : static_cast<Resource::native_resource*>(buffer);
         output->m_memory = memory;
+        output->m_device = this;
+        output->m_attachmentView = attachmentView;
+        output->m_imageAspects = isTexture ? detail::mapFormatAspects(desc.textureFormat) : 0;
         *resource = output;
         return result::Success;
     }
@@ -333,11 +510,253 @@ namespace llri
     {
         const bool isTexture = resource->m_desc.type != resource_type::Buffer;
 
+        if (resource->m_attachmentView)
+            static_cast<VolkDeviceTable*>(m_functionTable)->vkDestroyImageView(static_cast<VkDevice>(m_ptr), static_cast<VkImageView>(resource->m_attachmentView), nullptr);
+
         if (isTexture)
             static_cast<VolkDeviceTable*>(m_functionTable)->vkDestroyImage(static_cast<VkDevice>(m_ptr), static_cast<VkImage>(resource->m_resource), nullptr);
         else
             static_cast<VolkDeviceTable*>(m_functionTable)->vkDestroyBuffer(static_cast<VkDevice>(m_ptr), static_cast<VkBuffer>(resource->m_resource), nullptr);
         
         static_cast<VolkDeviceTable*>(m_functionTable)->vkFreeMemory(static_cast<VkDevice>(m_ptr), static_cast<VkDeviceMemory>(resource->m_memory), nullptr);
+
+        delete resource;
+    }
+
+    result Device::impl_createPipelineCache(const pipeline_cache_desc& desc, PipelineCache** cache)
+    {
+        VkPipelineCacheCreateInfo info {};
+        info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        info.pNext = nullptr;
+        info.flags = {};
+        info.initialDataSize = desc.dataSize;
+        info.pInitialData = desc.data;
+
+        VkPipelineCache vkCache;
+        const VkResult r = static_cast<VolkDeviceTable*>(m_functionTable)->
+            vkCreatePipelineCache(static_cast<VkDevice>(m_ptr), &info, nullptr, &vkCache);
+        if (r != VK_SUCCESS)
+            return detail::mapVkResult(r);
+
+        auto* output = new PipelineCache();
+        output->m_ptr = vkCache;
+        output->m_device = this;
+        output->m_deviceHandle = m_ptr;
+        output->m_deviceFunctionTable = m_functionTable;
+        output->m_validationCallbackMessenger = m_validationCallbackMessenger;
+        output->m_initialDataUsed = desc.dataSize > 0;
+
+        *cache = output;
+        return result::Success;
+    }
+
+    void Device::impl_destroyPipelineCache(PipelineCache* cache)
+    {
+        if (cache->m_ptr)
+        {
+            static_cast<VolkDeviceTable*>(m_functionTable)->
+                vkDestroyPipelineCache(static_cast<VkDevice>(m_ptr), static_cast<VkPipelineCache>(cache->m_ptr), nullptr);
+        }
+
+        delete cache;
+    }
+
+    result Device::impl_createGraphicsPipeline(const graphics_pipeline_desc& desc, Pipeline** pipeline)
+    {
+        auto* table = static_cast<VolkDeviceTable*>(m_functionTable);
+        auto vkDevice = static_cast<VkDevice>(m_ptr);
+
+        // shader stages
+        std::array<VkShaderModule, 2> modules {};
+        std::array<VkPipelineShaderStageCreateInfo, 2> stages {};
+        uint32_t numStages = 0;
+
+        const auto destroyModules = [&]()
+        {
+            for (size_t i = 0; i < numStages; i++)
+                table->vkDestroyShaderModule(vkDevice, modules[i], nullptr);
+        };
+
+        for (const auto& [shader, stage] : { std::make_pair(desc.vertexShader, VK_SHADER_STAGE_VERTEX_BIT), std::make_pair(desc.fragmentShader, VK_SHADER_STAGE_FRAGMENT_BIT) })
+        {
+            if (shader.size == 0)
+                continue;
+
+            VkShaderModuleCreateInfo moduleInfo {};
+            moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            moduleInfo.pNext = nullptr;
+            moduleInfo.flags = {};
+            moduleInfo.codeSize = shader.size;
+            moduleInfo.pCode = static_cast<const uint32_t*>(shader.bytecode);
+
+            const VkResult r = table->vkCreateShaderModule(vkDevice, &moduleInfo, nullptr, &modules[numStages]);
+            if (r != VK_SUCCESS)
+            {
+                destroyModules();
+                return detail::mapVkResult(r);
+            }
+
+            stages[numStages] = VkPipelineShaderStageCreateInfo {
+                VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, {},
+                stage, modules[numStages], shader.entryPoint ? shader.entryPoint : "main", nullptr
+            };
+            numStages++;
+        }
+
+        // vertex input
+        std::vector<VkVertexInputBindingDescription> bindings(desc.numVertexBindings);
+        for (size_t i = 0; i < desc.numVertexBindings; i++)
+        {
+            const auto& binding = desc.vertexBindings[i];
+            bindings[i] = VkVertexInputBindingDescription { binding.binding, binding.stride, binding.inputRate == vertex_input_rate::Instance ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX };
+        }
+
+        std::vector<VkVertexInputAttributeDescription> attributes(desc.numVertexAttributes);
+        for (size_t i = 0; i < desc.numVertexAttributes; i++)
+        {
+            const auto& attribute = desc.vertexAttributes[i];
+            attributes[i] = VkVertexInputAttributeDescription { attribute.location, attribute.binding, detail::mapTextureFormat(attribute.format), attribute.offset };
+        }
+
+        VkPipelineVertexInputStateCreateInfo vertexInput {};
+        vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInput.vertexBindingDescriptionCount = desc.numVertexBindings;
+        vertexInput.pVertexBindingDescriptions = bindings.data();
+        vertexInput.vertexAttributeDescriptionCount = desc.numVertexAttributes;
+        vertexInput.pVertexAttributeDescriptions = attributes.data();
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly {};
+        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = detail::mapPrimitiveTopology(desc.topology);
+        inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+        // viewport and scissor are dynamic, they're set in CommandList::beginRendering() or through CommandList::setViewport()/setScissor()
+        VkPipelineViewportStateCreateInfo viewportState {};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount = 1;
+
+        VkPipelineRasterizationStateCreateInfo rasterizer {};
+        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizer.depthClampEnable = VK_FALSE;
+        rasterizer.rasterizerDiscardEnable = VK_FALSE;
+        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizer.cullMode = detail::mapCullMode(desc.rasterizer.cullMode);
+        rasterizer.frontFace = detail::mapFrontFace(desc.rasterizer.frontFace);
+        rasterizer.depthBiasEnable = desc.rasterizer.depthBias != 0 || desc.rasterizer.depthBiasSlopeScale != 0.0f;
+        rasterizer.depthBiasConstantFactor = static_cast<float>(desc.rasterizer.depthBias);
+        rasterizer.depthBiasClamp = 0.0f;
+        rasterizer.depthBiasSlopeFactor = desc.rasterizer.depthBiasSlopeScale;
+        rasterizer.lineWidth = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisample {};
+        multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisample.rasterizationSamples = static_cast<VkSampleCountFlagBits>(desc.sampleCount);
+
+        const auto mapStencilFace = [&desc](const stencil_op_desc& face)
+        {
+            return VkStencilOpState {
+                detail::mapStencilOp(face.failOp), detail::mapStencilOp(face.passOp), detail::mapStencilOp(face.depthFailOp), detail::mapCompareOp(face.compareOp),
+                desc.depthStencil.stencilReadMask, desc.depthStencil.stencilWriteMask, 0
+            };
+        };
+
+        VkPipelineDepthStencilStateCreateInfo depthStencil {};
+        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable = desc.depthStencil.depthTestEnable;
+        depthStencil.depthWriteEnable = desc.depthStencil.depthWriteEnable;
+        depthStencil.depthCompareOp = detail::mapCompareOp(desc.depthStencil.depthCompareOp);
+        depthStencil.depthBoundsTestEnable = VK_FALSE;
+        depthStencil.stencilTestEnable = desc.depthStencil.stencilTestEnable;
+        if (desc.depthStencil.stencilTestEnable)
+        {
+            depthStencil.front = mapStencilFace(desc.depthStencil.front);
+            depthStencil.back = mapStencilFace(desc.depthStencil.back);
+        }
+        depthStencil.minDepthBounds = 0.0f;
+        depthStencil.maxDepthBounds = 1.0f;
+
+        std::array<VkPipelineColorBlendAttachmentState, detail::maxColorAttachments> blendAttachments {};
+        for (size_t i = 0; i < desc.numColorAttachments; i++)
+        {
+            const auto& attachment = desc.colorAttachments[i];
+            blendAttachments[i] = VkPipelineColorBlendAttachmentState {
+                attachment.blendEnable,
+                detail::mapBlendFactor(attachment.srcColorFactor), detail::mapBlendFactor(attachment.dstColorFactor), detail::mapBlendOp(attachment.colorOp),
+                detail::mapBlendFactor(attachment.srcAlphaFactor), detail::mapBlendFactor(attachment.dstAlphaFactor), detail::mapBlendOp(attachment.alphaOp),
+                detail::mapColorComponents(attachment.writeMask)
+            };
+        }
+
+        VkPipelineColorBlendStateCreateInfo colorBlend {};
+        colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlend.logicOpEnable = VK_FALSE;
+        colorBlend.attachmentCount = desc.numColorAttachments;
+        colorBlend.pAttachments = blendAttachments.data();
+
+        constexpr std::array<VkDynamicState, 3> dynamicStates { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR, VK_DYNAMIC_STATE_STENCIL_REFERENCE };
+        VkPipelineDynamicStateCreateInfo dynamicState {};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+        dynamicState.pDynamicStates = dynamicStates.data();
+
+        // pipelines are created against a compatible render pass, load and store operations don't affect compatibility
+        detail::render_pass_key key {};
+        key.numColorAttachments = static_cast<uint8_t>(desc.numColorAttachments);
+        key.sampleCount = desc.sampleCount;
+        for (size_t i = 0; i < desc.numColorAttachments; i++)
+            key.attachments[i] = detail::render_pass_attachment { desc.colorAttachments[i].format, attachment_load_op::Load, attachment_store_op::Store };
+        key.attachments[detail::maxColorAttachments] = detail::render_pass_attachment { desc.depthStencilFormat, attachment_load_op::Load, attachment_store_op::Store };
+
+        VkRenderPass renderPass;
+        VkResult r = detail::getRenderPass(vkDevice, table, static_cast<detail::render_pass_cache*>(m_renderPassCache), key, &renderPass);
+        if (r != VK_SUCCESS)
+        {
+            destroyModules();
+            return detail::mapVkResult(r);
+        }
+
+        VkGraphicsPipelineCreateInfo info {};
+        info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        info.pNext = nullptr;
+        info.flags = {};
+        info.stageCount = numStages;
+        info.pStages = stages.data();
+        info.pVertexInputState = &vertexInput;
+        info.pInputAssemblyState = &inputAssembly;
+        info.pTessellationState = nullptr;
+        info.pViewportState = &viewportState;
+        info.pRasterizationState = &rasterizer;
+        info.pMultisampleState = &multisample;
+        info.pDepthStencilState = desc.depthStencilFormat != format::Undefined ? &depthStencil : nullptr;
+        info.pColorBlendState = &colorBlend;
+        info.pDynamicState = &dynamicState;
+        info.layout = static_cast<VkPipelineLayout>(m_pushConstantLayouts[static_cast<size_t>(desc.pushConstantStages.value)]);
+        info.renderPass = renderPass;
+        info.subpass = 0;
+        info.basePipelineHandle = VK_NULL_HANDLE;
+        info.basePipelineIndex = -1;
+
+        const VkPipelineCache cache = desc.cache ? static_cast<VkPipelineCache>(desc.cache->m_ptr) : VK_NULL_HANDLE;
+
+        VkPipeline vkPipeline;
+        r = table->vkCreateGraphicsPipelines(vkDevice, cache, 1, &info, nullptr, &vkPipeline);
+        destroyModules();
+        if (r != VK_SUCCESS)
+            return detail::mapVkResult(r);
+
+        auto* output = new Pipeline();
+        output->m_ptr = vkPipeline;
+        output->m_device = this;
+        output->m_topology = desc.topology;
+        output->m_pushConstantStages = desc.pushConstantStages;
+        *pipeline = output;
+        return result::Success;
+    }
+
+    void Device::impl_destroyPipeline(Pipeline* pipeline)
+    {
+        static_cast<VolkDeviceTable*>(m_functionTable)->vkDestroyPipeline(static_cast<VkDevice>(m_ptr), static_cast<VkPipeline>(pipeline->m_ptr), nullptr);
+        delete pipeline;
     }
 }
@@ -0,0 +1,19 @@
+/**
+ * @file fence.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-vk/utils.hpp>
+#include <graphics/vulkan/volk.h>
+
+namespace llri
+{
+    result Fence::impl_getStatus() const
+    {
+        const VkResult r = static_cast<VolkDeviceTable*>(m_device->m_functionTable)->
+            vkGetFenceStatus(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkFence>(m_ptr));
+        return detail::mapVkResult(r);
+    }
+}
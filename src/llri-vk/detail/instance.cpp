@@ -7,6 +7,7 @@
 #include <llri/llri.hpp>
 #include <llri-vk/utils.hpp>
 #include <algorithm>
+#include <map>
 
 namespace llri
 {
@@ -133,6 +134,12 @@ namespace llri
                         extensions.emplace(detail::nameHash("VK_KHR_xcb_surface"), "VK_KHR_xcb_surface");
                         break;
                     }
+                    case instance_extension::DebugLabels:
+                    {
+                        extensions.emplace(detail::nameHash(VK_EXT_DEBUG_UTILS_EXTENSION_NAME), VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+                        output->m_debugLabels = true;
+                        break;
+                    }
                 }
             }
 
@@ -323,13 +330,22 @@ namespace llri
         output->m_desc = desc;
         output->m_adapter = desc.adapter;
         output->m_validationCallbackMessenger = m_validationCallbackMessenger;
+        output->m_debugLabels = m_debugLabels;
 
         // Queue creation
         auto families = detail::findQueueFamilies(static_cast<VkPhysicalDevice>(desc.adapter->m_ptr));
+        for (const auto& [type, family] : families)
+            output->m_queueFamilies[static_cast<size_t>(type)] = family;
+
+        uint32_t familyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(static_cast<VkPhysicalDevice>(desc.adapter->m_ptr), &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> familyProperties(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(static_cast<VkPhysicalDevice>(desc.adapter->m_ptr), &familyCount, familyProperties.data());
 
-        std::vector<float> graphicsPriorities;
-        std::vector<float> computePriorities;
-        std::vector<float> transferPriorities;
+        // queue types that fall back to the same family are spread across its queues,
+        // and the Nth queue that is requested from a family wraps around to queue N % queueCount if the family has fewer queues than requested
+        std::map<uint32_t, std::vector<float>> familyPriorities;
+        std::unordered_map<uint32_t, uint32_t> familyRequests;
 
         for (size_t i = 0; i < desc.numQueues; i++)
         {
@@ -346,36 +362,23 @@ namespace llri
                     break;
             }
 
-            switch (queueDesc.type)
-            {
-                case queue_type::Graphics:
-                    graphicsPriorities.push_back(priority);
-                    break;
-                case queue_type::Compute:
-                    computePriorities.push_back(priority);
-                    break;
-                case queue_type::Transfer:
-                    transferPriorities.push_back(priority);
-                    break;
-            }
+            const uint32_t family = families[queueDesc.type];
+            auto& priorities = familyPriorities[family];
+            const uint32_t request = familyRequests[family]++;
+
+            if (request < familyProperties[family].queueCount)
+                priorities.push_back(priority);
+            else
+                priorities[request % familyProperties[family].queueCount] = std::max(priorities[request % familyProperties[family].queueCount], priority);
         }
 
         std::vector<VkDeviceQueueCreateInfo> queues;
-
-        if (!graphicsPriorities.empty())
-            queues.push_back(VkDeviceQueueCreateInfo{ VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO, nullptr, {},
-                families[queue_type::Graphics],
-                static_cast<uint32_t>(graphicsPriorities.size()), graphicsPriorities.data() });
-
-        if (!computePriorities.empty())
-            queues.push_back(VkDeviceQueueCreateInfo{ VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO, nullptr, {},
-                families[queue_type::Compute],
-                static_cast<uint32_t>(computePriorities.size()), computePriorities.data() });
-
-        if (!transferPriorities.empty())
+        for (const auto& [family, priorities] : familyPriorities)
+        {
             queues.push_back(VkDeviceQueueCreateInfo{ VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO, nullptr, {},
-                families[queue_type::Transfer],
-                static_cast<uint32_t>(transferPriorities.size()), transferPriorities.data() });
+                family,
+                static_cast<uint32_t>(priorities.size()), priorities.data() });
+        }
 
         // Extensions
         std::vector<const char*> extensions;
@@ -390,11 +393,38 @@ namespace llri
 
         // Features
         VkPhysicalDeviceFeatures features{};
+        features.pipelineStatisticsQuery = desc.features.pipelineStatisticsQuery;
+
+        // synchronization2 allows split barriers to execute their transitions when they begin, instead of when they end
+        VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR, nullptr, VK_FALSE };
+        {
+            const auto physicalDevice = static_cast<VkPhysicalDevice>(desc.adapter->m_ptr);
+
+            if (vkGetPhysicalDeviceFeatures2 && detail::queryDeviceExtensionSupport(physicalDevice, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME))
+            {
+                VkPhysicalDeviceFeatures2 features2 { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, &synchronization2Features, {} };
+                vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+                if (synchronization2Features.synchronization2)
+                    extensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+            }
+        }
+
+        // feature structures are chained backwards, like the instance's pNext chain
+        void* pNext = synchronization2Features.synchronization2 ? &synchronization2Features : nullptr;
+
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR, nullptr, VK_TRUE };
+        if (desc.features.timelineSemaphores)
+        {
+            extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+            timelineSemaphoreFeatures.pNext = pNext;
+            pNext = &timelineSemaphoreFeatures;
+        }
 
         // Create device
         VkDeviceCreateInfo ci{
             VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-            nullptr,
+            pNext,
             {},
             static_cast<uint32_t>(queues.size()), queues.data(),
             0, nullptr, // Vulkan device layers are deprecated
@@ -410,6 +440,7 @@ namespace llri
             return detail::mapVkResult(r);
         }
         output->m_ptr = vkDevice;
+        output->m_synchronization2 = synchronization2Features.synchronization2;
 
         // Load function table
         auto* table = new VolkDeviceTable();
@@ -423,18 +454,42 @@ namespace llri
             { queue_type::Transfer, 0 }
         };
 
+        std::unordered_map<uint32_t, uint32_t> familyQueueCounts;
+        std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<std::mutex>> queueMutexes;
+
+        // timestamps are only supported by queue families with valid timestamp bits, and LLRI doesn't support them on Transfer queues
+        VkPhysicalDeviceProperties physicalDeviceProperties;
+        vkGetPhysicalDeviceProperties(static_cast<VkPhysicalDevice>(desc.adapter->m_ptr), &physicalDeviceProperties);
+
         for (size_t i = 0; i < desc.numQueues; i++)
         {
             auto& queueDesc = desc.queues[i];
 
+            const uint32_t family = families[queueDesc.type];
+            const uint32_t numFamilyQueues = static_cast<uint32_t>(familyPriorities[family].size());
+            const uint32_t index = familyQueueCounts[family]++ % numFamilyQueues;
+
             VkQueue vkQueue;
-            table->vkGetDeviceQueue(vkDevice, families[queueDesc.type], queueCounts[queueDesc.type], &vkQueue);
+            table->vkGetDeviceQueue(vkDevice, family, index, &vkQueue);
 
             auto* queue = new Queue();
             queue->m_desc = queueDesc;
             queue->m_device = output;
             queue->m_ptrs = std::vector<Queue::native_queue*>(desc.adapter->m_nodeCount, vkQueue);
+            if (queueDesc.type != queue_type::Transfer && familyProperties[families[queueDesc.type]].timestampValidBits > 0)
+                queue->m_timestampPeriod = static_cast<double>(physicalDeviceProperties.limits.timestampPeriod);
             queue->m_validationCallbackMessenger = output->m_validationCallbackMessenger;
+            queue->m_submitScratch = new detail::queue_submit_scratch();
+
+            // queues of a family that was requested more often than it has queues may be shared, and submissions to them are serialized
+            // the submission thread of a Background queue submits simultaneously with internal submissions on the calling thread, which are serialized in the same way
+            if (familyRequests[family] > numFamilyQueues || queueDesc.submitMode == queue_submit_mode::Background)
+            {
+                auto& mutex = queueMutexes[{ family, index }];
+                if (!mutex)
+                    mutex = std::make_shared<std::mutex>();
+                static_cast<detail::queue_submit_scratch*>(queue->m_submitScratch)->queueMutex = mutex;
+            }
 
             switch(queueDesc.type)
             {
@@ -452,6 +507,32 @@ namespace llri
             queueCounts[queueDesc.type]++;
         }
         
+        // create the pipeline layouts that are used for push constants, one for each combination of shader stages
+        // the layout at index 0 has no push constants and is used by pipelines that don't access them
+        const uint32_t pushConstantSize = desc.adapter->queryLimits().maxPushConstantSize;
+        for (size_t i = 0; i < output->m_pushConstantLayouts.size(); i++)
+        {
+            const VkPushConstantRange range { detail::mapShaderStages(static_cast<shader_stage_flag_bits>(i)), 0, pushConstantSize };
+
+            VkPipelineLayoutCreateInfo layoutInfo {};
+            layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            layoutInfo.pNext = nullptr;
+            layoutInfo.flags = {};
+            layoutInfo.setLayoutCount = 0;
+            layoutInfo.pSetLayouts = nullptr;
+            layoutInfo.pushConstantRangeCount = i == 0 ? 0 : 1;
+            layoutInfo.pPushConstantRanges = i == 0 ? nullptr : &range;
+
+            const VkResult lr = table->vkCreatePipelineLayout(vkDevice, &layoutInfo, nullptr, reinterpret_cast<VkPipelineLayout*>(&output->m_pushConstantLayouts[i]));
+            if (lr != VK_SUCCESS)
+            {
+                destroyDevice(output);
+                return detail::mapVkResult(lr);
+            }
+        }
+
+        output->m_renderPassCache = new detail::render_pass_cache();
+
         // create work resources
         if (queueCounts[queue_type::Graphics] > 0)
             output->m_workQueueType = queue_type::Graphics;
@@ -489,14 +570,39 @@ namespace llri
     {
         // Cleanup queue wrappers
         for (auto* graphics : device->m_graphicsQueues)
+        {
+            delete static_cast<detail::queue_submit_scratch*>(graphics->m_submitScratch);
             delete graphics;
+        }
 
         for (auto* compute : device->m_computeQueues)
+        {
+            delete static_cast<detail::queue_submit_scratch*>(compute->m_submitScratch);
             delete compute;
+        }
         
         for (auto* transfer : device->m_transferQueues)
+        {
+            delete static_cast<detail::queue_submit_scratch*>(transfer->m_submitScratch);
             delete transfer;
+        }
         
+        // Cleanup push constant layouts
+        for (void* layout : device->m_pushConstantLayouts)
+        {
+            if (layout)
+                static_cast<VolkDeviceTable*>(device->m_functionTable)->vkDestroyPipelineLayout(static_cast<VkDevice>(device->m_ptr), static_cast<VkPipelineLayout>(layout), nullptr);
+        }
+
+        // Cleanup render passes
+        if (device->m_renderPassCache)
+        {
+            auto* renderPassCache = static_cast<detail::render_pass_cache*>(device->m_renderPassCache);
+            for (auto& [key, renderPass] : renderPassCache->renderPasses)
+                static_cast<VolkDeviceTable*>(device->m_functionTable)->vkDestroyRenderPass(static_cast<VkDevice>(device->m_ptr), renderPass, nullptr);
+            delete renderPassCache;
+        }
+
         // Cleanup work objects
         if (device->m_workFence)
             static_cast<VolkDeviceTable*>(device->m_functionTable)->vkDestroyFence(static_cast<VkDevice>(device->m_ptr), static_cast<VkFence>(device->m_workFence), nullptr);
@@ -36,6 +36,8 @@ namespace llri
                 case instance_extension::SurfaceXcb:
                     return extensions.find(detail::nameHash("VK_KHR_xcb_surface")) != extensions.end() &&
                             extensions.find(detail::nameHash("VK_KHR_surface")) != extensions.end();
+                case instance_extension::DebugLabels:
+                    return extensions.find(detail::nameHash("VK_EXT_debug_utils")) != extensions.end();
             }
 
             return false;
@@ -0,0 +1,32 @@
+/**
+ * @file pipeline_cache.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-vk/utils.hpp>
+#include <graphics/vulkan/volk.h>
+
+namespace llri
+{
+    result PipelineCache::impl_serialize(std::vector<uint8_t>* data) const
+    {
+        auto* table = static_cast<VolkDeviceTable*>(m_deviceFunctionTable);
+        const size_t offset = data->size();
+
+        size_t size = 0;
+        VkResult r = table->vkGetPipelineCacheData(static_cast<VkDevice>(m_deviceHandle), static_cast<VkPipelineCache>(m_ptr), &size, nullptr);
+        if (r != VK_SUCCESS)
+            return detail::mapVkResult(r);
+
+        data->resize(offset + size);
+        r = table->vkGetPipelineCacheData(static_cast<VkDevice>(m_deviceHandle), static_cast<VkPipelineCache>(m_ptr), &size, data->data() + offset);
+        if (r != VK_SUCCESS && r != VK_INCOMPLETE)
+            return detail::mapVkResult(r);
+
+        // other threads may have changed the cache between the two calls
+        data->resize(offset + size);
+        return result::Success;
+    }
+}
@@ -0,0 +1,59 @@
+/**
+ * @file query_pool.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-vk/utils.hpp>
+#include <graphics/vulkan/volk.h>
+
+namespace llri
+{
+    result QueryPool::impl_getResults(uint32_t firstQuery, uint32_t numQueries, uint64_t* results) const
+    {
+        // without VK_QUERY_RESULT_WAIT_BIT, unavailable results return VK_NOT_READY instead of stalling
+        const VkResult r = static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkGetQueryPoolResults(static_cast<VkDevice>(m_deviceHandle), static_cast<VkQueryPool>(m_ptr), firstQuery, numQueries,
+                numQueries * sizeof(uint64_t), results, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+        return detail::mapVkResult(r);
+    }
+
+    result QueryPool::impl_getResults(uint32_t firstQuery, uint32_t numQueries, pipeline_statistics* results) const
+    {
+        // Vulkan only writes the selected counters, tightly packed in the order of their flag bits
+        const uint32_t numCounters = m_resultSize / sizeof(uint64_t);
+        std::vector<uint64_t> counters(static_cast<size_t>(numQueries) * numCounters);
+
+        const VkResult r = static_cast<VolkDeviceTable*>(m_deviceFunctionTable)->
+            vkGetQueryPoolResults(static_cast<VkDevice>(m_deviceHandle), static_cast<VkQueryPool>(m_ptr), firstQuery, numQueries,
+                counters.size() * sizeof(uint64_t), counters.data(), m_resultSize, VK_QUERY_RESULT_64_BIT);
+        if (r != VK_SUCCESS)
+            return detail::mapVkResult(r);
+
+        constexpr std::array<std::pair<pipeline_statistic_flag_bits, uint64_t pipeline_statistics::*>, 7> members {{
+            { pipeline_statistic_flag_bits::InputAssemblyVertices, &pipeline_statistics::inputAssemblyVertices },
+            { pipeline_statistic_flag_bits::InputAssemblyPrimitives, &pipeline_statistics::inputAssemblyPrimitives },
+            { pipeline_statistic_flag_bits::VertexShaderInvocations, &pipeline_statistics::vertexShaderInvocations },
+            { pipeline_statistic_flag_bits::ClippingInvocations, &pipeline_statistics::clippingInvocations },
+            { pipeline_statistic_flag_bits::ClippingPrimitives, &pipeline_statistics::clippingPrimitives },
+            { pipeline_statistic_flag_bits::FragmentShaderInvocations, &pipeline_statistics::fragmentShaderInvocations },
+            { pipeline_statistic_flag_bits::ComputeShaderInvocations, &pipeline_statistics::computeShaderInvocations }
+        }};
+
+        for (uint32_t i = 0; i < numQueries; i++)
+        {
+            results[i] = pipeline_statistics{};
+
+            const uint64_t* counter = counters.data() + static_cast<size_t>(i) * numCounters;
+            for (const auto& [bit, member] : members)
+            {
+                if (m_desc.pipelineStatistics.contains(bit))
+                    results[i].*member = *counter++;
+            }
+        }
+
+        return result::Success;
+    }
+}
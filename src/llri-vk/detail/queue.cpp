@@ -9,47 +9,151 @@
 
 namespace llri
 {
-    result Queue::impl_submit(const submit_desc& desc)
+    result Queue::impl_submit(uint32_t numDescs, const submit_desc* descs, [[maybe_unused]] const uint64_t* fenceValues)
     {
-        std::vector<VkCommandBuffer> buffers(desc.numCommandLists);
-        for (size_t i = 0; i < desc.numCommandLists; i++)
-            buffers[i] = static_cast<VkCommandBuffer>(desc.commandLists[i]->m_ptr);
-
-        std::vector<VkSemaphore> waitSemaphores(desc.numWaitSemaphores);
-        std::vector<VkPipelineStageFlags> waitSemaphoreStages(desc.numWaitSemaphores, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-        for (size_t i = 0; i < desc.numWaitSemaphores; i++)
-            waitSemaphores[i] = static_cast<VkSemaphore>(desc.waitSemaphores[i]->m_ptr);
-
-        std::vector<VkSemaphore> signalSemaphores(desc.numSignalSemaphores);
-        for (size_t i = 0; i < desc.numSignalSemaphores; i++)
-            signalSemaphores[i] = static_cast<VkSemaphore>(desc.signalSemaphores[i]->m_ptr);
-
-        VkSubmitInfo info;
-        info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        info.pNext = nullptr;
-        info.commandBufferCount = desc.numCommandLists;
-        info.pCommandBuffers = buffers.data();
-        info.waitSemaphoreCount = desc.numWaitSemaphores;
-        info.pWaitSemaphores = waitSemaphores.data();
-        info.signalSemaphoreCount = desc.numSignalSemaphores;
-        info.pSignalSemaphores = signalSemaphores.data();
-        info.pWaitDstStageMask = waitSemaphoreStages.data();
-
-        VkFence fence = VK_NULL_HANDLE;
-        if (desc.fence != nullptr)
+        auto* scratch = static_cast<detail::queue_submit_scratch*>(m_submitScratch);
+
+        std::unique_lock<std::mutex> queueLock;
+        if (scratch->queueMutex)
+            queueLock = std::unique_lock<std::mutex>(*scratch->queueMutex);
+
+        size_t numCommandLists = 0;
+        size_t numWaitSemaphores = 0;
+        size_t numSignalSemaphores = 0;
+        for (size_t d = 0; d < numDescs; d++)
         {
-            fence = static_cast<VkFence>(desc.fence->m_ptr);
-            desc.fence->m_signaled = true;
+            numCommandLists += descs[d].numCommandLists;
+            numWaitSemaphores += descs[d].numWaitSemaphores;
+            numSignalSemaphores += descs[d].numSignalSemaphores;
         }
 
-        const auto r = static_cast<VolkDeviceTable*>(m_device->m_functionTable)->
-            vkQueueSubmit(static_cast<VkQueue>(m_ptrs[0]), 1, &info, fence);
+        // the arrays are sized up front because the submit infos point into them
+        scratch->submitInfos.resize(numDescs);
+        scratch->timelineInfos.resize(numDescs);
+        scratch->commandBuffers.resize(numCommandLists);
+        scratch->waitSemaphores.resize(numWaitSemaphores);
+        scratch->waitSemaphoreStages.resize(numWaitSemaphores);
+        scratch->signalSemaphores.resize(numSignalSemaphores);
 
-        return detail::mapVkResult(r);
+        // device groups select the node that executes each batch through a device group submit info
+        const bool deviceGroup = m_device->m_adapter->queryNodeCount() > 1;
+        if (deviceGroup)
+        {
+            scratch->deviceGroupInfos.resize(numDescs);
+            scratch->commandBufferDeviceMasks.resize(numCommandLists);
+            scratch->waitSemaphoreDeviceIndices.resize(numWaitSemaphores);
+            scratch->signalSemaphoreDeviceIndices.resize(numSignalSemaphores);
+        }
+
+        VkCommandBuffer* buffers = scratch->commandBuffers.data();
+        VkSemaphore* waitSemaphores = scratch->waitSemaphores.data();
+        VkPipelineStageFlags* waitSemaphoreStages = scratch->waitSemaphoreStages.data();
+        VkSemaphore* signalSemaphores = scratch->signalSemaphores.data();
+        uint32_t* commandBufferDeviceMasks = scratch->commandBufferDeviceMasks.data();
+        uint32_t* waitSemaphoreDeviceIndices = scratch->waitSemaphoreDeviceIndices.data();
+        uint32_t* signalSemaphoreDeviceIndices = scratch->signalSemaphoreDeviceIndices.data();
+
+        // vkQueueSubmit() signals one fence, so the batches are split into one submission per fence
+        uint32_t firstInfo = 0;
+        for (uint32_t d = 0; d < numDescs; d++)
+        {
+            const submit_desc& desc = descs[d];
+
+            for (size_t i = 0; i < desc.numCommandLists; i++)
+                buffers[i] = static_cast<VkCommandBuffer>(desc.commandLists[i]->m_ptr);
+
+            for (size_t i = 0; i < desc.numWaitSemaphores; i++)
+            {
+                waitSemaphores[i] = static_cast<VkSemaphore>(desc.waitSemaphores[i]->m_ptr);
+                // stages that the queue doesn't support and the host stage can't be waited on, and None means that every stage waits
+                const VkPipelineStageFlags stages = desc.waitSemaphoreStages ? detail::mapPipelineStages(desc.waitSemaphoreStages[i]) & detail::getSupportedPipelineStages(m_desc.type) & ~VK_PIPELINE_STAGE_HOST_BIT : 0;
+                waitSemaphoreStages[i] = stages != 0 ? stages : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+            }
+
+            for (size_t i = 0; i < desc.numSignalSemaphores; i++)
+                signalSemaphores[i] = static_cast<VkSemaphore>(desc.signalSemaphores[i]->m_ptr);
+
+            // binary semaphores ignore their values, so the values are only passed if a timeline semaphore needs them
+            // Background Queues always set the value arrays, because they resolve the values of binary semaphores for other implementations
+            bool usesTimelineSemaphore = false;
+            for (size_t i = 0; i < desc.numWaitSemaphores; i++)
+                usesTimelineSemaphore |= desc.waitSemaphores[i]->m_type == semaphore_type::Timeline;
+            for (size_t i = 0; i < desc.numSignalSemaphores; i++)
+                usesTimelineSemaphore |= desc.signalSemaphores[i]->m_type == semaphore_type::Timeline;
+
+            VkTimelineSemaphoreSubmitInfoKHR& timelineInfo = scratch->timelineInfos[d];
+            timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+            timelineInfo.pNext = nullptr;
+            timelineInfo.waitSemaphoreValueCount = desc.waitSemaphoreValues ? desc.numWaitSemaphores : 0;
+            timelineInfo.pWaitSemaphoreValues = desc.waitSemaphoreValues;
+            timelineInfo.signalSemaphoreValueCount = desc.signalSemaphoreValues ? desc.numSignalSemaphores : 0;
+            timelineInfo.pSignalSemaphoreValues = desc.signalSemaphoreValues;
+
+            VkSubmitInfo& info = scratch->submitInfos[d];
+            info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            info.pNext = usesTimelineSemaphore ? &timelineInfo : nullptr;
+
+            if (deviceGroup)
+            {
+                // semaphores are waited on and signaled by the node that executes the batch
+                const uint32_t deviceMask = detail::mapNodeMask(desc.nodeMask);
+                const uint32_t deviceIndex = detail::mapNodeIndex(desc.nodeMask);
+                std::fill(commandBufferDeviceMasks, commandBufferDeviceMasks + desc.numCommandLists, deviceMask);
+                std::fill(waitSemaphoreDeviceIndices, waitSemaphoreDeviceIndices + desc.numWaitSemaphores, deviceIndex);
+                std::fill(signalSemaphoreDeviceIndices, signalSemaphoreDeviceIndices + desc.numSignalSemaphores, deviceIndex);
+
+                VkDeviceGroupSubmitInfo& deviceGroupInfo = scratch->deviceGroupInfos[d];
+                deviceGroupInfo.sType = VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO;
+                deviceGroupInfo.pNext = info.pNext;
+                deviceGroupInfo.waitSemaphoreCount = desc.numWaitSemaphores;
+                deviceGroupInfo.pWaitSemaphoreDeviceIndices = waitSemaphoreDeviceIndices;
+                deviceGroupInfo.commandBufferCount = desc.numCommandLists;
+                deviceGroupInfo.pCommandBufferDeviceMasks = commandBufferDeviceMasks;
+                deviceGroupInfo.signalSemaphoreCount = desc.numSignalSemaphores;
+                deviceGroupInfo.pSignalSemaphoreDeviceIndices = signalSemaphoreDeviceIndices;
+                info.pNext = &deviceGroupInfo;
+
+                commandBufferDeviceMasks += desc.numCommandLists;
+                waitSemaphoreDeviceIndices += desc.numWaitSemaphores;
+                signalSemaphoreDeviceIndices += desc.numSignalSemaphores;
+            }
+            info.commandBufferCount = desc.numCommandLists;
+            info.pCommandBuffers = buffers;
+            info.waitSemaphoreCount = desc.numWaitSemaphores;
+            info.pWaitSemaphores = waitSemaphores;
+            info.signalSemaphoreCount = desc.numSignalSemaphores;
+            info.pSignalSemaphores = signalSemaphores;
+            info.pWaitDstStageMask = waitSemaphoreStages;
+
+            buffers += desc.numCommandLists;
+            waitSemaphores += desc.numWaitSemaphores;
+            waitSemaphoreStages += desc.numWaitSemaphores;
+            signalSemaphores += desc.numSignalSemaphores;
+
+            if (desc.fence == nullptr && d + 1 < numDescs)
+                continue;
+
+            const VkFence fence = desc.fence != nullptr ? static_cast<VkFence>(desc.fence->m_ptr) : VK_NULL_HANDLE;
+
+            const auto r = static_cast<VolkDeviceTable*>(m_device->m_functionTable)->
+                vkQueueSubmit(static_cast<VkQueue>(m_ptrs[0]), d + 1 - firstInfo, scratch->submitInfos.data() + firstInfo, fence);
+            if (r != VK_SUCCESS)
+                return detail::mapVkResult(r);
+
+            firstInfo = d + 1;
+        }
+
+        return result::Success;
     }
 
     result Queue::impl_waitIdle()
     {
+        auto* scratch = static_cast<detail::queue_submit_scratch*>(m_submitScratch);
+
+        std::unique_lock<std::mutex> queueLock;
+        if (scratch->queueMutex)
+            queueLock = std::unique_lock<std::mutex>(*scratch->queueMutex);
+
         const auto r = static_cast<VolkDeviceTable*>(m_device->m_functionTable)->vkQueueWaitIdle(static_cast<VkQueue>(m_ptrs[0]));
         return detail::mapVkResult(r);
     }
@@ -0,0 +1,32 @@
+/**
+ * @file semaphore.cpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <llri/llri.hpp>
+#include <llri-vk/utils.hpp>
+#include <graphics/vulkan/volk.h>
+
+namespace llri
+{
+    result Semaphore::impl_signal(uint64_t value)
+    {
+        VkSemaphoreSignalInfoKHR info;
+        info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+        info.pNext = nullptr;
+        info.semaphore = static_cast<VkSemaphore>(m_ptr);
+        info.value = value;
+
+        const VkResult r = static_cast<VolkDeviceTable*>(m_device->m_functionTable)->
+            vkSignalSemaphoreKHR(static_cast<VkDevice>(m_device->m_ptr), &info);
+        return detail::mapVkResult(r);
+    }
+
+    result Semaphore::impl_getValue(uint64_t* value) const
+    {
+        const VkResult r = static_cast<VolkDeviceTable*>(m_device->m_functionTable)->
+            vkGetSemaphoreCounterValueKHR(static_cast<VkDevice>(m_device->m_ptr), static_cast<VkSemaphore>(m_ptr), value);
+        return detail::mapVkResult(r);
+    }
+}
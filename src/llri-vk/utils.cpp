@@ -146,6 +146,18 @@ namespace llri
             return static_cast<uint32_t>(-1);
         }
     
+        bool queryDeviceExtensionSupport(VkPhysicalDevice physicalDevice, const char* name)
+        {
+            uint32_t extensionCount = 0;
+            vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+            std::vector<VkExtensionProperties> extensions(extensionCount);
+            vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+
+            return std::any_of(extensions.begin(), extensions.end(), [name](const VkExtensionProperties& ext) {
+                return std::strcmp(ext.extensionName, name) == 0;
+            });
+        }
+
         std::unordered_map<queue_type, uint32_t> findQueueFamilies(VkPhysicalDevice physicalDevice)
         {
             std::unordered_map<queue_type, uint32_t> output
@@ -161,6 +173,8 @@ namespace llri
             std::vector<VkQueueFamilyProperties> properties(propertyCount);
             vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &propertyCount, properties.data());
 
+            // dedicated families are preferred so that Compute and Transfer work can execute asynchronously to Graphics work
+            uint32_t anyCompute = std::numeric_limits<uint32_t>::max();
             for (uint32_t i = 0; i < propertyCount; i++)
             {
                 auto& p = properties[i];
@@ -168,20 +182,132 @@ namespace llri
                 // Only the graphics queue has the graphics bit set
                 // it usually also has compute & transfer set, because graphics queue tends to be general purpose
                 if ((p.queueFlags & VK_QUEUE_GRAPHICS_BIT) == VK_QUEUE_GRAPHICS_BIT)
-                    output[queue_type::Graphics] = i;
+                {
+                    if (output[queue_type::Graphics] == std::numeric_limits<uint32_t>::max())
+                        output[queue_type::Graphics] = i;
+                }
 
                 // Dedicated compute family has no graphics bit but does have a compute bit
-                else if ((p.queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0 && (p.queueFlags & VK_QUEUE_COMPUTE_BIT) == VK_QUEUE_COMPUTE_BIT)
-                    output[queue_type::Compute] = i;
+                else if ((p.queueFlags & VK_QUEUE_COMPUTE_BIT) == VK_QUEUE_COMPUTE_BIT)
+                {
+                    if (output[queue_type::Compute] == std::numeric_limits<uint32_t>::max())
+                        output[queue_type::Compute] = i;
+                }
 
                 // Dedicated transfer family has no graphics bit, no compute bit, but does have a transfer bit
-                else if ((p.queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0 &&
-                    (p.queueFlags & VK_QUEUE_COMPUTE_BIT) == 0 &&
-                    (p.queueFlags & VK_QUEUE_TRANSFER_BIT) == VK_QUEUE_TRANSFER_BIT)
-                    output[queue_type::Transfer] = i;
+                else if ((p.queueFlags & VK_QUEUE_TRANSFER_BIT) == VK_QUEUE_TRANSFER_BIT)
+                {
+                    if (output[queue_type::Transfer] == std::numeric_limits<uint32_t>::max())
+                        output[queue_type::Transfer] = i;
+                }
+
+                if ((p.queueFlags & VK_QUEUE_COMPUTE_BIT) == VK_QUEUE_COMPUTE_BIT && anyCompute == std::numeric_limits<uint32_t>::max())
+                    anyCompute = i;
             }
 
+            // without a dedicated family, Compute falls back to a general purpose family that supports compute
+            if (output[queue_type::Compute] == std::numeric_limits<uint32_t>::max())
+                output[queue_type::Compute] = anyCompute;
+
+            // graphics and compute families implicitly support transfer operations, the dedicated compute family is preferred because it's more likely to execute asynchronously
+            if (output[queue_type::Transfer] == std::numeric_limits<uint32_t>::max())
+                output[queue_type::Transfer] = output[queue_type::Compute] != std::numeric_limits<uint32_t>::max() ? output[queue_type::Compute] : output[queue_type::Graphics];
+
             return output;
         }
+    
+        size_t render_pass_key_hash::operator()(const render_pass_key& key) const
+        {
+            const auto* data = reinterpret_cast<const uint8_t*>(&key);
+
+            uint64_t hash = 0xcbf29ce484222325;
+            constexpr uint64_t prime = 0x00000100000001b3;
+
+            for (size_t i = 0; i < sizeof(render_pass_key); i++)
+            {
+                hash = hash ^ data[i];
+                hash *= prime;
+            }
+
+            return static_cast<size_t>(hash);
+        }
+
+        VkResult getRenderPass(VkDevice device, VolkDeviceTable* table, render_pass_cache* cache, const render_pass_key& key, VkRenderPass* renderPass)
+        {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+
+            const auto it = cache->renderPasses.find(key);
+            if (it != cache->renderPasses.end())
+            {
+                *renderPass = it->second;
+                return VK_SUCCESS;
+            }
+
+            std::array<VkAttachmentDescription, maxColorAttachments + 1> attachments {};
+            std::array<VkAttachmentReference, maxColorAttachments> colorReferences {};
+            VkAttachmentReference depthStencilReference {};
+            uint32_t numAttachments = 0;
+
+            for (size_t i = 0; i < key.numColorAttachments; i++)
+            {
+                const auto& attachment = key.attachments[i];
+
+                attachments[numAttachments] = VkAttachmentDescription {
+                    {}, mapTextureFormat(attachment.format), static_cast<VkSampleCountFlagBits>(key.sampleCount),
+                    mapAttachmentLoadOp(attachment.loadOp), mapAttachmentStoreOp(attachment.storeOp),
+                    VK_ATTACHMENT_LOAD_OP_DONT_CARE, VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+                };
+                colorReferences[i] = VkAttachmentReference { numAttachments, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+                numAttachments++;
+            }
+
+            const auto& depthStencil = key.attachments[maxColorAttachments];
+            const bool hasDepthStencil = depthStencil.format != format::Undefined;
+            if (hasDepthStencil)
+            {
+                const bool hasStencil = has_stencil_component(depthStencil.format);
+
+                // textures stay in their LLRI state, so the layouts don't change across the render pass
+                attachments[numAttachments] = VkAttachmentDescription {
+                    {}, mapTextureFormat(depthStencil.format), static_cast<VkSampleCountFlagBits>(key.sampleCount),
+                    mapAttachmentLoadOp(depthStencil.loadOp), mapAttachmentStoreOp(depthStencil.storeOp),
+                    hasStencil ? mapAttachmentLoadOp(depthStencil.loadOp) : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                    hasStencil ? mapAttachmentStoreOp(depthStencil.storeOp) : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+                };
+                depthStencilReference = VkAttachmentReference { numAttachments, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+                numAttachments++;
+            }
+
+            VkSubpassDescription subpass {};
+            subpass.flags = {};
+            subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpass.inputAttachmentCount = 0;
+            subpass.pInputAttachments = nullptr;
+            subpass.colorAttachmentCount = key.numColorAttachments;
+            subpass.pColorAttachments = colorReferences.data();
+            subpass.pResolveAttachments = nullptr;
+            subpass.pDepthStencilAttachment = hasDepthStencil ? &depthStencilReference : nullptr;
+            subpass.preserveAttachmentCount = 0;
+            subpass.pPreserveAttachments = nullptr;
+
+            VkRenderPassCreateInfo info {};
+            info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+            info.pNext = nullptr;
+            info.flags = {};
+            info.attachmentCount = numAttachments;
+            info.pAttachments = attachments.data();
+            info.subpassCount = 1;
+            info.pSubpasses = &subpass;
+            info.dependencyCount = 0;
+            info.pDependencies = nullptr;
+
+            const VkResult r = table->vkCreateRenderPass(device, &info, nullptr, renderPass);
+            if (r == VK_SUCCESS)
+                cache->renderPasses.emplace(key, *renderPass);
+
+            return r;
+        }
     }
 }
@@ -19,6 +19,9 @@
 #endif
 
 #include <graphics/vulkan/volk.h>
+#include <mutex>
+#include <memory>
+#include <cstring>
 
 // Linux X11 defines None which clashes with flags::None
 #ifdef __linux__
@@ -59,6 +62,11 @@ namespace llri
 
         result mapVkResult(VkResult result);
 
+        /**
+         * @brief Attaches a debug name to a Vulkan object through VK_EXT_debug_utils.
+        */
+        result setObjectName(VkDevice device, VkObjectType type, uint64_t handle, const char* name);
+
         constexpr VkCommandBufferLevel mapCommandListUsage(command_list_usage usage)
         {
             switch (usage)
@@ -74,6 +82,79 @@ namespace llri
             return {};
         }
 
+        /**
+         * @brief Returns the node mask with 0 interpreted as 1, which is how LLRI node masks are passed to Vulkan device masks.
+        */
+        constexpr uint32_t mapNodeMask(uint32_t nodeMask)
+        {
+            return nodeMask == 0 ? 1 : nodeMask;
+        }
+
+        /**
+         * @brief Returns the device index of the lowest node in the node mask, with 0 interpreted as 1.
+        */
+        constexpr uint32_t mapNodeIndex(uint32_t nodeMask)
+        {
+            return nodeIndex(mapNodeMask(nodeMask));
+        }
+
+        constexpr VkCommandBufferUsageFlags mapCommandListSubmitMode(command_list_submit_mode mode)
+        {
+            switch (mode)
+            {
+                case command_list_submit_mode::OneTime:
+                    return VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                case command_list_submit_mode::Resubmit:
+                    return 0;
+                case command_list_submit_mode::Simultaneous:
+                    return VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+                default:
+                    break;
+            }
+
+            return {};
+        }
+
+        constexpr VkQueryType mapQueryType(query_type type)
+        {
+            switch (type)
+            {
+                case query_type::Timestamp:
+                    return VK_QUERY_TYPE_TIMESTAMP;
+                case query_type::PipelineStatistics:
+                    return VK_QUERY_TYPE_PIPELINE_STATISTICS;
+                default:
+                    break;
+            }
+
+            return {};
+        }
+
+        /**
+         * @brief Maps pipeline_statistic_flags to VkQueryPipelineStatisticFlags. The flag bits are ordered like their Vulkan counterparts, so results are written in the order of pipeline_statistic_flag_bits.
+        */
+        constexpr VkQueryPipelineStatisticFlags mapPipelineStatistics(pipeline_statistic_flags statistics)
+        {
+            VkQueryPipelineStatisticFlags output = 0;
+
+            if (statistics.contains(pipeline_statistic_flag_bits::InputAssemblyVertices))
+                output |= VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT;
+            if (statistics.contains(pipeline_statistic_flag_bits::InputAssemblyPrimitives))
+                output |= VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT;
+            if (statistics.contains(pipeline_statistic_flag_bits::VertexShaderInvocations))
+                output |= VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT;
+            if (statistics.contains(pipeline_statistic_flag_bits::ClippingInvocations))
+                output |= VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT;
+            if (statistics.contains(pipeline_statistic_flag_bits::ClippingPrimitives))
+                output |= VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT;
+            if (statistics.contains(pipeline_statistic_flag_bits::FragmentShaderInvocations))
+                output |= VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+            if (statistics.contains(pipeline_statistic_flag_bits::ComputeShaderInvocations))
+                output |= VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+            return output;
+        }
+
         constexpr VkImageType mapTextureType(resource_type type)
         {
             switch (type)
@@ -367,24 +448,74 @@ namespace llri
     
         constexpr VkPipelineStageFlags mapStateToPipelineStage(resource_state state)
         {
+            constexpr VkPipelineStageFlags shaderStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            constexpr VkPipelineStageFlags depthStencilStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+
             constexpr std::array<VkPipelineStageFlags, static_cast<size_t>(resource_state::MaxEnum) + 1> map {
                 VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
                 VK_PIPELINE_STAGE_HOST_BIT,
                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                depthStencilStages,
+                depthStencilStages,
+                shaderStages,
+                shaderStages,
                 VK_PIPELINE_STAGE_TRANSFER_BIT,
                 VK_PIPELINE_STAGE_TRANSFER_BIT,
                 VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
                 VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+                shaderStages
             };
             
             return map[static_cast<size_t>(state)];
         }
 
+        constexpr VkPipelineStageFlags mapPipelineStages(pipeline_stage_flags stages)
+        {
+            VkPipelineStageFlags output = 0;
+
+            if (stages.contains(pipeline_stage_flag_bits::VertexInput))
+                output |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+            if (stages.contains(pipeline_stage_flag_bits::VertexShader))
+                output |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+            if (stages.contains(pipeline_stage_flag_bits::FragmentShader))
+                output |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            if (stages.contains(pipeline_stage_flag_bits::DepthStencilAttachment))
+                output |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            if (stages.contains(pipeline_stage_flag_bits::ColorAttachment))
+                output |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            if (stages.contains(pipeline_stage_flag_bits::ComputeShader))
+                output |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            if (stages.contains(pipeline_stage_flag_bits::Transfer))
+                output |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+            if (stages.contains(pipeline_stage_flag_bits::Host))
+                output |= VK_PIPELINE_STAGE_HOST_BIT;
+
+            return output;
+        }
+
+        /**
+         * @brief Returns the pipeline stages that queues of the given type can execute, which states derived through mapStateToPipelineStage() are masked with.
+        */
+        constexpr VkPipelineStageFlags getSupportedPipelineStages(queue_type type)
+        {
+            constexpr VkPipelineStageFlags commonStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT | VK_PIPELINE_STAGE_ALL_COMMANDS_BIT |
+                VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_HOST_BIT;
+
+            switch (type)
+            {
+                case queue_type::Graphics:
+                    return ~VkPipelineStageFlags(0);
+                case queue_type::Compute:
+                    return commonStages | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+                case queue_type::Transfer:
+                    return commonStages;
+                default:
+                    break;
+            }
+
+            return commonStages;
+        }
+
         constexpr VkImageUsageFlags mapTextureUsage(resource_usage_flags usage)
         {
             VkImageUsageFlags output = 0;
@@ -435,9 +566,167 @@ namespace llri
                 output |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
             if (usage.contains(resource_usage_flag_bits::ShaderWrite))
                 output |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+            // LLRI doesn't have usage flags for vertex and index buffers, any buffer can be bound as one
+            output |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+            return output;
+        }
+
+        constexpr VkShaderStageFlags mapShaderStages(shader_stage_flags stages)
+        {
+            VkShaderStageFlags output = 0;
+
+            if (stages.contains(shader_stage_flag_bits::Vertex))
+                output |= VK_SHADER_STAGE_VERTEX_BIT;
+            if (stages.contains(shader_stage_flag_bits::Fragment))
+                output |= VK_SHADER_STAGE_FRAGMENT_BIT;
+            if (stages.contains(shader_stage_flag_bits::Compute))
+                output |= VK_SHADER_STAGE_COMPUTE_BIT;
+
+            return output;
+        }
+
+        inline VkImageAspectFlags mapFormatAspects(format f)
+        {
+            VkImageAspectFlags output = 0;
+            if (has_color_component(f))
+                output |= VK_IMAGE_ASPECT_COLOR_BIT;
+            if (has_depth_component(f))
+                output |= VK_IMAGE_ASPECT_DEPTH_BIT;
+            if (has_stencil_component(f))
+                output |= VK_IMAGE_ASPECT_STENCIL_BIT;
             return output;
         }
 
+        constexpr VkPrimitiveTopology mapPrimitiveTopology(primitive_topology topology)
+        {
+            constexpr std::array<VkPrimitiveTopology, static_cast<size_t>(primitive_topology::MaxEnum) + 1> map {
+                VK_PRIMITIVE_TOPOLOGY_POINT_LIST,
+                VK_PRIMITIVE_TOPOLOGY_LINE_LIST,
+                VK_PRIMITIVE_TOPOLOGY_LINE_STRIP,
+                VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+                VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP
+            };
+
+            return map[static_cast<size_t>(topology)];
+        }
+
+        constexpr VkCullModeFlags mapCullMode(cull_mode mode)
+        {
+            constexpr std::array<VkCullModeFlags, static_cast<size_t>(cull_mode::MaxEnum) + 1> map {
+                VK_CULL_MODE_NONE,
+                VK_CULL_MODE_FRONT_BIT,
+                VK_CULL_MODE_BACK_BIT
+            };
+
+            return map[static_cast<size_t>(mode)];
+        }
+
+        constexpr VkFrontFace mapFrontFace(front_face face)
+        {
+            return face == front_face::Clockwise ? VK_FRONT_FACE_CLOCKWISE : VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        }
+
+        constexpr VkCompareOp mapCompareOp(compare_op op)
+        {
+            constexpr std::array<VkCompareOp, static_cast<size_t>(compare_op::MaxEnum) + 1> map {
+                VK_COMPARE_OP_NEVER,
+                VK_COMPARE_OP_LESS,
+                VK_COMPARE_OP_EQUAL,
+                VK_COMPARE_OP_LESS_OR_EQUAL,
+                VK_COMPARE_OP_GREATER,
+                VK_COMPARE_OP_NOT_EQUAL,
+                VK_COMPARE_OP_GREATER_OR_EQUAL,
+                VK_COMPARE_OP_ALWAYS
+            };
+
+            return map[static_cast<size_t>(op)];
+        }
+
+        constexpr VkStencilOp mapStencilOp(stencil_op op)
+        {
+            constexpr std::array<VkStencilOp, static_cast<size_t>(stencil_op::MaxEnum) + 1> map {
+                VK_STENCIL_OP_KEEP,
+                VK_STENCIL_OP_ZERO,
+                VK_STENCIL_OP_REPLACE,
+                VK_STENCIL_OP_INCREMENT_AND_CLAMP,
+                VK_STENCIL_OP_DECREMENT_AND_CLAMP,
+                VK_STENCIL_OP_INVERT,
+                VK_STENCIL_OP_INCREMENT_AND_WRAP,
+                VK_STENCIL_OP_DECREMENT_AND_WRAP
+            };
+
+            return map[static_cast<size_t>(op)];
+        }
+
+        constexpr VkBlendFactor mapBlendFactor(blend_factor factor)
+        {
+            constexpr std::array<VkBlendFactor, static_cast<size_t>(blend_factor::MaxEnum) + 1> map {
+                VK_BLEND_FACTOR_ZERO,
+                VK_BLEND_FACTOR_ONE,
+                VK_BLEND_FACTOR_SRC_COLOR,
+                VK_BLEND_FACTOR_ONE_MINUS_SRC_COLOR,
+                VK_BLEND_FACTOR_DST_COLOR,
+                VK_BLEND_FACTOR_ONE_MINUS_DST_COLOR,
+                VK_BLEND_FACTOR_SRC_ALPHA,
+                VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+                VK_BLEND_FACTOR_DST_ALPHA,
+                VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA
+            };
+
+            return map[static_cast<size_t>(factor)];
+        }
+
+        constexpr VkBlendOp mapBlendOp(blend_op op)
+        {
+            constexpr std::array<VkBlendOp, static_cast<size_t>(blend_op::MaxEnum) + 1> map {
+                VK_BLEND_OP_ADD,
+                VK_BLEND_OP_SUBTRACT,
+                VK_BLEND_OP_REVERSE_SUBTRACT,
+                VK_BLEND_OP_MIN,
+                VK_BLEND_OP_MAX
+            };
+
+            return map[static_cast<size_t>(op)];
+        }
+
+        constexpr VkColorComponentFlags mapColorComponents(color_component_flags components)
+        {
+            VkColorComponentFlags output = 0;
+
+            if (components.contains(color_component_flag_bits::R))
+                output |= VK_COLOR_COMPONENT_R_BIT;
+            if (components.contains(color_component_flag_bits::G))
+                output |= VK_COLOR_COMPONENT_G_BIT;
+            if (components.contains(color_component_flag_bits::B))
+                output |= VK_COLOR_COMPONENT_B_BIT;
+            if (components.contains(color_component_flag_bits::A))
+                output |= VK_COLOR_COMPONENT_A_BIT;
+
+            return output;
+        }
+
+        constexpr VkAttachmentLoadOp mapAttachmentLoadOp(attachment_load_op op)
+        {
+            constexpr std::array<VkAttachmentLoadOp, static_cast<size_t>(attachment_load_op::MaxEnum) + 1> map {
+                VK_ATTACHMENT_LOAD_OP_LOAD,
+                VK_ATTACHMENT_LOAD_OP_CLEAR,
+                VK_ATTACHMENT_LOAD_OP_DONT_CARE
+            };
+
+            return map[static_cast<size_t>(op)];
+        }
+
+        constexpr VkAttachmentStoreOp mapAttachmentStoreOp(attachment_store_op op)
+        {
+            return op == attachment_store_op::Store ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        }
+
+        constexpr VkIndexType mapIndexType(index_type type)
+        {
+            return type == index_type::UInt16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+        }
+
         constexpr VkMemoryPropertyFlags mapMemoryType(memory_type type)
         {
             VkMemoryPropertyFlags memFlags = 0;
@@ -526,9 +815,83 @@ namespace llri
             return hash;
         }
     
+        /**
+         * @brief Checks if the physical device exposes the device extension with the given name.
+        */
+        bool queryDeviceExtensionSupport(VkPhysicalDevice physicalDevice, const char* name);
+
         /**
          * @brief Finds LLRI standard queue families (Graphics, Compute, Transfer)
+         * Compute and Transfer prefer dedicated families, and fall back to a more general family that supports their operations if the physical device has no dedicated family for them.
+         * A queue_type maps to UINT32_MAX if no family supports it.
         */
         std::unordered_map<queue_type, uint32_t> findQueueFamilies(VkPhysicalDevice physicalDevice);
+
+        /**
+         * @brief Describes an attachment of a render pass. Render passes are an implementation detail of the Vulkan implementation, LLRI exposes them as rendering scopes (CommandList::beginRendering()).
+        */
+        struct render_pass_attachment
+        {
+            llri::format format;
+            attachment_load_op loadOp;
+            attachment_store_op storeOp;
+        };
+
+        /**
+         * @brief Uniquely identifies a render pass. Color attachments are stored in [0, numColorAttachments - 1], the depth stencil attachment is always stored at the last index and has format::Undefined if it's not used.
+        */
+        struct render_pass_key
+        {
+            uint8_t numColorAttachments;
+            sample_count sampleCount;
+            std::array<render_pass_attachment, maxColorAttachments + 1> attachments;
+
+            bool operator==(const render_pass_key& other) const
+            {
+                return std::memcmp(this, &other, sizeof(render_pass_key)) == 0;
+            }
+        };
+
+        struct render_pass_key_hash
+        {
+            size_t operator()(const render_pass_key& key) const;
+        };
+
+        /**
+         * @brief The storage that Queue::impl_submit() reuses for every submission. The vectors only grow, so submissions stop allocating memory once they've reached their largest size.
+        */
+        struct queue_submit_scratch
+        {
+            std::vector<VkSubmitInfo> submitInfos;
+            std::vector<VkTimelineSemaphoreSubmitInfoKHR> timelineInfos;
+            std::vector<VkCommandBuffer> commandBuffers;
+            std::vector<VkSemaphore> waitSemaphores;
+            std::vector<VkPipelineStageFlags> waitSemaphoreStages;
+            std::vector<VkSemaphore> signalSemaphores;
+            std::vector<VkDeviceGroupSubmitInfo> deviceGroupInfos;
+            std::vector<uint32_t> commandBufferDeviceMasks;
+            std::vector<uint32_t> waitSemaphoreDeviceIndices;
+            std::vector<uint32_t> signalSemaphoreDeviceIndices;
+
+            /**
+             * @brief Set if the VkQueue is used by more than one thread: if it's shared with other Queues because more Queues were requested from its family than the family has, or if the Queue was created with queue_submit_mode::Background.
+             * Every submit and wait on the VkQueue, including LLRI's internal ones, locks this mutex because Vulkan requires them to be externally synchronized.
+            */
+            std::shared_ptr<std::mutex> queueMutex;
+        };
+
+        /**
+         * @brief Render passes are created on demand and shared by all rendering scopes and pipelines on a Device with compatible attachments.
+        */
+        struct render_pass_cache
+        {
+            std::mutex mutex;
+            std::unordered_map<render_pass_key, VkRenderPass, render_pass_key_hash> renderPasses;
+        };
+
+        /**
+         * @brief Gets the render pass that matches the key, creating it if it doesn't exist yet.
+        */
+        VkResult getRenderPass(VkDevice device, VolkDeviceTable* table, render_pass_cache* cache, const render_pass_key& key, VkRenderPass* renderPass);
     }
 }
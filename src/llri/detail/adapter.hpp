@@ -69,6 +69,10 @@ namespace llri
          * @brief The ID of the adapter. This ID refers to the product type/version, meaning that if multiple of the same kind of adapters were to be present, this ID would be the same among all of them.
         */
         uint32_t adapterId;
+        /**
+         * @brief The version of the adapter's driver. The encoding of this value is vendor and implementation specific, but the value is guaranteed to change when the driver is updated.
+        */
+        uint64_t driverVersion;
         /**
          * @brief The name of the adapter. This string describes the adapter and usually includes the vendor name and the product type/version.
         */
@@ -86,7 +90,15 @@ namespace llri
     */
     struct adapter_features
     {
-        // reserved for future adapter features.
+        /**
+         * @brief Pipeline statistics queries **can** be used, see query_type::PipelineStatistics.
+        */
+        bool pipelineStatisticsQuery;
+
+        /**
+         * @brief Semaphores **can** be created with semaphore_type::Timeline, see Semaphore::signal() and Device::waitSemaphores().
+        */
+        bool timelineSemaphores;
     };
 
     /**
@@ -94,9 +106,75 @@ namespace llri
     */
     struct adapter_limits
     {
-        // reserved for future adapter limits.
+        /**
+         * @brief The maximum size, in bytes, of the push constant data that can be passed through CommandList::pushConstants().
+         * This value is guaranteed to be at least 128 bytes.
+        */
+        uint32_t maxPushConstantSize;
+        /**
+         * @brief The maximum number of color attachments that can be used in a graphics Pipeline and in CommandList::beginRendering().
+         * This value is guaranteed to be at least 4 and at most 8.
+        */
+        uint32_t maxColorAttachments;
+        /**
+         * @brief The maximum number of vertex buffer binding slots that can be used in a graphics Pipeline.
+        */
+        uint32_t maxVertexInputBindings;
+        /**
+         * @brief The maximum number of vertex attributes that can be used in a graphics Pipeline.
+        */
+        uint32_t maxVertexInputAttributes;
     };
 
+    /**
+     * @brief Describes how a device node **can** access the memory of a Resource that was created on another node, see Device::queryPeerMemoryFeatures().
+    */
+    enum struct peer_memory_feature_flag_bits : uint32_t
+    {
+        /**
+         * @brief The node can't access the other node's memory.
+        */
+        None = 0,
+        /**
+         * @brief The memory **can** be the source of copy commands such as CommandList::copyBuffer().
+        */
+        CopySrc = 1 << 0,
+        /**
+         * @brief The memory **can** be the destination of copy commands such as CommandList::copyBuffer().
+        */
+        CopyDst = 1 << 1,
+        /**
+         * @brief The memory **can** be read by any other command.
+        */
+        GenericSrc = 1 << 2,
+        /**
+         * @brief The memory **can** be written by any other command.
+        */
+        GenericDst = 1 << 3,
+        /**
+         * @brief All peer memory features combined.
+        */
+        All = CopySrc | CopyDst | GenericSrc | GenericDst
+    };
+    LLRI_DEFINE_FLAG_BIT_OPERATORS(peer_memory_feature_flag_bits)
+
+    /**
+     * @brief Converts a peer_memory_feature_flag_bits to a string.
+     * @return The enum value as a string, or "Invalid peer_memory_feature_flag_bits value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(peer_memory_feature_flag_bits bits);
+
+    /**
+     * @brief Describes a combination of peer memory features.
+    */
+    using peer_memory_feature_flags = flags<peer_memory_feature_flag_bits>;
+
+    /**
+     * @brief Converts peer_memory_feature_flags to a string.
+     * @return The flags as a string, or "Invalid peer_memory_feature_flags value" if the value was not recognized as a valid combination of peer_memory_feature_flag_bits.
+    */
+    inline std::string to_string(peer_memory_feature_flags flags);
+
     /**
      * @brief Describes a format's properties.
     */
@@ -197,10 +275,22 @@ namespace llri
          * @brief Query the maximum number of available queues for a given queue type.
          * @param type The type of queue. This must be a valid queue_type value, or the function returns 0.
          *
+         * If the adapter has no dedicated hardware for a queue_type, its Queues are executed by the queue_type that Adapter::queryQueueFamilyType() returns, and this function returns that type's count.
+         *
          * @note (Device nodes) Queues are shared across device nodes. The Queue selects nodes (Adapters) to execute the commands on based on command list parameters.
         */
         [[nodiscard]] uint8_t queryQueueCount(queue_type type) const;
 
+        /**
+         * @brief Query which queue_type's hardware executes Queues of the given type.
+         *
+         * Adapters without dedicated Compute or Transfer hardware execute those Queues on a more general queue family, such as the Graphics family. Queues that share a family are spread across its hardware queues, and share hardware queues if more Queues are created than the family has, so their work **may** not execute in parallel.
+         *
+         * @param type The type of queue. This must be a valid queue_type value, or the function returns type.
+         * @return type if the adapter has dedicated hardware for it, or the more general queue_type whose hardware executes its Queues.
+        */
+        [[nodiscard]] queue_type queryQueueFamilyType(queue_type type) const;
+
         /**
          * @brief Query the properties of all formats.
          * The resulting unordered_map contains a format_properties structure for every format in llri::format.
@@ -240,6 +330,7 @@ namespace llri
         [[nodiscard]] bool impl_queryExtensionSupport(adapter_extension ext) const;
 
         [[nodiscard]] uint8_t impl_queryQueueCount(queue_type type) const;
+        [[nodiscard]] queue_type impl_queryQueueFamilyType(queue_type type) const;
         [[nodiscard]] std::unordered_map<format, format_properties> impl_queryFormatProperties() const;
         
         result impl_querySurfacePresentSupportEXT(SurfaceEXT* surface, queue_type type, bool* support) const;
@@ -26,6 +26,61 @@ namespace llri
         return "Invalid adapter_type value";
     }
 
+    inline std::string to_string(peer_memory_feature_flag_bits bits)
+    {
+        switch(bits)
+        {
+            case peer_memory_feature_flag_bits::None:
+                return "None";
+            case peer_memory_feature_flag_bits::CopySrc:
+                return "CopySrc";
+            case peer_memory_feature_flag_bits::CopyDst:
+                return "CopyDst";
+            case peer_memory_feature_flag_bits::GenericSrc:
+                return "GenericSrc";
+            case peer_memory_feature_flag_bits::GenericDst:
+                return "GenericDst";
+            case peer_memory_feature_flag_bits::All:
+                return to_string(static_cast<peer_memory_feature_flags>(bits));
+        }
+
+        return "Invalid peer_memory_feature_flag_bits value";
+    }
+
+    inline std::string to_string(peer_memory_feature_flags flags)
+    {
+        std::string out;
+
+        constexpr std::array<peer_memory_feature_flag_bits, 4> allBits = {
+            peer_memory_feature_flag_bits::CopySrc,
+            peer_memory_feature_flag_bits::CopyDst,
+            peer_memory_feature_flag_bits::GenericSrc,
+            peer_memory_feature_flag_bits::GenericDst
+        };
+
+        for (auto elem : allBits)
+        {
+            if (flags.contains(elem))
+            {
+                out += " | " + to_string(elem);
+                flags.remove(elem);
+            }
+        }
+
+        // all flags should've been covered and removed
+        if (flags != peer_memory_feature_flag_bits::None)
+            return "Invalid peer_memory_feature_flags value";
+
+        // remove excessive initial " | "
+        if (!out.empty() && out[0] == ' ' && out[1] == '|' && out[2] == ' ')
+            out = out.substr(3);
+
+        if (out.empty())
+            return "None";
+
+        return out;
+    }
+
     inline Adapter::native_adapter* Adapter::getNative() const
     {
         return m_ptr;
@@ -86,6 +141,15 @@ namespace llri
         LLRI_DETAIL_CALL_IMPL(impl_queryQueueCount(type), m_validationCallbackMessenger)
     }
 
+    inline queue_type Adapter::queryQueueFamilyType(queue_type type) const
+    {
+        // invalid values are returned as-is, validation messages can't be reported through a queue_type return value
+        if (type > queue_type::MaxEnum)
+            return type;
+
+        LLRI_DETAIL_CALL_IMPL(impl_queryQueueFamilyType(type), m_validationCallbackMessenger)
+    }
+
     inline const std::unordered_map<format, format_properties>& Adapter::queryFormatProperties() const
     {
         if (m_cachedFormatProperties.empty())
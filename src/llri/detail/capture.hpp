@@ -0,0 +1,248 @@
+/**
+ * @file capture.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+#ifdef LLRI_DISABLE_CAPTURE
+#define LLRI_DETAIL_CAPTURE(device, call) { }
+#else
+#define LLRI_DETAIL_CAPTURE(device, call) { \
+        if ((device)->m_capture) \
+            (device)->m_capture->call; \
+    }
+#endif
+
+namespace llri
+{
+    class Device;
+    class Queue;
+    class CommandGroup;
+    class CommandList;
+    class Fence;
+    class Semaphore;
+    struct semaphore_desc;
+    class Resource;
+    class QueryPool;
+    struct query_pool_desc;
+    struct rendering_desc;
+    struct viewport;
+    struct label_color;
+    class Pipeline;
+    struct graphics_pipeline_desc;
+    struct shader_bytecode;
+
+    /**
+     * @brief The first four bytes of a capture file, "LLRC" when read as characters.
+    */
+    constexpr uint32_t captureMagic = 0x43524C4C;
+
+    /**
+     * @brief The version of the capture file format. Files with a different version **can not** be replayed.
+    */
+    constexpr uint32_t captureVersion = 2;
+
+    /**
+     * @brief The type of a record in a capture file.
+     *
+     * A capture file starts with captureMagic, captureVersion, a byte that is 1 if device_desc::resourceStateTracking was enabled, and the number of Queues followed by each Queue's queue_type and queue_priority byte.
+     * The Queues receive the object ids [1, numQueues] in the order of Device::getQueue() for Graphics, Compute and Transfer.
+     *
+     * Every record that follows starts with a capture_opcode byte. Integers are stored as little-endian uint32_t unless noted otherwise, enums, flags and signed integers are stored as uint32_t, floats are stored as the uint32_t of their bits, and objects are referenced by their uint32_t id, where 0 means nullptr or an object that was created before the capture began.
+     * Byte data is stored as its uint32_t size in bytes followed by the bytes, padded with zeros to a multiple of four bytes. Strings are stored as byte data without their null terminator.
+     *
+     * - CreateResource: id, resource_desc (createNodeMask, visibleNodeMask, type, usage, memoryType, initialState, width, height, depthOrArrayLayers, mipLevels, sampleCount, textureFormat, sharingMode).
+     * - CreateFence: id, fence_flags.
+     * - DestroyResource, DestroyFence, DestroySemaphore, DestroyCommandGroup, DestroyQueryPool, DestroyPipeline, EndCommandList, EndRendering, EndLabel: id.
+     * - CreateSemaphore: id, semaphore_type, initialValue as uint64_t.
+     * - CreateCommandGroup: id, queue_type.
+     * - ResetCommandGroup: group id, command_group_reset_mode.
+     * - AllocateCommandList: group id, list id, command_list_alloc_desc (nodeMask, usage).
+     * - FreeCommandList: group id, list id.
+     * - BeginCommandList: id, command_list_submit_mode, 1 if the CommandList inherits a rendering scope and 0 otherwise. An inherited scope is followed by its area (x, y, width, height), numColorAttachments and their formats, depthStencilFormat, sampleCount and stencilReference.
+     * - ResourceBarrier: list id, numBarriers, and per barrier: type, resource id, oldState, newState, subresource range (4 values), srcStages, dstStages, split, ownershipTransfer, ownershipQueue.
+     * - RequireResourceState: list id, resource id, state, subresource range (4 values).
+     * - Submit: queue id, nodeMask, numCommandLists and their ids, numWaitSemaphores and per Semaphore its id, value as uint64_t and pipeline_stage_flags, numSignalSemaphores and per Semaphore its id and value as uint64_t, fence id. Values and stages are 0 if the submit_desc had no values or stages.
+     * - WaitFences: numFences and their ids, timeout as uint64_t, waitAny.
+     * - ResetFences: numFences and their ids.
+     * - SignalSemaphore: id, value as uint64_t.
+     * - WaitSemaphores: numSemaphores and per Semaphore its id and value as uint64_t, timeout as uint64_t, waitAny.
+     * - CreateQueryPool: id, query_pool_desc (type, count, nodeMask, pipelineStatistics).
+     * - PushConstants: list id, stageMask, offset, the constants as byte data.
+     * - BeginRendering: list id, area (x, y, width, height), contents, numColorAttachments and per attachment its texture id, loadOp, storeOp and clear value (4 values), then the number of depth stencil attachments (0 or 1) and the attachment in the same layout. Color clear values are stored as r, g, b, a and depth stencil clear values as depth, stencil, 0, 0.
+     * - SetViewport: list id, x, y, width, height, minDepth, maxDepth.
+     * - SetScissor: list id, offset (x, y), extent (width, height).
+     * - SetStencilReference: list id, reference.
+     * - ExecuteIndirectLists: list id, numLists and their ids.
+     * - ResetQueries: list id, query pool id, firstQuery, numQueries.
+     * - WriteTimestamp, BeginQuery, EndQuery: list id, query pool id, query.
+     * - CopyBuffer: list id, src id, srcOffset as uint64_t, dst id, dstOffset as uint64_t, size as uint64_t.
+     * - ResolveQueries: list id, query pool id, firstQuery, numQueries, buffer id, offset as uint64_t.
+     * - BeginLabel, InsertLabel: list id, color (r, g, b, a), the name as a string.
+     * - CreateGraphicsPipeline: id, pushConstantStages, the vertex and fragment shader as their bytecode in byte data followed by their entryPoint as a string (empty if it was nullptr), topology, numVertexBindings and per binding its binding, stride and inputRate, numVertexAttributes and per attribute its location, binding, format and offset, rasterizer (cullMode, frontFace, depthBias, depthBiasSlopeScale), depthStencil (depthTestEnable, depthWriteEnable, depthCompareOp, stencilTestEnable, stencilReadMask, stencilWriteMask, then failOp, passOp, depthFailOp and compareOp for front and back), numColorAttachments and per attachment its format, blendEnable, srcColorFactor, dstColorFactor, colorOp, srcAlphaFactor, dstAlphaFactor, alphaOp and writeMask, depthStencilFormat, sampleCount.
+     * - BindPipeline: list id, pipeline id.
+     * - BindVertexBuffers: list id, firstBinding, numBuffers and per buffer its id and offset as uint64_t. Offsets are 0 if no offsets were passed.
+     * - BindIndexBuffer: list id, buffer id, offset as uint64_t, index_type.
+     * - Draw: list id, vertexCount, instanceCount, firstVertex, firstInstance.
+     * - DrawIndexed: list id, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance.
+     *
+     * graphics_pipeline_desc::cache isn't captured, so Pipelines are replayed without a PipelineCache.
+     * Object names and the utilities that are built on top of LLRI aren't captured either, the LLRI calls that they make are captured instead.
+    */
+    enum struct capture_opcode : uint8_t
+    {
+        CreateResource,
+        DestroyResource,
+        CreateFence,
+        DestroyFence,
+        CreateSemaphore,
+        DestroySemaphore,
+        CreateCommandGroup,
+        DestroyCommandGroup,
+        ResetCommandGroup,
+        AllocateCommandList,
+        FreeCommandList,
+        BeginCommandList,
+        EndCommandList,
+        ResourceBarrier,
+        RequireResourceState,
+        Submit,
+        WaitFences,
+        SignalSemaphore,
+        WaitSemaphores,
+        ResetFences,
+        CreateQueryPool,
+        DestroyQueryPool,
+        PushConstants,
+        BeginRendering,
+        EndRendering,
+        SetViewport,
+        SetScissor,
+        SetStencilReference,
+        ExecuteIndirectLists,
+        ResetQueries,
+        WriteTimestamp,
+        BeginQuery,
+        EndQuery,
+        CopyBuffer,
+        ResolveQueries,
+        BeginLabel,
+        EndLabel,
+        InsertLabel,
+        CreateGraphicsPipeline,
+        DestroyPipeline,
+        BindPipeline,
+        BindVertexBuffers,
+        BindIndexBuffer,
+        Draw,
+        DrawIndexed,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = DrawIndexed
+    };
+
+    /**
+     * @brief Converts a capture_opcode to a string.
+     * @return The enum value as a string, or "Invalid capture_opcode value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(capture_opcode opcode);
+
+    namespace detail
+    {
+        /**
+         * @brief Writes the LLRI calls of a Device into a capture file. Calls **may** be captured from multiple threads, records are written one at a time.
+        */
+        class capture_writer
+        {
+        public:
+            capture_writer(std::ofstream file, bool resourceStateTracking, uint32_t numQueues, Queue* const* queues, const queue_desc* queueDescs);
+
+            capture_writer(const capture_writer&) = delete;
+            capture_writer& operator=(const capture_writer&) = delete;
+
+            void createResource(const Resource* resource, const resource_desc& desc);
+            void destroyResource(const Resource* resource);
+            void createFence(const Fence* fence, fence_flags flags);
+            void destroyFence(const Fence* fence);
+            void createSemaphore(const Semaphore* semaphore, const semaphore_desc& desc);
+            void destroySemaphore(const Semaphore* semaphore);
+            void createCommandGroup(const CommandGroup* group, queue_type type);
+            void destroyCommandGroup(const CommandGroup* group);
+            void resetCommandGroup(const CommandGroup* group, command_group_reset_mode mode);
+            void allocateCommandList(const CommandGroup* group, const CommandList* list, const command_list_alloc_desc& desc);
+            void freeCommandList(const CommandGroup* group, const CommandList* list);
+            void beginCommandList(const CommandList* list, const command_list_begin_desc& desc);
+            void endCommandList(const CommandList* list);
+            void resourceBarrier(const CommandList* list, uint32_t numBarriers, const resource_barrier* barriers);
+            void requireResourceState(const CommandList* list, const Resource* resource, resource_state state, const texture_subresource_range& range);
+            void submit(const Queue* queue, const submit_desc& desc);
+            void waitFences(uint32_t numFences, Fence* const* fences, uint64_t timeout, bool waitAny);
+            void resetFences(uint32_t numFences, Fence* const* fences);
+            void signalSemaphore(const Semaphore* semaphore, uint64_t value);
+            void waitSemaphores(uint32_t numSemaphores, Semaphore* const* semaphores, const uint64_t* values, uint64_t timeout, bool waitAny);
+            void createQueryPool(const QueryPool* queryPool, const query_pool_desc& desc);
+            void destroyQueryPool(const QueryPool* queryPool);
+            void pushConstants(const CommandList* list, shader_stage_flags stageMask, uint32_t offset, uint32_t size, const void* data);
+            void beginRendering(const CommandList* list, const rendering_desc& desc);
+            void endRendering(const CommandList* list);
+            void setViewport(const CommandList* list, const viewport& vp);
+            void setScissor(const CommandList* list, const rect_2d& scissor);
+            void setStencilReference(const CommandList* list, uint8_t reference);
+            void executeIndirectLists(const CommandList* list, uint32_t numLists, CommandList* const* lists);
+            void resetQueries(const CommandList* list, const QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries);
+            void query(capture_opcode opcode, const CommandList* list, const QueryPool* queryPool, uint32_t index);
+            void copyBuffer(const CommandList* list, const Resource* src, uint64_t srcOffset, const Resource* dst, uint64_t dstOffset, uint64_t size);
+            void resolveQueries(const CommandList* list, const QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries, const Resource* buffer, uint64_t offset);
+            void label(capture_opcode opcode, const CommandList* list, const char* name, const label_color& color);
+            void endLabel(const CommandList* list);
+            void createGraphicsPipeline(const Pipeline* pipeline, const graphics_pipeline_desc& desc);
+            void destroyPipeline(const Pipeline* pipeline);
+            void bindPipeline(const CommandList* list, const Pipeline* pipeline);
+            void bindVertexBuffers(const CommandList* list, uint32_t firstBinding, uint32_t numBuffers, Resource* const* buffers, const uint64_t* offsets);
+            void bindIndexBuffer(const CommandList* list, const Resource* buffer, uint64_t offset, index_type type);
+            void draw(const CommandList* list, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+            void drawIndexed(const CommandList* list, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+
+            /**
+             * @brief Calls that are made by LLRI itself on the current thread aren't captured while a suspension is active, because replaying the outer call repeats them.
+            */
+            struct suspension
+            {
+                suspension() { suspensionDepth()++; }
+                ~suspension() { suspensionDepth()--; }
+
+                suspension(const suspension&) = delete;
+                suspension& operator=(const suspension&) = delete;
+            };
+
+        private:
+            static uint32_t& suspensionDepth();
+
+            void beginRecord(capture_opcode opcode);
+            void endRecord();
+
+            uint32_t addObject(const void* object);
+            uint32_t removeObject(const void* object);
+            uint32_t getObject(const void* object) const;
+
+            void write(uint32_t value);
+            void write(uint64_t value);
+            void write(float value);
+            void writeBytes(uint32_t size, const void* data);
+            void writeRange(const texture_subresource_range& range);
+            void writeRect(const rect_2d& rect);
+            void writeShader(const shader_bytecode& shader);
+
+            std::ofstream m_file;
+            std::mutex m_mutex;
+            std::vector<uint8_t> m_record;
+
+            std::unordered_map<const void*, uint32_t> m_ids;
+            uint32_t m_nextId = 1;
+        };
+    }
+}
@@ -0,0 +1,923 @@
+/**
+ * @file capture.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    inline std::string to_string(capture_opcode opcode)
+    {
+        switch (opcode)
+        {
+            case capture_opcode::CreateResource:
+                return "CreateResource";
+            case capture_opcode::DestroyResource:
+                return "DestroyResource";
+            case capture_opcode::CreateFence:
+                return "CreateFence";
+            case capture_opcode::DestroyFence:
+                return "DestroyFence";
+            case capture_opcode::CreateSemaphore:
+                return "CreateSemaphore";
+            case capture_opcode::DestroySemaphore:
+                return "DestroySemaphore";
+            case capture_opcode::CreateCommandGroup:
+                return "CreateCommandGroup";
+            case capture_opcode::DestroyCommandGroup:
+                return "DestroyCommandGroup";
+            case capture_opcode::ResetCommandGroup:
+                return "ResetCommandGroup";
+            case capture_opcode::AllocateCommandList:
+                return "AllocateCommandList";
+            case capture_opcode::FreeCommandList:
+                return "FreeCommandList";
+            case capture_opcode::BeginCommandList:
+                return "BeginCommandList";
+            case capture_opcode::EndCommandList:
+                return "EndCommandList";
+            case capture_opcode::ResourceBarrier:
+                return "ResourceBarrier";
+            case capture_opcode::RequireResourceState:
+                return "RequireResourceState";
+            case capture_opcode::Submit:
+                return "Submit";
+            case capture_opcode::WaitFences:
+                return "WaitFences";
+            case capture_opcode::SignalSemaphore:
+                return "SignalSemaphore";
+            case capture_opcode::WaitSemaphores:
+                return "WaitSemaphores";
+            case capture_opcode::ResetFences:
+                return "ResetFences";
+            case capture_opcode::CreateQueryPool:
+                return "CreateQueryPool";
+            case capture_opcode::DestroyQueryPool:
+                return "DestroyQueryPool";
+            case capture_opcode::PushConstants:
+                return "PushConstants";
+            case capture_opcode::BeginRendering:
+                return "BeginRendering";
+            case capture_opcode::EndRendering:
+                return "EndRendering";
+            case capture_opcode::SetViewport:
+                return "SetViewport";
+            case capture_opcode::SetScissor:
+                return "SetScissor";
+            case capture_opcode::SetStencilReference:
+                return "SetStencilReference";
+            case capture_opcode::ExecuteIndirectLists:
+                return "ExecuteIndirectLists";
+            case capture_opcode::ResetQueries:
+                return "ResetQueries";
+            case capture_opcode::WriteTimestamp:
+                return "WriteTimestamp";
+            case capture_opcode::BeginQuery:
+                return "BeginQuery";
+            case capture_opcode::EndQuery:
+                return "EndQuery";
+            case capture_opcode::CopyBuffer:
+                return "CopyBuffer";
+            case capture_opcode::ResolveQueries:
+                return "ResolveQueries";
+            case capture_opcode::BeginLabel:
+                return "BeginLabel";
+            case capture_opcode::EndLabel:
+                return "EndLabel";
+            case capture_opcode::InsertLabel:
+                return "InsertLabel";
+            case capture_opcode::CreateGraphicsPipeline:
+                return "CreateGraphicsPipeline";
+            case capture_opcode::DestroyPipeline:
+                return "DestroyPipeline";
+            case capture_opcode::BindPipeline:
+                return "BindPipeline";
+            case capture_opcode::BindVertexBuffers:
+                return "BindVertexBuffers";
+            case capture_opcode::BindIndexBuffer:
+                return "BindIndexBuffer";
+            case capture_opcode::Draw:
+                return "Draw";
+            case capture_opcode::DrawIndexed:
+                return "DrawIndexed";
+        }
+
+        return "Invalid capture_opcode value";
+    }
+
+    namespace detail
+    {
+        inline capture_writer::capture_writer(std::ofstream file, bool resourceStateTracking, uint32_t numQueues, Queue* const* queues, const queue_desc* queueDescs) : m_file(std::move(file))
+        {
+            write(captureMagic);
+            write(captureVersion);
+            m_record.push_back(resourceStateTracking ? 1 : 0);
+
+            write(numQueues);
+            for (uint32_t i = 0; i < numQueues; i++)
+            {
+                addObject(queues[i]);
+                m_record.push_back(static_cast<uint8_t>(queueDescs[i].type));
+                m_record.push_back(static_cast<uint8_t>(queueDescs[i].priority));
+            }
+
+            endRecord();
+        }
+
+        inline uint32_t& capture_writer::suspensionDepth()
+        {
+            thread_local uint32_t depth = 0;
+            return depth;
+        }
+
+        inline void capture_writer::beginRecord(capture_opcode opcode)
+        {
+            m_record.clear();
+            m_record.push_back(static_cast<uint8_t>(opcode));
+        }
+
+        inline void capture_writer::endRecord()
+        {
+            m_file.write(reinterpret_cast<const char*>(m_record.data()), static_cast<std::streamsize>(m_record.size()));
+            m_record.clear();
+        }
+
+        inline uint32_t capture_writer::addObject(const void* object)
+        {
+            // addresses can be reused after an object is destroyed, so a new object always receives a new id
+            const uint32_t id = m_nextId++;
+            m_ids[object] = id;
+            return id;
+        }
+
+        inline uint32_t capture_writer::removeObject(const void* object)
+        {
+            const auto it = m_ids.find(object);
+            if (it == m_ids.end())
+                return 0;
+
+            const uint32_t id = it->second;
+            m_ids.erase(it);
+            return id;
+        }
+
+        inline uint32_t capture_writer::getObject(const void* object) const
+        {
+            const auto it = m_ids.find(object);
+            return it == m_ids.end() ? 0 : it->second;
+        }
+
+        inline void capture_writer::write(uint32_t value)
+        {
+            for (size_t i = 0; i < sizeof(value); i++)
+                m_record.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+
+        inline void capture_writer::write(uint64_t value)
+        {
+            for (size_t i = 0; i < sizeof(value); i++)
+                m_record.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+
+        inline void capture_writer::write(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            write(bits);
+        }
+
+        inline void capture_writer::writeBytes(uint32_t size, const void* data)
+        {
+            write(size);
+
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            m_record.insert(m_record.end(), bytes, bytes + size);
+            m_record.resize(m_record.size() + (4 - size % 4) % 4, 0);
+        }
+
+        inline void capture_writer::writeRect(const rect_2d& rect)
+        {
+            write(static_cast<uint32_t>(rect.offset.x));
+            write(static_cast<uint32_t>(rect.offset.y));
+            write(rect.extent.width);
+            write(rect.extent.height);
+        }
+
+        inline void capture_writer::writeRange(const texture_subresource_range& range)
+        {
+            write(range.baseMipLevel);
+            write(range.numMipLevels);
+            write(range.baseArrayLayer);
+            write(range.numArrayLayers);
+        }
+
+        inline void capture_writer::writeShader(const shader_bytecode& shader)
+        {
+            writeBytes(static_cast<uint32_t>(shader.size), shader.bytecode);
+            writeBytes(shader.entryPoint ? static_cast<uint32_t>(std::strlen(shader.entryPoint)) : 0u, shader.entryPoint);
+        }
+
+        inline void capture_writer::createResource(const Resource* resource, const resource_desc& desc)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::CreateResource);
+            write(addObject(resource));
+            write(desc.createNodeMask);
+            write(desc.visibleNodeMask);
+            write(static_cast<uint32_t>(desc.type));
+            write(static_cast<uint32_t>(desc.usage.value));
+            write(static_cast<uint32_t>(desc.memoryType));
+            write(static_cast<uint32_t>(desc.initialState));
+            write(desc.width);
+            write(desc.height);
+            write(static_cast<uint32_t>(desc.depthOrArrayLayers));
+            write(static_cast<uint32_t>(desc.mipLevels));
+            write(static_cast<uint32_t>(desc.sampleCount));
+            write(static_cast<uint32_t>(desc.textureFormat));
+            write(static_cast<uint32_t>(desc.sharingMode));
+            endRecord();
+        }
+
+        inline void capture_writer::destroyResource(const Resource* resource)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::DestroyResource);
+            write(removeObject(resource));
+            endRecord();
+        }
+
+        inline void capture_writer::createFence(const Fence* fence, fence_flags flags)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::CreateFence);
+            write(addObject(fence));
+            write(static_cast<uint32_t>(flags.value));
+            endRecord();
+        }
+
+        inline void capture_writer::destroyFence(const Fence* fence)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::DestroyFence);
+            write(removeObject(fence));
+            endRecord();
+        }
+
+        inline void capture_writer::createSemaphore(const Semaphore* semaphore, const semaphore_desc& desc)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::CreateSemaphore);
+            write(addObject(semaphore));
+            write(static_cast<uint32_t>(desc.type));
+            write(desc.initialValue);
+            endRecord();
+        }
+
+        inline void capture_writer::destroySemaphore(const Semaphore* semaphore)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::DestroySemaphore);
+            write(removeObject(semaphore));
+            endRecord();
+        }
+
+        inline void capture_writer::createCommandGroup(const CommandGroup* group, queue_type type)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::CreateCommandGroup);
+            write(addObject(group));
+            write(static_cast<uint32_t>(type));
+            endRecord();
+        }
+
+        inline void capture_writer::destroyCommandGroup(const CommandGroup* group)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::DestroyCommandGroup);
+            write(removeObject(group));
+            endRecord();
+        }
+
+        inline void capture_writer::resetCommandGroup(const CommandGroup* group, command_group_reset_mode mode)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::ResetCommandGroup);
+            write(getObject(group));
+            write(static_cast<uint32_t>(mode));
+            endRecord();
+        }
+
+        inline void capture_writer::allocateCommandList(const CommandGroup* group, const CommandList* list, const command_list_alloc_desc& desc)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::AllocateCommandList);
+            write(getObject(group));
+            write(addObject(list));
+            write(desc.nodeMask);
+            write(static_cast<uint32_t>(desc.usage));
+            endRecord();
+        }
+
+        inline void capture_writer::freeCommandList(const CommandGroup* group, const CommandList* list)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::FreeCommandList);
+            write(getObject(group));
+            write(removeObject(list));
+            endRecord();
+        }
+
+        inline void capture_writer::beginCommandList(const CommandList* list, const command_list_begin_desc& desc)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::BeginCommandList);
+            write(getObject(list));
+            write(static_cast<uint32_t>(desc.submitMode));
+
+            write(static_cast<uint32_t>(desc.inheritance != nullptr));
+            if (desc.inheritance)
+            {
+                writeRect(desc.inheritance->area);
+                write(desc.inheritance->numColorAttachments);
+                for (uint32_t i = 0; i < desc.inheritance->numColorAttachments; i++)
+                    write(static_cast<uint32_t>(desc.inheritance->colorFormats[i]));
+                write(static_cast<uint32_t>(desc.inheritance->depthStencilFormat));
+                write(static_cast<uint32_t>(desc.inheritance->sampleCount));
+                write(static_cast<uint32_t>(desc.inheritance->stencilReference));
+            }
+            endRecord();
+        }
+
+        inline void capture_writer::endCommandList(const CommandList* list)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::EndCommandList);
+            write(getObject(list));
+            endRecord();
+        }
+
+        inline void capture_writer::resourceBarrier(const CommandList* list, uint32_t numBarriers, const resource_barrier* barriers)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::ResourceBarrier);
+            write(getObject(list));
+            write(numBarriers);
+            for (uint32_t i = 0; i < numBarriers; i++)
+            {
+                const resource_barrier& barrier = barriers[i];
+                const bool transition = barrier.type == resource_barrier_type::Transition;
+
+                write(static_cast<uint32_t>(barrier.type));
+                write(getObject(transition ? barrier.trans.resource : barrier.rw.resource));
+                write(static_cast<uint32_t>(transition ? barrier.trans.oldState : resource_state::General));
+                write(static_cast<uint32_t>(transition ? barrier.trans.newState : resource_state::General));
+                writeRange(transition ? barrier.trans.subresourceRange : texture_subresource_range::all());
+                write(static_cast<uint32_t>(barrier.srcStages.value));
+                write(static_cast<uint32_t>(barrier.dstStages.value));
+                write(static_cast<uint32_t>(barrier.split));
+                write(static_cast<uint32_t>(barrier.ownershipTransfer));
+                write(static_cast<uint32_t>(barrier.ownershipQueue));
+            }
+            endRecord();
+        }
+
+        inline void capture_writer::requireResourceState(const CommandList* list, const Resource* resource, resource_state state, const texture_subresource_range& range)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::RequireResourceState);
+            write(getObject(list));
+            write(getObject(resource));
+            write(static_cast<uint32_t>(state));
+            writeRange(range);
+            endRecord();
+        }
+
+        inline void capture_writer::submit(const Queue* queue, const submit_desc& desc)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::Submit);
+            write(getObject(queue));
+            write(desc.nodeMask);
+
+            write(desc.numCommandLists);
+            for (uint32_t i = 0; i < desc.numCommandLists; i++)
+                write(getObject(desc.commandLists[i]));
+
+            write(desc.numWaitSemaphores);
+            for (uint32_t i = 0; i < desc.numWaitSemaphores; i++)
+            {
+                write(getObject(desc.waitSemaphores[i]));
+                write(desc.waitSemaphoreValues ? desc.waitSemaphoreValues[i] : uint64_t(0));
+                write(desc.waitSemaphoreStages ? static_cast<uint32_t>(desc.waitSemaphoreStages[i].value) : 0u);
+            }
+
+            write(desc.numSignalSemaphores);
+            for (uint32_t i = 0; i < desc.numSignalSemaphores; i++)
+            {
+                write(getObject(desc.signalSemaphores[i]));
+                write(desc.signalSemaphoreValues ? desc.signalSemaphoreValues[i] : uint64_t(0));
+            }
+
+            write(getObject(desc.fence));
+            endRecord();
+        }
+
+        inline void capture_writer::waitFences(uint32_t numFences, Fence* const* fences, uint64_t timeout, bool waitAny)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::WaitFences);
+            write(numFences);
+            for (uint32_t i = 0; i < numFences; i++)
+                write(getObject(fences[i]));
+            write(timeout);
+            write(static_cast<uint32_t>(waitAny));
+            endRecord();
+        }
+
+        inline void capture_writer::resetFences(uint32_t numFences, Fence* const* fences)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::ResetFences);
+            write(numFences);
+            for (uint32_t i = 0; i < numFences; i++)
+                write(getObject(fences[i]));
+            endRecord();
+        }
+
+        inline void capture_writer::signalSemaphore(const Semaphore* semaphore, uint64_t value)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::SignalSemaphore);
+            write(getObject(semaphore));
+            write(value);
+            endRecord();
+        }
+
+        inline void capture_writer::waitSemaphores(uint32_t numSemaphores, Semaphore* const* semaphores, const uint64_t* values, uint64_t timeout, bool waitAny)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::WaitSemaphores);
+            write(numSemaphores);
+            for (uint32_t i = 0; i < numSemaphores; i++)
+            {
+                write(getObject(semaphores[i]));
+                write(values[i]);
+            }
+            write(timeout);
+            write(static_cast<uint32_t>(waitAny));
+            endRecord();
+        }
+
+        inline void capture_writer::createQueryPool(const QueryPool* queryPool, const query_pool_desc& desc)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::CreateQueryPool);
+            write(addObject(queryPool));
+            write(static_cast<uint32_t>(desc.type));
+            write(desc.count);
+            write(desc.nodeMask);
+            write(static_cast<uint32_t>(desc.pipelineStatistics.value));
+            endRecord();
+        }
+
+        inline void capture_writer::destroyQueryPool(const QueryPool* queryPool)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::DestroyQueryPool);
+            write(removeObject(queryPool));
+            endRecord();
+        }
+
+        inline void capture_writer::pushConstants(const CommandList* list, shader_stage_flags stageMask, uint32_t offset, uint32_t size, const void* data)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::PushConstants);
+            write(getObject(list));
+            write(static_cast<uint32_t>(stageMask.value));
+            write(offset);
+            writeBytes(size, data);
+            endRecord();
+        }
+
+        inline void capture_writer::beginRendering(const CommandList* list, const rendering_desc& desc)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const auto writeAttachment = [this](const rendering_attachment_desc& attachment, bool depthStencil) {
+                write(getObject(attachment.texture));
+                write(static_cast<uint32_t>(attachment.loadOp));
+                write(static_cast<uint32_t>(attachment.storeOp));
+                if (depthStencil)
+                {
+                    write(attachment.clearValue.depthStencil.depth);
+                    write(static_cast<uint32_t>(attachment.clearValue.depthStencil.stencil));
+                    write(0u);
+                    write(0u);
+                }
+                else
+                {
+                    write(attachment.clearValue.color.r);
+                    write(attachment.clearValue.color.g);
+                    write(attachment.clearValue.color.b);
+                    write(attachment.clearValue.color.a);
+                }
+            };
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::BeginRendering);
+            write(getObject(list));
+            writeRect(desc.area);
+            write(static_cast<uint32_t>(desc.contents));
+
+            write(desc.numColorAttachments);
+            for (uint32_t i = 0; i < desc.numColorAttachments; i++)
+                writeAttachment(desc.colorAttachments[i], false);
+
+            write(static_cast<uint32_t>(desc.depthStencilAttachment != nullptr));
+            if (desc.depthStencilAttachment)
+                writeAttachment(*desc.depthStencilAttachment, true);
+            endRecord();
+        }
+
+        inline void capture_writer::endRendering(const CommandList* list)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::EndRendering);
+            write(getObject(list));
+            endRecord();
+        }
+
+        inline void capture_writer::setViewport(const CommandList* list, const viewport& vp)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::SetViewport);
+            write(getObject(list));
+            write(vp.x);
+            write(vp.y);
+            write(vp.width);
+            write(vp.height);
+            write(vp.minDepth);
+            write(vp.maxDepth);
+            endRecord();
+        }
+
+        inline void capture_writer::setScissor(const CommandList* list, const rect_2d& scissor)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::SetScissor);
+            write(getObject(list));
+            writeRect(scissor);
+            endRecord();
+        }
+
+        inline void capture_writer::setStencilReference(const CommandList* list, uint8_t reference)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::SetStencilReference);
+            write(getObject(list));
+            write(static_cast<uint32_t>(reference));
+            endRecord();
+        }
+
+        inline void capture_writer::executeIndirectLists(const CommandList* list, uint32_t numLists, CommandList* const* lists)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::ExecuteIndirectLists);
+            write(getObject(list));
+            write(numLists);
+            for (uint32_t i = 0; i < numLists; i++)
+                write(getObject(lists[i]));
+            endRecord();
+        }
+
+        inline void capture_writer::resetQueries(const CommandList* list, const QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::ResetQueries);
+            write(getObject(list));
+            write(getObject(queryPool));
+            write(firstQuery);
+            write(numQueries);
+            endRecord();
+        }
+
+        inline void capture_writer::query(capture_opcode opcode, const CommandList* list, const QueryPool* queryPool, uint32_t index)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(opcode);
+            write(getObject(list));
+            write(getObject(queryPool));
+            write(index);
+            endRecord();
+        }
+
+        inline void capture_writer::copyBuffer(const CommandList* list, const Resource* src, uint64_t srcOffset, const Resource* dst, uint64_t dstOffset, uint64_t size)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::CopyBuffer);
+            write(getObject(list));
+            write(getObject(src));
+            write(srcOffset);
+            write(getObject(dst));
+            write(dstOffset);
+            write(size);
+            endRecord();
+        }
+
+        inline void capture_writer::resolveQueries(const CommandList* list, const QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries, const Resource* buffer, uint64_t offset)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::ResolveQueries);
+            write(getObject(list));
+            write(getObject(queryPool));
+            write(firstQuery);
+            write(numQueries);
+            write(getObject(buffer));
+            write(offset);
+            endRecord();
+        }
+
+        inline void capture_writer::label(capture_opcode opcode, const CommandList* list, const char* name, const label_color& color)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(opcode);
+            write(getObject(list));
+            write(color.r);
+            write(color.g);
+            write(color.b);
+            write(color.a);
+            writeBytes(static_cast<uint32_t>(std::strlen(name)), name);
+            endRecord();
+        }
+
+        inline void capture_writer::endLabel(const CommandList* list)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::EndLabel);
+            write(getObject(list));
+            endRecord();
+        }
+
+        inline void capture_writer::createGraphicsPipeline(const Pipeline* pipeline, const graphics_pipeline_desc& desc)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::CreateGraphicsPipeline);
+            write(addObject(pipeline));
+            write(static_cast<uint32_t>(desc.pushConstantStages.value));
+            writeShader(desc.vertexShader);
+            writeShader(desc.fragmentShader);
+            write(static_cast<uint32_t>(desc.topology));
+
+            write(desc.numVertexBindings);
+            for (uint32_t i = 0; i < desc.numVertexBindings; i++)
+            {
+                write(desc.vertexBindings[i].binding);
+                write(desc.vertexBindings[i].stride);
+                write(static_cast<uint32_t>(desc.vertexBindings[i].inputRate));
+            }
+
+            write(desc.numVertexAttributes);
+            for (uint32_t i = 0; i < desc.numVertexAttributes; i++)
+            {
+                write(desc.vertexAttributes[i].location);
+                write(desc.vertexAttributes[i].binding);
+                write(static_cast<uint32_t>(desc.vertexAttributes[i].format));
+                write(desc.vertexAttributes[i].offset);
+            }
+
+            write(static_cast<uint32_t>(desc.rasterizer.cullMode));
+            write(static_cast<uint32_t>(desc.rasterizer.frontFace));
+            write(static_cast<uint32_t>(desc.rasterizer.depthBias));
+            write(desc.rasterizer.depthBiasSlopeScale);
+
+            const depth_stencil_desc& ds = desc.depthStencil;
+            write(static_cast<uint32_t>(ds.depthTestEnable));
+            write(static_cast<uint32_t>(ds.depthWriteEnable));
+            write(static_cast<uint32_t>(ds.depthCompareOp));
+            write(static_cast<uint32_t>(ds.stencilTestEnable));
+            write(static_cast<uint32_t>(ds.stencilReadMask));
+            write(static_cast<uint32_t>(ds.stencilWriteMask));
+            for (const stencil_op_desc& face : { ds.front, ds.back })
+            {
+                write(static_cast<uint32_t>(face.failOp));
+                write(static_cast<uint32_t>(face.passOp));
+                write(static_cast<uint32_t>(face.depthFailOp));
+                write(static_cast<uint32_t>(face.compareOp));
+            }
+
+            write(desc.numColorAttachments);
+            for (uint32_t i = 0; i < desc.numColorAttachments; i++)
+            {
+                const pipeline_color_attachment_desc& attachment = desc.colorAttachments[i];
+                write(static_cast<uint32_t>(attachment.format));
+                write(static_cast<uint32_t>(attachment.blendEnable));
+                write(static_cast<uint32_t>(attachment.srcColorFactor));
+                write(static_cast<uint32_t>(attachment.dstColorFactor));
+                write(static_cast<uint32_t>(attachment.colorOp));
+                write(static_cast<uint32_t>(attachment.srcAlphaFactor));
+                write(static_cast<uint32_t>(attachment.dstAlphaFactor));
+                write(static_cast<uint32_t>(attachment.alphaOp));
+                write(static_cast<uint32_t>(attachment.writeMask.value));
+            }
+
+            write(static_cast<uint32_t>(desc.depthStencilFormat));
+            write(static_cast<uint32_t>(desc.sampleCount));
+            endRecord();
+        }
+
+        inline void capture_writer::destroyPipeline(const Pipeline* pipeline)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::DestroyPipeline);
+            write(removeObject(pipeline));
+            endRecord();
+        }
+
+        inline void capture_writer::bindPipeline(const CommandList* list, const Pipeline* pipeline)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::BindPipeline);
+            write(getObject(list));
+            write(getObject(pipeline));
+            endRecord();
+        }
+
+        inline void capture_writer::bindVertexBuffers(const CommandList* list, uint32_t firstBinding, uint32_t numBuffers, Resource* const* buffers, const uint64_t* offsets)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::BindVertexBuffers);
+            write(getObject(list));
+            write(firstBinding);
+            write(numBuffers);
+            for (uint32_t i = 0; i < numBuffers; i++)
+            {
+                write(getObject(buffers[i]));
+                write(offsets ? offsets[i] : uint64_t(0));
+            }
+            endRecord();
+        }
+
+        inline void capture_writer::bindIndexBuffer(const CommandList* list, const Resource* buffer, uint64_t offset, index_type type)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::BindIndexBuffer);
+            write(getObject(list));
+            write(getObject(buffer));
+            write(offset);
+            write(static_cast<uint32_t>(type));
+            endRecord();
+        }
+
+        inline void capture_writer::draw(const CommandList* list, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::Draw);
+            write(getObject(list));
+            write(vertexCount);
+            write(instanceCount);
+            write(firstVertex);
+            write(firstInstance);
+            endRecord();
+        }
+
+        inline void capture_writer::drawIndexed(const CommandList* list, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+        {
+            if (suspensionDepth() > 0)
+                return;
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            beginRecord(capture_opcode::DrawIndexed);
+            write(getObject(list));
+            write(indexCount);
+            write(instanceCount);
+            write(firstIndex);
+            write(static_cast<uint32_t>(vertexOffset));
+            write(firstInstance);
+            endRecord();
+        }
+    }
+}
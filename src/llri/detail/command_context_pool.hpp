@@ -0,0 +1,156 @@
+/**
+ * @file command_context_pool.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    class CommandGroup;
+    class CommandList;
+    class Fence;
+    struct command_list_alloc_desc;
+
+    /**
+     * @brief Describes how a CommandContextPool should be created.
+    */
+    struct command_context_pool_desc
+    {
+        /**
+         * @brief The type of queue that the CommandContextPool's CommandGroups allocate for.
+         *
+         * @note Valid usage (ErrorInvalidUsage): type **must** be less or equal to queue_type::MaxEnum.
+         * @note Valid usage (ErrorInvalidUsage): Device::queryQueueCount(type) **must** return more than 0.
+        */
+        queue_type type;
+        /**
+         * @brief The number of threads that record CommandLists simultaneously. Each thread is identified by an index in the range [0, numThreads - 1].
+         *
+         * @note Valid usage (ErrorInvalidUsage): numThreads **must** be more than 0.
+        */
+        uint32_t numThreads;
+        /**
+         * @brief The number of frames that **may** be processed by the GPU while the next frame is recorded. A separate CommandGroup is created for every thread in every frame.
+         *
+         * @note Valid usage (ErrorInvalidUsage): numFramesInFlight **must** be more than 0.
+        */
+        uint32_t numFramesInFlight;
+        /**
+         * @brief The mode that the CommandGroups are reset with. command_group_reset_mode::KeepMemory is recommended, because it prevents memory from being reallocated every frame.
+         *
+         * @note Valid usage (ErrorInvalidUsage): resetMode **must** be less or equal to command_group_reset_mode::MaxEnum.
+        */
+        command_group_reset_mode resetMode;
+    };
+
+    /**
+     * @brief CommandContextPool manages a CommandGroup for every recording thread and every frame in flight, so that CommandLists can be recorded on multiple threads without sharing CommandGroups.
+     *
+     * Every frame, CommandContextPool::beginFrame() moves to the next frame in flight and waits until the GPU has finished executing that frame's CommandLists, after which its CommandGroups are reset for reuse.
+     * The GPU's progress is tracked through the frame Fence, which **must** be signaled by the last Queue::submit() of each frame.
+     *
+     * CommandLists acquired through CommandContextPool::acquireCommandList() are recycled between frames instead of being allocated again.
+     *
+     * @note CommandContextPool::getCommandGroup() and CommandContextPool::acquireCommandList() **may** be called simultaneously from multiple threads, as long as each thread uses a different threadIndex. CommandContextPool::beginFrame() **must not** be called while CommandLists of the pool are being recorded.
+    */
+    class CommandContextPool
+    {
+        friend class Device;
+        friend class FrameGraph;
+        friend class FrameScheduler;
+
+    public:
+        /**
+         * @brief Get the desc that the CommandContextPool was created with.
+        */
+        [[nodiscard]] command_context_pool_desc getDesc() const;
+
+        /**
+         * @brief Get the index of the current frame in flight, which is in the range [0, command_context_pool_desc::numFramesInFlight - 1].
+        */
+        [[nodiscard]] uint32_t getFrameIndex() const;
+
+        /**
+         * @brief Get the Fence that tracks the current frame. The last Queue::submit() of the frame **must** signal this Fence, so that the frame's CommandGroups can be safely reset once the frame comes around again.
+         *
+         * @return The current frame's Fence, or nullptr if CommandContextPool::beginFrame() hasn't been called yet.
+        */
+        [[nodiscard]] Fence* getFrameFence() const;
+
+        /**
+         * @brief Move to the next frame in flight.
+         *
+         * If the next frame's Fence was signaled by a Queue::submit(), this function waits for it before the frame's CommandGroups are reset with command_context_pool_desc::resetMode. CommandLists that were acquired in that frame are returned to the pool and **must not** be used anymore.
+         *
+         * @param timeout The time in milliseconds that the function **may** wait for the frame's Fence. Refer to Device::waitFences() for more information.
+         *
+         * @note Valid usage (ErrorInvalidState): None of the next frame's CommandLists **may** be in the command_list_state::Recording state.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Timeout if the frame's Fence didn't signal within the timeout. The current frame isn't changed.
+         * @return Device::waitFences() and CommandGroup::reset() defined result values.
+        */
+        result beginFrame(uint64_t timeout);
+
+        /**
+         * @brief Get the CommandGroup of a thread in the current frame. The CommandGroup is reset automatically when its frame comes around again.
+         *
+         * @param threadIndex The index of the thread.
+         * @param cmdGroup A pointer to the resulting CommandGroup variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): cmdGroup **must** be a valid non-null pointer to a CommandGroup* variable.
+         * @note Valid usage (ErrorInvalidUsage): threadIndex **must** be less than command_context_pool_desc::numThreads.
+         * @note Valid usage (ErrorInvalidState): CommandContextPool::beginFrame() **must** have been called at least once.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result getCommandGroup(uint32_t threadIndex, CommandGroup** cmdGroup);
+
+        /**
+         * @brief Acquire a CommandList in the command_list_state::Empty state from a thread's CommandGroup in the current frame.
+         *
+         * CommandLists are allocated on demand and reused in later frames, so after the first few frames no CommandLists need to be allocated anymore.
+         *
+         * @param threadIndex The index of the thread.
+         * @param desc The allocation description of the CommandList.
+         * @param cmdList A pointer to the resulting CommandList variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): cmdList **must** be a valid non-null pointer to a CommandList* variable.
+         * @note Valid usage (ErrorInvalidUsage): threadIndex **must** be less than command_context_pool_desc::numThreads.
+         * @note Valid usage (ErrorInvalidState): CommandContextPool::beginFrame() **must** have been called at least once.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return CommandGroup::allocate() defined result values.
+        */
+        result acquireCommandList(uint32_t threadIndex, const command_list_alloc_desc& desc, CommandList** cmdList);
+
+    private:
+        // Force private constructor/deconstructor so that only create/destroy can manage lifetime
+        CommandContextPool() = default;
+        ~CommandContextPool() = default;
+
+        /**
+         * @brief The CommandGroup of a single thread in a single frame, and the CommandLists that were allocated through it.
+         * CommandLists in [0, numAcquiredLists - 1] were acquired in the frame, the rest are available for reuse.
+        */
+        struct command_context
+        {
+            CommandGroup* group = nullptr;
+            std::vector<CommandList*> lists;
+            size_t numAcquiredLists = 0;
+        };
+
+        Device* m_device = nullptr;
+        command_context_pool_desc m_desc;
+
+        // contexts are stored per frame, so the contexts of frame f are stored in [f * numThreads, (f + 1) * numThreads - 1]
+        std::vector<command_context> m_contexts;
+        std::vector<Fence*> m_fences;
+
+        uint32_t m_frameIndex = 0;
+        bool m_frameStarted = false;
+    };
+}
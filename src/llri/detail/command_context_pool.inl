@@ -0,0 +1,107 @@
+/**
+ * @file command_context_pool.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    inline command_context_pool_desc CommandContextPool::getDesc() const
+    {
+        return m_desc;
+    }
+
+    inline uint32_t CommandContextPool::getFrameIndex() const
+    {
+        return m_frameIndex;
+    }
+
+    inline Fence* CommandContextPool::getFrameFence() const
+    {
+        if (!m_frameStarted)
+            return nullptr;
+
+        return m_fences[m_frameIndex];
+    }
+
+    inline result CommandContextPool::beginFrame(uint64_t timeout)
+    {
+        const uint32_t next = m_frameStarted ? (m_frameIndex + 1) % m_desc.numFramesInFlight : 0;
+
+        // the frame's CommandLists can only be reused once the GPU is done with them
+        Fence* fence = m_fences[next];
+        if (fence->m_signaled)
+        {
+            const result r = m_device->waitFence(fence, timeout);
+            if (r != result::Success)
+                return r;
+        }
+
+        for (uint32_t thread = 0; thread < m_desc.numThreads; thread++)
+        {
+            auto& context = m_contexts[next * m_desc.numThreads + thread];
+
+            const result r = context.group->reset(m_desc.resetMode);
+            if (r != result::Success)
+                return r;
+
+            context.numAcquiredLists = 0;
+        }
+
+        m_frameIndex = next;
+        m_frameStarted = true;
+        return result::Success;
+    }
+
+    inline result CommandContextPool::getCommandGroup(uint32_t threadIndex, CommandGroup** cmdGroup)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(cmdGroup != nullptr, result::ErrorInvalidUsage)
+
+        *cmdGroup = nullptr;
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(threadIndex < m_desc.numThreads, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted, result::ErrorInvalidState)
+
+        *cmdGroup = m_contexts[m_frameIndex * m_desc.numThreads + threadIndex].group;
+        return result::Success;
+    }
+
+    inline result CommandContextPool::acquireCommandList(uint32_t threadIndex, const command_list_alloc_desc& desc, CommandList** cmdList)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(cmdList != nullptr, result::ErrorInvalidUsage)
+
+        *cmdList = nullptr;
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(threadIndex < m_desc.numThreads, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted, result::ErrorInvalidState)
+
+        auto& context = m_contexts[m_frameIndex * m_desc.numThreads + threadIndex];
+
+        // reuse a CommandList that was allocated with the same desc in an earlier frame
+        for (size_t i = context.numAcquiredLists; i < context.lists.size(); i++)
+        {
+            const command_list_alloc_desc listDesc = context.lists[i]->getDesc();
+            if (listDesc.usage == desc.usage && listDesc.nodeMask == desc.nodeMask)
+            {
+                std::swap(context.lists[i], context.lists[context.numAcquiredLists]);
+                *cmdList = context.lists[context.numAcquiredLists++];
+                return result::Success;
+            }
+        }
+
+        CommandList* output;
+        const result r = context.group->allocate(desc, &output);
+        if (r != result::Success)
+            return r;
+
+        context.lists.push_back(output);
+        std::swap(context.lists.back(), context.lists[context.numAcquiredLists]);
+        context.numAcquiredLists++;
+
+        *cmdList = output;
+        return result::Success;
+    }
+}
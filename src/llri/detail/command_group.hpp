@@ -14,6 +14,32 @@ namespace llri
     enum struct queue_type : uint8_t;
     struct command_list_alloc_desc;
 
+    /**
+     * @brief Describes what happens to the memory of a CommandGroup when it is reset.
+    */
+    enum struct command_group_reset_mode : uint8_t
+    {
+        /**
+         * @brief The CommandGroup's memory is released back to the system. This keeps the CommandGroup's memory usage low but causes the memory to be allocated again when its CommandLists are recorded.
+        */
+        ReleaseMemory,
+        /**
+         * @brief The CommandGroup keeps its memory so that it can be reused when its CommandLists are recorded again.
+         * This is the preferred mode for CommandGroups that are reset every frame, because recording then doesn't need to allocate memory after the first few frames.
+        */
+        KeepMemory,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = KeepMemory
+    };
+
+    /**
+     * @brief Converts a command_group_reset_mode to a string.
+     * @return The enum value as a string, or "Invalid command_group_reset_mode value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(command_group_reset_mode mode);
+
     /**
      * @brief CommandGroups are responsible for allocating the memory required to record CommandLists. They are used to allocate one or multiple CommandLists.
      *
@@ -39,19 +65,36 @@ namespace llri
          * Vulkan: VkCommandPool
          */
         [[nodiscard]] native_command_group* getNative() const;
+
+        /**
+         * @brief Set the name of the CommandGroup, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
         
         /**
          * @brief Reset the CommandGroup and all of the allocated CommandLists.
          * After this, the CommandLists in this CommandGroup will be ready for recording again.
          *
+         * @param mode Describes if the CommandGroup's memory is released or kept for reuse. DirectX12 always keeps the memory of its command allocators, so the mode only affects Vulkan.
+         *
          * @note The CommandLists in this CommandGroup **can not** be in use in Queue::submit() at this time.
          *
          * @note Valid usage (ErrorInvalidState): None of the CommandLists created by the Group can be in the command_list_state::Recording state.
+         * @note Valid usage (ErrorInvalidUsage): mode **must** be less or equal to command_group_reset_mode::MaxEnum.
          *
          * @return Success upon correct execution of the operation.
          * @return Implementation defined result values: ErrorOutOfDeviceMemory.
         */
-        result reset();
+        result reset(command_group_reset_mode mode = command_group_reset_mode::ReleaseMemory);
 
         /**
          * @brief Allocate a CommandList. The resulting CommandList will be of the same queue_type as the the CommandGroup, and is a non-owning pointer.
@@ -134,7 +177,8 @@ namespace llri
         CommandList* m_currentlyRecording = nullptr;
 #endif
 
-        result impl_reset();
+        result impl_reset(command_group_reset_mode mode);
+        result impl_setName(const char* name);
 
         result impl_allocate(const command_list_alloc_desc& desc, CommandList** cmdList);
         result impl_allocate(const command_list_alloc_desc& desc, uint8_t count, std::vector<CommandList*>* cmdLists);
@@ -9,6 +9,19 @@
 
 namespace llri
 {
+    inline std::string to_string(command_group_reset_mode mode)
+    {
+        switch(mode)
+        {
+            case command_group_reset_mode::ReleaseMemory:
+                return "ReleaseMemory";
+            case command_group_reset_mode::KeepMemory:
+                return "KeepMemory";
+        }
+
+        return "Invalid command_group_reset_mode value";
+    }
+
     inline queue_type CommandGroup::getType() const
     {
         return m_type;
@@ -19,16 +32,34 @@ namespace llri
         return m_ptr;
     }
 
-    inline result CommandGroup::reset()
+    inline result CommandGroup::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_validationCallbackMessenger)
+#endif
+    }
+
+    inline result CommandGroup::reset(command_group_reset_mode mode)
     {
+        LLRI_DETAIL_VALIDATION_REQUIRE(mode <= command_group_reset_mode::MaxEnum, result::ErrorInvalidUsage)
+
 #ifdef LLRI_DETAIL_ENABLE_VALIDATION
         for (auto* cmdList : m_cmdLists)
         {
             LLRI_DETAIL_VALIDATION_REQUIRE(cmdList->getState() != command_list_state::Recording, result::ErrorInvalidState)
+            LLRI_DETAIL_VALIDATION_REQUIRE(!cmdList->isInFlight(), result::ErrorInvalidState)
         }
 #endif
 
-        LLRI_DETAIL_CALL_IMPL(impl_reset(), m_validationCallbackMessenger)
+        LLRI_DETAIL_CAPTURE(m_device, resetCommandGroup(this, mode))
+        LLRI_DETAIL_CALL_IMPL(impl_reset(mode), m_validationCallbackMessenger)
     }
 
     inline result CommandGroup::allocate(const command_list_alloc_desc& desc, CommandList** cmdList)
@@ -42,7 +73,13 @@ namespace llri
         LLRI_DETAIL_VALIDATION_REQUIRE(detail::hasSingleBit(desc.nodeMask), result::ErrorInvalidNodeMask)
         LLRI_DETAIL_VALIDATION_REQUIRE(desc.nodeMask < (1u << m_device->m_adapter->queryNodeCount()), result::ErrorInvalidNodeMask)
 
-        LLRI_DETAIL_CALL_IMPL(impl_allocate(desc, cmdList), m_validationCallbackMessenger)
+        const result r = impl_allocate(desc, cmdList);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        if (r == result::Success)
+            LLRI_DETAIL_CAPTURE(m_device, allocateCommandList(this, *cmdList, desc))
+
+        return r;
     }
 
     inline result CommandGroup::allocate(const command_list_alloc_desc& desc, uint8_t count, std::vector<CommandList*>* cmdLists)
@@ -54,7 +91,18 @@ namespace llri
         LLRI_DETAIL_VALIDATION_REQUIRE(desc.usage <= command_list_usage::MaxEnum, result::ErrorInvalidUsage)
         LLRI_DETAIL_VALIDATION_REQUIRE(count > 0, result::ErrorInvalidUsage)
 
-        LLRI_DETAIL_CALL_IMPL(impl_allocate(desc, count, cmdLists), m_validationCallbackMessenger)
+        const result r = impl_allocate(desc, count, cmdLists);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+#ifndef LLRI_DISABLE_CAPTURE
+        if (r == result::Success)
+        {
+            for (auto* cmdList : *cmdLists)
+                LLRI_DETAIL_CAPTURE(m_device, allocateCommandList(this, cmdList, desc))
+        }
+#endif
+
+        return r;
     }
 
     inline result CommandGroup::free(CommandList* cmdList)
@@ -63,7 +111,9 @@ namespace llri
         LLRI_DETAIL_VALIDATION_REQUIRE(detail::contains(m_cmdLists, cmdList), result::ErrorInvalidUsage)
 
         LLRI_DETAIL_VALIDATION_REQUIRE(cmdList->getState() != command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!cmdList->isInFlight(), result::ErrorInvalidState)
 
+        LLRI_DETAIL_CAPTURE(m_device, freeCommandList(this, cmdList))
         LLRI_DETAIL_CALL_IMPL(impl_free(cmdList), m_validationCallbackMessenger)
     }
 
@@ -78,9 +128,15 @@ namespace llri
             LLRI_DETAIL_VALIDATION_REQUIRE_ITER(cmdLists[i] != nullptr, i, result::ErrorInvalidUsage)
             LLRI_DETAIL_VALIDATION_REQUIRE_ITER(detail::contains(m_cmdLists, cmdLists[i]), i, result::ErrorInvalidUsage)
             LLRI_DETAIL_VALIDATION_REQUIRE_ITER(cmdLists[i]->getState() != command_list_state::Recording, i, result::ErrorInvalidState)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(!cmdLists[i]->isInFlight(), i, result::ErrorInvalidState)
         }
 #endif
 
+#ifndef LLRI_DISABLE_CAPTURE
+        for (size_t i = 0; i < numCommandLists; i++)
+            LLRI_DETAIL_CAPTURE(m_device, freeCommandList(this, cmdLists[i]))
+#endif
+
         LLRI_DETAIL_CALL_IMPL(impl_free(numCommandLists, cmdLists), m_validationCallbackMessenger)
     }
 }
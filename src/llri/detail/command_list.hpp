@@ -10,8 +10,14 @@
 namespace llri
 {
     class CommandGroup;
+    class QueryPool;
     struct resource_barrier;
 
+    namespace detail
+    {
+        struct fence_submission_state;
+    }
+
     /**
      * @brief Describes how the CommandList is going to be used. A CommandList's usage is exclusive and can not be changed after allocation.
     */
@@ -25,7 +31,8 @@ namespace llri
          * @brief The CommandList is indirect and can be submitted to another CommandList before that CommandList is submitted to a queue.
          * This can be useful for recording a set of commands that can be dynamically submitted to other lists, which might save CPU time.
          *
-         * Indirect CommandLists **can not** be submitted to a queue directly.
+         * Indirect CommandLists **can not** be submitted to a queue directly, but are executed through CommandList::executeIndirectLists().
+         * Indirect CommandLists **can not** record resource barriers, rendering scopes or dynamic state (viewport, scissor and stencil reference), which they inherit from the CommandList that executes them.
         */
         Indirect,
         /**
@@ -84,12 +91,103 @@ namespace llri
         Ready
     };
 
+    /**
+     * @brief Describes the rendering scope that an Indirect CommandList will be executed in.
+     *
+     * Indirect CommandLists that are executed inside of a rendering scope record their draw commands as if they were inside of that scope. Because the scope's attachments aren't known while the Indirect CommandList is recorded, their layout is described up front.
+     * The viewport and scissor of the Indirect CommandList are initialized to area, and its stencil reference is initialized to stencilReference.
+    */
+    struct command_list_inheritance_desc
+    {
+        /**
+         * @brief The area of the rendering scope, which **must** be equal to the rendering_desc::area of the scope that the CommandList is executed in.
+         * @note Valid usage (ErrorInvalidUsage): area.extent.width and area.extent.height **must** be more than 0 and area.offset **must not** be negative.
+        */
+        rect_2d area;
+
+        /**
+         * @brief The number of color attachments in the rendering scope.
+         * @note Valid usage (ErrorExceededLimit): numColorAttachments **must** be less than or equal to adapter_limits::maxColorAttachments.
+        */
+        uint32_t numColorAttachments;
+        /**
+         * @brief The formats of the color attachments in the rendering scope.
+         * @note Valid usage (ErrorInvalidUsage): If numColorAttachments is more than 0, colorFormats **must** be a valid non-null pointer to an array of numColorAttachments formats.
+         * @note Valid usage (ErrorInvalidFormat): Every format **must** have a color component.
+        */
+        const format* colorFormats;
+        /**
+         * @brief The format of the depth stencil attachment in the rendering scope, or format::Undefined if the scope has no depth stencil attachment.
+         * @note Valid usage (ErrorInvalidUsage): At least one color or depth stencil attachment **must** be used.
+         * @note Valid usage (ErrorInvalidFormat): If depthStencilFormat isn't format::Undefined, it **must** have a depth or stencil component.
+        */
+        llri::format depthStencilFormat;
+        /**
+         * @brief The sample count of the attachments in the rendering scope.
+         * @note Valid usage (ErrorInvalidUsage): sampleCount **must** be less or equal to sample_count::MaxEnum.
+        */
+        sample_count sampleCount;
+
+        /**
+         * @brief The stencil reference value, which **must** be equal to the value that was last set through CommandList::setStencilReference() in the CommandList that executes the Indirect CommandList (or 0 if none was set).
+        */
+        uint8_t stencilReference;
+    };
+
+    /**
+     * @brief Describes how often a recorded CommandList will be submitted. For Indirect CommandLists this applies to how often they're executed through CommandList::executeIndirectLists().
+    */
+    enum struct command_list_submit_mode : uint8_t
+    {
+        /**
+         * @brief The CommandList is submitted only once after it was recorded. This is the default and allows the implementation to optimize the CommandList for a single submission.
+         * @note Valid usage (ErrorInvalidState): The CommandList **must not** be submitted again until it is reset and recorded again.
+        */
+        OneTime,
+        /**
+         * @brief The CommandList **may** be submitted more than once after it was recorded, which allows static work to be recorded once and submitted every frame.
+         * @note Valid usage (ErrorInvalidState): The CommandList **must not** be submitted while a previous submission is still in flight.
+        */
+        Resubmit,
+        /**
+         * @brief The CommandList **may** be submitted more than once after it was recorded, including while previous submissions are still in flight.
+         * Indirect CommandLists that are executed by multiple Direct CommandLists (e.g. every frame while earlier frames are still in flight) **must** use this mode.
+         * @note This mode **may** have a performance cost on some implementations.
+        */
+        Simultaneous,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Simultaneous
+    };
+
+    /**
+     * @brief Converts a command_list_submit_mode to a string.
+     * @return The enum value as a string, or "Invalid command_list_submit_mode value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(command_list_submit_mode mode);
+
     /**
      * @brief Contextual information about how (and on what GPU) the CommandList will be submitted, and what kind of information was previously set (if this is an indirect CommandList).
     */
     struct command_list_begin_desc
     {
-        // Empty placeholder structure for future begin information
+        /**
+         * @brief The rendering scope that the CommandList will be executed in, or nullptr if the CommandList isn't executed inside of a rendering scope.
+         *
+         * @note Valid usage (ErrorInvalidUsage): If inheritance isn't nullptr, the CommandList **must** have been allocated with command_list_usage::Indirect, through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): If inheritance isn't nullptr, it **must** be a valid pointer to a valid command_list_inheritance_desc.
+        */
+        const command_list_inheritance_desc* inheritance;
+
+        /**
+         * @brief Describes how often the CommandList will be submitted after it is recorded.
+         *
+         * Submissions are only tracked as being in flight if they signal a Fence, and they're considered finished once the Fence is waited upon through Device::waitFences(), or once Queue::waitIdle() is called on the Queue that they were submitted to.
+         *
+         * @note Valid usage (ErrorInvalidUsage): submitMode **must** be less or equal to command_list_submit_mode::MaxEnum.
+        */
+        command_list_submit_mode submitMode;
     };
 
     /**
@@ -98,6 +196,17 @@ namespace llri
     */
     inline std::string to_string(command_list_state state);
 
+    /**
+     * @brief The color of a CommandList label, with components in the range [0.0, 1.0]. Tools **may** ignore the color, and a color of all zeroes lets the tool pick one.
+    */
+    struct label_color
+    {
+        float r;
+        float g;
+        float b;
+        float a;
+    };
+
     class CommandList
     {
         friend class Device;
@@ -119,6 +228,20 @@ namespace llri
          * Vulkan: VkCommandBuffer
          */
         [[nodiscard]] native_command_list* getNative() const;
+
+        /**
+         * @brief Set the name of the CommandList, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
         
         /**
          * @brief Set the CommandList in a command_list_state::Recording state.
@@ -131,7 +254,7 @@ namespace llri
          * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Empty state.
          *
          * @return Success upon correct execution of the operation.
-         * @return command_list_begin_desc defined return values: -
+         * @return command_list_begin_desc defined return values: ErrorInvalidUsage, ErrorInvalidFormat, ErrorExceededLimit.
          *
          * @note The memory required for CommandList recording is allocated through its CommandGroup. Because of this, commandLists allocated through the same CommandGroup **can not** be recorded simultaneously and are thus not thread-safe. For multi-threaded recording, it is recommended to create at least one separate CommandGroup per thread to prevent this from becoming an issue.
         */
@@ -143,6 +266,11 @@ namespace llri
          * The CommandList **must** be in the command_list_state::Recording state for it to transition into a command_list_state::Ready state.
          *
          * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state.
+         * @note Valid usage (ErrorInvalidState): The CommandList **must not** be inside of a rendering scope, unless it is an Indirect CommandList that inherited its rendering scope through command_list_inheritance_desc.
+         * @note Valid usage (ErrorInvalidState): Every split barrier that was begun with resource_barrier_split::BeginOnly **must** have been ended with resource_barrier_split::EndOnly.
+         * @note Valid usage (ErrorInvalidState): Every label that was begun with CommandList::beginLabel() **must** have been ended with CommandList::endLabel().
+         *
+         * @note Transitions that were required through CommandList::requireResourceState() but haven't been recorded yet are recorded before the CommandList ends.
          *
          * @return Success upon correct execution of the operation.
         */
@@ -176,7 +304,11 @@ namespace llri
         /**
          * @brief Insert one or more resource memory dependencies.
          *
+         * Barriers with resource_barrier_split::BeginOnly or EndOnly are split barriers: the transition begins in one call and ends in a later call, which allows the Adapter to overlap the transition with the work that is recorded in between.
+         *
          * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct.
          *
          * @note Valid usage (ErrorInvalidUsage): numBarriers **must** be more than 0.
          * @note Valid usage (ErrorInvalidUsage): barriers **must** be a valid non-null pointer to a resource_barrier array of size numBarriers.
@@ -211,6 +343,395 @@ namespace llri
          * @return resource_barrier defined result values: ErrorInvalidUsage, ErrorInvalidState.
          */
         result resourceBarrier(const resource_barrier& barrier);
+
+        /**
+         * @brief Require a range of subresources to be in the given state for the commands that follow, without specifying the state that they are currently in.
+         *
+         * The CommandList tracks the state of every subresource that it uses. Required transitions are batched and recorded right before the next command that might access the resources, transitions that don't change a subresource's state are dropped and transitions of subresources between the same states are merged into a single barrier.
+         * The first state that the CommandList requires of a subresource is resolved during Queue::submit(), which inserts a fix-up barrier before the CommandList if the subresource is in a different state at that point.
+         *
+         * @param resource The resource to transition.
+         * @param state The state that the subresources must be in.
+         * @param range The subresources to transition. This value is ignored for buffers.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): The CommandList **must not** be inside of a rendering scope.
+         * @note Valid usage (ErrorInvalidState): The Device **must** have been created with device_desc::resourceStateTracking enabled.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct.
+         * @note Valid usage (ErrorInvalidUsage): resource **must** be a valid non-null pointer to a Resource.
+         * @note Valid usage (ErrorInvalidUsage): state **must** be less or equal to resource_state::MaxEnum, and range **must** be a valid subresource range of the resource, as described in resource_barrier::trans.
+         * @note Valid usage (ErrorInvalidState): The resource **must** support state, as described in resource_state.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result requireResourceState(Resource* resource, resource_state state, const texture_subresource_range& range = texture_subresource_range::all());
+
+        /**
+         * @brief Update the values of the push constants.
+         *
+         * Push constants are a small block of memory that is written directly into the CommandList, making them the fastest way of passing small amounts of frequently changing data (e.g. per-draw indices or transforms) to shaders.
+         * Push constant values persist within the CommandList until they are overwritten by another call to pushConstants().
+         *
+         * @param stageMask The shader stages that will read the updated push constant range.
+         * @param offset The offset in bytes at which the data is written in the push constant memory.
+         * @param size The size of the data in bytes.
+         * @param data A pointer to the data that will be copied into the push constants.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         *
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must not** have been allocated through a CommandGroup with queue_type::Transfer.
+         * @note Valid usage (ErrorInvalidUsage): stageMask **must not** be shader_stage_flag_bits::None and **must** be a valid combination of shader_stage_flag_bits.
+         * @note Valid usage (ErrorInvalidUsage): If stageMask contains shader_stage_flag_bits::Vertex or shader_stage_flag_bits::Fragment, the CommandList **must** have been allocated through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): offset and size **must** be a multiple of 4.
+         * @note Valid usage (ErrorInvalidUsage): size **must** be more than 0.
+         * @note Valid usage (ErrorInvalidUsage): data **must** be a valid non-null pointer to a block of memory of at least size bytes.
+         * @note Valid usage (ErrorExceededLimit): offset + size **must** be less than or equal to adapter_limits::maxPushConstantSize.
+         * @note Valid usage: For the values to be visible to a graphics Pipeline, stageMask **must** be equal to the Pipeline's graphics_pipeline_desc::pushConstantStages.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result pushConstants(shader_stage_flags stageMask, uint32_t offset, uint32_t size, const void* data);
+
+        /**
+         * @brief Update the values of the push constants.
+         *
+         * @note Utility function; the equivalent of calling pushConstants(stageMask, offset, sizeof(T), &data);
+         * @note Read the documentation for CommandList::pushConstants() for information on its valid usage and return values.
+        */
+        template<typename T>
+        result pushConstants(shader_stage_flags stageMask, uint32_t offset, const T& data)
+        {
+            return pushConstants(stageMask, offset, static_cast<uint32_t>(sizeof(T)), &data);
+        }
+
+        /**
+         * @brief Begin a rendering scope, in which draw commands render to the given attachments.
+         *
+         * The attachments' load operations are applied at the start of the scope and their store operations are applied at CommandList::endRendering(). The viewport and scissor are set to desc.area.
+         * If device_desc::resourceStateTracking is enabled, the attachments are transitioned to resource_state::ColorAttachment and resource_state::DepthStencilAttachment automatically. Depth stencil attachments that are in the resource_state::DepthStencilAttachmentReadOnly state keep their state.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): The CommandList **must not** already be inside of a rendering scope.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return rendering_desc defined result values: ErrorInvalidUsage, ErrorExceededLimit.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result beginRendering(const rendering_desc& desc);
+
+        /**
+         * @brief End the current rendering scope and apply the attachments' store operations.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be inside of a rendering scope.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result endRendering();
+
+        /**
+         * @brief Bind a Pipeline to the CommandList, which is used by all following draw commands.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): pipeline **must** be a valid non-null pointer to a Pipeline.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result bindPipeline(Pipeline* pipeline);
+
+        /**
+         * @brief Set the viewport that is used by the following draw commands.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct.
+         * @note Valid usage (ErrorInvalidUsage): vp.width and vp.height **must** be more than 0.
+         * @note Valid usage (ErrorInvalidUsage): vp.minDepth and vp.maxDepth **must** be between 0.0 and 1.0.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result setViewport(const viewport& vp);
+
+        /**
+         * @brief Set the scissor rectangle that is used by the following draw commands. Fragments outside of the scissor rectangle are discarded.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct.
+         * @note Valid usage (ErrorInvalidUsage): scissor.offset **must not** be negative.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result setScissor(const rect_2d& scissor);
+
+        /**
+         * @brief Set the stencil reference value that is used by stencil tests and stencil_op::Replace.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result setStencilReference(uint8_t reference);
+
+        /**
+         * @brief Bind one or more vertex buffers to consecutive binding slots.
+         *
+         * @param firstBinding The first binding slot that is bound to.
+         * @param numBuffers The number of buffers in the buffers array.
+         * @param buffers An array of buffers, which are bound to [firstBinding, firstBinding + numBuffers - 1].
+         * @param offsets An array of byte offsets into each buffer, or nullptr to bind every buffer from its start.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         * @note Valid usage (ErrorInvalidState): A Pipeline **must** have been bound through CommandList::bindPipeline(). Rebinding a Pipeline with different vertex bindings requires the vertex buffers to be rebound.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): numBuffers **must** be more than 0.
+         * @note Valid usage (ErrorExceededLimit): firstBinding + numBuffers **must** be less than or equal to adapter_limits::maxVertexInputBindings.
+         * @note Valid usage (ErrorInvalidUsage): buffers **must** be a valid non-null pointer to an array of numBuffers valid non-null pointers to Resources with resource_type::Buffer.
+         * @note Valid usage (ErrorInvalidUsage): Each offset **must** be less than the size of its buffer.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result bindVertexBuffers(uint32_t firstBinding, uint32_t numBuffers, Resource* const* buffers, const uint64_t* offsets);
+
+        /**
+         * @brief Bind an index buffer, which is used by CommandList::drawIndexed().
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): buffer **must** be a valid non-null pointer to a Resource with resource_type::Buffer.
+         * @note Valid usage (ErrorInvalidUsage): offset **must** be less than the size of the buffer and a multiple of the index size.
+         * @note Valid usage (ErrorInvalidUsage): type **must** be less or equal to index_type::MaxEnum.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result bindIndexBuffer(Resource* buffer, uint64_t offset, index_type type);
+
+        /**
+         * @brief Draw primitives using the bound Pipeline and vertex buffers.
+         *
+         * @param vertexCount The number of vertices to draw.
+         * @param instanceCount The number of instances to draw.
+         * @param firstVertex The index of the first vertex to draw.
+         * @param firstInstance The index of the first instance to draw.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be inside of a rendering scope.
+         * @note Valid usage (ErrorInvalidState): A Pipeline **must** have been bound through CommandList::bindPipeline().
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+
+        /**
+         * @brief Draw indexed primitives using the bound Pipeline, vertex buffers and index buffer.
+         *
+         * @param indexCount The number of indices to draw.
+         * @param instanceCount The number of instances to draw.
+         * @param firstIndex The index of the first index in the index buffer.
+         * @param vertexOffset The value added to each index before it's used to read from the vertex buffers.
+         * @param firstInstance The index of the first instance to draw.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::Inline.
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be inside of a rendering scope.
+         * @note Valid usage (ErrorInvalidState): A Pipeline **must** have been bound through CommandList::bindPipeline().
+         * @note Valid usage: An index buffer **must** have been bound through CommandList::bindIndexBuffer().
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+
+        /**
+         * @brief Execute one or more Indirect CommandLists as if their commands were recorded into this CommandList.
+         *
+         * Indirect CommandLists **can** be recorded in parallel on multiple threads (using separate CommandGroups) and stitched together into a single Direct CommandList.
+         * Indirect CommandLists that were started with command_list_submit_mode::Simultaneous **may** be executed multiple times (e.g. every frame) for as long as their CommandGroup isn't reset, which makes them useful for replaying static sets of commands at a low CPU cost.
+         *
+         * Indirect CommandLists don't inherit the bound Pipeline, vertex and index buffers or push constants from this CommandList, and after this call that state is undefined in this CommandList and **must** be set again before it is used.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the Recording state.
+         * @note Valid usage (ErrorInvalidState): If the CommandList is inside of a rendering scope, the scope **must** have been started with rendering_contents::IndirectLists.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct, through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): numLists **must** be more than 0.
+         * @note Valid usage (ErrorInvalidUsage): lists **must** be a valid non-null pointer to an array of numLists valid non-null pointers to CommandLists.
+         * @note Valid usage (ErrorInvalidUsage): Every CommandList in lists **must** have been allocated with command_list_usage::Indirect, through a CommandGroup with the same queue_type as this CommandList.
+         * @note Valid usage (ErrorInvalidState): Every CommandList in lists **must** be in the Ready state.
+         * @note Valid usage (ErrorInvalidState): Every CommandList in lists that was already executed since it was recorded **must** have been started with command_list_submit_mode::Simultaneous.
+         * @note Valid usage (ErrorInvalidUsage): If the CommandList is inside of a rendering scope, every CommandList in lists **must** have been started with a command_list_inheritance_desc with the same area, attachment formats, sample count and stencil reference as the scope. Otherwise, every CommandList in lists **must** have been started without a command_list_inheritance_desc.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result executeIndirectLists(uint32_t numLists, CommandList* const* lists);
+
+        /**
+         * @brief Reset a range of queries so that they **can** be written again. Queries **must** be reset before they're written for the first time, and before every following write.
+         *
+         * @param queryPool The QueryPool that contains the queries.
+         * @param firstQuery The index of the first query to reset.
+         * @param numQueries The number of queries to reset.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state, and **must not** be inside of a rendering scope.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct, through a CommandGroup with queue_type::Graphics or queue_type::Compute.
+         * @note Valid usage (ErrorInvalidUsage): queryPool **must** be a valid non-null pointer to a QueryPool.
+         * @note Valid usage (ErrorInvalidUsage): numQueries **must** be more than 0, and firstQuery + numQueries **must** be less or equal to query_pool_desc::count.
+         * @note Valid usage (ErrorIncompatibleNodeMask): queryPool **must** have been created with the same nodeMask as the CommandList.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result resetQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries);
+
+        /**
+         * @brief Write the GPU timestamp into a query after all previously recorded commands have completed.
+         *
+         * @param queryPool The QueryPool that contains the query, which **must** have been created with query_type::Timestamp.
+         * @param query The index of the query to write.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct, through a CommandGroup with queue_type::Graphics or queue_type::Compute.
+         * @note Valid usage (ErrorFeatureNotSupported): Queue::queryTimestampPeriod() **must** return more than 0.0 for Queues of the CommandList's queue_type.
+         * @note Valid usage (ErrorInvalidUsage): queryPool **must** be a valid non-null pointer to a QueryPool that was created with query_type::Timestamp.
+         * @note Valid usage (ErrorInvalidUsage): query **must** be less than query_pool_desc::count.
+         * @note Valid usage (ErrorIncompatibleNodeMask): queryPool **must** have been created with the same nodeMask as the CommandList.
+         * @note Valid usage: The query **must** have been reset with CommandList::resetQueries() since it was last written.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result writeTimestamp(QueryPool* queryPool, uint32_t query);
+
+        /**
+         * @brief Start collecting pipeline statistics into a query. The query counts the work of all the commands that are recorded until CommandList::endQuery() is called with the same query.
+         *
+         * @param queryPool The QueryPool that contains the query, which **must** have been created with query_type::PipelineStatistics.
+         * @param query The index of the query to begin.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct, through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): queryPool **must** be a valid non-null pointer to a QueryPool that was created with query_type::PipelineStatistics.
+         * @note Valid usage (ErrorInvalidUsage): query **must** be less than query_pool_desc::count.
+         * @note Valid usage (ErrorIncompatibleNodeMask): queryPool **must** have been created with the same nodeMask as the CommandList.
+         * @note Valid usage: The query **must** have been reset with CommandList::resetQueries() since it was last ended.
+         * @note Valid usage: The query **must** be ended with CommandList::endQuery() in the same CommandList, inside of the same rendering scope if it was begun inside of one, and no other pipeline statistics query **may** be active in the CommandList in the meantime.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result beginQuery(QueryPool* queryPool, uint32_t query);
+
+        /**
+         * @brief Stop collecting pipeline statistics into a query that was begun with CommandList::beginQuery().
+         *
+         * @param queryPool The QueryPool that contains the query, which **must** have been created with query_type::PipelineStatistics.
+         * @param query The index of the query to end.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct, through a CommandGroup with queue_type::Graphics.
+         * @note Valid usage (ErrorInvalidUsage): queryPool **must** be a valid non-null pointer to a QueryPool that was created with query_type::PipelineStatistics.
+         * @note Valid usage (ErrorInvalidUsage): query **must** be less than query_pool_desc::count.
+         * @note Valid usage (ErrorIncompatibleNodeMask): queryPool **must** have been created with the same nodeMask as the CommandList.
+         * @note Valid usage: The query **must** have been begun with CommandList::beginQuery() in this CommandList.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result endQuery(QueryPool* queryPool, uint32_t query);
+
+        /**
+         * @brief Copy a range of bytes from one buffer into another.
+         *
+         * Either buffer **may** have been created on another node than the CommandList's node, in which case the copy accesses that node's memory directly (peer memory), without a round trip through host memory.
+         *
+         * @param src The buffer to copy from, which **must** be in the resource_state::TransferSrc state.
+         * @param srcOffset The offset in bytes into src at which the copy starts.
+         * @param dst The buffer to copy into, which **must** be in the resource_state::TransferDst state.
+         * @param dstOffset The offset in bytes into dst at which the copy starts.
+         * @param size The number of bytes to copy.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state, and **must not** be inside of a rendering scope.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct.
+         * @note Valid usage (ErrorInvalidUsage): src **must** be a valid non-null pointer to a Resource with resource_type::Buffer, which was created with resource_usage_flag_bits::TransferSrc.
+         * @note Valid usage (ErrorInvalidUsage): dst **must** be a valid non-null pointer to a Resource with resource_type::Buffer, which was created with resource_usage_flag_bits::TransferDst.
+         * @note Valid usage (ErrorInvalidUsage): size **must** be more than 0, srcOffset + size **must** be less or equal to src's width, and dstOffset + size **must** be less or equal to dst's width.
+         * @note Valid usage (ErrorInvalidUsage): If src and dst are the same Resource, the source and destination ranges **must not** overlap.
+         * @note Valid usage (ErrorIncompatibleNodeMask): The CommandList's node **must** be set in the resource_desc::visibleNodeMask of src and dst.
+         * @note Valid usage (ErrorFeatureNotSupported): If src was created on another node, Device::queryPeerMemoryFeatures() **must** report peer_memory_feature_flag_bits::CopySrc for the CommandList's node and src's node. If dst was created on another node, it **must** report peer_memory_feature_flag_bits::CopyDst for the CommandList's node and dst's node.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result copyBuffer(Resource* src, uint64_t srcOffset, Resource* dst, uint64_t dstOffset, uint64_t size);
+
+        /**
+         * @brief Copy the results of a range of queries into a buffer, waiting for the queries to finish on the GPU. Each result takes up QueryPool::getResultSize() bytes.
+         *
+         * @param queryPool The QueryPool that contains the queries.
+         * @param firstQuery The index of the first query to copy.
+         * @param numQueries The number of queries to copy.
+         * @param buffer The buffer to copy the results into, which **must** be in the resource_state::TransferDst state.
+         * @param offset The offset in bytes into buffer at which the first result is written.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state, and **must not** be inside of a rendering scope.
+         * @note Valid usage (ErrorInvalidUsage): The CommandList **must** have been allocated with command_list_usage::Direct, through a CommandGroup with queue_type::Graphics or queue_type::Compute.
+         * @note Valid usage (ErrorInvalidUsage): queryPool **must** be a valid non-null pointer to a QueryPool.
+         * @note Valid usage (ErrorInvalidUsage): numQueries **must** be more than 0, and firstQuery + numQueries **must** be less or equal to query_pool_desc::count.
+         * @note Valid usage (ErrorIncompatibleNodeMask): queryPool **must** have been created with the same nodeMask as the CommandList.
+         * @note Valid usage (ErrorInvalidUsage): buffer **must** be a valid non-null pointer to a Resource with resource_type::Buffer, which was created with resource_usage_flag_bits::TransferDst.
+         * @note Valid usage (ErrorInvalidUsage): offset **must** be a multiple of 8, and offset + numQueries * QueryPool::getResultSize() **must** be less or equal to the buffer's width.
+         * @note Valid usage: Each query in the range **must** have been written since it was last reset.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result resolveQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries, Resource* buffer, uint64_t offset);
+
+        /**
+         * @brief Begin a named region of commands, which groups the commands that are recorded until the matching CommandList::endLabel() in debugging and profiling tools such as RenderDoc, PIX and Nsight. Labels **can** be nested.
+         *
+         * The label is only recorded if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name of the region as a null-terminated string.
+         * @param color The color of the region.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state.
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result beginLabel(const char* name, const label_color& color = {});
+
+        /**
+         * @brief End the region that was most recently begun with CommandList::beginLabel().
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state.
+         * @note Valid usage (ErrorInvalidState): A label **must** have been begun in this CommandList that hasn't been ended yet.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result endLabel();
+
+        /**
+         * @brief Insert a single named marker between the commands of the CommandList.
+         *
+         * The label is only recorded if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name of the marker as a null-terminated string.
+         * @param color The color of the marker.
+         *
+         * @note Valid usage (ErrorInvalidState): The CommandList **must** be in the command_list_state::Recording state.
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result insertLabel(const char* name, const label_color& color = {});
     private:
         // Force private constructor/deconstructor so that only alloc/free can manage lifetime
         CommandList() = default;
@@ -227,9 +748,92 @@ namespace llri
 
         void* m_validationCallbackMessenger = nullptr;
 
+        // the bound pipeline and the attachments of the current rendering scope
+        // DirectX12 resolves the attachment store operations at endRendering()
+        Pipeline* m_pipeline = nullptr;
+        bool m_isRendering = false;
+        uint32_t m_numRenderingAttachments = 0;
+        std::array<rendering_attachment_desc, detail::maxColorAttachments + 1> m_renderingAttachments {};
+
+        // the layout of the current rendering scope, which is used to validate executeIndirectLists()
+        // Indirect CommandLists that were started with a command_list_inheritance_desc are inside of an inherited rendering scope for their entire recording
+        rendering_contents m_renderingContents = rendering_contents::Inline;
+        bool m_inheritsRendering = false;
+        rect_2d m_renderingArea {};
+        detail::rendering_layout m_renderingLayout {};
+        uint8_t m_stencilReference = 0;
+
+        command_list_submit_mode m_submitMode = command_list_submit_mode::OneTime;
+
+#ifndef LLRI_DISABLE_VALIDATION
+        // the number of times that the list was submitted since it was recorded, and the fenced submissions that may still be in flight
+        uint32_t m_numSubmissions = 0;
+        std::vector<std::pair<std::shared_ptr<detail::fence_submission_state>, uint64_t>> m_pendingSubmissions;
+
+        [[nodiscard]] bool isInFlight() const;
+        void trackSubmission(const std::shared_ptr<detail::fence_submission_state>& fenceState);
+
+        // the number of labels that were begun but not ended yet
+        uint32_t m_numOpenLabels = 0;
+#endif
+
+        // split barriers that have begun but not ended yet
+        std::vector<detail::split_barrier> m_splitBarriers;
+
+        // returns the index of the begun split barrier that the end barrier matches, or m_splitBarriers.size() if there is none
+        [[nodiscard]] size_t findSplitBarrier(const resource_barrier& barrier) const;
+
+        // Vulkan: the VkEvents that are used for split barriers, reused every time the CommandList is recorded and destroyed when the CommandList is freed
+        std::vector<void*> m_events;
+        size_t m_numUsedEvents = 0;
+
+        // Vulkan: the framebuffers that were created by beginRendering(), destroyed when the CommandList is reset or freed
+        std::vector<void*> m_framebuffers;
+
+        // DirectX12: the queries that were written by writeTimestamp() or endQuery(), resolved into their pool's readback buffer in contiguous ranges by end()
+        std::vector<std::pair<QueryPool*, uint32_t>> m_queriesToResolve;
+
+        // resource state tracking, only used if device_desc::resourceStateTracking is enabled
+        std::unordered_map<Resource*, detail::resource_state_tracker> m_resourceStates;
+        std::vector<detail::pending_transition> m_pendingTransitions;
+        std::vector<resource_barrier> m_pendingBarriers; // reused storage for merging m_pendingTransitions
+
+        [[nodiscard]] bool tracksResourceStates() const;
+        detail::resource_state_tracker& getResourceStateTracker(Resource* resource);
+        void trackTransition(Resource* resource, resource_state state, const texture_subresource_range& range);
+        void trackBarriers(uint32_t numBarriers, const resource_barrier* barriers);
+        result flushPendingTransitions();
+
+        // compares the first states of the tracked subresources against their global states, appends the necessary fix-up transitions, and updates the global states to the states after this CommandList
+        // the global states are read from and written to states, which starts out with the Resources' tracked states, so that they're only committed once the submission succeeds
+        void resolveResourceStates(std::unordered_map<Resource*, std::vector<resource_state>>& states, std::vector<detail::pending_transition>& fixups) const;
+
+        result impl_setName(const char* name);
         result impl_begin(const command_list_begin_desc& desc);
         result impl_end();
         
         result impl_resourceBarrier(uint32_t numBarriers, const resource_barrier* barriers);
+        result impl_pushConstants(shader_stage_flags stageMask, uint32_t offset, uint32_t size, const void* data);
+
+        result impl_beginRendering(const rendering_desc& desc);
+        result impl_endRendering();
+        result impl_bindPipeline(Pipeline* pipeline);
+        result impl_setViewport(const viewport& vp);
+        result impl_setScissor(const rect_2d& scissor);
+        result impl_setStencilReference(uint8_t reference);
+        result impl_bindVertexBuffers(uint32_t firstBinding, uint32_t numBuffers, Resource* const* buffers, const uint64_t* offsets);
+        result impl_bindIndexBuffer(Resource* buffer, uint64_t offset, index_type type);
+        result impl_draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+        result impl_drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+        result impl_executeIndirectLists(uint32_t numLists, CommandList* const* lists);
+        result impl_resetQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries);
+        result impl_writeTimestamp(QueryPool* queryPool, uint32_t query);
+        result impl_beginQuery(QueryPool* queryPool, uint32_t query);
+        result impl_endQuery(QueryPool* queryPool, uint32_t query);
+        result impl_resolveQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries, Resource* buffer, uint64_t offset);
+        result impl_copyBuffer(Resource* src, uint64_t srcOffset, Resource* dst, uint64_t dstOffset, uint64_t size);
+        result impl_beginLabel(const char* name, const label_color& color);
+        result impl_endLabel();
+        result impl_insertLabel(const char* name, const label_color& color);
     };
 }
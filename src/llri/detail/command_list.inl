@@ -37,6 +37,21 @@ namespace llri
         return "Invalid command_list_state value";
     }
 
+    inline std::string to_string(command_list_submit_mode mode)
+    {
+        switch(mode)
+        {
+            case command_list_submit_mode::OneTime:
+                return "OneTime";
+            case command_list_submit_mode::Resubmit:
+                return "Resubmit";
+            case command_list_submit_mode::Simultaneous:
+                return "Simultaneous";
+        }
+
+        return "Invalid command_list_submit_mode value";
+    }
+
     inline command_list_alloc_desc CommandList::getDesc() const
     {
         return m_desc;
@@ -47,27 +62,100 @@ namespace llri
         return m_ptr;
     }
 
+    inline result CommandList::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_group->m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_validationCallbackMessenger)
+#endif
+    }
+
     inline result CommandList::begin(const command_list_begin_desc& desc)
     {
         LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Empty, result::ErrorInvalidState)
         
         LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_currentlyRecording == nullptr, result::ErrorOccupied)
 
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.submitMode <= command_list_submit_mode::MaxEnum, result::ErrorInvalidUsage)
+
+        const command_list_inheritance_desc* inheritance = desc.inheritance;
+        if (inheritance)
+        {
+            LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Indirect, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE(inheritance->area.extent.width > 0 && inheritance->area.extent.height > 0, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE(inheritance->area.offset.x >= 0 && inheritance->area.offset.y >= 0, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE(inheritance->numColorAttachments > 0 || inheritance->depthStencilFormat != format::Undefined, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE(inheritance->numColorAttachments <= m_group->m_device->m_limits.maxColorAttachments, result::ErrorExceededLimit)
+            LLRI_DETAIL_VALIDATION_REQUIRE_IF(inheritance->numColorAttachments > 0, inheritance->colorFormats != nullptr, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE(inheritance->sampleCount <= sample_count::MaxEnum, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_IF(inheritance->depthStencilFormat != format::Undefined,
+                has_depth_component(inheritance->depthStencilFormat) || has_stencil_component(inheritance->depthStencilFormat), result::ErrorInvalidFormat)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+            for (size_t i = 0; i < inheritance->numColorAttachments; i++)
+            {
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(has_color_component(inheritance->colorFormats[i]), i, result::ErrorInvalidFormat)
+            }
+#endif
+        }
+
 #ifdef LLRI_DETAIL_ENABLE_VALIDATION
         m_group->m_currentlyRecording = this;
+        m_numSubmissions = 0;
+        m_pendingSubmissions.clear();
+        m_numOpenLabels = 0;
 #endif
 
+        m_submitMode = desc.submitMode;
+        m_splitBarriers.clear();
+        m_resourceStates.clear();
+        m_pendingTransitions.clear();
+
+        m_pipeline = nullptr;
+        m_isRendering = inheritance != nullptr;
+        m_inheritsRendering = inheritance != nullptr;
+        m_renderingContents = rendering_contents::Inline;
+        m_numRenderingAttachments = 0;
+        m_stencilReference = 0;
+
+        if (inheritance)
+        {
+            m_renderingArea = inheritance->area;
+            m_renderingLayout.numColorAttachments = inheritance->numColorAttachments;
+            for (size_t i = 0; i < inheritance->numColorAttachments; i++)
+                m_renderingLayout.colorFormats[i] = inheritance->colorFormats[i];
+            m_renderingLayout.depthStencilFormat = inheritance->depthStencilFormat;
+            m_renderingLayout.sampleCount = inheritance->sampleCount;
+            m_stencilReference = inheritance->stencilReference;
+        }
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, beginCommandList(this, desc))
         LLRI_DETAIL_CALL_IMPL(impl_begin(desc), m_validationCallbackMessenger)
     }
 
     inline result CommandList::end()
     {
         LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_inheritsRendering, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_splitBarriers.empty(), result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_numOpenLabels == 0, result::ErrorInvalidState)
+
+        const result flushed = flushPendingTransitions();
+        if (flushed != result::Success)
+            return flushed;
 
 #ifdef LLRI_DETAIL_ENABLE_VALIDATION
         m_group->m_currentlyRecording = nullptr;
 #endif
 
+        LLRI_DETAIL_CAPTURE(m_group->m_device, endCommandList(this))
         LLRI_DETAIL_CALL_IMPL(impl_end(), m_validationCallbackMessenger)
     }
 
@@ -86,14 +174,48 @@ namespace llri
     inline result CommandList::resourceBarrier(uint32_t numBarriers, const resource_barrier* barriers)
     {
         LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, llri::result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
         
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
         LLRI_DETAIL_VALIDATION_REQUIRE(numBarriers > 0, result::ErrorInvalidUsage)
         LLRI_DETAIL_VALIDATION_REQUIRE(barriers != nullptr, result::ErrorInvalidUsage)
         
 #ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        // non-graphics queues can't execute graphics stages, and transfer queues can't execute shaders
+        pipeline_stage_flags supportedStages = pipeline_stage_flag_bits::All;
+        if (m_group->m_type == queue_type::Compute)
+            supportedStages = pipeline_stage_flag_bits::ComputeShader | pipeline_stage_flag_bits::Transfer | pipeline_stage_flag_bits::Host;
+        else if (m_group->m_type == queue_type::Transfer)
+            supportedStages = pipeline_stage_flag_bits::Transfer | pipeline_stage_flag_bits::Host;
+
         for (size_t i = 0; i < numBarriers; i++)
         {
             LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].type <= resource_barrier_type::MaxEnum, i, result::ErrorInvalidUsage)
+
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(supportedStages.all(barriers[i].srcStages), i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(supportedStages.all(barriers[i].dstStages), i, result::ErrorInvalidUsage)
+
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].split <= resource_barrier_split::MaxEnum, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].split == resource_barrier_split::None || barriers[i].type == resource_barrier_type::Transition, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].split == resource_barrier_split::None || !m_isRendering, i, result::ErrorInvalidState)
+
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].ownershipTransfer <= queue_ownership_transfer::MaxEnum, i, result::ErrorInvalidUsage)
+            if (barriers[i].ownershipTransfer != queue_ownership_transfer::None)
+            {
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].type == resource_barrier_type::Transition, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].split == resource_barrier_split::None, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].ownershipQueue <= queue_type::MaxEnum, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource != nullptr && barriers[i].trans.resource->m_desc.sharingMode == resource_sharing_mode::Exclusive, i, result::ErrorInvalidUsage)
+            }
+            if (barriers[i].split == resource_barrier_split::BeginOnly)
+            {
+                const bool begun = std::any_of(m_splitBarriers.begin(), m_splitBarriers.end(), [&](const detail::split_barrier& split) { return split.barrier.trans.resource == barriers[i].trans.resource; });
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(!begun, i, result::ErrorInvalidState)
+            }
+            else if (barriers[i].split == resource_barrier_split::EndOnly)
+            {
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(findSplitBarrier(barriers[i]) != m_splitBarriers.size(), i, result::ErrorInvalidState)
+            }
             
             switch (barriers[i].type)
             {
@@ -105,118 +227,31 @@ namespace llri
                 case resource_barrier_type::Transition:
                 {
                     LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource != nullptr, i, result::ErrorInvalidUsage)
-                    LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.oldState != barriers[i].trans.newState, i, result::ErrorInvalidUsage)
-					
-					const auto resourceDesc = barriers[i].trans.resource->getDesc();
+                    LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.oldState != barriers[i].trans.newState || barriers[i].ownershipTransfer != queue_ownership_transfer::None, i, result::ErrorInvalidUsage)
 					
-					// validate subresource range
-					if (resourceDesc.type != resource_type::Buffer && barriers[i].trans.subresourceRange != texture_subresource_range::all())
-					{
-						LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.subresourceRange.baseMipLevel < resourceDesc.mipLevels, i, result::ErrorInvalidUsage)
-						
-						LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.subresourceRange.numMipLevels > 0, i, result::ErrorInvalidUsage)
-						
-						LLRI_DETAIL_VALIDATION_REQUIRE_ITER((barriers[i].trans.subresourceRange.baseMipLevel + barriers[i].trans.subresourceRange.numMipLevels) <= resourceDesc.mipLevels, i, result::ErrorInvalidUsage)
-						
-						LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.subresourceRange.baseArrayLayer < resourceDesc.depthOrArrayLayers, i, result::ErrorInvalidUsage)
-						
-						LLRI_DETAIL_VALIDATION_REQUIRE_ITER((resourceDesc.type != resource_type::Texture3D) || (barriers[i].trans.subresourceRange.baseArrayLayer == 0), i, result::ErrorInvalidUsage)
-						
-						if (resourceDesc.type == resource_type::Texture3D)
-						{
-							LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.subresourceRange.numArrayLayers == 1, i, result::ErrorInvalidUsage)
-						}
-						else
-						{
-							LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.subresourceRange.numArrayLayers > 0, i, result::ErrorInvalidUsage)
-							
-							LLRI_DETAIL_VALIDATION_REQUIRE_ITER((barriers[i].trans.subresourceRange.baseArrayLayer + barriers[i].trans.subresourceRange.numArrayLayers) <= resourceDesc.depthOrArrayLayers, i, result::ErrorInvalidUsage)
-						}
-					}
-					
-					// validate new state correctness
+                    const resource_desc resourceDesc = barriers[i].trans.resource->getDesc();
+                    LLRI_DETAIL_VALIDATION_REQUIRE_ITER(detail::isValidSubresourceRange(resourceDesc, barriers[i].trans.subresourceRange), i, result::ErrorInvalidUsage)
+
+                    // validate new state correctness
                     LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.newState <= resource_state::MaxEnum, i, result::ErrorInvalidUsage)
-                    
-                    switch(barriers[i].trans.newState)
-                    {
-                        case resource_state::General:
-                        {
-							// no requirements
-                            break;
-                        }
-                        case resource_state::Upload:
-                        {
-                            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().memoryType == memory_type::Upload, i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::ColorAttachment:
-                        {
-							LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-								usage.contains(resource_usage_flag_bits::ColorAttachment), i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::DepthStencilAttachment:
-                        {
-                            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-								usage.contains(resource_usage_flag_bits::DepthStencilAttachment), i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::DepthStencilAttachmentReadOnly:
-                        {
-                            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-								usage.contains(resource_usage_flag_bits::DepthStencilAttachment), i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::ShaderReadOnly:
-                        {
-							if (barriers[i].trans.resource->getDesc().type != resource_type::Buffer)
-								LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-									usage.contains(resource_usage_flag_bits::Sampled), i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::ShaderReadWrite:
-                        {
-							LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-								usage.contains(resource_usage_flag_bits::ShaderWrite), i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::TransferSrc:
-                        {
-							LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-								usage.contains(resource_usage_flag_bits::TransferSrc), i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::TransferDst:
-                        {
-							LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-								usage.contains(resource_usage_flag_bits::TransferDst), i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::VertexBuffer:
-                        {
-							LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-								type == resource_type::Buffer, i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::IndexBuffer:
-                        {							LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-								type == resource_type::Buffer, i, result::ErrorInvalidState)
-                            break;
-                        }
-                        case resource_state::ConstantBuffer:
-                        {
-							LLRI_DETAIL_VALIDATION_REQUIRE_ITER(barriers[i].trans.resource->getDesc().
-								type == resource_type::Buffer, i, result::ErrorInvalidState)
-                            break;
-                        }
-                    }
-                    
+                    LLRI_DETAIL_VALIDATION_REQUIRE_ITER(detail::supportsResourceState(resourceDesc, barriers[i].trans.newState), i, result::ErrorInvalidState)
                     break;
                 }
             }
         }
 #endif
 
+        if (tracksResourceStates())
+        {
+            // pending tracked transitions are recorded first so that the barriers are executed in the order they were issued
+            const result r = flushPendingTransitions();
+            if (r != result::Success)
+                return r;
+
+            trackBarriers(numBarriers, barriers);
+        }
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, resourceBarrier(this, numBarriers, barriers))
         LLRI_DETAIL_CALL_IMPL(impl_resourceBarrier(numBarriers, barriers), m_validationCallbackMessenger)
     }
     
@@ -224,4 +259,646 @@ namespace llri
     {
         return resourceBarrier(1, &barrier);
     }
+
+    inline result CommandList::pushConstants(shader_stage_flags stageMask, uint32_t offset, uint32_t size, const void* data)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type != queue_type::Transfer, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(stageMask != shader_stage_flag_bits::None, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(stageMask <= shader_stage_flag_bits::All, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(stageMask.any(shader_stage_flag_bits::AllGraphics), m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(offset % 4 == 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(size % 4 == 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(size > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(data != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(offset + size <= m_group->m_device->m_limits.maxPushConstantSize, result::ErrorExceededLimit)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, pushConstants(this, stageMask, offset, size, data))
+        LLRI_DETAIL_CALL_IMPL(impl_pushConstants(stageMask, offset, size, data), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::beginRendering(const rendering_desc& desc)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numColorAttachments > 0 || desc.depthStencilAttachment != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numColorAttachments <= m_group->m_device->m_limits.maxColorAttachments, result::ErrorExceededLimit)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.numColorAttachments > 0, desc.colorAttachments != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.area.extent.width > 0 && desc.area.extent.height > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.area.offset.x >= 0 && desc.area.offset.y >= 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.contents <= rendering_contents::MaxEnum, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        const uint64_t areaRight = static_cast<uint64_t>(desc.area.offset.x) + desc.area.extent.width;
+        const uint64_t areaBottom = static_cast<uint64_t>(desc.area.offset.y) + desc.area.extent.height;
+        const Resource* firstTexture = nullptr;
+
+        // the depth stencil attachment is validated as the last element
+        for (size_t i = 0; i <= desc.numColorAttachments; i++)
+        {
+            const bool isDepthStencil = i == desc.numColorAttachments;
+            const rendering_attachment_desc* attachment = isDepthStencil ? desc.depthStencilAttachment : &desc.colorAttachments[i];
+            if (attachment == nullptr)
+                continue;
+
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(attachment->texture != nullptr, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(attachment->loadOp <= attachment_load_op::MaxEnum, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(attachment->storeOp <= attachment_store_op::MaxEnum, i, result::ErrorInvalidUsage)
+
+            const resource_desc& textureDesc = attachment->texture->m_desc;
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(textureDesc.type == resource_type::Texture2D, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(textureDesc.usage.contains(isDepthStencil ? resource_usage_flag_bits::DepthStencilAttachment : resource_usage_flag_bits::ColorAttachment), i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(areaRight <= textureDesc.width && areaBottom <= textureDesc.height, i, result::ErrorInvalidUsage)
+
+            if (firstTexture == nullptr)
+                firstTexture = attachment->texture;
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(textureDesc.sampleCount == firstTexture->m_desc.sampleCount, i, result::ErrorInvalidUsage)
+        }
+#endif
+
+        if (tracksResourceStates())
+        {
+            // attachments are transitioned automatically, unless a depth stencil attachment is used in a read-only state
+            for (size_t i = 0; i < desc.numColorAttachments; i++)
+                trackTransition(desc.colorAttachments[i].texture, resource_state::ColorAttachment, texture_subresource_range { 0, 1, 0, 1 });
+
+            if (desc.depthStencilAttachment)
+            {
+                Resource* texture = desc.depthStencilAttachment->texture;
+                if (getResourceStateTracker(texture).currentStates[0] != resource_state::DepthStencilAttachmentReadOnly)
+                    trackTransition(texture, resource_state::DepthStencilAttachment, texture_subresource_range { 0, 1, 0, 1 });
+            }
+
+            const result r = flushPendingTransitions();
+            if (r != result::Success)
+                return r;
+        }
+
+        m_isRendering = true;
+        m_renderingContents = desc.contents;
+        m_renderingArea = desc.area;
+        m_numRenderingAttachments = 0;
+        for (size_t i = 0; i < desc.numColorAttachments; i++)
+        {
+            m_renderingLayout.colorFormats[i] = desc.colorAttachments[i].texture->m_desc.textureFormat;
+            m_renderingAttachments[m_numRenderingAttachments++] = desc.colorAttachments[i];
+        }
+        if (desc.depthStencilAttachment)
+            m_renderingAttachments[m_numRenderingAttachments++] = *desc.depthStencilAttachment;
+
+        m_renderingLayout.numColorAttachments = desc.numColorAttachments;
+        m_renderingLayout.depthStencilFormat = desc.depthStencilAttachment ? desc.depthStencilAttachment->texture->m_desc.textureFormat : format::Undefined;
+        m_renderingLayout.sampleCount = m_renderingAttachments[0].texture->m_desc.sampleCount;
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, beginRendering(this, desc))
+        LLRI_DETAIL_CALL_IMPL(impl_beginRendering(desc), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::endRendering()
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_isRendering, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, endRendering(this))
+        const result r = impl_endRendering();
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        m_isRendering = false;
+        m_renderingContents = rendering_contents::Inline;
+        m_numRenderingAttachments = 0;
+        return r;
+    }
+
+    inline result CommandList::bindPipeline(Pipeline* pipeline)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(pipeline != nullptr, result::ErrorInvalidUsage)
+
+        m_pipeline = pipeline;
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, bindPipeline(this, pipeline))
+        LLRI_DETAIL_CALL_IMPL(impl_bindPipeline(pipeline), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::setViewport(const viewport& vp)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(vp.width > 0.0f && vp.height > 0.0f, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(vp.minDepth >= 0.0f && vp.minDepth <= 1.0f, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(vp.maxDepth >= 0.0f && vp.maxDepth <= 1.0f, result::ErrorInvalidUsage)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, setViewport(this, vp))
+        LLRI_DETAIL_CALL_IMPL(impl_setViewport(vp), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::setScissor(const rect_2d& scissor)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(scissor.offset.x >= 0 && scissor.offset.y >= 0, result::ErrorInvalidUsage)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, setScissor(this, scissor))
+        LLRI_DETAIL_CALL_IMPL(impl_setScissor(scissor), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::setStencilReference(uint8_t reference)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+
+        m_stencilReference = reference;
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, setStencilReference(this, reference))
+        LLRI_DETAIL_CALL_IMPL(impl_setStencilReference(reference), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::bindVertexBuffers(uint32_t firstBinding, uint32_t numBuffers, Resource* const* buffers, const uint64_t* offsets)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_pipeline != nullptr, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(numBuffers > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(static_cast<uint64_t>(firstBinding) + numBuffers <= m_group->m_device->m_limits.maxVertexInputBindings, result::ErrorExceededLimit)
+        LLRI_DETAIL_VALIDATION_REQUIRE(buffers != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        for (size_t i = 0; i < numBuffers; i++)
+        {
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(buffers[i] != nullptr, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(buffers[i]->m_desc.type == resource_type::Buffer, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(offsets == nullptr || offsets[i] < buffers[i]->m_desc.width, i, result::ErrorInvalidUsage)
+        }
+#endif
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, bindVertexBuffers(this, firstBinding, numBuffers, buffers, offsets))
+        LLRI_DETAIL_CALL_IMPL(impl_bindVertexBuffers(firstBinding, numBuffers, buffers, offsets), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::bindIndexBuffer(Resource* buffer, uint64_t offset, index_type type)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(buffer != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(buffer->m_desc.type == resource_type::Buffer, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(offset < buffer->m_desc.width, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(type <= index_type::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(offset % (type == index_type::UInt16 ? 2 : 4) == 0, result::ErrorInvalidUsage)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, bindIndexBuffer(this, buffer, offset, type))
+        LLRI_DETAIL_CALL_IMPL(impl_bindIndexBuffer(buffer, offset, type), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_isRendering, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_pipeline != nullptr, result::ErrorInvalidState)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, draw(this, vertexCount, instanceCount, firstVertex, firstInstance))
+        LLRI_DETAIL_CALL_IMPL(impl_draw(vertexCount, instanceCount, firstVertex, firstInstance), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::Inline, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_isRendering, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_pipeline != nullptr, result::ErrorInvalidState)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, drawIndexed(this, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance))
+        LLRI_DETAIL_CALL_IMPL(impl_drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::executeIndirectLists(uint32_t numLists, CommandList* const* lists)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering || m_renderingContents == rendering_contents::IndirectLists, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(numLists > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(lists != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        for (size_t i = 0; i < numLists; i++)
+        {
+            const CommandList* list = lists[i];
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list != nullptr, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list->m_desc.usage == command_list_usage::Indirect, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list->m_group->m_type == m_group->m_type, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list->getState() == command_list_state::Ready, i, result::ErrorInvalidState)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list->m_numSubmissions == 0 || list->m_submitMode == command_list_submit_mode::Simultaneous, i, result::ErrorInvalidState)
+
+            // Indirect CommandLists must be executed in a rendering scope that matches the one they were recorded for
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list->m_inheritsRendering == m_isRendering, i, result::ErrorInvalidUsage)
+            if (m_isRendering)
+            {
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list->m_renderingLayout == m_renderingLayout, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list->m_renderingArea.offset.x == m_renderingArea.offset.x && list->m_renderingArea.offset.y == m_renderingArea.offset.y, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list->m_renderingArea.extent.width == m_renderingArea.extent.width && list->m_renderingArea.extent.height == m_renderingArea.extent.height, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(list->m_stencilReference == m_stencilReference, i, result::ErrorInvalidUsage)
+            }
+        }
+#endif
+
+        const result flushed = flushPendingTransitions();
+        if (flushed != result::Success)
+            return flushed;
+
+        // state that is set by Indirect CommandLists is undefined after they're executed
+        m_pipeline = nullptr;
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        for (size_t i = 0; i < numLists; i++)
+            lists[i]->m_numSubmissions++;
+#endif
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, executeIndirectLists(this, numLists, lists))
+        LLRI_DETAIL_CALL_IMPL(impl_executeIndirectLists(numLists, lists), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::resetQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type != queue_type::Transfer, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryPool != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(numQueries > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(static_cast<uint64_t>(firstQuery) + numQueries <= queryPool->m_desc.count, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE((queryPool->m_desc.nodeMask == 0 ? 1 : queryPool->m_desc.nodeMask) == (m_desc.nodeMask == 0 ? 1 : m_desc.nodeMask), result::ErrorIncompatibleNodeMask)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, resetQueries(this, queryPool, firstQuery, numQueries))
+        LLRI_DETAIL_CALL_IMPL(impl_resetQueries(queryPool, firstQuery, numQueries), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::writeTimestamp(QueryPool* queryPool, uint32_t query)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type != queue_type::Transfer, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_device->getQueue(m_group->m_type, 0)->queryTimestampPeriod() > 0.0, result::ErrorFeatureNotSupported)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryPool != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryPool->m_desc.type == query_type::Timestamp, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(query < queryPool->m_desc.count, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE((queryPool->m_desc.nodeMask == 0 ? 1 : queryPool->m_desc.nodeMask) == (m_desc.nodeMask == 0 ? 1 : m_desc.nodeMask), result::ErrorIncompatibleNodeMask)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, query(capture_opcode::WriteTimestamp, this, queryPool, query))
+        LLRI_DETAIL_CALL_IMPL(impl_writeTimestamp(queryPool, query), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::beginQuery(QueryPool* queryPool, uint32_t query)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryPool != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryPool->m_desc.type == query_type::PipelineStatistics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(query < queryPool->m_desc.count, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE((queryPool->m_desc.nodeMask == 0 ? 1 : queryPool->m_desc.nodeMask) == (m_desc.nodeMask == 0 ? 1 : m_desc.nodeMask), result::ErrorIncompatibleNodeMask)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, query(capture_opcode::BeginQuery, this, queryPool, query))
+        LLRI_DETAIL_CALL_IMPL(impl_beginQuery(queryPool, query), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::endQuery(QueryPool* queryPool, uint32_t query)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryPool != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryPool->m_desc.type == query_type::PipelineStatistics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(query < queryPool->m_desc.count, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE((queryPool->m_desc.nodeMask == 0 ? 1 : queryPool->m_desc.nodeMask) == (m_desc.nodeMask == 0 ? 1 : m_desc.nodeMask), result::ErrorIncompatibleNodeMask)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, query(capture_opcode::EndQuery, this, queryPool, query))
+        LLRI_DETAIL_CALL_IMPL(impl_endQuery(queryPool, query), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::copyBuffer(Resource* src, uint64_t srcOffset, Resource* dst, uint64_t dstOffset, uint64_t size)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(src != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(src->m_desc.type == resource_type::Buffer, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(src->m_desc.usage.contains(resource_usage_flag_bits::TransferSrc), result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(dst != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(dst->m_desc.type == resource_type::Buffer, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(dst->m_desc.usage.contains(resource_usage_flag_bits::TransferDst), result::ErrorInvalidUsage)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(size > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(srcOffset <= src->m_desc.width && size <= src->m_desc.width - srcOffset, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(dstOffset <= dst->m_desc.width && size <= dst->m_desc.width - dstOffset, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(src == dst, srcOffset + size <= dstOffset || dstOffset + size <= srcOffset, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        const uint32_t nodeMask = m_desc.nodeMask == 0 ? 1 : m_desc.nodeMask;
+        const uint32_t srcNodeMask = src->m_desc.createNodeMask == 0 ? 1 : src->m_desc.createNodeMask;
+        const uint32_t dstNodeMask = dst->m_desc.createNodeMask == 0 ? 1 : dst->m_desc.createNodeMask;
+        LLRI_DETAIL_VALIDATION_REQUIRE(((src->m_desc.visibleNodeMask == 0 ? 1 : src->m_desc.visibleNodeMask) & nodeMask) == nodeMask, result::ErrorIncompatibleNodeMask)
+        LLRI_DETAIL_VALIDATION_REQUIRE(((dst->m_desc.visibleNodeMask == 0 ? 1 : dst->m_desc.visibleNodeMask) & nodeMask) == nodeMask, result::ErrorIncompatibleNodeMask)
+
+        // copies between nodes access the other node's memory, which the Device reports per pair of nodes
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(srcNodeMask != nodeMask,
+            m_group->m_device->queryPeerMemoryFeatures(detail::nodeIndex(nodeMask), detail::nodeIndex(srcNodeMask)).contains(peer_memory_feature_flag_bits::CopySrc), result::ErrorFeatureNotSupported)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(dstNodeMask != nodeMask,
+            m_group->m_device->queryPeerMemoryFeatures(detail::nodeIndex(nodeMask), detail::nodeIndex(dstNodeMask)).contains(peer_memory_feature_flag_bits::CopyDst), result::ErrorFeatureNotSupported)
+#endif
+
+        // the buffers may have pending transitions to resource_state::TransferSrc and TransferDst
+        const result flushed = flushPendingTransitions();
+        if (flushed != result::Success)
+            return flushed;
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, copyBuffer(this, src, srcOffset, dst, dstOffset, size))
+        LLRI_DETAIL_CALL_IMPL(impl_copyBuffer(src, srcOffset, dst, dstOffset, size), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::resolveQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries, Resource* buffer, uint64_t offset)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_group->m_type != queue_type::Transfer, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryPool != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(numQueries > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(static_cast<uint64_t>(firstQuery) + numQueries <= queryPool->m_desc.count, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE((queryPool->m_desc.nodeMask == 0 ? 1 : queryPool->m_desc.nodeMask) == (m_desc.nodeMask == 0 ? 1 : m_desc.nodeMask), result::ErrorIncompatibleNodeMask)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(buffer != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(buffer->m_desc.type == resource_type::Buffer, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(buffer->m_desc.usage.contains(resource_usage_flag_bits::TransferDst), result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(offset % sizeof(uint64_t) == 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(offset + static_cast<uint64_t>(numQueries) * queryPool->m_resultSize <= buffer->m_desc.width, result::ErrorInvalidUsage)
+
+        // the buffer may have a pending transition to resource_state::TransferDst
+        const result flushed = flushPendingTransitions();
+        if (flushed != result::Success)
+            return flushed;
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, resolveQueries(this, queryPool, firstQuery, numQueries, buffer, offset))
+        LLRI_DETAIL_CALL_IMPL(impl_resolveQueries(queryPool, firstQuery, numQueries, buffer, offset), m_validationCallbackMessenger)
+    }
+
+    inline result CommandList::beginLabel([[maybe_unused]] const char* name, [[maybe_unused]] const label_color& color)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        m_numOpenLabels++;
+#endif
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, label(capture_opcode::BeginLabel, this, name, color))
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_group->m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_beginLabel(name, color), m_validationCallbackMessenger)
+#endif
+    }
+
+    inline result CommandList::endLabel()
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_numOpenLabels > 0, result::ErrorInvalidState)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        m_numOpenLabels--;
+#endif
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, endLabel(this))
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_group->m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_endLabel(), m_validationCallbackMessenger)
+#endif
+    }
+
+    inline result CommandList::insertLabel([[maybe_unused]] const char* name, [[maybe_unused]] const label_color& color)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, label(capture_opcode::InsertLabel, this, name, color))
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_group->m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_insertLabel(name, color), m_validationCallbackMessenger)
+#endif
+    }
+
+    inline result CommandList::requireResourceState(Resource* resource, resource_state state, const texture_subresource_range& range)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(getState() == command_list_state::Recording, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(!m_isRendering, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(tracksResourceStates(), result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.usage == command_list_usage::Direct, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(resource != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(state <= resource_state::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(detail::isValidSubresourceRange(resource->m_desc, range), result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(detail::supportsResourceState(resource->m_desc, state), result::ErrorInvalidState)
+
+        LLRI_DETAIL_CAPTURE(m_group->m_device, requireResourceState(this, resource, state, range))
+        trackTransition(resource, state, range);
+        return result::Success;
+    }
+
+    inline size_t CommandList::findSplitBarrier(const resource_barrier& barrier) const
+    {
+        for (size_t i = 0; i < m_splitBarriers.size(); i++)
+        {
+            if (detail::isSameTransition(m_splitBarriers[i].barrier, barrier))
+                return i;
+        }
+
+        return m_splitBarriers.size();
+    }
+
+    inline bool CommandList::tracksResourceStates() const
+    {
+        return m_group->m_device->m_desc.resourceStateTracking;
+    }
+
+    inline detail::resource_state_tracker& CommandList::getResourceStateTracker(Resource* resource)
+    {
+        auto& tracker = m_resourceStates[resource];
+        if (tracker.currentStates.empty())
+        {
+            const uint32_t numSubresources = detail::subresourceCount(resource->m_desc);
+            tracker.firstStates.assign(numSubresources, detail::unknownResourceState);
+            tracker.currentStates.assign(numSubresources, detail::unknownResourceState);
+            tracker.pendingTransitions.assign(numSubresources, detail::noPendingTransition);
+        }
+
+        return tracker;
+    }
+
+    inline void CommandList::trackTransition(Resource* resource, resource_state state, const texture_subresource_range& range)
+    {
+        auto& tracker = getResourceStateTracker(resource);
+        detail::forEachSubresource(resource->m_desc, range, [&](uint32_t subresource) {
+            resource_state& current = tracker.currentStates[subresource];
+            if (current == state)
+                return;
+
+            if (current == detail::unknownResourceState)
+            {
+                // the state that the subresource is in before its first use is resolved in Queue::submit()
+                tracker.firstStates[subresource] = state;
+                current = state;
+                return;
+            }
+
+            // consecutive transitions of a subresource collapse into one, or cancel each other out
+            uint32_t& pending = tracker.pendingTransitions[subresource];
+            if (pending == detail::noPendingTransition)
+            {
+                pending = static_cast<uint32_t>(m_pendingTransitions.size());
+                m_pendingTransitions.push_back(detail::pending_transition { resource, subresource, current, state });
+            }
+            else if (m_pendingTransitions[pending].oldState == state)
+            {
+                // the last transition takes the place of the cancelled one, so that the indices of the other transitions remain valid
+                const uint32_t index = pending;
+                const detail::pending_transition moved = m_pendingTransitions.back();
+                m_pendingTransitions[index] = moved;
+                m_pendingTransitions.pop_back();
+
+                if (index < m_pendingTransitions.size())
+                    m_resourceStates.at(moved.resource).pendingTransitions[moved.subresource] = index;
+                pending = detail::noPendingTransition;
+            }
+            else
+            {
+                m_pendingTransitions[pending].newState = state;
+            }
+
+            current = state;
+        });
+    }
+
+    inline void CommandList::trackBarriers(uint32_t numBarriers, const resource_barrier* barriers)
+    {
+        for (size_t i = 0; i < numBarriers; i++)
+        {
+            // the transition of a split barrier only completes when it ends, and an ownership transfer's transition is tracked by its Release barrier
+            const resource_barrier& barrier = barriers[i];
+            if (barrier.type != resource_barrier_type::Transition || barrier.split == resource_barrier_split::BeginOnly || barrier.ownershipTransfer == queue_ownership_transfer::Acquire)
+                continue;
+
+            auto& tracker = getResourceStateTracker(barrier.trans.resource);
+            detail::forEachSubresource(barrier.trans.resource->m_desc, barrier.trans.subresourceRange, [&](uint32_t subresource) {
+                if (tracker.currentStates[subresource] == detail::unknownResourceState)
+                    tracker.firstStates[subresource] = barrier.trans.oldState;
+
+                tracker.currentStates[subresource] = barrier.trans.newState;
+            });
+        }
+    }
+
+    inline result CommandList::flushPendingTransitions()
+    {
+        if (m_pendingTransitions.empty())
+            return result::Success;
+
+        for (const auto& transition : m_pendingTransitions)
+            m_resourceStates.at(transition.resource).pendingTransitions[transition.subresource] = detail::noPendingTransition;
+
+        m_pendingBarriers.clear();
+        detail::mergeTransitions(m_pendingTransitions, m_pendingBarriers);
+        m_pendingTransitions.clear();
+
+        LLRI_DETAIL_CALL_IMPL(impl_resourceBarrier(static_cast<uint32_t>(m_pendingBarriers.size()), m_pendingBarriers.data()), m_validationCallbackMessenger)
+    }
+
+    inline void CommandList::resolveResourceStates(std::unordered_map<Resource*, std::vector<resource_state>>& states, std::vector<detail::pending_transition>& fixups) const
+    {
+        for (const auto& [resource, tracker] : m_resourceStates)
+        {
+            auto staged = states.find(resource);
+            if (staged == states.end())
+                staged = states.emplace(resource, resource->m_trackedStates).first;
+
+            for (uint32_t subresource = 0; subresource < tracker.firstStates.size(); subresource++)
+            {
+                const resource_state first = tracker.firstStates[subresource];
+                if (first == detail::unknownResourceState)
+                    continue;
+
+                resource_state& global = staged->second[subresource];
+                if (global != first)
+                    fixups.push_back(detail::pending_transition { resource, subresource, global, first });
+
+                global = tracker.currentStates[subresource];
+            }
+        }
+    }
+
+#ifndef LLRI_DISABLE_VALIDATION
+    inline bool CommandList::isInFlight() const
+    {
+        for (const auto& [state, submission] : m_pendingSubmissions)
+        {
+            if (state->numCompleted < submission)
+                return true;
+        }
+
+        return false;
+    }
+
+    inline void CommandList::trackSubmission(const std::shared_ptr<detail::fence_submission_state>& fenceState)
+    {
+        // submissions that have completed no longer need to be tracked
+        m_pendingSubmissions.erase(std::remove_if(m_pendingSubmissions.begin(), m_pendingSubmissions.end(), [](const auto& pending) {
+            return pending.first->numCompleted >= pending.second;
+        }), m_pendingSubmissions.end());
+
+        m_pendingSubmissions.emplace_back(fenceState, fenceState->numSubmitted);
+    }
+#endif
 }
@@ -0,0 +1,442 @@
+/**
+ * @file command_stream.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    class CommandList;
+    class Pipeline;
+    class QueryPool;
+    class Resource;
+
+    /**
+     * @brief Describes how a CommandStream should be created.
+    */
+    struct command_stream_desc
+    {
+        /**
+         * @brief The size in bytes of the blocks that the CommandStream's arena allocates. Commands and the data that they reference are packed into these blocks, a command whose data exceeds blockSize gets a block of its own.
+         *
+         * @note Valid usage (ErrorInvalidUsage): blockSize **must** be more than 0.
+        */
+        size_t blockSize;
+    };
+
+    /**
+     * @brief The operation of a command that was recorded into a CommandStream. Each opcode matches the CommandList function of the same name.
+    */
+    enum struct command_stream_opcode : uint8_t
+    {
+        ResourceBarrier,
+        RequireResourceState,
+        PushConstants,
+        BeginRendering,
+        EndRendering,
+        BindPipeline,
+        SetViewport,
+        SetScissor,
+        SetStencilReference,
+        BindVertexBuffers,
+        BindIndexBuffer,
+        Draw,
+        DrawIndexed,
+        ExecuteIndirectLists,
+        ResetQueries,
+        WriteTimestamp,
+        BeginQuery,
+        EndQuery,
+        ResolveQueries,
+        CopyBuffer,
+        BeginLabel,
+        EndLabel,
+        InsertLabel,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = InsertLabel
+    };
+
+    /**
+     * @brief Converts a command_stream_opcode to a string.
+     * @return The enum value as a string, or "Invalid command_stream_opcode value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(command_stream_opcode opcode);
+
+    namespace detail
+    {
+        /**
+         * @brief The header that every command in a CommandStream starts with. Commands are trivially destructible so that the arena can be reused without destroying them.
+        */
+        struct command_stream_command
+        {
+            command_stream_opcode opcode;
+        };
+
+        struct command_stream_resource_barrier : command_stream_command
+        {
+            uint32_t numBarriers;
+            const resource_barrier* barriers;
+        };
+
+        struct command_stream_require_resource_state : command_stream_command
+        {
+            Resource* resource;
+            resource_state state;
+            texture_subresource_range range;
+        };
+
+        struct command_stream_push_constants : command_stream_command
+        {
+            shader_stage_flags stageMask;
+            uint32_t offset;
+            uint32_t size;
+            const void* data;
+        };
+
+        struct command_stream_begin_rendering : command_stream_command
+        {
+            rendering_desc desc;
+        };
+
+        struct command_stream_bind_pipeline : command_stream_command
+        {
+            Pipeline* pipeline;
+        };
+
+        struct command_stream_set_viewport : command_stream_command
+        {
+            viewport vp;
+        };
+
+        struct command_stream_set_scissor : command_stream_command
+        {
+            rect_2d scissor;
+        };
+
+        struct command_stream_set_stencil_reference : command_stream_command
+        {
+            uint8_t reference;
+        };
+
+        struct command_stream_bind_vertex_buffers : command_stream_command
+        {
+            uint32_t firstBinding;
+            uint32_t numBuffers;
+            Resource* const* buffers;
+            const uint64_t* offsets;
+        };
+
+        struct command_stream_bind_index_buffer : command_stream_command
+        {
+            Resource* buffer;
+            uint64_t offset;
+            index_type type;
+        };
+
+        struct command_stream_draw : command_stream_command
+        {
+            uint32_t vertexCount;
+            uint32_t instanceCount;
+            uint32_t firstVertex;
+            uint32_t firstInstance;
+        };
+
+        struct command_stream_draw_indexed : command_stream_command
+        {
+            uint32_t indexCount;
+            uint32_t instanceCount;
+            uint32_t firstIndex;
+            int32_t vertexOffset;
+            uint32_t firstInstance;
+        };
+
+        struct command_stream_execute_indirect_lists : command_stream_command
+        {
+            uint32_t numLists;
+            CommandList* const* lists;
+        };
+
+        /**
+         * @brief Used by ResetQueries, WriteTimestamp, BeginQuery and EndQuery. The latter three store their query in firstQuery.
+        */
+        struct command_stream_queries : command_stream_command
+        {
+            QueryPool* queryPool;
+            uint32_t firstQuery;
+            uint32_t numQueries;
+        };
+
+        struct command_stream_resolve_queries : command_stream_command
+        {
+            QueryPool* queryPool;
+            uint32_t firstQuery;
+            uint32_t numQueries;
+            Resource* buffer;
+            uint64_t offset;
+        };
+
+        struct command_stream_copy_buffer : command_stream_command
+        {
+            Resource* src;
+            uint64_t srcOffset;
+            Resource* dst;
+            uint64_t dstOffset;
+            uint64_t size;
+        };
+
+        struct command_stream_label : command_stream_command
+        {
+            const char* name;
+            label_color color;
+        };
+    }
+
+    /**
+     * @brief CommandStream records commands into a compact CPU-side stream instead of sending them to the driver, so that they can be inspected, reordered and translated into a CommandList later.
+     *
+     * Commands and the data that they point to (barriers, push constants, attachments, label names) are copied into an arena of blocks that is reused after CommandStream::reset(), so recording a command only costs a few stores and never calls into the driver.
+     * Commands aren't validated when they're recorded. The CommandList functions that CommandStream::translate() calls validate them instead, so a recording error is reported as the result of the translation.
+     *
+     * A CommandStream **must** only be recorded by one thread at a time, but separate CommandStreams **may** be recorded simultaneously. Translating a CommandStream doesn't modify it, so translateCommandStreams() can translate many streams on the application's worker threads at once.
+    */
+    class CommandStream
+    {
+        friend class Device;
+
+    public:
+        /**
+         * @brief Get the desc that the CommandStream was created with.
+        */
+        [[nodiscard]] command_stream_desc getDesc() const;
+
+        /**
+         * @brief Get the number of commands in the stream.
+        */
+        [[nodiscard]] size_t getNumCommands() const;
+
+        /**
+         * @brief Get the opcode of a command in the stream.
+         * @param index The index of the command, which **must** be less than CommandStream::getNumCommands().
+        */
+        [[nodiscard]] command_stream_opcode getOpcode(size_t index) const;
+
+        /**
+         * @brief Get the number of bytes that the stream's arena has allocated. Memory is kept after CommandStream::reset(), so this value only grows.
+        */
+        [[nodiscard]] size_t getAllocatedSize() const;
+
+        /**
+         * @brief Remove all commands from the stream. The arena's blocks are kept and reused by the next recording.
+        */
+        void reset();
+
+        /**
+         * @brief Record CommandList::resourceBarrier(). The barriers are copied into the stream.
+        */
+        void resourceBarrier(uint32_t numBarriers, const resource_barrier* barriers);
+
+        /**
+         * @brief Record CommandList::resourceBarrier() with a single barrier.
+        */
+        void resourceBarrier(const resource_barrier& barrier);
+
+        /**
+         * @brief Record CommandList::requireResourceState(). The transition is determined by the CommandList's tracked state at the time of translation.
+        */
+        void requireResourceState(Resource* resource, resource_state state, const texture_subresource_range& range = texture_subresource_range::all());
+
+        /**
+         * @brief Record CommandList::pushConstants(). The data is copied into the stream.
+        */
+        void pushConstants(shader_stage_flags stageMask, uint32_t offset, uint32_t size, const void* data);
+
+        /**
+         * @brief Record CommandList::pushConstants() with the contents of data.
+        */
+        template<typename T>
+        void pushConstants(shader_stage_flags stageMask, uint32_t offset, const T& data)
+        {
+            pushConstants(stageMask, offset, static_cast<uint32_t>(sizeof(T)), &data);
+        }
+
+        /**
+         * @brief Record CommandList::beginRendering(). The attachment descriptions are copied into the stream.
+        */
+        void beginRendering(const rendering_desc& desc);
+
+        /**
+         * @brief Record CommandList::endRendering().
+        */
+        void endRendering();
+
+        /**
+         * @brief Record CommandList::bindPipeline().
+        */
+        void bindPipeline(Pipeline* pipeline);
+
+        /**
+         * @brief Record CommandList::setViewport().
+        */
+        void setViewport(const viewport& vp);
+
+        /**
+         * @brief Record CommandList::setScissor().
+        */
+        void setScissor(const rect_2d& scissor);
+
+        /**
+         * @brief Record CommandList::setStencilReference().
+        */
+        void setStencilReference(uint8_t reference);
+
+        /**
+         * @brief Record CommandList::bindVertexBuffers(). The buffer and offset arrays are copied into the stream.
+        */
+        void bindVertexBuffers(uint32_t firstBinding, uint32_t numBuffers, Resource* const* buffers, const uint64_t* offsets);
+
+        /**
+         * @brief Record CommandList::bindIndexBuffer().
+        */
+        void bindIndexBuffer(Resource* buffer, uint64_t offset, index_type type);
+
+        /**
+         * @brief Record CommandList::draw().
+        */
+        void draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+
+        /**
+         * @brief Record CommandList::drawIndexed().
+        */
+        void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+
+        /**
+         * @brief Record CommandList::executeIndirectLists(). The array of CommandLists is copied into the stream, the CommandLists themselves **must** stay valid until the stream is translated.
+        */
+        void executeIndirectLists(uint32_t numLists, CommandList* const* lists);
+
+        /**
+         * @brief Record CommandList::resetQueries().
+        */
+        void resetQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries);
+
+        /**
+         * @brief Record CommandList::writeTimestamp().
+        */
+        void writeTimestamp(QueryPool* queryPool, uint32_t query);
+
+        /**
+         * @brief Record CommandList::beginQuery().
+        */
+        void beginQuery(QueryPool* queryPool, uint32_t query);
+
+        /**
+         * @brief Record CommandList::endQuery().
+        */
+        void endQuery(QueryPool* queryPool, uint32_t query);
+
+        /**
+         * @brief Record CommandList::resolveQueries().
+        */
+        void resolveQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries, Resource* buffer, uint64_t offset);
+
+        /**
+         * @brief Record CommandList::copyBuffer().
+        */
+        void copyBuffer(Resource* src, uint64_t srcOffset, Resource* dst, uint64_t dstOffset, uint64_t size);
+
+        /**
+         * @brief Record CommandList::beginLabel(). The name is copied into the stream.
+        */
+        void beginLabel(const char* name, const label_color& color = {});
+
+        /**
+         * @brief Record CommandList::endLabel().
+        */
+        void endLabel();
+
+        /**
+         * @brief Record CommandList::insertLabel(). The name is copied into the stream.
+        */
+        void insertLabel(const char* name, const label_color& color = {});
+
+        /**
+         * @brief Reorder the stream to reduce the number of barrier commands.
+         *
+         * A resourceBarrier() command is hoisted over the state commands that precede it (bindPipeline(), setViewport(), setScissor(), setStencilReference(), pushConstants(), bindVertexBuffers() and bindIndexBuffer()), because they don't access resources until a draw is executed.
+         * If that brings it next to an earlier resourceBarrier() command, the two are merged into a single command, unless they both contain a barrier for the same Resource, since barriers within a single command aren't ordered.
+         * Commands that do access resources, rendering scope boundaries, queries and labels are never reordered.
+        */
+        void optimize();
+
+        /**
+         * @brief Translate the stream's commands into native commands by calling the matching CommandList functions in order.
+         *
+         * @param cmdList The CommandList that the commands are recorded into.
+         *
+         * @note Valid usage (ErrorInvalidUsage): cmdList **must** be a valid non-null pointer to a CommandList.
+         * @note Valid usage (ErrorInvalidState): cmdList **must** be in the command_list_state::Recording state.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return The result of the first CommandList function that didn't return Success, in which case the remaining commands aren't translated.
+        */
+        result translate(CommandList* cmdList) const;
+
+    private:
+        // Force private constructor/deconstructor so that only create/destroy can manage lifetime
+        CommandStream() = default;
+        ~CommandStream() = default;
+
+        struct arena_block
+        {
+            std::unique_ptr<uint8_t[]> data;
+            size_t size;
+        };
+
+        void* allocate(size_t size, size_t alignment);
+
+        template<typename T>
+        T* record(command_stream_opcode opcode);
+
+        template<typename T>
+        const T* copy(const T* data, size_t count);
+
+        result translateCommand(CommandList* cmdList, const detail::command_stream_command* command) const;
+
+        command_stream_desc m_desc;
+
+        // blocks [0, m_block] are in use, the blocks after m_block are kept for reuse
+        std::vector<arena_block> m_blocks;
+        size_t m_block = 0;
+        size_t m_offset = 0;
+
+        // commands are referenced through this index so that optimize() can reorder them without moving their data
+        std::vector<detail::command_stream_command*> m_commands;
+    };
+
+    /**
+     * @brief A function that calls job with every index in [0, numJobs) and returns once all calls have returned. The calls **may** be made simultaneously from multiple threads.
+     *
+     * This lets the application run LLRI's parallel work on its own job system or thread pool, rather than LLRI starting threads of its own.
+    */
+    using job_executor = std::function<void(uint32_t numJobs, const std::function<void(uint32_t)>& job)>;
+
+    /**
+     * @brief Translate CommandStreams into CommandLists, in parallel if an executor is passed. Each stream is translated by a separate job.
+     *
+     * @param numStreams The number of streams and CommandLists.
+     * @param streams An array of CommandStreams, where streams[i] is translated into cmdLists[i].
+     * @param cmdLists An array of CommandLists in the command_list_state::Recording state. A CommandList **must not** appear more than once in the array.
+     * @param executor The executor that runs the jobs, or an empty function to translate the streams one after another on the calling thread.
+     *
+     * @note Valid usage (ErrorInvalidUsage): If numStreams is more than 0, streams and cmdLists **must** be valid non-null pointers to arrays of numStreams elements, and all of their elements **must** be valid non-null pointers.
+     *
+     * @return Success upon correct execution of the operation.
+     * @return CommandStream::translate() defined result values. If multiple streams fail, the result of the stream that comes first in the array is returned.
+    */
+    inline result translateCommandStreams(uint32_t numStreams, const CommandStream* const* streams, CommandList* const* cmdLists, const job_executor& executor = {});
+}
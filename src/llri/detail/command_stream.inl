@@ -0,0 +1,559 @@
+/**
+ * @file command_stream.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    inline std::string to_string(command_stream_opcode opcode)
+    {
+        switch (opcode)
+        {
+            case command_stream_opcode::ResourceBarrier:
+                return "ResourceBarrier";
+            case command_stream_opcode::RequireResourceState:
+                return "RequireResourceState";
+            case command_stream_opcode::PushConstants:
+                return "PushConstants";
+            case command_stream_opcode::BeginRendering:
+                return "BeginRendering";
+            case command_stream_opcode::EndRendering:
+                return "EndRendering";
+            case command_stream_opcode::BindPipeline:
+                return "BindPipeline";
+            case command_stream_opcode::SetViewport:
+                return "SetViewport";
+            case command_stream_opcode::SetScissor:
+                return "SetScissor";
+            case command_stream_opcode::SetStencilReference:
+                return "SetStencilReference";
+            case command_stream_opcode::BindVertexBuffers:
+                return "BindVertexBuffers";
+            case command_stream_opcode::BindIndexBuffer:
+                return "BindIndexBuffer";
+            case command_stream_opcode::Draw:
+                return "Draw";
+            case command_stream_opcode::DrawIndexed:
+                return "DrawIndexed";
+            case command_stream_opcode::ExecuteIndirectLists:
+                return "ExecuteIndirectLists";
+            case command_stream_opcode::ResetQueries:
+                return "ResetQueries";
+            case command_stream_opcode::WriteTimestamp:
+                return "WriteTimestamp";
+            case command_stream_opcode::BeginQuery:
+                return "BeginQuery";
+            case command_stream_opcode::EndQuery:
+                return "EndQuery";
+            case command_stream_opcode::ResolveQueries:
+                return "ResolveQueries";
+            case command_stream_opcode::CopyBuffer:
+                return "CopyBuffer";
+            case command_stream_opcode::BeginLabel:
+                return "BeginLabel";
+            case command_stream_opcode::EndLabel:
+                return "EndLabel";
+            case command_stream_opcode::InsertLabel:
+                return "InsertLabel";
+        }
+
+        return "Invalid command_stream_opcode value";
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief Returns true if the command only sets state that isn't used until a draw is executed, which allows barriers to be hoisted over it.
+        */
+        inline bool isCommandStreamStateCommand(command_stream_opcode opcode)
+        {
+            switch (opcode)
+            {
+                case command_stream_opcode::PushConstants:
+                case command_stream_opcode::BindPipeline:
+                case command_stream_opcode::SetViewport:
+                case command_stream_opcode::SetScissor:
+                case command_stream_opcode::SetStencilReference:
+                case command_stream_opcode::BindVertexBuffers:
+                case command_stream_opcode::BindIndexBuffer:
+                    return true;
+                default:
+                    break;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Returns true if any of the barriers in lhs and rhs affect the same Resource.
+        */
+        inline bool sharesBarrierResource(const command_stream_resource_barrier* lhs, const command_stream_resource_barrier* rhs)
+        {
+            const auto getResource = [](const resource_barrier& barrier) { return barrier.type == resource_barrier_type::Transition ? barrier.trans.resource : barrier.rw.resource; };
+
+            for (uint32_t i = 0; i < lhs->numBarriers; i++)
+            {
+                for (uint32_t j = 0; j < rhs->numBarriers; j++)
+                {
+                    if (getResource(lhs->barriers[i]) == getResource(rhs->barriers[j]))
+                        return true;
+                }
+            }
+
+            return false;
+        }
+    }
+
+    inline command_stream_desc CommandStream::getDesc() const
+    {
+        return m_desc;
+    }
+
+    inline size_t CommandStream::getNumCommands() const
+    {
+        return m_commands.size();
+    }
+
+    inline command_stream_opcode CommandStream::getOpcode(size_t index) const
+    {
+        return m_commands[index]->opcode;
+    }
+
+    inline size_t CommandStream::getAllocatedSize() const
+    {
+        size_t output = 0;
+        for (const auto& block : m_blocks)
+            output += block.size;
+        return output;
+    }
+
+    inline void CommandStream::reset()
+    {
+        m_block = 0;
+        m_offset = 0;
+        m_commands.clear();
+    }
+
+    inline void* CommandStream::allocate(size_t size, size_t alignment)
+    {
+        size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+        if (m_blocks.empty() || offset + size > m_blocks[m_block].size)
+        {
+            // move on to the next block, reusing it if it's large enough and inserting a new one otherwise
+            if (!m_blocks.empty())
+                m_block++;
+
+            if (m_block == m_blocks.size() || m_blocks[m_block].size < size)
+            {
+                const size_t blockSize = std::max(m_desc.blockSize, size);
+                m_blocks.insert(m_blocks.begin() + static_cast<std::ptrdiff_t>(m_block), arena_block { std::unique_ptr<uint8_t[]>(new uint8_t[blockSize]), blockSize });
+            }
+
+            offset = 0;
+        }
+
+        m_offset = offset + size;
+        return m_blocks[m_block].data.get() + offset;
+    }
+
+    template<typename T>
+    T* CommandStream::record(command_stream_opcode opcode)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "CommandStream commands must be trivially destructible because the arena is reused without destroying them.");
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "CommandStream blocks aren't aligned for over-aligned commands.");
+
+        T* command = new (allocate(sizeof(T), alignof(T))) T();
+        command->opcode = opcode;
+        m_commands.push_back(command);
+        return command;
+    }
+
+    template<typename T>
+    const T* CommandStream::copy(const T* data, size_t count)
+    {
+        // invalid pointers are passed on as-is so that the CommandList reports them during translation
+        if (data == nullptr || count == 0)
+            return data;
+
+        T* output = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        std::uninitialized_copy(data, data + count, output);
+        return output;
+    }
+
+    inline void CommandStream::resourceBarrier(uint32_t numBarriers, const resource_barrier* barriers)
+    {
+        auto* command = record<detail::command_stream_resource_barrier>(command_stream_opcode::ResourceBarrier);
+        command->numBarriers = numBarriers;
+        command->barriers = copy(barriers, numBarriers);
+    }
+
+    inline void CommandStream::resourceBarrier(const resource_barrier& barrier)
+    {
+        resourceBarrier(1, &barrier);
+    }
+
+    inline void CommandStream::requireResourceState(Resource* resource, resource_state state, const texture_subresource_range& range)
+    {
+        auto* command = record<detail::command_stream_require_resource_state>(command_stream_opcode::RequireResourceState);
+        command->resource = resource;
+        command->state = state;
+        command->range = range;
+    }
+
+    inline void CommandStream::pushConstants(shader_stage_flags stageMask, uint32_t offset, uint32_t size, const void* data)
+    {
+        auto* command = record<detail::command_stream_push_constants>(command_stream_opcode::PushConstants);
+        command->stageMask = stageMask;
+        command->offset = offset;
+        command->size = size;
+        command->data = copy(static_cast<const uint8_t*>(data), size);
+    }
+
+    inline void CommandStream::beginRendering(const rendering_desc& desc)
+    {
+        auto* command = record<detail::command_stream_begin_rendering>(command_stream_opcode::BeginRendering);
+        command->desc = desc;
+        command->desc.colorAttachments = copy(desc.colorAttachments, desc.numColorAttachments);
+        command->desc.depthStencilAttachment = copy(desc.depthStencilAttachment, 1);
+    }
+
+    inline void CommandStream::endRendering()
+    {
+        record<detail::command_stream_command>(command_stream_opcode::EndRendering);
+    }
+
+    inline void CommandStream::bindPipeline(Pipeline* pipeline)
+    {
+        record<detail::command_stream_bind_pipeline>(command_stream_opcode::BindPipeline)->pipeline = pipeline;
+    }
+
+    inline void CommandStream::setViewport(const viewport& vp)
+    {
+        record<detail::command_stream_set_viewport>(command_stream_opcode::SetViewport)->vp = vp;
+    }
+
+    inline void CommandStream::setScissor(const rect_2d& scissor)
+    {
+        record<detail::command_stream_set_scissor>(command_stream_opcode::SetScissor)->scissor = scissor;
+    }
+
+    inline void CommandStream::setStencilReference(uint8_t reference)
+    {
+        record<detail::command_stream_set_stencil_reference>(command_stream_opcode::SetStencilReference)->reference = reference;
+    }
+
+    inline void CommandStream::bindVertexBuffers(uint32_t firstBinding, uint32_t numBuffers, Resource* const* buffers, const uint64_t* offsets)
+    {
+        auto* command = record<detail::command_stream_bind_vertex_buffers>(command_stream_opcode::BindVertexBuffers);
+        command->firstBinding = firstBinding;
+        command->numBuffers = numBuffers;
+        command->buffers = copy(buffers, numBuffers);
+        command->offsets = copy(offsets, numBuffers);
+    }
+
+    inline void CommandStream::bindIndexBuffer(Resource* buffer, uint64_t offset, index_type type)
+    {
+        auto* command = record<detail::command_stream_bind_index_buffer>(command_stream_opcode::BindIndexBuffer);
+        command->buffer = buffer;
+        command->offset = offset;
+        command->type = type;
+    }
+
+    inline void CommandStream::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+    {
+        auto* command = record<detail::command_stream_draw>(command_stream_opcode::Draw);
+        command->vertexCount = vertexCount;
+        command->instanceCount = instanceCount;
+        command->firstVertex = firstVertex;
+        command->firstInstance = firstInstance;
+    }
+
+    inline void CommandStream::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+    {
+        auto* command = record<detail::command_stream_draw_indexed>(command_stream_opcode::DrawIndexed);
+        command->indexCount = indexCount;
+        command->instanceCount = instanceCount;
+        command->firstIndex = firstIndex;
+        command->vertexOffset = vertexOffset;
+        command->firstInstance = firstInstance;
+    }
+
+    inline void CommandStream::executeIndirectLists(uint32_t numLists, CommandList* const* lists)
+    {
+        auto* command = record<detail::command_stream_execute_indirect_lists>(command_stream_opcode::ExecuteIndirectLists);
+        command->numLists = numLists;
+        command->lists = copy(lists, numLists);
+    }
+
+    inline void CommandStream::resetQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries)
+    {
+        auto* command = record<detail::command_stream_queries>(command_stream_opcode::ResetQueries);
+        command->queryPool = queryPool;
+        command->firstQuery = firstQuery;
+        command->numQueries = numQueries;
+    }
+
+    inline void CommandStream::writeTimestamp(QueryPool* queryPool, uint32_t query)
+    {
+        auto* command = record<detail::command_stream_queries>(command_stream_opcode::WriteTimestamp);
+        command->queryPool = queryPool;
+        command->firstQuery = query;
+    }
+
+    inline void CommandStream::beginQuery(QueryPool* queryPool, uint32_t query)
+    {
+        auto* command = record<detail::command_stream_queries>(command_stream_opcode::BeginQuery);
+        command->queryPool = queryPool;
+        command->firstQuery = query;
+    }
+
+    inline void CommandStream::endQuery(QueryPool* queryPool, uint32_t query)
+    {
+        auto* command = record<detail::command_stream_queries>(command_stream_opcode::EndQuery);
+        command->queryPool = queryPool;
+        command->firstQuery = query;
+    }
+
+    inline void CommandStream::resolveQueries(QueryPool* queryPool, uint32_t firstQuery, uint32_t numQueries, Resource* buffer, uint64_t offset)
+    {
+        auto* command = record<detail::command_stream_resolve_queries>(command_stream_opcode::ResolveQueries);
+        command->queryPool = queryPool;
+        command->firstQuery = firstQuery;
+        command->numQueries = numQueries;
+        command->buffer = buffer;
+        command->offset = offset;
+    }
+
+    inline void CommandStream::copyBuffer(Resource* src, uint64_t srcOffset, Resource* dst, uint64_t dstOffset, uint64_t size)
+    {
+        auto* command = record<detail::command_stream_copy_buffer>(command_stream_opcode::CopyBuffer);
+        command->src = src;
+        command->srcOffset = srcOffset;
+        command->dst = dst;
+        command->dstOffset = dstOffset;
+        command->size = size;
+    }
+
+    inline void CommandStream::beginLabel(const char* name, const label_color& color)
+    {
+        auto* command = record<detail::command_stream_label>(command_stream_opcode::BeginLabel);
+        command->name = name ? copy(name, std::strlen(name) + 1) : nullptr;
+        command->color = color;
+    }
+
+    inline void CommandStream::endLabel()
+    {
+        record<detail::command_stream_command>(command_stream_opcode::EndLabel);
+    }
+
+    inline void CommandStream::insertLabel(const char* name, const label_color& color)
+    {
+        auto* command = record<detail::command_stream_label>(command_stream_opcode::InsertLabel);
+        command->name = name ? copy(name, std::strlen(name) + 1) : nullptr;
+        command->color = color;
+    }
+
+    inline void CommandStream::optimize()
+    {
+        // the barrier command that a following barrier command may still be merged into, if only state commands are recorded in between
+        constexpr size_t noBarrier = std::numeric_limits<size_t>::max();
+        size_t mergeTarget = noBarrier;
+
+        size_t numCommands = 0;
+        for (auto* command : m_commands)
+        {
+            if (command->opcode == command_stream_opcode::ResourceBarrier)
+            {
+                auto* barrier = static_cast<detail::command_stream_resource_barrier*>(command);
+                auto* target = mergeTarget != noBarrier ? static_cast<detail::command_stream_resource_barrier*>(m_commands[mergeTarget]) : nullptr;
+
+                // invalid barrier commands are left in place so that translation reports them
+                const bool valid = barrier->numBarriers > 0 && barrier->barriers != nullptr;
+                if (target && valid && !detail::sharesBarrierResource(target, barrier))
+                {
+                    // the merged barriers are stored in a new allocation, the originals stay in the arena until reset()
+                    auto* merged = static_cast<resource_barrier*>(allocate(sizeof(resource_barrier) * (target->numBarriers + barrier->numBarriers), alignof(resource_barrier)));
+                    std::uninitialized_copy(target->barriers, target->barriers + target->numBarriers, merged);
+                    std::uninitialized_copy(barrier->barriers, barrier->barriers + barrier->numBarriers, merged + target->numBarriers);
+
+                    target->barriers = merged;
+                    target->numBarriers += barrier->numBarriers;
+                    continue;
+                }
+
+                mergeTarget = valid ? numCommands : noBarrier;
+            }
+            else if (!detail::isCommandStreamStateCommand(command->opcode))
+            {
+                mergeTarget = noBarrier;
+            }
+
+            m_commands[numCommands++] = command;
+        }
+
+        m_commands.resize(numCommands);
+    }
+
+    inline result CommandStream::translate(CommandList* cmdList) const
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(cmdList != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(cmdList->getState() == command_list_state::Recording, result::ErrorInvalidState)
+
+        for (const auto* command : m_commands)
+        {
+            const result r = translateCommand(cmdList, command);
+            if (r != result::Success)
+                return r;
+        }
+
+        return result::Success;
+    }
+
+    inline result CommandStream::translateCommand(CommandList* cmdList, const detail::command_stream_command* command) const
+    {
+        switch (command->opcode)
+        {
+            case command_stream_opcode::ResourceBarrier:
+            {
+                const auto* c = static_cast<const detail::command_stream_resource_barrier*>(command);
+                return cmdList->resourceBarrier(c->numBarriers, c->barriers);
+            }
+            case command_stream_opcode::RequireResourceState:
+            {
+                const auto* c = static_cast<const detail::command_stream_require_resource_state*>(command);
+                return cmdList->requireResourceState(c->resource, c->state, c->range);
+            }
+            case command_stream_opcode::PushConstants:
+            {
+                const auto* c = static_cast<const detail::command_stream_push_constants*>(command);
+                return cmdList->pushConstants(c->stageMask, c->offset, c->size, c->data);
+            }
+            case command_stream_opcode::BeginRendering:
+                return cmdList->beginRendering(static_cast<const detail::command_stream_begin_rendering*>(command)->desc);
+            case command_stream_opcode::EndRendering:
+                return cmdList->endRendering();
+            case command_stream_opcode::BindPipeline:
+                return cmdList->bindPipeline(static_cast<const detail::command_stream_bind_pipeline*>(command)->pipeline);
+            case command_stream_opcode::SetViewport:
+                return cmdList->setViewport(static_cast<const detail::command_stream_set_viewport*>(command)->vp);
+            case command_stream_opcode::SetScissor:
+                return cmdList->setScissor(static_cast<const detail::command_stream_set_scissor*>(command)->scissor);
+            case command_stream_opcode::SetStencilReference:
+                return cmdList->setStencilReference(static_cast<const detail::command_stream_set_stencil_reference*>(command)->reference);
+            case command_stream_opcode::BindVertexBuffers:
+            {
+                const auto* c = static_cast<const detail::command_stream_bind_vertex_buffers*>(command);
+                return cmdList->bindVertexBuffers(c->firstBinding, c->numBuffers, c->buffers, c->offsets);
+            }
+            case command_stream_opcode::BindIndexBuffer:
+            {
+                const auto* c = static_cast<const detail::command_stream_bind_index_buffer*>(command);
+                return cmdList->bindIndexBuffer(c->buffer, c->offset, c->type);
+            }
+            case command_stream_opcode::Draw:
+            {
+                const auto* c = static_cast<const detail::command_stream_draw*>(command);
+                return cmdList->draw(c->vertexCount, c->instanceCount, c->firstVertex, c->firstInstance);
+            }
+            case command_stream_opcode::DrawIndexed:
+            {
+                const auto* c = static_cast<const detail::command_stream_draw_indexed*>(command);
+                return cmdList->drawIndexed(c->indexCount, c->instanceCount, c->firstIndex, c->vertexOffset, c->firstInstance);
+            }
+            case command_stream_opcode::ExecuteIndirectLists:
+            {
+                const auto* c = static_cast<const detail::command_stream_execute_indirect_lists*>(command);
+                return cmdList->executeIndirectLists(c->numLists, c->lists);
+            }
+            case command_stream_opcode::ResetQueries:
+            {
+                const auto* c = static_cast<const detail::command_stream_queries*>(command);
+                return cmdList->resetQueries(c->queryPool, c->firstQuery, c->numQueries);
+            }
+            case command_stream_opcode::WriteTimestamp:
+            {
+                const auto* c = static_cast<const detail::command_stream_queries*>(command);
+                return cmdList->writeTimestamp(c->queryPool, c->firstQuery);
+            }
+            case command_stream_opcode::BeginQuery:
+            {
+                const auto* c = static_cast<const detail::command_stream_queries*>(command);
+                return cmdList->beginQuery(c->queryPool, c->firstQuery);
+            }
+            case command_stream_opcode::EndQuery:
+            {
+                const auto* c = static_cast<const detail::command_stream_queries*>(command);
+                return cmdList->endQuery(c->queryPool, c->firstQuery);
+            }
+            case command_stream_opcode::ResolveQueries:
+            {
+                const auto* c = static_cast<const detail::command_stream_resolve_queries*>(command);
+                return cmdList->resolveQueries(c->queryPool, c->firstQuery, c->numQueries, c->buffer, c->offset);
+            }
+            case command_stream_opcode::CopyBuffer:
+            {
+                const auto* c = static_cast<const detail::command_stream_copy_buffer*>(command);
+                return cmdList->copyBuffer(c->src, c->srcOffset, c->dst, c->dstOffset, c->size);
+            }
+            case command_stream_opcode::BeginLabel:
+            {
+                const auto* c = static_cast<const detail::command_stream_label*>(command);
+                return cmdList->beginLabel(c->name, c->color);
+            }
+            case command_stream_opcode::EndLabel:
+                return cmdList->endLabel();
+            case command_stream_opcode::InsertLabel:
+            {
+                const auto* c = static_cast<const detail::command_stream_label*>(command);
+                return cmdList->insertLabel(c->name, c->color);
+            }
+        }
+
+        return result::ErrorInvalidUsage;
+    }
+
+    inline result translateCommandStreams(uint32_t numStreams, const CommandStream* const* streams, CommandList* const* cmdLists, const job_executor& executor)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(numStreams == 0 || streams != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(numStreams == 0 || cmdLists != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        for (size_t i = 0; i < numStreams; i++)
+        {
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(streams[i] != nullptr, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(cmdLists[i] != nullptr, i, result::ErrorInvalidUsage)
+        }
+#endif
+
+        // results are stored per stream so that the first failing stream in the array is reported regardless of thread timing
+        if (!executor)
+        {
+            for (size_t i = 0; i < numStreams; i++)
+            {
+                const result r = streams[i]->translate(cmdLists[i]);
+                if (r != result::Success)
+                    return r;
+            }
+
+            return result::Success;
+        }
+
+        // results are stored per stream so that the first failing stream in the array is reported regardless of thread timing
+        std::vector<result> results(numStreams, result::Success);
+        executor(numStreams, [&](uint32_t i) {
+            results[i] = streams[i]->translate(cmdLists[i]);
+        });
+
+        for (const result r : results)
+        {
+            if (r != result::Success)
+                return r;
+        }
+
+        return result::Success;
+    }
+}
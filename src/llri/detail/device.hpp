@@ -19,12 +19,37 @@ namespace llri
     enum struct fence_flag_bits : uint32_t;
     using fence_flags = flags<fence_flag_bits>;
     class Fence;
+    class CommandContextPool;
+    struct command_context_pool_desc;
+    class FrameGraph;
+    struct frame_graph_desc;
+    class FrameScheduler;
+    struct frame_scheduler_desc;
+    class GpuProfiler;
+    struct gpu_profiler_desc;
+    class CommandStream;
+    struct command_stream_desc;
 
     class Semaphore;
+    struct semaphore_desc;
+
+    class QueryPool;
+    struct query_pool_desc;
 
     class Resource;
     struct resource_desc;
 
+    class PipelineCache;
+    struct pipeline_cache_desc;
+
+    class Pipeline;
+    struct graphics_pipeline_desc;
+
+    namespace detail
+    {
+        class capture_writer;
+    }
+
     /**
      * @brief Device description to be used in Instance::createDevice().
     */
@@ -68,12 +93,23 @@ namespace llri
         uint32_t numQueues;
         /**
          * @brief An array of device queue descriptions, which is used to create the queues upon device creation, [queues, queues + numQueues - 1].
+         * Queues whose types share hardware (see Adapter::queryQueueFamilyType()) are spread across that hardware's queues, and share them if more Queues are requested than the hardware has.
          *
          * @note Valid usage (ErrorInvalidUsage):This value **must** be a valid non-null pointer to an array of queue_desc structures, with a size of at least device_desc::numQueues.
          * @note Valid usage (ErrorExceededLimit): The total number of elements with queue_desc::type as a given queue_type **must not** exceed Adapter::queryQueueCount() with that queue_type.
          * @note All conditions in queue_desc must be met.
         */
         queue_desc* queues;
+
+        /**
+         * @brief Enables automatic resource state tracking.
+         *
+         * When enabled, every Resource keeps track of the state of each of its subresources, and CommandList::requireResourceState() **may** be used to transition resources without specifying their current state.
+         * Each CommandList records the state that it expects its resources to be in when it starts executing, and Queue::submit() inserts fix-up barriers before it if the resources are in a different state at that point.
+         *
+         * @note Tracking adds CPU overhead to resource barriers and submission, and is thus disabled by default. Applications that track resource states themselves **should** leave it disabled.
+        */
+        bool resourceStateTracking;
     };
 
     /**
@@ -84,6 +120,13 @@ namespace llri
         friend Instance;
         friend class CommandGroup;
         friend class Queue;
+        friend class CommandList;
+        friend class Fence;
+        friend class Semaphore;
+        friend class Resource;
+        friend class QueryPool;
+        friend class PipelineCache;
+        friend class Pipeline;
   
     public:
         using native_device = void;
@@ -100,6 +143,20 @@ namespace llri
          * Vulkan: VkDevice
          */
         [[nodiscard]] native_device* getNative() const;
+
+        /**
+         * @brief Set the name of the Device, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
         
         /**
          * @brief Get the adapter that the device represents.
@@ -127,6 +184,18 @@ namespace llri
         */
         uint8_t queryQueueCount(queue_type type);
 
+        /**
+         * @brief Query how localNode **can** access the memory of Resources that were created on remoteNode.
+         *
+         * Resources are created on the node in resource_desc::createNodeMask, and other nodes in resource_desc::visibleNodeMask access that node's memory (peer memory), which is usually much slower than local memory but avoids a round trip through host memory.
+         *
+         * @param localNode The index of the node that accesses the memory.
+         * @param remoteNode The index of the node that the Resource was created on.
+         *
+         * @return peer_memory_feature_flag_bits::All if localNode equals remoteNode, the supported peer memory features otherwise, or peer_memory_feature_flag_bits::None if either node is more than or equal to Adapter::queryNodeCount().
+        */
+        [[nodiscard]] peer_memory_feature_flags queryPeerMemoryFeatures(uint8_t localNode, uint8_t remoteNode);
+
         /**
          * @brief Create a command group. Command groups are responsible for allocating and managing the necessary device memory for command queues.
          *
@@ -151,6 +220,118 @@ namespace llri
         */
         void destroyCommandGroup(CommandGroup* cmdGroup);
 
+        /**
+         * @brief Create a CommandContextPool, which manages a CommandGroup for every recording thread and every frame in flight.
+         *
+         * @param desc The description of the CommandContextPool.
+         * @param pool A pointer to the resulting CommandContextPool variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): pool **must** be a valid non-null pointer to a CommandContextPool* variable.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return command_context_pool_desc defined result values: ErrorInvalidUsage.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result createCommandContextPool(const command_context_pool_desc& desc, CommandContextPool** pool);
+
+        /**
+         * @brief Destroy the CommandContextPool, including all of its CommandGroups, CommandLists and Fences.
+         *
+         * None of the CommandContextPool's CommandLists **may** be in use by the GPU at the time of destruction.
+         *
+         * @param pool A pointer to a valid CommandContextPool, or nullptr.
+        */
+        void destroyCommandContextPool(CommandContextPool* pool);
+
+        /**
+         * @brief Create a FrameGraph, which schedules, records and submits the passes of a frame on all of the Device's Queues.
+         *
+         * @param desc The description of the FrameGraph.
+         * @param frameGraph A pointer to the resulting FrameGraph variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): frameGraph **must** be a valid non-null pointer to a FrameGraph* variable.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return frame_graph_desc defined result values: ErrorInvalidUsage.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result createFrameGraph(const frame_graph_desc& desc, FrameGraph** frameGraph);
+
+        /**
+         * @brief Destroy the FrameGraph, including all of its CommandLists, Semaphores and transient Resources.
+         *
+         * None of the FrameGraph's passes **may** be in use by the GPU at the time of destruction.
+         *
+         * @param frameGraph A pointer to a valid FrameGraph, or nullptr.
+        */
+        void destroyFrameGraph(FrameGraph* frameGraph);
+
+        /**
+         * @brief Create a FrameScheduler, which waits on frames in flight, resets their CommandGroups, runs deferred work and measures how long the CPU waits for the GPU.
+         *
+         * @param desc The description of the FrameScheduler.
+         * @param scheduler A pointer to the resulting FrameScheduler variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): scheduler **must** be a valid non-null pointer to a FrameScheduler* variable.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return frame_scheduler_desc defined result values: ErrorInvalidUsage.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result createFrameScheduler(const frame_scheduler_desc& desc, FrameScheduler** scheduler);
+
+        /**
+         * @brief Destroy the FrameScheduler, including its CommandContextPool. Callbacks that were deferred but not called yet are called first, starting with the oldest frame.
+         *
+         * None of the FrameScheduler's frames **may** be in use by the GPU at the time of destruction.
+         *
+         * @param scheduler A pointer to a valid FrameScheduler, or nullptr.
+        */
+        void destroyFrameScheduler(FrameScheduler* scheduler);
+
+        /**
+         * @brief Create a GpuProfiler, which measures the GPU time of named scopes in CommandLists and reads the results back a number of frames later.
+         *
+         * @param desc The description of the GpuProfiler.
+         * @param profiler A pointer to the resulting GpuProfiler variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): profiler **must** be a valid non-null pointer to a GpuProfiler* variable.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return gpu_profiler_desc defined result values: ErrorInvalidUsage, ErrorFeatureNotSupported.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result createGpuProfiler(const gpu_profiler_desc& desc, GpuProfiler** profiler);
+
+        /**
+         * @brief Destroy the GpuProfiler, including its QueryPool.
+         *
+         * None of the GpuProfiler's scopes **may** be in use by the GPU at the time of destruction.
+         *
+         * @param profiler A pointer to a valid GpuProfiler, or nullptr.
+        */
+        void destroyGpuProfiler(GpuProfiler* profiler);
+
+        /**
+         * @brief Create a CommandStream, which records commands into a CPU-side stream that is translated into a CommandList later.
+         *
+         * @param desc The description of the CommandStream.
+         * @param stream A pointer to the resulting CommandStream variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): stream **must** be a valid non-null pointer to a CommandStream* variable.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return command_stream_desc defined result values: ErrorInvalidUsage.
+        */
+        result createCommandStream(const command_stream_desc& desc, CommandStream** stream);
+
+        /**
+         * @brief Destroy the CommandStream, including the memory of its arena.
+         *
+         * @param stream A pointer to a valid CommandStream, or nullptr.
+        */
+        void destroyCommandStream(CommandStream* stream);
+
         /**
          * @brief Create a Fence which can be used for cpu-gpu synchronization.
          *
@@ -180,9 +361,12 @@ namespace llri
          *
          * When waitFences() returns result::Success, all fences are reset, meaning that they're no longer signaled.
          *
+         * If waitAny is true, the function instead returns as soon as one of the fences reaches its signal, and none of the fences are reset. Use Fence::getStatus() to find the fences that reached their signal, and Device::resetFences() to reset them.
+         *
          * @param numFences The number of fences in the fences array.
          * @param fences An array of Fence pointers. Each fence must be a valid pointer to a Fence.
          * @param timeout Timeout is the time in milliseconds until the function **must** return. If timeout is more than 0, the function will block as described above. If timeout is 0, then no blocking occurs, but the function returns Success if all fences reach their signal, and returns Timeout if (some of) fences did not.
+         * @param waitAny If true, the function waits for any of the fences instead of all of them.
          *
          * @note Valid usage (ErrorInvalidUsage): numFences **must** be more than 0.
          * @note Valid usage (ErrorInvalidUsage): fences **must** be a valid non-null pointer to a Fence* array.
@@ -193,7 +377,7 @@ namespace llri
          * @return Timeout if the wait time for the fences was longer than their wait time.
          * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory, ErrorDeviceLost.
         */
-        result waitFences(uint32_t numFences, Fence** fences, uint64_t timeout);
+        result waitFences(uint32_t numFences, Fence** fences, uint64_t timeout, bool waitAny = false);
 
         /**
          * @brief Utility function. Equivalent of calling waitFences(1, &fence, timeout). Refer to the documentation of waitFences() for information on its usage.
@@ -201,15 +385,39 @@ namespace llri
         */
         result waitFence(Fence* fence, uint64_t timeout);
 
+        /**
+         * @brief Reset fences that have reached their signal without waiting on them, so that they can be signaled by a submit again.
+         * Fences that were never signaled are left as they are.
+         *
+         * @param numFences The number of fences in the fences array.
+         * @param fences An array of Fence pointers.
+         *
+         * @note Valid usage (ErrorInvalidUsage): numFences **must** be more than 0.
+         * @note Valid usage (ErrorInvalidUsage): fences **must** be a valid non-null pointer to an array of numFences valid non-null Fence pointers.
+         * @note Valid usage (ErrorInvalidState): each fence that was signaled by a submit **must** have reached its signal, see Fence::getStatus().
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result resetFences(uint32_t numFences, Fence** fences);
+
         /**
          * @brief Create a Semaphore, which can be used for synchronization between GPU events.
+         * @param desc The description of the Semaphore.
          * @param semaphore A pointer to the resulting Semaphore variable.
          *
-         * @note Valid uage (ErrorInvalidUsage): semaphore **must** be a valid non-null pointer to a Semaphore* variable.
+         * @note Valid usage (ErrorInvalidUsage): semaphore **must** be a valid non-null pointer to a Semaphore* variable.
+         * @note Valid usage: the conditions in semaphore_desc **must** be met.
          *
          * @return Success upon correct execution of the operation.
          * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
         */
+        result createSemaphore(const semaphore_desc& desc, Semaphore** semaphore);
+
+        /**
+         * @brief Utility function. Equivalent of calling createSemaphore(semaphore_desc { semaphore_type::Binary, 0 }, semaphore).
+         * @return All possible result values from Device::createSemaphore().
+        */
         result createSemaphore(Semaphore** semaphore);
 
         /**
@@ -218,6 +426,45 @@ namespace llri
         */
         void destroySemaphore(Semaphore* semaphore);
 
+        /**
+         * @brief Wait on the host until semaphore_type::Timeline Semaphores reach their values, or until the timeout value.
+         *
+         * @param numSemaphores The number of Semaphores in the semaphores and values arrays.
+         * @param semaphores An array of Semaphores to wait on.
+         * @param values An array of values, one for each Semaphore. The wait for a Semaphore is complete when its value is greater or equal to the value in this array.
+         * @param timeout Timeout is the time in milliseconds until the function **must** return. If timeout is 0, no blocking occurs, and the function returns Timeout if the wait isn't complete. Pass LLRI_TIMEOUT_MAX to wait indefinitely.
+         * @param waitAny If true, the function returns when any of the Semaphores reaches its value, otherwise it returns when all of them do.
+         *
+         * @note Valid usage (ErrorInvalidUsage): numSemaphores **must** be more than 0.
+         * @note Valid usage (ErrorInvalidUsage): semaphores **must** be a valid non-null pointer to an array of numSemaphores valid non-null Semaphore pointers.
+         * @note Valid usage (ErrorInvalidUsage): values **must** be a valid non-null pointer to an array of numSemaphores values.
+         * @note Valid usage (ErrorInvalidState): Each Semaphore **must** have been created with semaphore_type::Timeline.
+         *
+         * @return Success upon correct execution of the operation, if the wait completed within the timeout.
+         * @return Timeout if the wait didn't complete within the timeout.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory, ErrorDeviceLost.
+        */
+        result waitSemaphores(uint32_t numSemaphores, Semaphore** semaphores, const uint64_t* values, uint64_t timeout, bool waitAny);
+
+        /**
+         * @brief Create a QueryPool, which stores the results of GPU queries such as timestamps.
+         * @param desc The description of the QueryPool.
+         * @param queryPool A pointer to the resulting QueryPool variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): queryPool **must** be a valid non-null pointer to a QueryPool* variable.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return query_pool_desc defined result values: ErrorInvalidUsage, ErrorInvalidNodeMask.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result createQueryPool(const query_pool_desc& desc, QueryPool** queryPool);
+
+        /**
+         * @brief Destroy the given QueryPool.
+         * @param queryPool A pointer to a valid QueryPool, or nullptr.
+        */
+        void destroyQueryPool(QueryPool* queryPool);
+
         /**
          * @brief Create a resource (a buffer or texture) and allocate the memory for it.
          * @param desc The description of the resource.
@@ -236,6 +483,67 @@ namespace llri
          * @param resource A pointer to a valid Resource, or nullptr.
         */
         void destroyResource(Resource* resource);
+
+        /**
+         * @brief Create a PipelineCache, which stores the results of pipeline compilation and can be serialized to skip compilation in later runs.
+         * @param desc The description of the PipelineCache.
+         * @param cache A pointer to the resulting PipelineCache variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): cache **must** be a valid non-null pointer to a PipelineCache* variable.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return pipeline_cache_desc defined result values: ErrorInvalidUsage.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result createPipelineCache(const pipeline_cache_desc& desc, PipelineCache** cache);
+
+        /**
+         * @brief Destroy the given PipelineCache.
+         * @param cache A pointer to a valid PipelineCache, or nullptr.
+        */
+        void destroyPipelineCache(PipelineCache* cache);
+
+        /**
+         * @brief Create a graphics Pipeline, which contains the shaders and fixed-function state used by CommandList::draw() and CommandList::drawIndexed().
+         * @param desc The description of the graphics Pipeline.
+         * @param pipeline A pointer to the resulting Pipeline variable.
+         *
+         * @note Valid usage (ErrorInvalidUsage): pipeline **must** be a valid non-null pointer to a Pipeline* variable.
+         * @note Valid usage (ErrorInvalidUsage): desc.numColorAttachments **must** be more than 0 or desc.depthStencilFormat **must not** be format::Undefined.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return graphics_pipeline_desc defined result values: ErrorInvalidUsage, ErrorInvalidFormat, ErrorExceededLimit.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory, ErrorInvalidUsage (invalid shader bytecode).
+        */
+        result createGraphicsPipeline(const graphics_pipeline_desc& desc, Pipeline** pipeline);
+
+        /**
+         * @brief Destroy the given Pipeline.
+         * @param pipeline A pointer to a valid Pipeline, or nullptr.
+        */
+        void destroyPipeline(Pipeline* pipeline);
+
+        /**
+         * @brief Start capturing the Device's LLRI calls into a binary file, which can be replayed with the replay application.
+         *
+         * Resource, Fence, Semaphore, QueryPool, CommandGroup, CommandList and graphics Pipeline lifetimes, Queue submissions, Fence and Semaphore operations and the CommandList commands are captured, see capture_opcode for the exact set of captured calls.
+         * Objects that were created before the capture began are referenced as id 0, and the commands that use them **can not** be replayed.
+         *
+         * @param path The path of the capture file. An existing file is overwritten.
+         *
+         * @note Valid usage (ErrorInvalidUsage): path **must** be a valid non-null pointer to a null-terminated string.
+         * @note Valid usage (ErrorInvalidState): The Device **must not** already be capturing.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return ErrorInitializationFailed if the file couldn't be opened for writing.
+         * @return ErrorFeatureNotSupported if LLRI_DISABLE_CAPTURE is defined.
+        */
+        result beginCapture(const char* path);
+
+        /**
+         * @brief Stop capturing and close the capture file. This function does nothing if the Device isn't capturing.
+        */
+        void endCapture();
     private:
         // Force private constructor/deconstructor so that only create/destroy can manage lifetime
         Device() = default;
@@ -252,6 +560,11 @@ namespace llri
         std::vector<Queue*> m_transferQueues;
 
         device_desc m_desc;
+        // the Adapter's limits, cached at creation so that validating recorded commands doesn't query the driver
+        adapter_limits m_limits {};
+
+        // the capture that LLRI calls are written to, or nullptr if the Device isn't capturing
+        detail::capture_writer* m_capture = nullptr;
         
         // used for internal commands/work (e.g. transitioning internal states)
         void* m_workCmdGroup = nullptr;
@@ -259,17 +572,48 @@ namespace llri
         void* m_workFence = nullptr;
         queue_type m_workQueueType;
 
+        // internal pipeline layouts that describe the push constant ranges, indexed by their shader_stage_flags
+        // DirectX12 uses a single root signature for all shader stages, stored at index shader_stage_flag_bits::All
+        std::array<void*, static_cast<size_t>(shader_stage_flag_bits::All) + 1> m_pushConstantLayouts {};
+
+        // Vulkan: the queue family index of each queue_type, or UINT32_MAX if the Adapter has no family for the type, unused by DirectX12
+        std::array<uint32_t, static_cast<size_t>(queue_type::MaxEnum) + 1> m_queueFamilies {};
+
+        // Vulkan: render passes that are created on demand for rendering scopes and graphics pipelines, unused by DirectX12
+        void* m_renderPassCache = nullptr;
+
+        // Vulkan: VK_KHR_synchronization2 is enabled and used for split barriers
+        bool m_synchronization2 = false;
+
+        // instance_extension::DebugLabels was enabled, without it setName() and CommandList labels are ignored
+        bool m_debugLabels = false;
+
+        result impl_setName(const char* name);
+
         result impl_createCommandGroup(queue_type type, CommandGroup** cmdGroup);
         void impl_destroyCommandGroup(CommandGroup* cmdGroup);
 
         result impl_createFence(fence_flags flags, Fence** fence);
         void impl_destroyFence(Fence* fence);
-        result impl_waitFences(uint32_t numFences, Fence** fences, uint64_t timeout);
+        result impl_waitFences(uint32_t numFences, Fence** fences, uint64_t timeout, bool waitAny);
+        result impl_resetFences(uint32_t numFences, Fence** fences);
 
-        result impl_createSemaphore(Semaphore** semaphore);
+        result impl_createSemaphore(const semaphore_desc& desc, Semaphore** semaphore);
         void impl_destroySemaphore(Semaphore* semaphore);
+        result impl_waitSemaphores(uint32_t numSemaphores, Semaphore** semaphores, const uint64_t* values, uint64_t timeout, bool waitAny);
+
+        result impl_createQueryPool(const query_pool_desc& desc, QueryPool** queryPool);
+        void impl_destroyQueryPool(QueryPool* queryPool);
+
+        [[nodiscard]] peer_memory_feature_flags impl_queryPeerMemoryFeatures(uint8_t localNode, uint8_t remoteNode);
 
         result impl_createResource(const resource_desc& desc, Resource** resource);
         void impl_destroyResource(Resource* resource);
+
+        result impl_createPipelineCache(const pipeline_cache_desc& desc, PipelineCache** cache);
+        void impl_destroyPipelineCache(PipelineCache* cache);
+
+        result impl_createGraphicsPipeline(const graphics_pipeline_desc& desc, Pipeline** pipeline);
+        void impl_destroyPipeline(Pipeline* pipeline);
     };
 }
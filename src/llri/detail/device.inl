@@ -18,6 +18,20 @@ namespace llri
     {
         return m_ptr;
     }
+
+    inline result Device::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_validationCallbackMessenger)
+#endif
+    }
     
     inline Adapter* Device::getAdapter() const
     {
@@ -74,6 +88,17 @@ namespace llri
         return 0;
     }
 
+    inline peer_memory_feature_flags Device::queryPeerMemoryFeatures(uint8_t localNode, uint8_t remoteNode)
+    {
+        if (localNode >= m_adapter->queryNodeCount() || remoteNode >= m_adapter->queryNodeCount())
+            return peer_memory_feature_flag_bits::None;
+
+        if (localNode == remoteNode)
+            return peer_memory_feature_flag_bits::All;
+
+        LLRI_DETAIL_CALL_IMPL(impl_queryPeerMemoryFeatures(localNode, remoteNode), m_validationCallbackMessenger)
+    }
+
     inline result Device::createCommandGroup(queue_type type, CommandGroup** cmdGroup)
     {
         LLRI_DETAIL_VALIDATION_REQUIRE(cmdGroup != nullptr, result::ErrorInvalidUsage)
@@ -83,7 +108,13 @@ namespace llri
         LLRI_DETAIL_VALIDATION_REQUIRE(type <= queue_type::MaxEnum, result::ErrorInvalidUsage)
         LLRI_DETAIL_VALIDATION_REQUIRE(queryQueueCount(type) > 0, result::ErrorInvalidUsage)
 
-        LLRI_DETAIL_CALL_IMPL(impl_createCommandGroup(type, cmdGroup), m_validationCallbackMessenger)
+        const result r = impl_createCommandGroup(type, cmdGroup);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        if (r == result::Success)
+            LLRI_DETAIL_CAPTURE(this, createCommandGroup(*cmdGroup, type))
+
+        return r;
     }
 
     inline void Device::destroyCommandGroup(CommandGroup* cmdGroup)
@@ -100,10 +131,250 @@ namespace llri
             cmdGroup->free(static_cast<uint8_t>(cmdLists.size()), cmdLists.data());
         }
 
+        LLRI_DETAIL_CAPTURE(this, destroyCommandGroup(cmdGroup))
         impl_destroyCommandGroup(cmdGroup);
         LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
     }
 
+    inline result Device::createCommandContextPool(const command_context_pool_desc& desc, CommandContextPool** pool)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(pool != nullptr, result::ErrorInvalidUsage)
+
+        *pool = nullptr;
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.type <= queue_type::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryQueueCount(desc.type) > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numThreads > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numFramesInFlight > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.resetMode <= command_group_reset_mode::MaxEnum, result::ErrorInvalidUsage)
+
+        // CommandContextPool is implemented on top of CommandGroups and Fences and thus has no implementation specific code
+        auto* output = new CommandContextPool();
+        output->m_device = this;
+        output->m_desc = desc;
+        output->m_contexts.resize(static_cast<size_t>(desc.numThreads) * desc.numFramesInFlight);
+        output->m_fences.resize(desc.numFramesInFlight, nullptr);
+
+        for (auto& context : output->m_contexts)
+        {
+            const result r = createCommandGroup(desc.type, &context.group);
+            if (r != result::Success)
+            {
+                destroyCommandContextPool(output);
+                return r;
+            }
+        }
+
+        for (auto& fence : output->m_fences)
+        {
+            const result r = createFence(fence_flag_bits::None, &fence);
+            if (r != result::Success)
+            {
+                destroyCommandContextPool(output);
+                return r;
+            }
+        }
+
+        *pool = output;
+        return result::Success;
+    }
+
+    inline void Device::destroyCommandContextPool(CommandContextPool* pool)
+    {
+        if (!pool)
+            return;
+
+        for (auto& context : pool->m_contexts)
+            destroyCommandGroup(context.group);
+
+        for (auto* fence : pool->m_fences)
+            destroyFence(fence);
+
+        delete pool;
+    }
+
+    inline result Device::createFrameGraph(const frame_graph_desc& desc, FrameGraph** frameGraph)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(frameGraph != nullptr, result::ErrorInvalidUsage)
+
+        *frameGraph = nullptr;
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numThreads > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numFramesInFlight > 0, result::ErrorInvalidUsage)
+
+        // FrameGraph is implemented on top of CommandContextPools, Semaphores and Resources and thus has no implementation specific code
+        auto* output = new FrameGraph();
+        output->m_device = this;
+        output->m_desc = desc;
+        output->m_semaphores.resize(desc.numFramesInFlight);
+        output->m_transientResources.resize(desc.numFramesInFlight);
+        output->m_threadResults.resize(desc.numThreads);
+        output->m_workers.start(desc.numThreads - 1);
+
+        for (size_t type = 0; type <= static_cast<size_t>(queue_type::MaxEnum); type++)
+        {
+            if (queryQueueCount(static_cast<queue_type>(type)) == 0)
+                continue;
+
+            const result r = createCommandContextPool({ static_cast<queue_type>(type), desc.numThreads, desc.numFramesInFlight, command_group_reset_mode::KeepMemory }, &output->m_pools[type]);
+            if (r != result::Success)
+            {
+                destroyFrameGraph(output);
+                return r;
+            }
+        }
+
+        *frameGraph = output;
+        return result::Success;
+    }
+
+    inline void Device::destroyFrameGraph(FrameGraph* frameGraph)
+    {
+        if (!frameGraph)
+            return;
+
+        for (auto* pool : frameGraph->m_pools)
+            destroyCommandContextPool(pool);
+
+        for (auto& semaphores : frameGraph->m_semaphores)
+        {
+            for (auto* semaphore : semaphores)
+                destroySemaphore(semaphore);
+        }
+
+        for (auto& transients : frameGraph->m_transientResources)
+        {
+            for (auto& transient : transients)
+                destroyResource(transient.resource);
+        }
+
+        delete frameGraph;
+    }
+
+    inline result Device::createFrameScheduler(const frame_scheduler_desc& desc, FrameScheduler** scheduler)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(scheduler != nullptr, result::ErrorInvalidUsage)
+
+        *scheduler = nullptr;
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.type <= queue_type::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryQueueCount(desc.type) > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numThreads > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numFramesInFlight > 0, result::ErrorInvalidUsage)
+
+        // FrameScheduler is implemented on top of a CommandContextPool and thus has no implementation specific code
+        auto* output = new FrameScheduler();
+        output->m_device = this;
+        output->m_desc = desc;
+        output->m_numFrameIndices = desc.numFramesInFlight + 1;
+        output->m_callbacks.resize(output->m_numFrameIndices);
+
+        const result r = createCommandContextPool({ desc.type, desc.numThreads, output->m_numFrameIndices, command_group_reset_mode::KeepMemory }, &output->m_pool);
+        if (r != result::Success)
+        {
+            destroyFrameScheduler(output);
+            return r;
+        }
+
+        *scheduler = output;
+        return result::Success;
+    }
+
+    inline void Device::destroyFrameScheduler(FrameScheduler* scheduler)
+    {
+        if (!scheduler)
+            return;
+
+        // the frame after the current one is the oldest frame in flight
+        if (scheduler->m_pool)
+        {
+            const uint32_t numFrames = scheduler->m_numFrameIndices;
+            for (uint32_t i = 1; i <= numFrames; i++)
+                scheduler->flushCallbacks((scheduler->m_pool->getFrameIndex() + i) % numFrames);
+        }
+
+        destroyCommandContextPool(scheduler->m_pool);
+        delete scheduler;
+    }
+
+    inline result Device::createGpuProfiler(const gpu_profiler_desc& desc, GpuProfiler** profiler)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(profiler != nullptr, result::ErrorInvalidUsage)
+
+        *profiler = nullptr;
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.queue <= queue_type::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryQueueCount(desc.queue) > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(getQueue(desc.queue, 0)->queryTimestampPeriod() > 0.0, result::ErrorFeatureNotSupported)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.maxScopes > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numFramesInFlight > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.pipelineStatistics <= pipeline_statistic_flag_bits::All, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.pipelineStatistics != pipeline_statistic_flag_bits::None, desc.queue == queue_type::Graphics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.pipelineStatistics != pipeline_statistic_flag_bits::None, m_desc.features.pipelineStatisticsQuery, result::ErrorFeatureNotSupported)
+
+        // GpuProfiler is implemented on top of a QueryPool and thus has no implementation specific code
+        auto* output = new GpuProfiler();
+        output->m_device = this;
+        output->m_desc = desc;
+        output->m_timestampPeriod = getQueue(desc.queue, 0)->queryTimestampPeriod();
+        output->m_names.resize(static_cast<size_t>(desc.maxScopes) * desc.numFramesInFlight);
+        output->m_numScopes = std::make_unique<std::atomic<uint32_t>[]>(desc.numFramesInFlight);
+        output->m_timestamps.resize(static_cast<size_t>(desc.maxScopes) * 2);
+
+        const result r = createQueryPool({ query_type::Timestamp, desc.maxScopes * 2 * desc.numFramesInFlight, 0, pipeline_statistic_flag_bits::None }, &output->m_queryPool);
+        if (r != result::Success)
+        {
+            destroyGpuProfiler(output);
+            return r;
+        }
+
+        if (desc.pipelineStatistics != pipeline_statistic_flag_bits::None)
+        {
+            output->m_statistics.resize(desc.maxScopes);
+
+            const result statistics = createQueryPool({ query_type::PipelineStatistics, desc.maxScopes * desc.numFramesInFlight, 0, desc.pipelineStatistics }, &output->m_statisticsPool);
+            if (statistics != result::Success)
+            {
+                destroyGpuProfiler(output);
+                return statistics;
+            }
+        }
+
+        *profiler = output;
+        return result::Success;
+    }
+
+    inline void Device::destroyGpuProfiler(GpuProfiler* profiler)
+    {
+        if (!profiler)
+            return;
+
+        destroyQueryPool(profiler->m_queryPool);
+        destroyQueryPool(profiler->m_statisticsPool);
+        delete profiler;
+    }
+
+    inline result Device::createCommandStream(const command_stream_desc& desc, CommandStream** stream)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(stream != nullptr, result::ErrorInvalidUsage)
+
+        *stream = nullptr;
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.blockSize > 0, result::ErrorInvalidUsage)
+
+        // CommandStream only records on the CPU and translates through CommandList, so it has no implementation specific code
+        auto* output = new CommandStream();
+        output->m_desc = desc;
+
+        *stream = output;
+        return result::Success;
+    }
+
+    inline void Device::destroyCommandStream(CommandStream* stream)
+    {
+        delete stream;
+    }
+
     inline result Device::createFence(fence_flags flags, Fence** fence)
     {
         LLRI_DETAIL_VALIDATION_REQUIRE(fence != nullptr, result::ErrorInvalidUsage)
@@ -112,7 +383,13 @@ namespace llri
 
         LLRI_DETAIL_VALIDATION_REQUIRE(flags == fence_flag_bits::None || flags == fence_flag_bits::Signaled, result::ErrorInvalidUsage)
 
-        LLRI_DETAIL_CALL_IMPL(impl_createFence(flags, fence), m_validationCallbackMessenger)
+        const result r = impl_createFence(flags, fence);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        if (r == result::Success)
+            LLRI_DETAIL_CAPTURE(this, createFence(*fence, flags))
+
+        return r;
     }
 
     inline void Device::destroyFence(Fence* fence)
@@ -120,11 +397,18 @@ namespace llri
         if (!fence)
             return;
 
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        // the Fence's submissions can no longer be waited upon, so they're considered finished
+        if (fence->m_submissionState)
+            fence->m_submissionState->numCompleted = fence->m_submissionState->numSubmitted;
+#endif
+
+        LLRI_DETAIL_CAPTURE(this, destroyFence(fence))
         impl_destroyFence(fence);
         LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
     }
 
-    inline result Device::waitFences(uint32_t numFences, Fence** fences, uint64_t timeout)
+    inline result Device::waitFences(uint32_t numFences, Fence** fences, uint64_t timeout, bool waitAny)
     {
         LLRI_DETAIL_VALIDATION_REQUIRE(fences != nullptr, result::ErrorInvalidUsage)
         LLRI_DETAIL_VALIDATION_REQUIRE(numFences > 0, result::ErrorInvalidUsage)
@@ -137,7 +421,44 @@ namespace llri
         }
 #endif
 
-        LLRI_DETAIL_CALL_IMPL(impl_waitFences(numFences, fences, timeout), m_validationCallbackMessenger)
+        LLRI_DETAIL_CAPTURE(this, waitFences(numFences, fences, timeout, waitAny))
+
+        // Fences of Background Queues can only be waited on once their submission reached the driver, a failed submission never signals its Fence
+        for (size_t i = 0; i < numFences; i++)
+        {
+            Fence* fence = fences[i];
+            if (!fence->m_submitQueue)
+                continue;
+
+            fence->m_submitQueue->waitForSubmissionThread();
+            if (fence->m_submitResult != result::Success)
+            {
+                const result error = fence->m_submitResult;
+                fence->m_signaled = false;
+                fence->m_submitQueue = nullptr;
+                fence->m_submitResult = result::Success;
+                return error;
+            }
+        }
+
+        const result r = impl_waitFences(numFences, fences, timeout, waitAny);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        // waiting for any fence leaves the fences signaled so that their status can still be queried
+        if (r == result::Success && !waitAny)
+        {
+            for (size_t i = 0; i < numFences; i++)
+            {
+                fences[i]->m_signaled = false;
+                fences[i]->m_submitQueue = nullptr;
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+                if (fences[i]->m_submissionState)
+                    fences[i]->m_submissionState->numCompleted = fences[i]->m_submissionState->numSubmitted;
+#endif
+            }
+        }
+
+        return r;
     }
 
     inline result Device::waitFence(Fence* fence, uint64_t timeout)
@@ -145,13 +466,67 @@ namespace llri
         return waitFences(1, &fence, timeout);
     }
 
-    inline result Device::createSemaphore(Semaphore** semaphore)
+    inline result Device::resetFences(uint32_t numFences, Fence** fences)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(fences != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(numFences > 0, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        for (size_t i = 0; i < numFences; i++)
+        {
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(fences[i] != nullptr, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(!fences[i]->m_signaled || fences[i]->getStatus() != result::NotReady, i, result::ErrorInvalidState)
+        }
+#endif
+
+        LLRI_DETAIL_CAPTURE(this, resetFences(numFences, fences))
+
+        const result r = impl_resetFences(numFences, fences);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        if (r == result::Success)
+        {
+            for (size_t i = 0; i < numFences; i++)
+            {
+                fences[i]->m_signaled = false;
+                fences[i]->m_submitQueue = nullptr;
+                fences[i]->m_submitResult = result::Success;
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+                if (fences[i]->m_submissionState)
+                    fences[i]->m_submissionState->numCompleted = fences[i]->m_submissionState->numSubmitted;
+#endif
+            }
+        }
+
+        return r;
+    }
+
+    inline result Device::createSemaphore(const semaphore_desc& desc, Semaphore** semaphore)
     {
         LLRI_DETAIL_VALIDATION_REQUIRE(semaphore != nullptr, result::ErrorInvalidUsage)
 
         *semaphore = nullptr;
 
-        LLRI_DETAIL_CALL_IMPL(impl_createSemaphore(semaphore), m_validationCallbackMessenger)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.type <= semaphore_type::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.type == semaphore_type::Timeline, m_desc.features.timelineSemaphores, result::ErrorFeatureNotSupported)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.type == semaphore_type::Binary, desc.initialValue == 0, result::ErrorInvalidUsage)
+
+        const result r = impl_createSemaphore(desc, semaphore);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        if (r == result::Success)
+        {
+            (*semaphore)->m_type = desc.type;
+            (*semaphore)->m_counter = desc.initialValue;
+            LLRI_DETAIL_CAPTURE(this, createSemaphore(*semaphore, desc))
+        }
+
+        return r;
+    }
+
+    inline result Device::createSemaphore(Semaphore** semaphore)
+    {
+        return createSemaphore(semaphore_desc { semaphore_type::Binary, 0 }, semaphore);
     }
 
     inline void Device::destroySemaphore(Semaphore* semaphore)
@@ -159,10 +534,65 @@ namespace llri
         if (!semaphore)
             return;
 
+        LLRI_DETAIL_CAPTURE(this, destroySemaphore(semaphore))
         impl_destroySemaphore(semaphore);
         LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
     }
 
+    inline result Device::waitSemaphores(uint32_t numSemaphores, Semaphore** semaphores, const uint64_t* values, uint64_t timeout, bool waitAny)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(numSemaphores > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(semaphores != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(values != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        for (size_t i = 0; i < numSemaphores; i++)
+        {
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(semaphores[i] != nullptr, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(semaphores[i]->m_type == semaphore_type::Timeline, i, result::ErrorInvalidState)
+        }
+#endif
+
+        LLRI_DETAIL_CAPTURE(this, waitSemaphores(numSemaphores, semaphores, values, timeout, waitAny))
+        LLRI_DETAIL_CALL_IMPL(impl_waitSemaphores(numSemaphores, semaphores, values, timeout, waitAny), m_validationCallbackMessenger)
+    }
+
+    inline result Device::createQueryPool(const query_pool_desc& desc, QueryPool** queryPool)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(queryPool != nullptr, result::ErrorInvalidUsage)
+
+        *queryPool = nullptr;
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.type <= query_type::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.count > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.type == query_type::PipelineStatistics, m_desc.features.pipelineStatisticsQuery, result::ErrorFeatureNotSupported)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.type == query_type::PipelineStatistics, desc.pipelineStatistics != pipeline_statistic_flag_bits::None && desc.pipelineStatistics <= pipeline_statistic_flag_bits::All, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        const uint32_t nodeMask = desc.nodeMask == 0 ? 1 : desc.nodeMask;
+        LLRI_DETAIL_VALIDATION_REQUIRE(detail::hasSingleBit(nodeMask), result::ErrorInvalidNodeMask)
+        LLRI_DETAIL_VALIDATION_REQUIRE(nodeMask < (1u << m_adapter->queryNodeCount()), result::ErrorInvalidNodeMask)
+#endif
+
+        const result r = impl_createQueryPool(desc, queryPool);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        if (r == result::Success)
+            LLRI_DETAIL_CAPTURE(this, createQueryPool(*queryPool, desc))
+
+        return r;
+    }
+
+    inline void Device::destroyQueryPool(QueryPool* queryPool)
+    {
+        if (!queryPool)
+            return;
+
+        LLRI_DETAIL_CAPTURE(this, destroyQueryPool(queryPool))
+        impl_destroyQueryPool(queryPool);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+    }
+
     inline result Device::createResource(const resource_desc& desc, Resource** resource)
     {
         LLRI_DETAIL_VALIDATION_REQUIRE(resource != nullptr, result::ErrorInvalidUsage)
@@ -240,6 +670,8 @@ namespace llri
         // desc.initialState is a valid value
         LLRI_DETAIL_VALIDATION_REQUIRE(desc.initialState <= resource_state::MaxEnum, result::ErrorInvalidUsage)
 
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.sharingMode <= resource_sharing_mode::MaxEnum, result::ErrorInvalidUsage)
+
         switch(desc.type)
         {
             case resource_type::Buffer:
@@ -313,7 +745,16 @@ namespace llri
         LLRI_DETAIL_VALIDATION_REQUIRE_IF(isTexture, formatProperties.usage.all(desc.usage), result::ErrorInvalidUsage)
 #endif
 
-        LLRI_DETAIL_CALL_IMPL(impl_createResource(desc, resource), m_validationCallbackMessenger)
+        const result r = impl_createResource(desc, resource);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        if (r == result::Success && m_desc.resourceStateTracking)
+            (*resource)->m_trackedStates.assign(detail::subresourceCount(desc), desc.initialState);
+
+        if (r == result::Success)
+            LLRI_DETAIL_CAPTURE(this, createResource(*resource, desc))
+
+        return r;
     }
 
     inline void Device::destroyResource(Resource* resource)
@@ -321,7 +762,175 @@ namespace llri
         if (!resource)
             return;
 
+        LLRI_DETAIL_CAPTURE(this, destroyResource(resource))
         impl_destroyResource(resource);
         LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
     }
+
+    inline result Device::createPipelineCache(const pipeline_cache_desc& desc, PipelineCache** cache)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(cache != nullptr, result::ErrorInvalidUsage)
+
+        *cache = nullptr;
+
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.dataSize > 0, desc.data != nullptr, result::ErrorInvalidUsage)
+
+        // strip the LLRI header, the implementation only receives the data if it matches this adapter and driver
+        pipeline_cache_desc payload;
+        detail::readPipelineCacheHeader(m_adapter->queryInfo(), desc, &payload);
+
+        LLRI_DETAIL_CALL_IMPL(impl_createPipelineCache(payload, cache), m_validationCallbackMessenger)
+    }
+
+    inline void Device::destroyPipelineCache(PipelineCache* cache)
+    {
+        if (!cache)
+            return;
+
+        impl_destroyPipelineCache(cache);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+    }
+
+    inline result Device::createGraphicsPipeline(const graphics_pipeline_desc& desc, Pipeline** pipeline)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(pipeline != nullptr, result::ErrorInvalidUsage)
+
+        *pipeline = nullptr;
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        const adapter_limits& limits = m_limits;
+#endif
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.pushConstantStages <= shader_stage_flag_bits::AllGraphics, result::ErrorInvalidUsage)
+
+        // shaders
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.vertexShader.size > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.vertexShader.bytecode != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.fragmentShader.size > 0, desc.fragmentShader.bytecode != nullptr, result::ErrorInvalidUsage)
+
+        // vertex input
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.topology <= primitive_topology::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numVertexBindings <= limits.maxVertexInputBindings, result::ErrorExceededLimit)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.numVertexBindings > 0, desc.vertexBindings != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numVertexAttributes <= limits.maxVertexInputAttributes, result::ErrorExceededLimit)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.numVertexAttributes > 0, desc.vertexAttributes != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        for (size_t i = 0; i < desc.numVertexBindings; i++)
+        {
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.vertexBindings[i].binding < limits.maxVertexInputBindings, i, result::ErrorExceededLimit)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.vertexBindings[i].inputRate <= vertex_input_rate::MaxEnum, i, result::ErrorInvalidUsage)
+        }
+
+        for (size_t i = 0; i < desc.numVertexAttributes; i++)
+        {
+            const auto& attribute = desc.vertexAttributes[i];
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(attribute.location < limits.maxVertexInputAttributes, i, result::ErrorExceededLimit)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(has_color_component(attribute.format), i, result::ErrorInvalidFormat)
+
+            bool bindingFound = false;
+            for (size_t j = 0; j < desc.numVertexBindings; j++)
+                bindingFound |= desc.vertexBindings[j].binding == attribute.binding;
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(bindingFound, i, result::ErrorInvalidUsage)
+        }
+#endif
+
+        // rasterizer
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.rasterizer.cullMode <= cull_mode::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.rasterizer.frontFace <= front_face::MaxEnum, result::ErrorInvalidUsage)
+
+        // attachments
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numColorAttachments > 0 || desc.depthStencilFormat != format::Undefined, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numColorAttachments <= limits.maxColorAttachments, result::ErrorExceededLimit)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.numColorAttachments > 0, desc.colorAttachments != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.sampleCount <= sample_count::MaxEnum, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        for (size_t i = 0; i < desc.numColorAttachments; i++)
+        {
+            const auto& attachment = desc.colorAttachments[i];
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(has_color_component(attachment.format), i, result::ErrorInvalidFormat)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(attachment.writeMask <= color_component_flag_bits::All, i, result::ErrorInvalidUsage)
+
+            if (attachment.blendEnable)
+            {
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(attachment.srcColorFactor <= blend_factor::MaxEnum && attachment.dstColorFactor <= blend_factor::MaxEnum, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(attachment.srcAlphaFactor <= blend_factor::MaxEnum && attachment.dstAlphaFactor <= blend_factor::MaxEnum, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(attachment.colorOp <= blend_op::MaxEnum && attachment.alphaOp <= blend_op::MaxEnum, i, result::ErrorInvalidUsage)
+            }
+        }
+#endif
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        if (desc.depthStencilFormat != format::Undefined)
+        {
+            const auto& ds = desc.depthStencil;
+            LLRI_DETAIL_VALIDATION_REQUIRE(has_depth_component(desc.depthStencilFormat) || has_stencil_component(desc.depthStencilFormat), result::ErrorInvalidFormat)
+            LLRI_DETAIL_VALIDATION_REQUIRE_IF(ds.depthTestEnable, ds.depthCompareOp <= compare_op::MaxEnum, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_IF(ds.stencilTestEnable, has_stencil_component(desc.depthStencilFormat), result::ErrorInvalidFormat)
+
+            if (ds.stencilTestEnable)
+            {
+                for (const auto& face : { ds.front, ds.back })
+                {
+                    LLRI_DETAIL_VALIDATION_REQUIRE(face.failOp <= stencil_op::MaxEnum && face.passOp <= stencil_op::MaxEnum && face.depthFailOp <= stencil_op::MaxEnum, result::ErrorInvalidUsage)
+                    LLRI_DETAIL_VALIDATION_REQUIRE(face.compareOp <= compare_op::MaxEnum, result::ErrorInvalidUsage)
+                }
+            }
+        }
+#endif
+
+        const result r = impl_createGraphicsPipeline(desc, pipeline);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        if (r == result::Success)
+            LLRI_DETAIL_CAPTURE(this, createGraphicsPipeline(*pipeline, desc))
+
+        return r;
+    }
+
+    inline void Device::destroyPipeline(Pipeline* pipeline)
+    {
+        if (!pipeline)
+            return;
+
+        LLRI_DETAIL_CAPTURE(this, destroyPipeline(pipeline))
+        impl_destroyPipeline(pipeline);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+    }
+
+    inline result Device::beginCapture([[maybe_unused]] const char* path)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(path != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_capture == nullptr, result::ErrorInvalidState)
+
+#ifdef LLRI_DISABLE_CAPTURE
+        return result::ErrorFeatureNotSupported;
+#else
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return result::ErrorInitializationFailed;
+
+        // Queues are given the first ids so that the replay can map them without records of their own
+        std::vector<Queue*> queues;
+        std::vector<queue_desc> queueDescs;
+        for (const auto* typeQueues : { &m_graphicsQueues, &m_computeQueues, &m_transferQueues })
+        {
+            for (auto* queue : *typeQueues)
+            {
+                queues.push_back(queue);
+                queueDescs.push_back(queue->m_desc);
+            }
+        }
+
+        m_capture = new detail::capture_writer(std::move(file), m_desc.resourceStateTracking, static_cast<uint32_t>(queues.size()), queues.data(), queueDescs.data());
+        return result::Success;
+#endif
+    }
+
+    inline void Device::endCapture()
+    {
+        delete m_capture;
+        m_capture = nullptr;
+    }
 }
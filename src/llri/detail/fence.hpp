@@ -44,6 +44,19 @@ namespace llri
     */
     std::string to_string(fence_flags flags);
 
+    namespace detail
+    {
+        /**
+         * @brief Tracks the submissions that signal a Fence, so that the validation layer can determine if a CommandList is still in flight.
+         * The state is shared with the CommandLists that were submitted with the Fence, so that it outlives the Fence if it's destroyed first.
+        */
+        struct fence_submission_state
+        {
+            uint64_t numSubmitted = 0;
+            uint64_t numCompleted = 0;
+        };
+    }
+
     /**
      * @brief Fence is a synchronization structure that enables synchronization between GPU and CPU events.
      * Fences are often signaled by Queues after submitting CommandLists, after which the Fence can be waited upon using Device::waitFences().
@@ -52,6 +65,9 @@ namespace llri
     {
         friend class Device;
         friend class Queue;
+        friend class CommandContextPool;
+        friend class FrameGraph;
+        friend class FrameScheduler;
 
     public:
         using native_fence = void;
@@ -68,6 +84,31 @@ namespace llri
          * Vulkan: VkFence
          */
         [[nodiscard]] native_fence* getNative() const;
+
+        /**
+         * @brief Set the name of the Fence, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
+
+        /**
+         * @brief Query if the Fence has reached its signal, without blocking and without resetting the Fence.
+         * A Fence that hasn't been signaled by a submit since it was last reset is never ready, unless it was created with fence_flag_bits::Signaled.
+         *
+         * @return Success if the Fence reached its signal.
+         * @return NotReady if the Fence hasn't reached its signal yet, or if the submission that signals it is still waiting to be passed to the driver by a queue_submit_mode::Background Queue.
+         * @return The result of the submission if a queue_submit_mode::Background Queue failed to pass it to the driver.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory, ErrorDeviceLost.
+        */
+        result getStatus() const;
     private:
         // Force private constructor/deconstructor so that only create/destroy can manage lifetime
         Fence() = default;
@@ -76,8 +117,21 @@ namespace llri
         fence_flags m_flags;
 
         native_fence* m_ptr = nullptr;
+        Device* m_device = nullptr;
         void* m_event = nullptr;
         uint64_t m_counter = 0;
         bool m_signaled = false;
+
+        // the queue_submit_mode::Background Queue whose submission thread signals the Fence, the position of the submission in its ring, and the result of that submission
+        Queue* m_submitQueue = nullptr;
+        uint64_t m_submitPosition = 0;
+        result m_submitResult = result::Success;
+
+#ifndef LLRI_DISABLE_VALIDATION
+        std::shared_ptr<detail::fence_submission_state> m_submissionState;
+#endif
+
+        result impl_setName(const char* name);
+        result impl_getStatus() const;
     };
 }
@@ -46,4 +46,37 @@ namespace llri
     {
         return m_ptr;
     }
+
+    inline result Fence::getStatus() const
+    {
+        // unsignaled fences have no pending signal, which the implementations don't need to be asked about
+        if (!m_signaled)
+            return result::NotReady;
+
+        if (m_submitQueue)
+        {
+            // the submission can't have reached its signal if it's still waiting in the ring
+            if (m_submitQueue->m_submissionThread->numProcessed.load(std::memory_order_acquire) <= m_submitPosition)
+                return result::NotReady;
+
+            if (m_submitResult != result::Success)
+                return m_submitResult;
+        }
+
+        LLRI_DETAIL_CALL_IMPL(impl_getStatus(), m_device->m_validationCallbackMessenger)
+    }
+
+    inline result Fence::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_device->m_validationCallbackMessenger)
+#endif
+    }
 }
@@ -0,0 +1,283 @@
+/**
+ * @file frame_graph.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    class CommandContextPool;
+    class CommandList;
+    class Semaphore;
+
+    /**
+     * @brief A handle to a Resource that is used by a FrameGraph. Handles are only valid in the frame that they were created in.
+    */
+    using frame_graph_resource = uint32_t;
+
+    /**
+     * @brief Describes how a FrameGraph should be created.
+    */
+    struct frame_graph_desc
+    {
+        /**
+         * @brief The number of threads that record the FrameGraph's passes in FrameGraph::execute(). The calling thread is one of these threads, the others are started when the FrameGraph is created and sleep while it isn't executing.
+         *
+         * @note Valid usage (ErrorInvalidUsage): numThreads **must** be more than 0.
+        */
+        uint32_t numThreads;
+        /**
+         * @brief The number of frames that **may** be processed by the GPU while the next frame is recorded. CommandLists, Semaphores and transient Resources are kept separately for each frame in flight.
+         *
+         * @note Valid usage (ErrorInvalidUsage): numFramesInFlight **must** be more than 0.
+        */
+        uint32_t numFramesInFlight;
+    };
+
+    /**
+     * @brief Describes how a pass accesses a resource.
+    */
+    struct frame_graph_resource_access
+    {
+        /**
+         * @brief The resource that is accessed.
+         *
+         * @note Valid usage (ErrorInvalidUsage): resource **must** be a handle that was returned by FrameGraph::importResource() or FrameGraph::createTransientResource() in the current frame.
+        */
+        frame_graph_resource resource;
+        /**
+         * @brief The state that the resource **must** be in during the pass. Accesses in resource_state::General, ShaderReadWrite, ColorAttachment, DepthStencilAttachment and TransferDst are considered writes, all other states are reads.
+         *
+         * @note Valid usage (ErrorInvalidUsage): state **must** be less or equal to resource_state::MaxEnum.
+         * @note Valid usage (ErrorInvalidState): The resource **must** support state, as described in resource_state.
+        */
+        resource_state state;
+    };
+
+    /**
+     * @brief Describes a pass in a FrameGraph.
+    */
+    struct frame_graph_pass_desc
+    {
+        /**
+         * @brief The type of Queue that the pass prefers to execute on. Passes on different Queues can execute simultaneously.
+         *
+         * If the Device has no Queue of this type, compute passes execute on the Graphics queue and transfer passes on the Compute or Graphics queue.
+         *
+         * @note Valid usage (ErrorInvalidUsage): queue **must** be less or equal to queue_type::MaxEnum.
+         * @note Valid usage (ErrorInvalidUsage): If queue is queue_type::Graphics, the Device **must** have a Graphics Queue.
+        */
+        queue_type queue;
+        /**
+         * @brief The number of resources that the pass accesses.
+        */
+        uint32_t numAccesses;
+        /**
+         * @brief The resources that the pass accesses, [accesses, accesses + numAccesses - 1].
+         *
+         * @note Valid usage (ErrorInvalidUsage): If numAccesses is more than 0, accesses **must** be a valid pointer to an array of frame_graph_resource_access with a size of at least numAccesses.
+         * @note Valid usage (ErrorInvalidUsage): Each resource **must** only be accessed once per pass.
+        */
+        const frame_graph_resource_access* accesses;
+        /**
+         * @brief Records the commands of the pass. The CommandList is in the Recording state, and all accessed resources are in their requested states.
+         *
+         * The function **may** be called from any of the FrameGraph's recording threads, and **must not** access resources other than the ones it declared.
+         *
+         * @note Valid usage (ErrorInvalidUsage): record **must** be a valid function.
+        */
+        std::function<void(CommandList*)> record;
+    };
+
+    /**
+     * @brief FrameGraph schedules the work of a frame from passes that declare which resources they access and in which states.
+     *
+     * Every frame, passes are added after FrameGraph::beginFrame(), and FrameGraph::execute() then:
+     * - orders the passes topologically based on their dependencies, preferring to keep passes on the same Queue together.
+     * - inserts only the barriers that are necessary for the resources' state changes and read/write hazards, batched per pass. Transitions between passes on different Queues are recorded on the more capable queue type of the two.
+     * - reuses a transient Resource for a later transient whose lifetime doesn't overlap, but only if both have an identical resource_desc and are used on a single Queue. Memory isn't aliased between transients with different descriptions.
+     * - records the passes in parallel on frame_graph_desc::numThreads threads.
+     * - submits the passes to their Queues, and synchronizes dependencies between Queues with Semaphores.
+     *
+     * @note FrameGraph functions **must not** be called simultaneously from multiple threads.
+    */
+    class FrameGraph
+    {
+        friend class Device;
+
+    public:
+        /**
+         * @brief Get the desc that the FrameGraph was created with.
+        */
+        [[nodiscard]] frame_graph_desc getDesc() const;
+
+        /**
+         * @brief Get the index of the current frame in flight, which is in the range [0, frame_graph_desc::numFramesInFlight - 1].
+        */
+        [[nodiscard]] uint32_t getFrameIndex() const;
+
+        /**
+         * @brief Move to the next frame in flight. This waits until the GPU has finished executing the frame's previous passes, and removes all passes and resource handles of the previous frame.
+         *
+         * @param timeout The time in milliseconds that the function **may** wait for the frame. Refer to Device::waitFences() for more information.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return CommandContextPool::beginFrame() defined result values.
+        */
+        result beginFrame(uint64_t timeout);
+
+        /**
+         * @brief Import a Resource that is owned by the application, so that passes can access it.
+         *
+         * @param resource The Resource to import.
+         * @param state The state that the Resource is in before the first pass that accesses it.
+         * @param handle A pointer to the resulting frame_graph_resource variable.
+         *
+         * @note Valid usage (ErrorInvalidState): FrameGraph::beginFrame() **must** have been called, and FrameGraph::execute() **must not** have been called since.
+         * @note Valid usage (ErrorInvalidUsage): resource **must** be a valid non-null pointer to a Resource, and handle **must** be a valid non-null pointer to a frame_graph_resource variable.
+         * @note Valid usage (ErrorInvalidUsage): state **must** be less or equal to resource_state::MaxEnum.
+         * @note Valid usage: if resource was created with resource_sharing_mode::Exclusive, the passes that access it **must** all use the same queue_type, because the FrameGraph doesn't transfer queue ownership.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result importResource(Resource* resource, resource_state state, frame_graph_resource* handle);
+
+        /**
+         * @brief Declare a Resource that only exists for the current frame. The Resource is created or reused by FrameGraph::execute(), and its contents are undefined before its first pass.
+         *
+         * @param desc The description of the Resource. desc.initialState is ignored if the Resource's memory is reused.
+         * @param handle A pointer to the resulting frame_graph_resource variable.
+         *
+         * @note Valid usage (ErrorInvalidState): FrameGraph::beginFrame() **must** have been called, and FrameGraph::execute() **must not** have been called since.
+         * @note Valid usage (ErrorInvalidUsage): handle **must** be a valid non-null pointer to a frame_graph_resource variable.
+         * @note Valid usage (ErrorInvalidUsage): desc.sharingMode **must** be resource_sharing_mode::Concurrent.
+         * @note Valid usage: desc **must** be valid for Device::createResource().
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result createTransientResource(const resource_desc& desc, frame_graph_resource* handle);
+
+        /**
+         * @brief Add a pass to the current frame.
+         *
+         * @note Valid usage (ErrorInvalidState): FrameGraph::beginFrame() **must** have been called, and FrameGraph::execute() **must not** have been called since.
+         * @note All conditions in frame_graph_pass_desc **must** be met.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result addPass(const frame_graph_pass_desc& desc);
+
+        /**
+         * @brief Schedule, record and submit the passes of the current frame.
+         *
+         * @note Valid usage (ErrorInvalidState): FrameGraph::beginFrame() **must** have been called, and FrameGraph::execute() **must not** have been called since.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Device::createResource(), Device::createSemaphore(), CommandList and Queue::submit() defined result values.
+        */
+        result execute();
+
+        /**
+         * @brief Get the Resource of a handle. Transient Resources are only assigned during FrameGraph::execute(), so this function returns nullptr for them before that.
+        */
+        [[nodiscard]] Resource* getResource(frame_graph_resource handle) const;
+
+        /**
+         * @brief Get the state that a resource is in. After FrameGraph::execute(), this is the state that the resource is in after its last pass.
+        */
+        [[nodiscard]] resource_state getResourceState(frame_graph_resource handle) const;
+
+    private:
+        // Force private constructor/deconstructor so that only create/destroy can manage lifetime
+        FrameGraph() = default;
+        ~FrameGraph() = default;
+
+        static constexpr uint32_t noPass = std::numeric_limits<uint32_t>::max();
+
+        struct resource_entry
+        {
+            Resource* resource;
+            resource_state state;
+            bool transient;
+            resource_desc desc;
+
+            // the first and last position in the execution order of the passes that access the resource
+            uint32_t firstUse;
+            uint32_t lastUse;
+            // the queue of the first pass that accesses the resource, and whether all passes that access it are on that queue
+            queue_type queue;
+            bool singleQueue;
+        };
+
+        struct pass_entry
+        {
+            queue_type queue;
+            std::vector<frame_graph_resource_access> accesses;
+            std::function<void(CommandList*)> record;
+
+            std::vector<uint32_t> dependencies;
+            std::vector<resource_barrier> barriers;
+            // barriers that are recorded after the pass, for transitions that the passes of other queues depend on
+            std::vector<resource_barrier> postBarriers;
+            CommandList* list;
+            uint32_t batch;
+        };
+
+        // a transient Resource that can be reused in every frame that has the same frame index
+        struct transient_resource
+        {
+            Resource* resource;
+            resource_state state;
+            // the position in the execution order of the last pass that used the Resource in the current frame, or noPass if it's unused
+            uint32_t lastUse;
+            queue_type queue;
+            bool singleQueue;
+        };
+
+        // a group of passes that is submitted to a Queue at once
+        struct submission_batch
+        {
+            queue_type queue;
+            std::vector<CommandList*> lists;
+            std::vector<Semaphore*> waitSemaphores;
+            std::vector<Semaphore*> signalSemaphores;
+        };
+
+        Device* m_device = nullptr;
+        frame_graph_desc m_desc;
+
+        // a CommandContextPool for every queue type that the Device has, indexed by queue_type
+        std::array<CommandContextPool*, static_cast<size_t>(queue_type::MaxEnum) + 1> m_pools {};
+
+        // Semaphores and transient Resources are stored per frame in flight
+        std::vector<std::vector<Semaphore*>> m_semaphores;
+        std::vector<std::vector<transient_resource>> m_transientResources;
+        uint32_t m_numUsedSemaphores = 0;
+
+        uint32_t m_frameIndex = 0;
+        bool m_frameStarted = false;
+        bool m_executed = false;
+
+        std::vector<resource_entry> m_resources;
+        std::vector<pass_entry> m_passes;
+        std::vector<uint32_t> m_order;
+        std::vector<submission_batch> m_batches;
+
+        // the threads that record the passes together with the thread that calls execute(), and the result of each
+        detail::worker_pool m_workers;
+        std::vector<result> m_threadResults;
+
+        [[nodiscard]] queue_type selectQueue(queue_type preferred);
+        result acquireSemaphore(Semaphore** semaphore);
+
+        void resolveDependencies();
+        void sortPasses();
+        result assignTransientResources();
+        void resolveBarriers();
+        result recordPasses();
+        result submitPasses();
+    };
+}
@@ -0,0 +1,572 @@
+/**
+ * @file frame_graph.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    namespace detail
+    {
+        /**
+         * @brief Returns true if accessing a resource in state can write to it.
+        */
+        constexpr bool isWriteState(resource_state state)
+        {
+            return state == resource_state::General || state == resource_state::ShaderReadWrite || state == resource_state::ColorAttachment ||
+                state == resource_state::DepthStencilAttachment || state == resource_state::TransferDst;
+        }
+
+        /**
+         * @brief Returns true if Resources created with lhs and rhs are interchangeable, ignoring their initial states.
+        */
+        inline bool isSameResourceDesc(const resource_desc& lhs, const resource_desc& rhs)
+        {
+            return lhs.createNodeMask == rhs.createNodeMask && lhs.visibleNodeMask == rhs.visibleNodeMask &&
+                lhs.type == rhs.type && lhs.usage.value == rhs.usage.value && lhs.memoryType == rhs.memoryType &&
+                lhs.width == rhs.width && lhs.height == rhs.height && lhs.depthOrArrayLayers == rhs.depthOrArrayLayers &&
+                lhs.mipLevels == rhs.mipLevels && lhs.sampleCount == rhs.sampleCount && lhs.textureFormat == rhs.textureFormat && lhs.sharingMode == rhs.sharingMode;
+        }
+    }
+
+    inline frame_graph_desc FrameGraph::getDesc() const
+    {
+        return m_desc;
+    }
+
+    inline uint32_t FrameGraph::getFrameIndex() const
+    {
+        return m_frameIndex;
+    }
+
+    inline result FrameGraph::beginFrame(uint64_t timeout)
+    {
+        const uint32_t next = m_frameStarted ? (m_frameIndex + 1) % m_desc.numFramesInFlight : 0;
+
+        // wait for all queues before any of the pools moves to the next frame, so that the pools stay in sync if the wait times out
+        for (auto* pool : m_pools)
+        {
+            if (!pool)
+                continue;
+
+            Fence* fence = pool->m_fences[next];
+            if (fence->m_signaled)
+            {
+                const result r = m_device->waitFence(fence, timeout);
+                if (r != result::Success)
+                    return r;
+            }
+        }
+
+        for (auto* pool : m_pools)
+        {
+            if (!pool)
+                continue;
+
+            const result r = pool->beginFrame(timeout);
+            if (r != result::Success)
+                return r;
+        }
+
+        for (auto& transient : m_transientResources[next])
+            transient.lastUse = noPass;
+
+        m_numUsedSemaphores = 0;
+        m_resources.clear();
+        m_passes.clear();
+
+        m_frameIndex = next;
+        m_frameStarted = true;
+        m_executed = false;
+        return result::Success;
+    }
+
+    inline result FrameGraph::importResource(Resource* resource, resource_state state, frame_graph_resource* handle)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted && !m_executed, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(resource != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(handle != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(state <= resource_state::MaxEnum, result::ErrorInvalidUsage)
+
+        *handle = static_cast<frame_graph_resource>(m_resources.size());
+        m_resources.push_back(resource_entry { resource, state, false, resource->getDesc(), noPass, noPass, queue_type::Graphics, true });
+        return result::Success;
+    }
+
+    inline result FrameGraph::createTransientResource(const resource_desc& desc, frame_graph_resource* handle)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted && !m_executed, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(handle != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.sharingMode == resource_sharing_mode::Concurrent, result::ErrorInvalidUsage)
+
+        *handle = static_cast<frame_graph_resource>(m_resources.size());
+        m_resources.push_back(resource_entry { nullptr, desc.initialState, true, desc, noPass, noPass, queue_type::Graphics, true });
+        return result::Success;
+    }
+
+    inline result FrameGraph::addPass(const frame_graph_pass_desc& desc)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted && !m_executed, result::ErrorInvalidState)
+
+        LLRI_DETAIL_VALIDATION_REQUIRE(desc.queue <= queue_type::MaxEnum, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_pools[static_cast<size_t>(selectQueue(desc.queue))] != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.numAccesses > 0, desc.accesses != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(static_cast<bool>(desc.record), result::ErrorInvalidUsage)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        for (size_t i = 0; i < desc.numAccesses; i++)
+        {
+            const frame_graph_resource_access& access = desc.accesses[i];
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(access.resource < m_resources.size(), i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(access.state <= resource_state::MaxEnum, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(detail::supportsResourceState(m_resources[access.resource].desc, access.state), i, result::ErrorInvalidState)
+
+            const bool unique = std::none_of(desc.accesses, desc.accesses + i, [&](const frame_graph_resource_access& other) { return other.resource == access.resource; });
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(unique, i, result::ErrorInvalidUsage)
+        }
+#endif
+
+        pass_entry pass {};
+        pass.queue = selectQueue(desc.queue);
+        pass.accesses.assign(desc.accesses, desc.accesses + desc.numAccesses);
+        pass.record = desc.record;
+        m_passes.push_back(std::move(pass));
+        return result::Success;
+    }
+
+    inline result FrameGraph::execute()
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted && !m_executed, result::ErrorInvalidState)
+
+        m_executed = true;
+        if (m_passes.empty())
+            return result::Success;
+
+        resolveDependencies();
+        sortPasses();
+
+        result r = assignTransientResources();
+        if (r != result::Success)
+            return r;
+
+        resolveBarriers();
+
+        r = recordPasses();
+        if (r != result::Success)
+            return r;
+
+        return submitPasses();
+    }
+
+    inline Resource* FrameGraph::getResource(frame_graph_resource handle) const
+    {
+        if (handle >= m_resources.size())
+            return nullptr;
+
+        return m_resources[handle].resource;
+    }
+
+    inline resource_state FrameGraph::getResourceState(frame_graph_resource handle) const
+    {
+        if (handle >= m_resources.size())
+            return resource_state::General;
+
+        return m_resources[handle].state;
+    }
+
+    inline queue_type FrameGraph::selectQueue(queue_type preferred)
+    {
+        if (m_device->queryQueueCount(preferred) > 0)
+            return preferred;
+
+        // Graphics queues can execute all work, and Compute queues can execute all but graphics work
+        if (preferred == queue_type::Transfer && m_device->queryQueueCount(queue_type::Compute) > 0)
+            return queue_type::Compute;
+
+        return queue_type::Graphics;
+    }
+
+    inline result FrameGraph::acquireSemaphore(Semaphore** semaphore)
+    {
+        auto& semaphores = m_semaphores[m_frameIndex];
+        if (m_numUsedSemaphores == semaphores.size())
+        {
+            Semaphore* output;
+            const result r = m_device->createSemaphore(&output);
+            if (r != result::Success)
+                return r;
+
+            semaphores.push_back(output);
+        }
+
+        *semaphore = semaphores[m_numUsedSemaphores++];
+        return result::Success;
+    }
+
+    inline void FrameGraph::resolveDependencies()
+    {
+        // passes depend on the last pass that modified a resource, and modifications also depend on the reads before them
+        // a transition to another state is a modification, even if both states only read
+        struct resource_usage
+        {
+            uint32_t lastModification = noPass;
+            std::vector<uint32_t> reads;
+            resource_state state = detail::unknownResourceState;
+        };
+
+        std::vector<resource_usage> usages(m_resources.size());
+        for (size_t i = 0; i < m_resources.size(); i++)
+        {
+            if (!m_resources[i].transient)
+                usages[i].state = m_resources[i].state;
+        }
+
+        for (uint32_t p = 0; p < m_passes.size(); p++)
+        {
+            auto& pass = m_passes[p];
+            pass.dependencies.clear();
+
+            for (const auto& access : pass.accesses)
+            {
+                auto& usage = usages[access.resource];
+                if (usage.lastModification != noPass)
+                    pass.dependencies.push_back(usage.lastModification);
+
+                if (detail::isWriteState(access.state) || usage.state != access.state)
+                {
+                    pass.dependencies.insert(pass.dependencies.end(), usage.reads.begin(), usage.reads.end());
+                    usage.reads.clear();
+                    usage.lastModification = p;
+                }
+                else
+                {
+                    usage.reads.push_back(p);
+                }
+
+                usage.state = access.state;
+            }
+
+            std::sort(pass.dependencies.begin(), pass.dependencies.end());
+            pass.dependencies.erase(std::unique(pass.dependencies.begin(), pass.dependencies.end()), pass.dependencies.end());
+        }
+    }
+
+    inline void FrameGraph::sortPasses()
+    {
+        const size_t numPasses = m_passes.size();
+
+        std::vector<uint32_t> numRemainingDependencies(numPasses);
+        std::vector<std::vector<uint32_t>> dependents(numPasses);
+        for (uint32_t p = 0; p < numPasses; p++)
+        {
+            numRemainingDependencies[p] = static_cast<uint32_t>(m_passes[p].dependencies.size());
+            for (uint32_t dependency : m_passes[p].dependencies)
+                dependents[dependency].push_back(p);
+        }
+
+        // Kahn's algorithm, which prefers passes on the queue of the previous pass so that fewer submissions and Semaphores are needed
+        // ties are broken by the order in which the passes were added
+        std::vector<bool> scheduled(numPasses, false);
+        m_order.clear();
+
+        queue_type currentQueue = m_passes[0].queue;
+        while (m_order.size() < numPasses)
+        {
+            uint32_t next = noPass;
+            for (uint32_t p = 0; p < numPasses; p++)
+            {
+                if (scheduled[p] || numRemainingDependencies[p] != 0)
+                    continue;
+
+                if (m_passes[p].queue == currentQueue)
+                {
+                    next = p;
+                    break;
+                }
+
+                if (next == noPass)
+                    next = p;
+            }
+
+            scheduled[next] = true;
+            currentQueue = m_passes[next].queue;
+            m_order.push_back(next);
+
+            for (uint32_t dependent : dependents[next])
+                numRemainingDependencies[dependent]--;
+        }
+    }
+
+    inline result FrameGraph::assignTransientResources()
+    {
+        for (uint32_t i = 0; i < m_order.size(); i++)
+        {
+            const auto& pass = m_passes[m_order[i]];
+            for (const auto& access : pass.accesses)
+            {
+                auto& entry = m_resources[access.resource];
+                if (entry.firstUse == noPass)
+                {
+                    entry.firstUse = i;
+                    entry.queue = pass.queue;
+                }
+                else if (entry.queue != pass.queue)
+                {
+                    entry.singleQueue = false;
+                }
+
+                entry.lastUse = i;
+            }
+        }
+
+        std::vector<uint32_t> transients;
+        for (uint32_t i = 0; i < m_resources.size(); i++)
+        {
+            if (m_resources[i].transient && m_resources[i].firstUse != noPass)
+                transients.push_back(i);
+        }
+
+        std::sort(transients.begin(), transients.end(), [this](uint32_t lhs, uint32_t rhs) {
+            return m_resources[lhs].firstUse < m_resources[rhs].firstUse;
+        });
+
+        // a Resource is reused if it's unused in the frame, or if its previous lifetime ended before the new one starts on the same queue
+        // the queue's barriers then order the two lifetimes
+        auto& pool = m_transientResources[m_frameIndex];
+        for (uint32_t index : transients)
+        {
+            auto& entry = m_resources[index];
+
+            auto it = std::find_if(pool.begin(), pool.end(), [&](const transient_resource& transient) {
+                if (!detail::isSameResourceDesc(transient.resource->getDesc(), entry.desc))
+                    return false;
+
+                if (transient.lastUse == noPass)
+                    return true;
+
+                return transient.singleQueue && entry.singleQueue && transient.queue == entry.queue && transient.lastUse < entry.firstUse;
+            });
+
+            if (it == pool.end())
+            {
+                Resource* resource;
+                const result r = m_device->createResource(entry.desc, &resource);
+                if (r != result::Success)
+                    return r;
+
+                pool.push_back(transient_resource { resource, entry.desc.initialState, noPass, entry.queue, true });
+                it = pool.end() - 1;
+            }
+
+            // the state of a Resource that is reused within the frame is only known once the barriers are resolved
+            entry.resource = it->resource;
+            entry.state = it->lastUse == noPass ? it->state : detail::unknownResourceState;
+
+            it->lastUse = entry.lastUse;
+            it->queue = entry.queue;
+            it->singleQueue = entry.singleQueue;
+        }
+
+        return result::Success;
+    }
+
+    inline void FrameGraph::resolveBarriers()
+    {
+        struct resource_usage
+        {
+            resource_state state;
+            bool written;
+            // the last pass that used the resource, and whether every pass that used it in its current state is on that pass's queue
+            uint32_t lastPass = noPass;
+            bool singleQueue = true;
+        };
+
+        std::unordered_map<Resource*, resource_usage> usages;
+        for (const auto& entry : m_resources)
+        {
+            if (entry.resource && entry.state != detail::unknownResourceState)
+                usages.emplace(entry.resource, resource_usage { entry.state, false, noPass, true });
+        }
+
+        for (auto& pass : m_passes)
+        {
+            pass.barriers.clear();
+            pass.postBarriers.clear();
+        }
+
+        // passes are resolved in execution order, so that the states of reused transient Resources carry over between their lifetimes
+        for (uint32_t index : m_order)
+        {
+            auto& pass = m_passes[index];
+
+            for (const auto& access : pass.accesses)
+            {
+                Resource* resource = m_resources[access.resource].resource;
+                auto& usage = usages[resource];
+
+                const bool write = detail::isWriteState(access.state);
+                const bool otherQueue = usage.lastPass != noPass && m_passes[usage.lastPass].queue != pass.queue;
+                if (usage.state != access.state)
+                {
+                    // a queue can't always transition between the states of other queues, DirectX 12 compute and copy queues can't transition graphics states for example
+                    // so if the resource was last used on another queue, the transition is recorded once, on the more capable queue type of the pair
+                    // if that's the producing queue, the transition is recorded after its use, before the Semaphore that this pass waits on is signaled
+                    // this isn't possible if passes on multiple queues used the resource, but then its state is already supported by all of them
+                    if (otherQueue && usage.singleQueue && m_passes[usage.lastPass].queue < pass.queue)
+                        m_passes[usage.lastPass].postBarriers.push_back(resource_barrier::transition(resource, usage.state, access.state));
+                    else
+                        pass.barriers.push_back(resource_barrier::transition(resource, usage.state, access.state));
+
+                    usage.singleQueue = true;
+                }
+                else
+                {
+                    if (usage.written || write)
+                        pass.barriers.push_back(resource_barrier::read_write(resource));
+
+                    usage.singleQueue &= !otherQueue;
+                }
+
+                usage.state = access.state;
+                usage.written = write;
+                usage.lastPass = index;
+            }
+        }
+
+        for (auto& entry : m_resources)
+        {
+            if (entry.resource)
+                entry.state = usages[entry.resource].state;
+        }
+
+        for (auto& transient : m_transientResources[m_frameIndex])
+        {
+            if (transient.lastUse != noPass)
+                transient.state = usages[transient.resource].state;
+        }
+    }
+
+    inline result FrameGraph::recordPasses()
+    {
+        // every thread records every numThreads-th pass, into CommandLists of its own CommandGroups
+        const auto recordPasses = [this](uint32_t thread) -> result
+        {
+            for (size_t i = thread; i < m_order.size(); i += m_desc.numThreads)
+            {
+                auto& pass = m_passes[m_order[i]];
+
+                result r = m_pools[static_cast<size_t>(pass.queue)]->acquireCommandList(thread, command_list_alloc_desc { 0, command_list_usage::Direct }, &pass.list);
+                if (r != result::Success)
+                    return r;
+
+                r = pass.list->begin({});
+                if (r != result::Success)
+                    return r;
+
+                if (!pass.barriers.empty())
+                {
+                    r = pass.list->resourceBarrier(static_cast<uint32_t>(pass.barriers.size()), pass.barriers.data());
+                    if (r != result::Success)
+                        return r;
+                }
+
+                pass.record(pass.list);
+
+                if (!pass.postBarriers.empty())
+                {
+                    r = pass.list->resourceBarrier(static_cast<uint32_t>(pass.postBarriers.size()), pass.postBarriers.data());
+                    if (r != result::Success)
+                        return r;
+                }
+
+                r = pass.list->end();
+                if (r != result::Success)
+                    return r;
+            }
+
+            return result::Success;
+        };
+
+        const uint32_t numThreads = std::min(m_desc.numThreads, static_cast<uint32_t>(m_order.size()));
+        m_workers.run(numThreads, [&](uint32_t thread) {
+            m_threadResults[thread] = recordPasses(thread);
+        });
+
+        for (uint32_t thread = 0; thread < numThreads; thread++)
+        {
+            if (m_threadResults[thread] != result::Success)
+                return m_threadResults[thread];
+        }
+
+        return result::Success;
+    }
+
+    inline result FrameGraph::submitPasses()
+    {
+        // consecutive passes on the same queue are submitted together
+        m_batches.clear();
+        for (uint32_t index : m_order)
+        {
+            auto& pass = m_passes[index];
+            if (m_batches.empty() || m_batches.back().queue != pass.queue)
+                m_batches.push_back(submission_batch { pass.queue, {}, {}, {} });
+
+            pass.batch = static_cast<uint32_t>(m_batches.size() - 1);
+            m_batches.back().lists.push_back(pass.list);
+        }
+
+        // dependencies between queues are synchronized with a Semaphore per pair of batches
+        std::vector<std::pair<uint32_t, uint32_t>> crossQueueDependencies;
+        for (const auto& pass : m_passes)
+        {
+            for (uint32_t dependency : pass.dependencies)
+            {
+                const auto& source = m_passes[dependency];
+                if (source.queue != pass.queue)
+                    crossQueueDependencies.emplace_back(source.batch, pass.batch);
+            }
+        }
+
+        std::sort(crossQueueDependencies.begin(), crossQueueDependencies.end());
+        crossQueueDependencies.erase(std::unique(crossQueueDependencies.begin(), crossQueueDependencies.end()), crossQueueDependencies.end());
+
+        for (const auto& [source, destination] : crossQueueDependencies)
+        {
+            Semaphore* semaphore;
+            const result r = acquireSemaphore(&semaphore);
+            if (r != result::Success)
+                return r;
+
+            m_batches[source].signalSemaphores.push_back(semaphore);
+            m_batches[destination].waitSemaphores.push_back(semaphore);
+        }
+
+        // the last batch on each queue signals the frame Fence of the queue's CommandContextPool
+        std::array<size_t, static_cast<size_t>(queue_type::MaxEnum) + 1> lastBatches {};
+        for (size_t i = 0; i < m_batches.size(); i++)
+            lastBatches[static_cast<size_t>(m_batches[i].queue)] = i;
+
+        for (size_t i = 0; i < m_batches.size(); i++)
+        {
+            auto& batch = m_batches[i];
+            auto* pool = m_pools[static_cast<size_t>(batch.queue)];
+
+            const submit_desc desc {
+                0,
+                static_cast<uint32_t>(batch.lists.size()), batch.lists.data(),
+                static_cast<uint32_t>(batch.waitSemaphores.size()), batch.waitSemaphores.data(), nullptr, nullptr,
+                static_cast<uint32_t>(batch.signalSemaphores.size()), batch.signalSemaphores.data(), nullptr,
+                lastBatches[static_cast<size_t>(batch.queue)] == i ? pool->getFrameFence() : nullptr
+            };
+
+            const result r = m_device->getQueue(batch.queue, 0)->submit(desc);
+            if (r != result::Success)
+                return r;
+        }
+
+        return result::Success;
+    }
+}
@@ -0,0 +1,184 @@
+/**
+ * @file frame_scheduler.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    class CommandContextPool;
+    class Fence;
+
+    /**
+     * @brief Describes how a FrameScheduler should be created.
+    */
+    struct frame_scheduler_desc
+    {
+        /**
+         * @brief The type of queue that the FrameScheduler's CommandGroups allocate for.
+         *
+         * @note Valid usage (ErrorInvalidUsage): type **must** be less or equal to queue_type::MaxEnum.
+         * @note Valid usage (ErrorInvalidUsage): Device::queryQueueCount(type) **must** return more than 0.
+        */
+        queue_type type;
+        /**
+         * @brief The number of threads that record CommandLists simultaneously. Refer to command_context_pool_desc::numThreads for more information.
+         *
+         * @note Valid usage (ErrorInvalidUsage): numThreads **must** be more than 0.
+        */
+        uint32_t numThreads;
+        /**
+         * @brief The latency of the FrameScheduler, which is the number of frames that **may** be processed by the GPU while the next frame is recorded.
+         *
+         * A higher latency lets the CPU run further ahead of the GPU, which hides stalls on either side at the cost of input latency and memory that is kept alive for longer.
+         *
+         * @note Valid usage (ErrorInvalidUsage): numFramesInFlight **must** be more than 0.
+        */
+        uint32_t numFramesInFlight;
+    };
+
+    /**
+     * @brief The CPU time that was spent on a single frame, split into the time that the CPU waited for the GPU and the time that it spent on the frame itself.
+    */
+    struct frame_scheduler_timings
+    {
+        /**
+         * @brief The number of the frame, which counts up from 0 with every FrameScheduler::beginFrame().
+        */
+        uint64_t frameNumber;
+        /**
+         * @brief The time in milliseconds that FrameScheduler::beginFrame() blocked on the Fence of the frame that last used the frame index.
+         *
+         * This is the time that the frame was GPU-bound. If it is consistently more than 0, the CPU is waiting for the GPU and a lower latency won't affect the frame rate.
+        */
+        double waitMilliseconds;
+        /**
+         * @brief The time in milliseconds between the end of FrameScheduler::beginFrame() and FrameScheduler::endFrame(), which is the time that the frame was CPU-bound.
+         *
+         * If waitMilliseconds is consistently 0 while this value is high, the GPU is idling on the CPU and a higher latency won't help either.
+        */
+        double cpuMilliseconds;
+    };
+
+    /**
+     * @brief FrameScheduler runs the frames-in-flight loop that most applications need: it waits on the oldest frame in flight, resets its CommandGroups, runs the work that was deferred until that frame was done, and measures how long the CPU waited for the GPU.
+     *
+     * Every frame starts with FrameScheduler::beginFrame() and ends with FrameScheduler::endFrame(). The frame's CommandLists are acquired through the FrameScheduler's CommandContextPool, and the last Queue::submit() of the frame **must** signal FrameScheduler::getFrameFence().
+     *
+     * Work that **can't** happen until the GPU is done with a frame, such as destroying a Resource or reusing upload memory, **can** be deferred with FrameScheduler::defer().
+     *
+     * @note FrameScheduler::defer() **may** be called simultaneously from multiple threads. The other functions **must not** be called simultaneously with any FrameScheduler function.
+    */
+    class FrameScheduler
+    {
+        friend class Device;
+
+    public:
+        /**
+         * @brief Get the desc that the FrameScheduler was created with.
+        */
+        [[nodiscard]] frame_scheduler_desc getDesc() const;
+
+        /**
+         * @brief Get the index of the current frame, which is in the range [0, frame_scheduler_desc::numFramesInFlight].
+         *
+         * The FrameScheduler keeps numFramesInFlight + 1 frame indices so that numFramesInFlight frames **can** be processed by the GPU while the current frame is recorded.
+        */
+        [[nodiscard]] uint32_t getFrameIndex() const;
+
+        /**
+         * @brief Get the number of the current frame, which counts up from 0 with every FrameScheduler::beginFrame().
+        */
+        [[nodiscard]] uint64_t getFrameNumber() const;
+
+        /**
+         * @brief Get the CommandContextPool that the frame's CommandGroups and CommandLists are acquired from.
+         *
+         * @note CommandContextPool::beginFrame() **must not** be called on this pool, FrameScheduler::beginFrame() moves it to the next frame.
+        */
+        [[nodiscard]] CommandContextPool* getCommandContextPool() const;
+
+        /**
+         * @brief Get the Fence that tracks the current frame. The last Queue::submit() of the frame **must** signal this Fence.
+         *
+         * @return The current frame's Fence, or nullptr if FrameScheduler::beginFrame() hasn't been called yet.
+        */
+        [[nodiscard]] Fence* getFrameFence() const;
+
+        /**
+         * @brief Start the next frame.
+         *
+         * If the Fence of the frame that last used the next frame index was signaled by a Queue::submit(), this function waits for it, after which its CommandGroups are reset and the callbacks that were deferred in that frame are called.
+         *
+         * @param timeout The time in milliseconds that the function **may** wait for the frame's Fence. Refer to Device::waitFences() for more information.
+         *
+         * @note Valid usage (ErrorInvalidState): FrameScheduler::endFrame() **must** have been called after the previous call to FrameScheduler::beginFrame().
+         * @note All conditions in CommandContextPool::beginFrame() **must** be met.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Timeout if the frame's Fence didn't signal within the timeout. The current frame isn't changed and no callbacks are called.
+         * @return CommandContextPool::beginFrame() defined result values.
+        */
+        result beginFrame(uint64_t timeout);
+
+        /**
+         * @brief End the current frame, which completes its timings.
+         *
+         * @note Valid usage (ErrorInvalidState): FrameScheduler::beginFrame() **must** have been called, and FrameScheduler::endFrame() **must not** have been called since.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result endFrame();
+
+        /**
+         * @brief Defer a callback until the GPU has finished executing the current frame.
+         *
+         * The callback is called on the thread that calls FrameScheduler::beginFrame() once the frame's Fence has been waited on, or by Device::destroyFrameScheduler().
+         * Callbacks of the same frame are called in the order that they were deferred in.
+         *
+         * @param callback The function to call, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): callback **must** be a valid callable function.
+         * @note Valid usage (ErrorInvalidState): FrameScheduler::beginFrame() **must** have been called at least once.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result defer(const std::function<void()>& callback);
+
+        /**
+         * @brief Get the timings of the last frame that was ended with FrameScheduler::endFrame().
+         *
+         * @return The timings of the last ended frame, or all zeroes if no frame has been ended yet.
+        */
+        [[nodiscard]] const frame_scheduler_timings& getTimings() const;
+
+    private:
+        // Force private constructor/deconstructor so that only create/destroy can manage lifetime
+        FrameScheduler() = default;
+        ~FrameScheduler() = default;
+
+        // calls the deferred callbacks of a frame in flight and removes them
+        void flushCallbacks(uint32_t frameIndex);
+
+        Device* m_device = nullptr;
+        frame_scheduler_desc m_desc;
+        CommandContextPool* m_pool = nullptr;
+        // the frame being recorded needs an index on top of the frames that are in flight
+        uint32_t m_numFrameIndices = 0;
+
+        // deferred callbacks are stored per frame index
+        std::vector<std::vector<std::function<void()>>> m_callbacks;
+        std::mutex m_callbackMutex;
+
+        uint64_t m_frameNumber = 0;
+        bool m_frameStarted = false;
+        bool m_frameEnded = true;
+
+        std::chrono::steady_clock::time_point m_frameStart;
+        frame_scheduler_timings m_current {};
+        frame_scheduler_timings m_timings {};
+    };
+}
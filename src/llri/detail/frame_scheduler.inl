@@ -0,0 +1,108 @@
+/**
+ * @file frame_scheduler.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    inline frame_scheduler_desc FrameScheduler::getDesc() const
+    {
+        return m_desc;
+    }
+
+    inline uint32_t FrameScheduler::getFrameIndex() const
+    {
+        return m_pool->getFrameIndex();
+    }
+
+    inline uint64_t FrameScheduler::getFrameNumber() const
+    {
+        return m_frameNumber;
+    }
+
+    inline CommandContextPool* FrameScheduler::getCommandContextPool() const
+    {
+        return m_pool;
+    }
+
+    inline Fence* FrameScheduler::getFrameFence() const
+    {
+        return m_pool->getFrameFence();
+    }
+
+    inline result FrameScheduler::beginFrame(uint64_t timeout)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameEnded, result::ErrorInvalidState)
+
+        const uint32_t next = m_frameStarted ? (m_pool->getFrameIndex() + 1) % m_numFrameIndices : 0;
+
+        // the wait is done here rather than in the pool so that only the time spent blocking on the GPU is measured
+        const auto waitStart = std::chrono::steady_clock::now();
+        Fence* fence = m_pool->m_fences[next];
+        if (fence->m_signaled)
+        {
+            const result r = m_device->waitFence(fence, timeout);
+            if (r != result::Success)
+                return r;
+        }
+        const auto waitEnd = std::chrono::steady_clock::now();
+
+        const result r = m_pool->beginFrame(timeout);
+        if (r != result::Success)
+            return r;
+
+        // only now that the pool has moved on can the frame's callbacks be sure that it is retired
+        flushCallbacks(next);
+
+        if (m_frameStarted)
+            m_frameNumber++;
+
+        m_current = { m_frameNumber, std::chrono::duration<double, std::milli>(waitEnd - waitStart).count(), 0.0 };
+        m_frameStart = std::chrono::steady_clock::now();
+        m_frameStarted = true;
+        m_frameEnded = false;
+        return result::Success;
+    }
+
+    inline result FrameScheduler::endFrame()
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted && !m_frameEnded, result::ErrorInvalidState)
+
+        m_current.cpuMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_frameStart).count();
+        m_timings = m_current;
+        m_frameEnded = true;
+        return result::Success;
+    }
+
+    inline result FrameScheduler::defer(const std::function<void()>& callback)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(static_cast<bool>(callback), result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted, result::ErrorInvalidState)
+
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        m_callbacks[m_pool->getFrameIndex()].push_back(callback);
+        return result::Success;
+    }
+
+    inline const frame_scheduler_timings& FrameScheduler::getTimings() const
+    {
+        return m_timings;
+    }
+
+    inline void FrameScheduler::flushCallbacks(uint32_t frameIndex)
+    {
+        // the callbacks are moved out of the lock so that they can defer new work themselves
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(m_callbackMutex);
+            callbacks.swap(m_callbacks[frameIndex]);
+        }
+
+        for (auto& callback : callbacks)
+            callback();
+    }
+}
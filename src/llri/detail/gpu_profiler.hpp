@@ -0,0 +1,195 @@
+/**
+ * @file gpu_profiler.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    class CommandList;
+    class QueryPool;
+
+    /**
+     * @brief Describes how a GpuProfiler should be created.
+    */
+    struct gpu_profiler_desc
+    {
+        /**
+         * @brief The type of Queue that the profiled CommandLists are submitted to. Timestamps are converted to time with the Queue's timestamp period.
+         *
+         * @note Valid usage (ErrorInvalidUsage): queue **must** be less or equal to queue_type::MaxEnum, and Device::queryQueueCount(queue) **must** return more than 0.
+         * @note Valid usage (ErrorFeatureNotSupported): Queue::queryTimestampPeriod() **must** return more than 0.0 for the first Queue of this type.
+        */
+        queue_type queue;
+        /**
+         * @brief The maximum number of scopes that **can** be recorded in a single frame.
+         *
+         * @note Valid usage (ErrorInvalidUsage): maxScopes **must** be more than 0.
+        */
+        uint32_t maxScopes;
+        /**
+         * @brief The number of frames that **may** be processed by the GPU while the next frame is recorded. The results of a frame are read back numFramesInFlight frames later, so that reading them never stalls the CPU.
+         *
+         * @note Valid usage (ErrorInvalidUsage): numFramesInFlight **must** be more than 0.
+        */
+        uint32_t numFramesInFlight;
+        /**
+         * @brief The pipeline statistics that are collected for each scope, in addition to its GPU time. If this value is pipeline_statistic_flag_bits::None, no statistics are collected.
+         *
+         * Scopes that collect statistics **must** start and end in the same CommandList and the same rendering scope, and **must not** overlap with other scopes in the same CommandList.
+         *
+         * @note Valid usage (ErrorInvalidUsage): pipelineStatistics **must** be a valid combination of pipeline_statistic_flag_bits.
+         * @note Valid usage (ErrorInvalidUsage): If pipelineStatistics isn't pipeline_statistic_flag_bits::None, queue **must** be queue_type::Graphics.
+         * @note Valid usage (ErrorFeatureNotSupported): If pipelineStatistics isn't pipeline_statistic_flag_bits::None, adapter_features::pipelineStatisticsQuery **must** have been enabled in device_desc::features.
+        */
+        pipeline_statistic_flags pipelineStatistics;
+    };
+
+    /**
+     * @brief The measured GPU time of a single scope.
+    */
+    struct gpu_profiler_scope_result
+    {
+        /**
+         * @brief The name that the scope was started with.
+        */
+        std::string name;
+        /**
+         * @brief The GPU time between the start and the end of the scope, in milliseconds.
+        */
+        double milliseconds;
+        /**
+         * @brief The pipeline statistics of the commands in the scope. Only the counters that were selected in gpu_profiler_desc::pipelineStatistics are set, the others are 0.
+        */
+        pipeline_statistics statistics;
+    };
+
+    /**
+     * @brief GpuProfiler measures the GPU time of named scopes in CommandLists with timestamp queries, and optionally their pipeline statistics.
+     *
+     * Every frame, GpuProfiler::beginFrame() reads back the results of the frame that used the same frame index numFramesInFlight frames ago and resets its queries, after which scopes **can** be recorded through GpuProfiler::beginScope() and GpuProfiler::endScope(), or through a GpuProfileScope.
+     *
+     * GpuProfiler::beginScope() and GpuProfiler::endScope() **may** be called simultaneously from multiple threads, as long as each CommandList is only used by one thread. Other functions **must not** be called simultaneously with any GpuProfiler function.
+    */
+    class GpuProfiler
+    {
+        friend class Device;
+
+    public:
+        /**
+         * @brief Get the desc that the GpuProfiler was created with.
+        */
+        [[nodiscard]] gpu_profiler_desc getDesc() const;
+
+        /**
+         * @brief Get the index of the current frame in flight, which is in the range [0, gpu_profiler_desc::numFramesInFlight - 1].
+        */
+        [[nodiscard]] uint32_t getFrameIndex() const;
+
+        /**
+         * @brief Move to the next frame in flight. This reads back the scopes of the frame that last used the frame index, and records the reset of the frame's queries into list.
+         *
+         * The GPU **should** have finished executing the CommandLists of the frame that last used the frame index, which is usually guaranteed by waiting on that frame's Fence (e.g. through CommandContextPool::beginFrame() with the same numFramesInFlight). If the results aren't available yet, NotReady is returned and nothing is recorded into list, the profiler stays on the current frame so that beginFrame() can be called again once that frame's Fence is signaled. Vulkan detects this without stalling, DirectX12 can't detect it and returns the last resolved values.
+         *
+         * @param list The CommandList to record the reset into. The list **must** execute before the CommandLists that contain the frame's scopes, and it **may** contain scopes itself.
+         *
+         * @note Valid usage (ErrorInvalidUsage): list **must** be a valid non-null pointer to a CommandList.
+         * @note Valid usage: Every scope of the frame that last used the frame index **must** have been ended, and the CommandLists that contain them **must** have been submitted.
+         * @note All conditions in CommandList::resetQueries() **must** be met.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return NotReady if the results of the frame that last used the frame index aren't available yet.
+         * @return CommandList::resetQueries() and QueryPool::getResults() defined result values.
+        */
+        result beginFrame(CommandList* list);
+
+        /**
+         * @brief Start a named scope, which measures the GPU time of the commands that are recorded into list until GpuProfiler::endScope() is called.
+         *
+         * @param list The CommandList to record the scope's start timestamp into.
+         * @param name The name of the scope, which is copied.
+         * @param scope A pointer to the resulting scope index, which **must** be passed to GpuProfiler::endScope().
+         *
+         * @note Valid usage (ErrorInvalidState): GpuProfiler::beginFrame() **must** have been called.
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string, and scope **must** be a valid non-null pointer to a uint32_t variable.
+         * @note All conditions in CommandList::writeTimestamp() **must** be met, as well as the conditions in CommandList::beginQuery() if gpu_profiler_desc::pipelineStatistics isn't pipeline_statistic_flag_bits::None.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return ErrorExceededLimit if gpu_profiler_desc::maxScopes scopes were already started this frame.
+         * @return CommandList::writeTimestamp() and CommandList::beginQuery() defined result values.
+        */
+        result beginScope(CommandList* list, const char* name, uint32_t* scope);
+
+        /**
+         * @brief End a scope that was started with GpuProfiler::beginScope() in the current frame.
+         *
+         * @param list The CommandList to record the scope's end timestamp into. This **may** be a different CommandList than the one that the scope started in, as long as it executes after it, unless the GpuProfiler collects pipeline statistics.
+         * @param scope The scope index that was returned by GpuProfiler::beginScope().
+         *
+         * @note Valid usage (ErrorInvalidUsage): scope **must** be a scope index that was returned by GpuProfiler::beginScope() in the current frame.
+         * @note All conditions in CommandList::writeTimestamp() **must** be met, as well as the conditions in CommandList::endQuery() if gpu_profiler_desc::pipelineStatistics isn't pipeline_statistic_flag_bits::None.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return CommandList::writeTimestamp() and CommandList::endQuery() defined result values.
+        */
+        result endScope(CommandList* list, uint32_t scope);
+
+        /**
+         * @brief Get the scopes that were read back by the last call to GpuProfiler::beginFrame(), in the order that they were started.
+         *
+         * The results belong to the frame numFramesInFlight frames before the current frame, and are empty if that frame had no scopes or if its results weren't available.
+        */
+        [[nodiscard]] const std::vector<gpu_profiler_scope_result>& getResults() const;
+
+    private:
+        // Force private constructor/deconstructor so that only create/destroy can manage lifetime
+        GpuProfiler() = default;
+        ~GpuProfiler() = default;
+
+        Device* m_device = nullptr;
+        gpu_profiler_desc m_desc;
+        double m_timestampPeriod = 0.0;
+
+        // every frame in flight uses 2 * maxScopes queries, the start and end timestamp of each scope
+        QueryPool* m_queryPool = nullptr;
+        // every frame in flight uses maxScopes pipeline statistics queries, or none if gpu_profiler_desc::pipelineStatistics is None
+        QueryPool* m_statisticsPool = nullptr;
+
+        uint32_t m_frameIndex = 0;
+        bool m_frameStarted = false;
+
+        // the scopes of each frame in flight, indexed by frame * maxScopes + scope
+        std::vector<std::string> m_names;
+        std::unique_ptr<std::atomic<uint32_t>[]> m_numScopes;
+
+        std::vector<uint64_t> m_timestamps; // reused storage for reading back the queries
+        std::vector<pipeline_statistics> m_statistics;
+        std::vector<gpu_profiler_scope_result> m_results;
+
+        result readResults(uint32_t frame);
+    };
+
+    /**
+     * @brief GpuProfileScope starts a GpuProfiler scope when it's constructed and ends it when it's destroyed.
+     *
+     * A scope that failed to start, for example because gpu_profiler_desc::maxScopes was exceeded, isn't recorded.
+    */
+    class GpuProfileScope
+    {
+    public:
+        GpuProfileScope(GpuProfiler* profiler, CommandList* list, const char* name);
+        ~GpuProfileScope();
+
+        GpuProfileScope(const GpuProfileScope&) = delete;
+        GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+    private:
+        GpuProfiler* m_profiler;
+        CommandList* m_list;
+        uint32_t m_scope = 0;
+        bool m_started = false;
+    };
+}
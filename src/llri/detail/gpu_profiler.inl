@@ -0,0 +1,146 @@
+/**
+ * @file gpu_profiler.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    inline gpu_profiler_desc GpuProfiler::getDesc() const
+    {
+        return m_desc;
+    }
+
+    inline uint32_t GpuProfiler::getFrameIndex() const
+    {
+        return m_frameIndex;
+    }
+
+    inline result GpuProfiler::beginFrame(CommandList* list)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(list != nullptr, result::ErrorInvalidUsage)
+
+        const uint32_t next = m_frameStarted ? (m_frameIndex + 1) % m_desc.numFramesInFlight : 0;
+
+        // if the frame's results aren't available yet, the frame doesn't advance and its queries aren't reset, so that beginFrame() can be called again once the GPU has caught up
+        m_results.clear();
+        const result r = readResults(next);
+        if (r != result::Success)
+            return r;
+
+        // the frame's queries are reset on the GPU, so that they can be written again once the list executes
+        const result reset = list->resetQueries(m_queryPool, next * m_desc.maxScopes * 2, m_desc.maxScopes * 2);
+        if (reset != result::Success)
+            return reset;
+
+        if (m_statisticsPool)
+        {
+            const result resetStatistics = list->resetQueries(m_statisticsPool, next * m_desc.maxScopes, m_desc.maxScopes);
+            if (resetStatistics != result::Success)
+                return resetStatistics;
+        }
+
+        m_numScopes[next] = 0;
+        m_frameIndex = next;
+        m_frameStarted = true;
+        return result::Success;
+    }
+
+    inline result GpuProfiler::beginScope(CommandList* list, const char* name, uint32_t* scope)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(scope != nullptr, result::ErrorInvalidUsage)
+
+        // scopes are allocated atomically so that they can be started from multiple recording threads
+        const uint32_t index = m_numScopes[m_frameIndex].fetch_add(1);
+        if (index >= m_desc.maxScopes)
+        {
+            m_numScopes[m_frameIndex] = m_desc.maxScopes;
+            return result::ErrorExceededLimit;
+        }
+
+        const result r = list->writeTimestamp(m_queryPool, (m_frameIndex * m_desc.maxScopes + index) * 2);
+        if (r != result::Success)
+            return r;
+
+        if (m_statisticsPool)
+        {
+            const result statistics = list->beginQuery(m_statisticsPool, m_frameIndex * m_desc.maxScopes + index);
+            if (statistics != result::Success)
+                return statistics;
+        }
+
+        m_names[m_frameIndex * m_desc.maxScopes + index] = name;
+        *scope = index;
+        return result::Success;
+    }
+
+    inline result GpuProfiler::endScope(CommandList* list, uint32_t scope)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_frameStarted, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(scope < std::min(m_numScopes[m_frameIndex].load(), m_desc.maxScopes), result::ErrorInvalidUsage)
+
+        // the statistics query ends first so that it doesn't count the end timestamp
+        if (m_statisticsPool)
+        {
+            const result statistics = list->endQuery(m_statisticsPool, m_frameIndex * m_desc.maxScopes + scope);
+            if (statistics != result::Success)
+                return statistics;
+        }
+
+        return list->writeTimestamp(m_queryPool, (m_frameIndex * m_desc.maxScopes + scope) * 2 + 1);
+    }
+
+    inline const std::vector<gpu_profiler_scope_result>& GpuProfiler::getResults() const
+    {
+        return m_results;
+    }
+
+    inline result GpuProfiler::readResults(uint32_t frame)
+    {
+        const uint32_t numScopes = std::min(m_numScopes[frame].load(), m_desc.maxScopes);
+        if (numScopes == 0)
+            return result::Success;
+
+        // the frame was submitted numFramesInFlight frames ago, so its results are usually available without waiting
+        const result r = m_queryPool->getResults(frame * m_desc.maxScopes * 2, numScopes * 2, m_timestamps.data());
+        if (r != result::Success)
+            return r;
+
+        if (m_statisticsPool)
+        {
+            const result statistics = m_statisticsPool->getResults(frame * m_desc.maxScopes, numScopes, m_statistics.data());
+            if (statistics != result::Success)
+                return statistics;
+        }
+
+        m_results.resize(numScopes);
+        for (uint32_t i = 0; i < numScopes; i++)
+        {
+            const uint64_t begin = m_timestamps[i * 2];
+            const uint64_t end = m_timestamps[i * 2 + 1];
+
+            m_results[i].name = m_names[frame * m_desc.maxScopes + i];
+            m_results[i].milliseconds = end > begin ? static_cast<double>(end - begin) * m_timestampPeriod / 1000000.0 : 0.0;
+            m_results[i].statistics = m_statisticsPool ? m_statistics[i] : pipeline_statistics{};
+        }
+
+        return result::Success;
+    }
+
+    inline GpuProfileScope::GpuProfileScope(GpuProfiler* profiler, CommandList* list, const char* name) :
+        m_profiler(profiler), m_list(list)
+    {
+        m_started = profiler->beginScope(list, name, &m_scope) == result::Success;
+    }
+
+    inline GpuProfileScope::~GpuProfileScope()
+    {
+        if (m_started)
+            m_profiler->endScope(m_list, m_scope);
+    }
+}
@@ -240,6 +240,9 @@ namespace llri
 
         std::unordered_map<void*, Adapter*> m_cachedAdapters;
 
+        // instance_extension::DebugLabels was enabled, passed on to every Device
+        bool m_debugLabels = false;
+
 #ifdef LLRI_DETAIL_ENABLE_VALIDATION
         std::unordered_set<instance_extension> m_enabledExtensions;
 #endif
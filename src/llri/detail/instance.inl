@@ -25,6 +25,8 @@ namespace llri
                 return "SurfaceXlib";
             case instance_extension::SurfaceXcb:
                 return "SurfaceXcb";
+            case instance_extension::DebugLabels:
+                return "DebugLabels";
         }
 
         return "Invalid instance_extension value";
@@ -129,6 +131,14 @@ namespace llri
 
         LLRI_DETAIL_VALIDATION_REQUIRE(desc.adapter->m_ptr != nullptr, result::ErrorDeviceLost)
 
+        // the supported features are only queried if any feature is enabled, since the query goes through the driver
+        if (desc.features.pipelineStatisticsQuery || desc.features.timelineSemaphores)
+        {
+            const adapter_features supportedFeatures = desc.adapter->queryFeatures();
+            LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.features.pipelineStatisticsQuery, supportedFeatures.pipelineStatisticsQuery, result::ErrorFeatureNotSupported)
+            LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.features.timelineSemaphores, supportedFeatures.timelineSemaphores, result::ErrorFeatureNotSupported)
+        }
+
         LLRI_DETAIL_VALIDATION_REQUIRE(desc.numQueues != 0, result::ErrorInvalidUsage);
         LLRI_DETAIL_VALIDATION_REQUIRE(desc.queues != nullptr, result::ErrorInvalidUsage);
 
@@ -157,10 +167,28 @@ namespace llri
                     to_string(queue.type) + " queue, even though the maximum number of queues of this type is " + std::to_string(maxQueueCounts[queue.type]) + ".", result::ErrorInvalidUsage)
 
             LLRI_DETAIL_VALIDATION_REQUIRE_ITER(queue.priority <= queue_priority::MaxEnum, i, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(queue.submitMode <= queue_submit_mode::MaxEnum, i, result::ErrorInvalidUsage)
         }
 #endif
 
-        LLRI_DETAIL_CALL_IMPL(impl_createDevice(desc, device), (*device)->m_validationCallbackMessenger)
+        const result r = impl_createDevice(desc, device);
+        if (r != result::Success)
+            return r;
+
+        LLRI_DETAIL_POLL_API_MESSAGES((*device)->m_validationCallbackMessenger)
+
+        (*device)->m_limits = desc.adapter->queryLimits();
+
+        for (auto* queues : { &(*device)->m_graphicsQueues, &(*device)->m_computeQueues, &(*device)->m_transferQueues })
+        {
+            for (auto* queue : *queues)
+            {
+                if (queue->m_desc.submitMode == queue_submit_mode::Background)
+                    queue->startSubmissionThread();
+            }
+        }
+
+        return result::Success;
     }
 
     inline void Instance::destroyDevice(Device* device)
@@ -168,6 +196,19 @@ namespace llri
         if (!device)
             return;
 
+        device->endCapture();
+
+        // the Queues' fix-up pools are created through the Device, so they're destroyed before the Queues themselves
+        // submission threads are stopped first, since they may still reference the fix-up CommandLists
+        for (auto* queues : { &device->m_graphicsQueues, &device->m_computeQueues, &device->m_transferQueues })
+        {
+            for (auto* queue : *queues)
+            {
+                queue->stopSubmissionThread();
+                device->destroyCommandContextPool(queue->m_fixupPool);
+            }
+        }
+
         impl_destroyDevice(device);
 
         LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
@@ -40,10 +40,15 @@ namespace llri
          * @brief Create a SurfaceEXT object from an XCB connection & XCB window
          */
         SurfaceXcb,
+        /**
+         * @brief Attach names to objects through their setName() function, and labels to regions of CommandLists through CommandList::beginLabel(), CommandList::endLabel() and CommandList::insertLabel().
+         * Names and labels are shown in debugging and profiling tools such as RenderDoc, PIX and Nsight. If this extension isn't enabled, these functions do nothing.
+        */
+        DebugLabels,
         /**
          * @brief The highest value in this enum.
         */
-        MaxEnum = SurfaceXcb
+        MaxEnum = DebugLabels
     };
 
     /**
@@ -82,6 +82,7 @@ namespace llri
     }
 }
 
+#include <llri/detail/worker_pool.inl>
 #include <llri/detail/callback.inl>
 
 #include <llri/detail/instance.inl>
@@ -92,9 +93,21 @@ namespace llri
 
 #include <llri/detail/resource.inl>
 
+#include <llri/detail/pipeline.inl>
+#include <llri/detail/pipeline_cache.inl>
+#include <llri/detail/rendering.inl>
+
 #include <llri/detail/command_group.inl>
 #include <llri/detail/command_list.inl>
+#include <llri/detail/command_stream.inl>
+#include <llri/detail/capture.inl>
+#include <llri/detail/command_context_pool.inl>
+#include <llri/detail/frame_graph.inl>
+#include <llri/detail/frame_scheduler.inl>
+#include <llri/detail/query_pool.inl>
+#include <llri/detail/gpu_profiler.inl>
 
 #include <llri/detail/fence.inl>
+#include <llri/detail/semaphore.inl>
 
 #include <llri/detail/swapchain_ext.inl>
@@ -42,4 +42,21 @@ namespace llri
     {
         return "{ " + std::to_string(offset.x) + ", " + std::to_string(offset.y) + " }";
     }
+
+    /**
+     * @brief A two-dimensional rectangle described by an offset and an extent.
+    */
+    struct rect_2d
+    {
+        offset_2d offset;
+        extent_2d extent;
+    };
+
+    /**
+     * @brief Converts a rect_2d to a string using the format: "{ { x, y }, { width, height } }"
+    */
+    inline std::string to_string(rect_2d rect)
+    {
+        return "{ " + to_string(rect.offset) + ", " + to_string(rect.extent) + " }";
+    }
 }
@@ -0,0 +1,737 @@
+/**
+ * @file pipeline.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    class PipelineCache;
+
+    /**
+     * @brief Describes the programmable shader stages of a pipeline.
+    */
+    enum struct shader_stage_flag_bits : uint32_t
+    {
+        /**
+         * @brief No shader stage.
+        */
+        None = 0,
+        /**
+         * @brief The vertex shader stage.
+        */
+        Vertex = 1 << 0,
+        /**
+         * @brief The fragment (pixel) shader stage.
+        */
+        Fragment = 1 << 1,
+        /**
+         * @brief The compute shader stage.
+        */
+        Compute = 1 << 2,
+        /**
+         * @brief All graphics shader stages combined.
+        */
+        AllGraphics = Vertex | Fragment,
+        /**
+         * @brief All shader stages combined.
+        */
+        All = Vertex | Fragment | Compute
+    };
+    LLRI_DEFINE_FLAG_BIT_OPERATORS(shader_stage_flag_bits)
+
+    /**
+     * @brief Converts a shader_stage_flag_bits to a string.
+     * @return The enum value as a string, or "Invalid shader_stage_flag_bits value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(shader_stage_flag_bits bits);
+
+    /**
+     * @brief Describes a combination of shader stages.
+    */
+    using shader_stage_flags = flags<shader_stage_flag_bits>;
+
+    /**
+     * @brief Converts shader_stage_flags to a string.
+     * @return The flags as a string, or "Invalid shader_stage_flags value" if the value was not recognized as a valid combination of shader_stage_flag_bits.
+    */
+    inline std::string to_string(shader_stage_flags flags);
+
+    /**
+     * @brief Describes how vertices are assembled into primitives.
+    */
+    enum struct primitive_topology : uint8_t
+    {
+        /**
+         * @brief Each vertex is drawn as a separate point.
+        */
+        PointList,
+        /**
+         * @brief Each pair of vertices is drawn as a separate line.
+        */
+        LineList,
+        /**
+         * @brief Each vertex after the first forms a line with the vertex before it.
+        */
+        LineStrip,
+        /**
+         * @brief Each set of three vertices is drawn as a separate triangle.
+        */
+        TriangleList,
+        /**
+         * @brief Each vertex after the first two forms a triangle with the two vertices before it.
+        */
+        TriangleStrip,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = TriangleStrip
+    };
+
+    /**
+     * @brief Converts a primitive_topology to a string.
+     * @return The enum value as a string, or "Invalid primitive_topology value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(primitive_topology topology);
+
+    /**
+     * @brief Describes the rate at which vertex attributes are pulled from a vertex buffer.
+    */
+    enum struct vertex_input_rate : uint8_t
+    {
+        /**
+         * @brief The attributes advance once per vertex.
+        */
+        Vertex,
+        /**
+         * @brief The attributes advance once per instance.
+        */
+        Instance,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Instance
+    };
+
+    /**
+     * @brief Converts a vertex_input_rate to a string.
+     * @return The enum value as a string, or "Invalid vertex_input_rate value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(vertex_input_rate rate);
+
+    /**
+     * @brief Describes which triangles are discarded based on their facing.
+    */
+    enum struct cull_mode : uint8_t
+    {
+        /**
+         * @brief No triangles are discarded.
+        */
+        None,
+        /**
+         * @brief Front-facing triangles are discarded.
+        */
+        Front,
+        /**
+         * @brief Back-facing triangles are discarded.
+        */
+        Back,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Back
+    };
+
+    /**
+     * @brief Converts a cull_mode to a string.
+     * @return The enum value as a string, or "Invalid cull_mode value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(cull_mode mode);
+
+    /**
+     * @brief Describes the vertex winding order that is considered front-facing.
+    */
+    enum struct front_face : uint8_t
+    {
+        /**
+         * @brief Triangles with a counter-clockwise winding order are front-facing.
+        */
+        CounterClockwise,
+        /**
+         * @brief Triangles with a clockwise winding order are front-facing.
+        */
+        Clockwise,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Clockwise
+    };
+
+    /**
+     * @brief Converts a front_face to a string.
+     * @return The enum value as a string, or "Invalid front_face value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(front_face face);
+
+    /**
+     * @brief Describes how a new value is compared against an existing value in depth and stencil tests.
+    */
+    enum struct compare_op : uint8_t
+    {
+        /**
+         * @brief The test never passes.
+        */
+        Never,
+        /**
+         * @brief The test passes if the new value is less than the existing value.
+        */
+        Less,
+        /**
+         * @brief The test passes if the new value is equal to the existing value.
+        */
+        Equal,
+        /**
+         * @brief The test passes if the new value is less than or equal to the existing value.
+        */
+        LessOrEqual,
+        /**
+         * @brief The test passes if the new value is more than the existing value.
+        */
+        Greater,
+        /**
+         * @brief The test passes if the new value is not equal to the existing value.
+        */
+        NotEqual,
+        /**
+         * @brief The test passes if the new value is more than or equal to the existing value.
+        */
+        GreaterOrEqual,
+        /**
+         * @brief The test always passes.
+        */
+        Always,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Always
+    };
+
+    /**
+     * @brief Converts a compare_op to a string.
+     * @return The enum value as a string, or "Invalid compare_op value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(compare_op op);
+
+    /**
+     * @brief Describes what happens to the stored stencil value when a stencil test passes or fails.
+    */
+    enum struct stencil_op : uint8_t
+    {
+        /**
+         * @brief The stencil value is kept.
+        */
+        Keep,
+        /**
+         * @brief The stencil value is set to 0.
+        */
+        Zero,
+        /**
+         * @brief The stencil value is set to the stencil reference (see CommandList::setStencilReference()).
+        */
+        Replace,
+        /**
+         * @brief The stencil value is incremented and clamped to the maximum value.
+        */
+        IncrementAndClamp,
+        /**
+         * @brief The stencil value is decremented and clamped to 0.
+        */
+        DecrementAndClamp,
+        /**
+         * @brief The bits of the stencil value are inverted.
+        */
+        Invert,
+        /**
+         * @brief The stencil value is incremented and wraps to 0 if it exceeds the maximum value.
+        */
+        IncrementAndWrap,
+        /**
+         * @brief The stencil value is decremented and wraps to the maximum value if it goes below 0.
+        */
+        DecrementAndWrap,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = DecrementAndWrap
+    };
+
+    /**
+     * @brief Converts a stencil_op to a string.
+     * @return The enum value as a string, or "Invalid stencil_op value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(stencil_op op);
+
+    /**
+     * @brief Describes the factor that a source or destination color or alpha value is multiplied with during blending.
+    */
+    enum struct blend_factor : uint8_t
+    {
+        /**
+         * @brief The value is multiplied with 0.
+        */
+        Zero,
+        /**
+         * @brief The value is multiplied with 1.
+        */
+        One,
+        /**
+         * @brief The value is multiplied with the source color, or the source alpha when it's used as an alpha factor.
+        */
+        SrcColor,
+        /**
+         * @brief The value is multiplied with 1 - the source color, or 1 - the source alpha when it's used as an alpha factor.
+        */
+        OneMinusSrcColor,
+        /**
+         * @brief The value is multiplied with the destination color, or the destination alpha when it's used as an alpha factor.
+        */
+        DstColor,
+        /**
+         * @brief The value is multiplied with 1 - the destination color, or 1 - the destination alpha when it's used as an alpha factor.
+        */
+        OneMinusDstColor,
+        /**
+         * @brief The value is multiplied with the source alpha.
+        */
+        SrcAlpha,
+        /**
+         * @brief The value is multiplied with 1 - the source alpha.
+        */
+        OneMinusSrcAlpha,
+        /**
+         * @brief The value is multiplied with the destination alpha.
+        */
+        DstAlpha,
+        /**
+         * @brief The value is multiplied with 1 - the destination alpha.
+        */
+        OneMinusDstAlpha,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = OneMinusDstAlpha
+    };
+
+    /**
+     * @brief Converts a blend_factor to a string.
+     * @return The enum value as a string, or "Invalid blend_factor value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(blend_factor factor);
+
+    /**
+     * @brief Describes how the weighted source and destination values are combined during blending.
+    */
+    enum struct blend_op : uint8_t
+    {
+        /**
+         * @brief src + dst
+        */
+        Add,
+        /**
+         * @brief src - dst
+        */
+        Subtract,
+        /**
+         * @brief dst - src
+        */
+        ReverseSubtract,
+        /**
+         * @brief min(src, dst), the blend factors are ignored.
+        */
+        Min,
+        /**
+         * @brief max(src, dst), the blend factors are ignored.
+        */
+        Max,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Max
+    };
+
+    /**
+     * @brief Converts a blend_op to a string.
+     * @return The enum value as a string, or "Invalid blend_op value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(blend_op op);
+
+    /**
+     * @brief Describes which color components are written to a color attachment.
+    */
+    enum struct color_component_flag_bits : uint8_t
+    {
+        None = 0,
+        R = 1 << 0,
+        G = 1 << 1,
+        B = 1 << 2,
+        A = 1 << 3,
+        All = R | G | B | A
+    };
+    LLRI_DEFINE_FLAG_BIT_OPERATORS(color_component_flag_bits)
+
+    /**
+     * @brief Converts a color_component_flag_bits to a string.
+     * @return The enum value as a string, or "Invalid color_component_flag_bits value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(color_component_flag_bits bits);
+
+    /**
+     * @brief Describes a combination of color components.
+    */
+    using color_component_flags = flags<color_component_flag_bits>;
+
+    /**
+     * @brief Converts color_component_flags to a string.
+     * @return The flags as a string, or "Invalid color_component_flags value" if the value was not recognized as a valid combination of color_component_flag_bits.
+    */
+    inline std::string to_string(color_component_flags flags);
+
+    /**
+     * @brief Describes the compiled bytecode of a shader stage.
+    */
+    struct shader_bytecode
+    {
+        /**
+         * @brief The size of the bytecode in bytes. A size of 0 means that the stage is not present in the pipeline.
+        */
+        size_t size;
+        /**
+         * @brief The compiled shader bytecode, in the format of the implementation:
+         *
+         * DirectX12: DXIL or DXBC
+         * Vulkan: SPIR-V
+         *
+         * @note Valid usage (ErrorInvalidUsage): If size is more than 0, bytecode **must** be a valid non-null pointer to an array of at least size bytes.
+        */
+        const void* bytecode;
+        /**
+         * @brief The name of the shader's entry point. If entryPoint is nullptr, "main" is used.
+         * @note DirectX12 bytecode contains its entry point, so this value is ignored by the DirectX12 implementation.
+        */
+        const char* entryPoint;
+    };
+
+    /**
+     * @brief Describes a vertex buffer binding slot.
+    */
+    struct vertex_binding_desc
+    {
+        /**
+         * @brief The index of the binding slot, as used in CommandList::bindVertexBuffers().
+         * @note Valid usage (ErrorExceededLimit): binding **must** be less than adapter_limits::maxVertexInputBindings.
+        */
+        uint32_t binding;
+        /**
+         * @brief The distance in bytes between two consecutive elements in the buffer.
+        */
+        uint32_t stride;
+        /**
+         * @brief Describes if the elements advance per vertex or per instance.
+         * @note Valid usage (ErrorInvalidUsage): inputRate **must** be less or equal to vertex_input_rate::MaxEnum.
+        */
+        vertex_input_rate inputRate;
+    };
+
+    /**
+     * @brief Describes a vertex attribute that is read from a vertex buffer binding slot.
+    */
+    struct vertex_attribute_desc
+    {
+        /**
+         * @brief The shader input location of the attribute.
+         *
+         * DirectX12 shaders **must** declare the attribute with the semantic TEXCOORD[location].
+         * @note Valid usage (ErrorExceededLimit): location **must** be less than adapter_limits::maxVertexInputAttributes.
+        */
+        uint32_t location;
+        /**
+         * @brief The binding slot that the attribute is read from.
+         * @note Valid usage (ErrorInvalidUsage): binding **must** match the vertex_binding_desc::binding of one of the bindings in graphics_pipeline_desc::vertexBindings.
+        */
+        uint32_t binding;
+        /**
+         * @brief The format of the attribute.
+         * @note Valid usage (ErrorInvalidFormat): format **must** be a color format.
+        */
+        llri::format format;
+        /**
+         * @brief The offset in bytes of the attribute within an element of the binding.
+        */
+        uint32_t offset;
+    };
+
+    /**
+     * @brief Describes how primitives are rasterized.
+    */
+    struct rasterizer_desc
+    {
+        /**
+         * @brief Describes which triangles are discarded.
+         * @note Valid usage (ErrorInvalidUsage): cullMode **must** be less or equal to cull_mode::MaxEnum.
+        */
+        cull_mode cullMode;
+        /**
+         * @brief Describes which winding order is front-facing.
+         * @note Valid usage (ErrorInvalidUsage): frontFace **must** be less or equal to front_face::MaxEnum.
+        */
+        front_face frontFace;
+        /**
+         * @brief A constant depth value added to each fragment.
+        */
+        int32_t depthBias;
+        /**
+         * @brief A factor that is multiplied with the fragment's slope and added to each fragment's depth.
+        */
+        float depthBiasSlopeScale;
+    };
+
+    /**
+     * @brief Describes the stencil operations for triangles of one facing.
+    */
+    struct stencil_op_desc
+    {
+        /**
+         * @brief The operation applied when the stencil test fails.
+        */
+        stencil_op failOp;
+        /**
+         * @brief The operation applied when both the stencil and depth tests pass.
+        */
+        stencil_op passOp;
+        /**
+         * @brief The operation applied when the stencil test passes but the depth test fails.
+        */
+        stencil_op depthFailOp;
+        /**
+         * @brief The comparison used in the stencil test.
+        */
+        compare_op compareOp;
+    };
+
+    /**
+     * @brief Describes the depth and stencil tests of a graphics pipeline.
+     * @note Ignored if graphics_pipeline_desc::depthStencilFormat is format::Undefined.
+    */
+    struct depth_stencil_desc
+    {
+        /**
+         * @brief If fragments are tested against the depth attachment.
+        */
+        bool depthTestEnable;
+        /**
+         * @brief If fragments that pass the depth test write their depth to the depth attachment.
+        */
+        bool depthWriteEnable;
+        /**
+         * @brief The comparison used in the depth test.
+         * @note Valid usage (ErrorInvalidUsage): depthCompareOp **must** be less or equal to compare_op::MaxEnum.
+        */
+        compare_op depthCompareOp;
+        /**
+         * @brief If fragments are tested against the stencil attachment.
+         * @note Valid usage (ErrorInvalidFormat): If stencilTestEnable is true, graphics_pipeline_desc::depthStencilFormat **must** have a stencil component.
+        */
+        bool stencilTestEnable;
+        /**
+         * @brief The bits of the stencil value that are read by the stencil test.
+        */
+        uint8_t stencilReadMask;
+        /**
+         * @brief The bits of the stencil value that are written by the stencil operations.
+        */
+        uint8_t stencilWriteMask;
+        /**
+         * @brief The stencil operations for front-facing triangles.
+         * @note Valid usage (ErrorInvalidUsage): all members **must** be less or equal to their MaxEnum value.
+        */
+        stencil_op_desc front;
+        /**
+         * @brief The stencil operations for back-facing triangles.
+         * @note Valid usage (ErrorInvalidUsage): all members **must** be less or equal to their MaxEnum value.
+        */
+        stencil_op_desc back;
+    };
+
+    /**
+     * @brief Describes the format and blend state of a color attachment of a graphics pipeline.
+    */
+    struct pipeline_color_attachment_desc
+    {
+        /**
+         * @brief The format of the color attachment. The texture that is bound to this attachment in CommandList::beginRendering() **must** have the same format.
+         * @note Valid usage (ErrorInvalidFormat): format **must** be a color format.
+        */
+        llri::format format;
+        /**
+         * @brief If blending is enabled for this attachment. If blendEnable is false, fragment values are written unmodified.
+        */
+        bool blendEnable;
+        blend_factor srcColorFactor;
+        blend_factor dstColorFactor;
+        blend_op colorOp;
+        blend_factor srcAlphaFactor;
+        blend_factor dstAlphaFactor;
+        blend_op alphaOp;
+        /**
+         * @brief The color components that are written to the attachment.
+        */
+        color_component_flags writeMask;
+    };
+
+    /**
+     * @brief Describes how a graphics Pipeline should be created.
+    */
+    struct graphics_pipeline_desc
+    {
+        /**
+         * @brief The PipelineCache that is used to skip compilation if a pipeline with the same state was compiled before. cache **may** be nullptr.
+        */
+        PipelineCache* cache;
+        /**
+         * @brief The shader stages that access push constants in this pipeline. CommandList::pushConstants() **must** be called with exactly this stageMask for the values to be visible to this pipeline.
+         * @note Valid usage (ErrorInvalidUsage): pushConstantStages **must** be a valid combination of shader_stage_flag_bits::AllGraphics.
+        */
+        shader_stage_flags pushConstantStages;
+
+        /**
+         * @brief The vertex shader.
+         * @note Valid usage (ErrorInvalidUsage): vertexShader.size **must** be more than 0.
+        */
+        shader_bytecode vertexShader;
+        /**
+         * @brief The fragment shader. A fragment shader **may** be omitted by setting its size to 0, e.g. for depth-only rendering.
+        */
+        shader_bytecode fragmentShader;
+
+        /**
+         * @brief The primitive topology that is used to assemble vertices.
+         * @note Valid usage (ErrorInvalidUsage): topology **must** be less or equal to primitive_topology::MaxEnum.
+        */
+        primitive_topology topology;
+
+        /**
+         * @brief The number of elements in vertexBindings.
+         * @note Valid usage (ErrorExceededLimit): numVertexBindings **must** be less than or equal to adapter_limits::maxVertexInputBindings.
+        */
+        uint32_t numVertexBindings;
+        /**
+         * @brief An array of vertex buffer binding slots.
+         * @note Valid usage (ErrorInvalidUsage): If numVertexBindings is more than 0, vertexBindings **must** be a valid non-null pointer to an array of numVertexBindings elements.
+        */
+        const vertex_binding_desc* vertexBindings;
+        /**
+         * @brief The number of elements in vertexAttributes.
+         * @note Valid usage (ErrorExceededLimit): numVertexAttributes **must** be less than or equal to adapter_limits::maxVertexInputAttributes.
+        */
+        uint32_t numVertexAttributes;
+        /**
+         * @brief An array of vertex attributes.
+         * @note Valid usage (ErrorInvalidUsage): If numVertexAttributes is more than 0, vertexAttributes **must** be a valid non-null pointer to an array of numVertexAttributes elements.
+        */
+        const vertex_attribute_desc* vertexAttributes;
+
+        /**
+         * @brief The rasterizer state.
+        */
+        rasterizer_desc rasterizer;
+        /**
+         * @brief The depth and stencil test state.
+        */
+        depth_stencil_desc depthStencil;
+
+        /**
+         * @brief The number of color attachments that the pipeline renders to.
+         * @note Valid usage (ErrorExceededLimit): numColorAttachments **must** be less than or equal to adapter_limits::maxColorAttachments.
+        */
+        uint32_t numColorAttachments;
+        /**
+         * @brief An array of color attachment formats and blend states.
+         * @note Valid usage (ErrorInvalidUsage): If numColorAttachments is more than 0, colorAttachments **must** be a valid non-null pointer to an array of numColorAttachments elements.
+        */
+        const pipeline_color_attachment_desc* colorAttachments;
+        /**
+         * @brief The format of the depth stencil attachment, or format::Undefined if the pipeline doesn't render to a depth stencil attachment.
+         * @note Valid usage (ErrorInvalidFormat): If depthStencilFormat is not format::Undefined, it **must** have a depth or stencil component.
+        */
+        format depthStencilFormat;
+        /**
+         * @brief The number of samples of the attachments that the pipeline renders to.
+         * @note Valid usage (ErrorInvalidUsage): sampleCount **must** be a valid sample_count value.
+        */
+        sample_count sampleCount;
+    };
+
+    /**
+     * @brief A Pipeline contains the shaders and fixed-function state that are used by draw or dispatch commands.
+     * Pipelines are bound to a CommandList through CommandList::bindPipeline().
+    */
+    class Pipeline
+    {
+        friend class Device;
+        friend class CommandList;
+
+    public:
+        using native_pipeline = void;
+
+        /**
+         * @brief Gets the native Pipeline pointer, which depending on the llri::getImplementation() is a pointer to the following:
+         *
+         * DirectX12: ID3D12PipelineState*
+         * Vulkan: VkPipeline
+         */
+        [[nodiscard]] native_pipeline* getNative() const;
+
+        /**
+         * @brief Set the name of the Pipeline, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
+
+        /**
+         * @brief Returns the primitive topology that the Pipeline was created with.
+        */
+        [[nodiscard]] primitive_topology getTopology() const;
+
+        /**
+         * @brief Returns the push constant shader stages that the Pipeline was created with.
+        */
+        [[nodiscard]] shader_stage_flags getPushConstantStages() const;
+
+    private:
+        // Force private constructor/deconstructor so that only create/destroy can manage lifetime
+        Pipeline() = default;
+        ~Pipeline() = default;
+
+        native_pipeline* m_ptr = nullptr;
+        Device* m_device = nullptr;
+
+        primitive_topology m_topology = primitive_topology::TriangleList;
+        shader_stage_flags m_pushConstantStages;
+
+        // DirectX12 passes vertex strides when binding vertex buffers, indexed by vertex_binding_desc::binding
+        std::vector<uint32_t> m_vertexStrides;
+
+        result impl_setName(const char* name);
+    };
+}
@@ -0,0 +1,300 @@
+/**
+ * @file pipeline.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    inline std::string to_string(shader_stage_flag_bits bits)
+    {
+        switch(bits)
+        {
+            case shader_stage_flag_bits::None:
+                return "None";
+            case shader_stage_flag_bits::Vertex:
+                return "Vertex";
+            case shader_stage_flag_bits::Fragment:
+                return "Fragment";
+            case shader_stage_flag_bits::Compute:
+                return "Compute";
+            case shader_stage_flag_bits::AllGraphics:
+            case shader_stage_flag_bits::All:
+                return to_string(static_cast<shader_stage_flags>(bits));
+        }
+
+        return "Invalid shader_stage_flag_bits value";
+    }
+
+    inline std::string to_string(shader_stage_flags flags)
+    {
+        std::string out;
+
+        constexpr std::array<shader_stage_flag_bits, 3> allBits = {
+            shader_stage_flag_bits::Vertex,
+            shader_stage_flag_bits::Fragment,
+            shader_stage_flag_bits::Compute
+        };
+
+        for (auto elem : allBits)
+        {
+            if (flags.contains(elem))
+            {
+                out += " | " + to_string(elem);
+                flags.remove(elem);
+            }
+        }
+
+        // all flags should've been covered and removed
+        if (flags != shader_stage_flag_bits::None)
+            return "Invalid shader_stage_flags value";
+
+        // remove excessive initial " | "
+        if (!out.empty() && out[0] == ' ' && out[1] == '|' && out[2] == ' ')
+            out = out.substr(3);
+
+        return out;
+    }
+
+    inline std::string to_string(primitive_topology topology)
+    {
+        switch(topology)
+        {
+            case primitive_topology::PointList:
+                return "PointList";
+            case primitive_topology::LineList:
+                return "LineList";
+            case primitive_topology::LineStrip:
+                return "LineStrip";
+            case primitive_topology::TriangleList:
+                return "TriangleList";
+            case primitive_topology::TriangleStrip:
+                return "TriangleStrip";
+        }
+
+        return "Invalid primitive_topology value";
+    }
+
+    inline std::string to_string(vertex_input_rate rate)
+    {
+        switch(rate)
+        {
+            case vertex_input_rate::Vertex:
+                return "Vertex";
+            case vertex_input_rate::Instance:
+                return "Instance";
+        }
+
+        return "Invalid vertex_input_rate value";
+    }
+
+    inline std::string to_string(cull_mode mode)
+    {
+        switch(mode)
+        {
+            case cull_mode::None:
+                return "None";
+            case cull_mode::Front:
+                return "Front";
+            case cull_mode::Back:
+                return "Back";
+        }
+
+        return "Invalid cull_mode value";
+    }
+
+    inline std::string to_string(front_face face)
+    {
+        switch(face)
+        {
+            case front_face::CounterClockwise:
+                return "CounterClockwise";
+            case front_face::Clockwise:
+                return "Clockwise";
+        }
+
+        return "Invalid front_face value";
+    }
+
+    inline std::string to_string(compare_op op)
+    {
+        switch(op)
+        {
+            case compare_op::Never:
+                return "Never";
+            case compare_op::Less:
+                return "Less";
+            case compare_op::Equal:
+                return "Equal";
+            case compare_op::LessOrEqual:
+                return "LessOrEqual";
+            case compare_op::Greater:
+                return "Greater";
+            case compare_op::NotEqual:
+                return "NotEqual";
+            case compare_op::GreaterOrEqual:
+                return "GreaterOrEqual";
+            case compare_op::Always:
+                return "Always";
+        }
+
+        return "Invalid compare_op value";
+    }
+
+    inline std::string to_string(stencil_op op)
+    {
+        switch(op)
+        {
+            case stencil_op::Keep:
+                return "Keep";
+            case stencil_op::Zero:
+                return "Zero";
+            case stencil_op::Replace:
+                return "Replace";
+            case stencil_op::IncrementAndClamp:
+                return "IncrementAndClamp";
+            case stencil_op::DecrementAndClamp:
+                return "DecrementAndClamp";
+            case stencil_op::Invert:
+                return "Invert";
+            case stencil_op::IncrementAndWrap:
+                return "IncrementAndWrap";
+            case stencil_op::DecrementAndWrap:
+                return "DecrementAndWrap";
+        }
+
+        return "Invalid stencil_op value";
+    }
+
+    inline std::string to_string(blend_factor factor)
+    {
+        switch(factor)
+        {
+            case blend_factor::Zero:
+                return "Zero";
+            case blend_factor::One:
+                return "One";
+            case blend_factor::SrcColor:
+                return "SrcColor";
+            case blend_factor::OneMinusSrcColor:
+                return "OneMinusSrcColor";
+            case blend_factor::DstColor:
+                return "DstColor";
+            case blend_factor::OneMinusDstColor:
+                return "OneMinusDstColor";
+            case blend_factor::SrcAlpha:
+                return "SrcAlpha";
+            case blend_factor::OneMinusSrcAlpha:
+                return "OneMinusSrcAlpha";
+            case blend_factor::DstAlpha:
+                return "DstAlpha";
+            case blend_factor::OneMinusDstAlpha:
+                return "OneMinusDstAlpha";
+        }
+
+        return "Invalid blend_factor value";
+    }
+
+    inline std::string to_string(blend_op op)
+    {
+        switch(op)
+        {
+            case blend_op::Add:
+                return "Add";
+            case blend_op::Subtract:
+                return "Subtract";
+            case blend_op::ReverseSubtract:
+                return "ReverseSubtract";
+            case blend_op::Min:
+                return "Min";
+            case blend_op::Max:
+                return "Max";
+        }
+
+        return "Invalid blend_op value";
+    }
+
+    inline std::string to_string(color_component_flag_bits bits)
+    {
+        switch(bits)
+        {
+            case color_component_flag_bits::None:
+                return "None";
+            case color_component_flag_bits::R:
+                return "R";
+            case color_component_flag_bits::G:
+                return "G";
+            case color_component_flag_bits::B:
+                return "B";
+            case color_component_flag_bits::A:
+                return "A";
+            case color_component_flag_bits::All:
+                return to_string(static_cast<color_component_flags>(bits));
+        }
+
+        return "Invalid color_component_flag_bits value";
+    }
+
+    inline std::string to_string(color_component_flags flags)
+    {
+        std::string out;
+
+        constexpr std::array<color_component_flag_bits, 4> allBits = {
+            color_component_flag_bits::R,
+            color_component_flag_bits::G,
+            color_component_flag_bits::B,
+            color_component_flag_bits::A
+        };
+
+        for (auto elem : allBits)
+        {
+            if (flags.contains(elem))
+            {
+                out += " | " + to_string(elem);
+                flags.remove(elem);
+            }
+        }
+
+        // all flags should've been covered and removed
+        if (flags != color_component_flag_bits::None)
+            return "Invalid color_component_flags value";
+
+        // remove excessive initial " | "
+        if (!out.empty() && out[0] == ' ' && out[1] == '|' && out[2] == ' ')
+            out = out.substr(3);
+
+        return out;
+    }
+
+    inline Pipeline::native_pipeline* Pipeline::getNative() const
+    {
+        return m_ptr;
+    }
+
+    inline result Pipeline::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_device->m_validationCallbackMessenger)
+#endif
+    }
+
+    inline primitive_topology Pipeline::getTopology() const
+    {
+        return m_topology;
+    }
+
+    inline shader_stage_flags Pipeline::getPushConstantStages() const
+    {
+        return m_pushConstantStages;
+    }
+}
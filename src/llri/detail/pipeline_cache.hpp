@@ -0,0 +1,145 @@
+/**
+ * @file pipeline_cache.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    struct adapter_info;
+
+    /**
+     * @brief Describes how a PipelineCache should be created.
+    */
+    struct pipeline_cache_desc
+    {
+        /**
+         * @brief The size of pipeline_cache_desc::data in bytes. If dataSize is 0, the PipelineCache is created empty.
+        */
+        size_t dataSize;
+        /**
+         * @brief Data that was previously obtained through PipelineCache::serialize(), which is used to initialize the PipelineCache.
+         *
+         * The data is validated against the Adapter's adapter_info::vendorId, adapter_info::adapterId, adapter_info::driverVersion and the current llri::implementation. If any of these don't match, or if the data is corrupted, the data is silently discarded and the PipelineCache is created empty. PipelineCache::isInitialDataUsed() **can** be used to detect if this occurred.
+         *
+         * @note Valid usage (ErrorInvalidUsage): If dataSize is more than 0, data **must** be a valid non-null pointer to an array of at least dataSize bytes.
+        */
+        const void* data;
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief The header that LLRI prepends to serialized pipeline cache data. The header is used to validate the data against the adapter and driver that it was created with.
+        */
+        struct pipeline_cache_header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t implementation;
+            uint32_t vendorId;
+            uint32_t adapterId;
+            uint32_t reserved;
+            uint64_t driverVersion;
+            uint64_t dataSize;
+            uint64_t dataHash;
+        };
+
+        constexpr uint32_t pipelineCacheMagic = 0x49524c4c; // "LLRI"
+        constexpr uint32_t pipelineCacheVersion = 1;
+
+        /**
+         * @brief Hashes the pipeline cache data (FNV-1a) to detect corrupted or truncated data.
+        */
+        inline uint64_t hashPipelineCacheData(const uint8_t* data, size_t size);
+
+        /**
+         * @brief Validates the header of serialized pipeline cache data and outputs the implementation data that follows it.
+         * @return true if the header matches the adapter, false if the data should be discarded.
+        */
+        inline bool readPipelineCacheHeader(const adapter_info& info, const pipeline_cache_desc& desc, pipeline_cache_desc* payload);
+
+        /**
+         * @brief Writes a pipeline cache header to the start of data, describing the implementation data that follows it.
+        */
+        inline void writePipelineCacheHeader(const adapter_info& info, std::vector<uint8_t>* data);
+    }
+
+    /**
+     * @brief PipelineCache stores the results of pipeline compilation so that pipelines that are created with the same state again don't need to be recompiled.
+     * Pipelines are created through a PipelineCache, and the cache **can** be serialized to disk to turn pipeline compilation into a cache hit in later runs of the application.
+     *
+     * PipelineCache is internally synchronized and **may** be used by multiple threads simultaneously.
+    */
+    class PipelineCache
+    {
+        friend class Device;
+
+    public:
+        using native_pipeline_cache = void;
+
+        /**
+         * @brief Gets the native PipelineCache pointer, which depending on the llri::getImplementation() is a pointer to the following:
+         *
+         * DirectX12: ID3D12PipelineLibrary* (**may** be nullptr if the driver does not support pipeline libraries)
+         * Vulkan: VkPipelineCache
+         */
+        [[nodiscard]] native_pipeline_cache* getNative() const;
+
+        /**
+         * @brief Set the name of the PipelineCache. DirectX12 ignores the name if the PipelineCache has no native pipeline library, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
+
+        /**
+         * @brief Returns true if the data passed through pipeline_cache_desc::data was accepted and used to initialize the PipelineCache.
+         * Returns false if no data was passed, or if the data was discarded because it was created on a different adapter, driver or implementation.
+        */
+        [[nodiscard]] bool isInitialDataUsed() const;
+
+        /**
+         * @brief Serialize the contents of the PipelineCache into a byte blob.
+         *
+         * The resulting data **can** be stored and passed into pipeline_cache_desc::data in later runs of the application.
+         *
+         * @param data A pointer to a vector of bytes. The vector's contents are replaced with the serialized data.
+         *
+         * @note Valid usage (ErrorInvalidUsage): data **must** be a valid non-null pointer to a std::vector<uint8_t>.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result serialize(std::vector<uint8_t>* data) const;
+
+    private:
+        // Force private constructor/deconstructor so that only create/destroy can manage lifetime
+        PipelineCache() = default;
+        ~PipelineCache() = default;
+
+        native_pipeline_cache* m_ptr = nullptr;
+        Device* m_device = nullptr;
+        void* m_deviceHandle = nullptr;
+        void* m_deviceFunctionTable = nullptr;
+
+        void* m_validationCallbackMessenger = nullptr;
+
+        bool m_initialDataUsed = false;
+        // DirectX12 pipeline libraries reference their initial data for as long as they exist
+        std::vector<uint8_t> m_initialData;
+
+        result impl_serialize(std::vector<uint8_t>* data) const;
+        result impl_setName(const char* name);
+    };
+}
@@ -0,0 +1,116 @@
+/**
+ * @file pipeline_cache.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+#include <cstring>
+
+namespace llri
+{
+    namespace detail
+    {
+        inline uint64_t hashPipelineCacheData(const uint8_t* data, size_t size)
+        {
+            uint64_t hash = 0xcbf29ce484222325;
+            constexpr uint64_t prime = 0x00000100000001b3;
+
+            for (size_t i = 0; i < size; i++)
+            {
+                hash = hash ^ data[i];
+                hash *= prime;
+            }
+
+            return hash;
+        }
+
+        inline bool readPipelineCacheHeader(const adapter_info& info, const pipeline_cache_desc& desc, pipeline_cache_desc* payload)
+        {
+            *payload = pipeline_cache_desc { 0, nullptr };
+
+            if (desc.data == nullptr || desc.dataSize < sizeof(pipeline_cache_header))
+                return false;
+
+            // the data isn't guaranteed to be aligned, so the header is copied out
+            pipeline_cache_header header;
+            std::memcpy(&header, desc.data, sizeof(pipeline_cache_header));
+
+            if (header.magic != pipelineCacheMagic ||
+                header.version != pipelineCacheVersion ||
+                header.implementation != static_cast<uint32_t>(getImplementation()) ||
+                header.vendorId != info.vendorId ||
+                header.adapterId != info.adapterId ||
+                header.driverVersion != info.driverVersion)
+                return false;
+
+            const auto* data = static_cast<const uint8_t*>(desc.data) + sizeof(pipeline_cache_header);
+            if (header.dataSize != desc.dataSize - sizeof(pipeline_cache_header) ||
+                header.dataHash != hashPipelineCacheData(data, static_cast<size_t>(header.dataSize)))
+                return false;
+
+            *payload = pipeline_cache_desc { static_cast<size_t>(header.dataSize), data };
+            return true;
+        }
+
+        inline void writePipelineCacheHeader(const adapter_info& info, std::vector<uint8_t>* data)
+        {
+            pipeline_cache_header header {};
+            header.magic = pipelineCacheMagic;
+            header.version = pipelineCacheVersion;
+            header.implementation = static_cast<uint32_t>(getImplementation());
+            header.vendorId = info.vendorId;
+            header.adapterId = info.adapterId;
+            header.reserved = 0;
+            header.driverVersion = info.driverVersion;
+            header.dataSize = data->size() - sizeof(pipeline_cache_header);
+            header.dataHash = hashPipelineCacheData(data->data() + sizeof(pipeline_cache_header), data->size() - sizeof(pipeline_cache_header));
+
+            std::memcpy(data->data(), &header, sizeof(pipeline_cache_header));
+        }
+    }
+
+    inline PipelineCache::native_pipeline_cache* PipelineCache::getNative() const
+    {
+        return m_ptr;
+    }
+
+    inline result PipelineCache::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_validationCallbackMessenger)
+#endif
+    }
+
+    inline bool PipelineCache::isInitialDataUsed() const
+    {
+        return m_initialDataUsed;
+    }
+
+    inline result PipelineCache::serialize(std::vector<uint8_t>* data) const
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(data != nullptr, result::ErrorInvalidUsage)
+
+        // the implementation writes its data after the space reserved for the header
+        data->assign(sizeof(detail::pipeline_cache_header), 0);
+
+        const result r = impl_serialize(data);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+        if (r != result::Success)
+        {
+            data->clear();
+            return r;
+        }
+
+        detail::writePipelineCacheHeader(m_device->getAdapter()->queryInfo(), data);
+        return result::Success;
+    }
+}
@@ -0,0 +1,257 @@
+/**
+ * @file query_pool.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    /**
+     * @brief The type of information that the queries in a QueryPool collect.
+    */
+    enum struct query_type : uint8_t
+    {
+        /**
+         * @brief Each query stores a 64-bit GPU timestamp, written by CommandList::writeTimestamp() after all previous commands in the CommandList have completed.
+         * Timestamps are measured in ticks, and Queue::queryTimestampPeriod() converts them to nanoseconds.
+        */
+        Timestamp,
+        /**
+         * @brief Each query counts the pipeline_statistics that were selected in query_pool_desc::pipelineStatistics, for the commands that are recorded between CommandList::beginQuery() and CommandList::endQuery().
+         *
+         * Pipeline statistics queries **must** only be used if adapter_features::pipelineStatisticsQuery was enabled in device_desc::features.
+        */
+        PipelineStatistics,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = PipelineStatistics
+    };
+
+    /**
+     * @brief Converts a query_type to a string.
+     * @return The enum value as a string, or "Invalid query_type value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(query_type type);
+
+    /**
+     * @brief Describes the counters that a pipeline statistics query collects.
+    */
+    enum struct pipeline_statistic_flag_bits : uint32_t
+    {
+        /**
+         * @brief No counters.
+        */
+        None = 0,
+        /**
+         * @brief The number of vertices that were read by the input assembler, see pipeline_statistics::inputAssemblyVertices.
+        */
+        InputAssemblyVertices = 1 << 0,
+        /**
+         * @brief The number of primitives that were assembled by the input assembler, see pipeline_statistics::inputAssemblyPrimitives.
+        */
+        InputAssemblyPrimitives = 1 << 1,
+        /**
+         * @brief The number of vertex shader invocations, see pipeline_statistics::vertexShaderInvocations.
+        */
+        VertexShaderInvocations = 1 << 2,
+        /**
+         * @brief The number of primitives that were processed by the clipping stage, see pipeline_statistics::clippingInvocations.
+        */
+        ClippingInvocations = 1 << 3,
+        /**
+         * @brief The number of primitives that were output by the clipping stage, see pipeline_statistics::clippingPrimitives.
+        */
+        ClippingPrimitives = 1 << 4,
+        /**
+         * @brief The number of fragment shader invocations, see pipeline_statistics::fragmentShaderInvocations.
+        */
+        FragmentShaderInvocations = 1 << 5,
+        /**
+         * @brief The number of compute shader invocations, see pipeline_statistics::computeShaderInvocations.
+        */
+        ComputeShaderInvocations = 1 << 6,
+        /**
+         * @brief All counters combined.
+        */
+        All = InputAssemblyVertices | InputAssemblyPrimitives | VertexShaderInvocations | ClippingInvocations | ClippingPrimitives | FragmentShaderInvocations | ComputeShaderInvocations
+    };
+    LLRI_DEFINE_FLAG_BIT_OPERATORS(pipeline_statistic_flag_bits)
+
+    /**
+     * @brief Converts a pipeline_statistic_flag_bits to a string.
+     * @return The enum value as a string, or "Invalid pipeline_statistic_flag_bits value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(pipeline_statistic_flag_bits bits);
+
+    /**
+     * @brief Describes a combination of pipeline statistics counters.
+    */
+    using pipeline_statistic_flags = flags<pipeline_statistic_flag_bits>;
+
+    /**
+     * @brief Converts pipeline_statistic_flags to a string.
+     * @return The flags as a string, or "Invalid pipeline_statistic_flags value" if the value was not recognized as a valid combination of pipeline_statistic_flag_bits.
+    */
+    inline std::string to_string(pipeline_statistic_flags flags);
+
+    /**
+     * @brief The result of a pipeline statistics query, as read by QueryPool::getResults(). Counters that weren't selected in query_pool_desc::pipelineStatistics are 0.
+     *
+     * Counters **may** be approximate, and implementations **may** count invocations that don't affect the output (e.g. helper invocations).
+    */
+    struct pipeline_statistics
+    {
+        uint64_t inputAssemblyVertices;
+        uint64_t inputAssemblyPrimitives;
+        uint64_t vertexShaderInvocations;
+        uint64_t clippingInvocations;
+        uint64_t clippingPrimitives;
+        uint64_t fragmentShaderInvocations;
+        uint64_t computeShaderInvocations;
+    };
+
+    /**
+     * @brief Describes how a QueryPool should be created.
+    */
+    struct query_pool_desc
+    {
+        /**
+         * @brief The type of the queries in the QueryPool.
+         *
+         * @note Valid usage (ErrorInvalidUsage): type **must** be less or equal to query_type::MaxEnum.
+        */
+        query_type type;
+        /**
+         * @brief The number of queries in the QueryPool.
+         *
+         * @note Valid usage (ErrorInvalidUsage): count **must** be more than 0.
+        */
+        uint32_t count;
+        /**
+         * @brief The device node that the QueryPool is created on. Only CommandLists that are allocated with the same nodeMask can use the QueryPool. If this value is 0, it is interpreted as 1.
+         *
+         * @note Valid usage (ErrorInvalidNodeMask): Exactly one bit **must** be set, and that bit **must** be less than 1 << Adapter::queryNodeCount().
+        */
+        uint32_t nodeMask;
+        /**
+         * @brief The counters that are collected by each query if type is query_type::PipelineStatistics. This value is ignored for other query types.
+         *
+         * @note Valid usage (ErrorInvalidUsage): If type is query_type::PipelineStatistics, pipelineStatistics **must** be a valid combination of pipeline_statistic_flag_bits other than pipeline_statistic_flag_bits::None.
+        */
+        pipeline_statistic_flags pipelineStatistics;
+    };
+
+    /**
+     * @brief QueryPool stores the results of a fixed number of GPU queries, such as timestamps.
+     *
+     * Queries are reset with CommandList::resetQueries(), written by CommandList::writeTimestamp() or CommandList::beginQuery() and CommandList::endQuery(), and their results **can** be read back on the host through QueryPool::getResults() or copied into a buffer with CommandList::resolveQueries().
+    */
+    class QueryPool
+    {
+        friend class Device;
+        friend class CommandList;
+
+    public:
+        using native_query_pool = void;
+
+        /**
+         * @brief Get the desc that the QueryPool was created with.
+        */
+        [[nodiscard]] query_pool_desc getDesc() const;
+
+        /**
+         * @brief Gets the native QueryPool pointer, which depending on the llri::getImplementation() is a pointer to the following:
+         *
+         * DirectX12: ID3D12QueryHeap*
+         * Vulkan: VkQueryPool
+         */
+        [[nodiscard]] native_query_pool* getNative() const;
+
+        /**
+         * @brief Set the name of the QueryPool, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
+
+        /**
+         * @brief Get the size in bytes of a single query's result when it's copied into a buffer by CommandList::resolveQueries().
+         *
+         * Timestamps are always 8 bytes. The layout of pipeline statistics in buffers is implementation defined: Vulkan writes the selected counters as consecutive uint64_t values in the order of pipeline_statistic_flag_bits, DirectX12 writes a D3D12_QUERY_DATA_PIPELINE_STATISTICS structure.
+        */
+        [[nodiscard]] uint32_t getResultSize() const;
+
+        /**
+         * @brief Read the timestamps of a range of queries into a host array, without waiting for the GPU.
+         *
+         * The CommandLists that wrote the queries **should** have finished executing, for example by waiting on the Fence that they were submitted with.
+         *
+         * @param firstQuery The index of the first query to read.
+         * @param numQueries The number of queries to read.
+         * @param results A pointer to an array of at least numQueries uint64_t values.
+         *
+         * @note Valid usage (ErrorInvalidUsage): The QueryPool **must** have been created with query_type::Timestamp.
+         * @note Valid usage (ErrorInvalidUsage): firstQuery + numQueries **must** be less or equal to query_pool_desc::count, and numQueries **must** be more than 0.
+         * @note Valid usage (ErrorInvalidUsage): results **must** be a valid non-null pointer to an array of at least numQueries uint64_t values.
+         * @note Valid usage: Each query in the range **must** have been written since it was last reset.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return NotReady if the results of one or more queries aren't available yet. Only Vulkan **can** detect this, DirectX12 returns the last resolved values instead.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory, ErrorDeviceLost.
+        */
+        result getResults(uint32_t firstQuery, uint32_t numQueries, uint64_t* results) const;
+
+        /**
+         * @brief Read the pipeline statistics of a range of queries into a host array, without waiting for the GPU.
+         *
+         * The CommandLists that wrote the queries **should** have finished executing, for example by waiting on the Fence that they were submitted with.
+         *
+         * @param firstQuery The index of the first query to read.
+         * @param numQueries The number of queries to read.
+         * @param results A pointer to an array of at least numQueries pipeline_statistics structures.
+         *
+         * @note Valid usage (ErrorInvalidUsage): The QueryPool **must** have been created with query_type::PipelineStatistics.
+         * @note Valid usage (ErrorInvalidUsage): firstQuery + numQueries **must** be less or equal to query_pool_desc::count, and numQueries **must** be more than 0.
+         * @note Valid usage (ErrorInvalidUsage): results **must** be a valid non-null pointer to an array of at least numQueries pipeline_statistics structures.
+         * @note Valid usage: Each query in the range **must** have been ended since it was last reset.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return NotReady if the results of one or more queries aren't available yet. Only Vulkan **can** detect this, DirectX12 returns the last resolved values instead.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory, ErrorDeviceLost.
+        */
+        result getResults(uint32_t firstQuery, uint32_t numQueries, pipeline_statistics* results) const;
+
+    private:
+        // Force private constructor/deconstructor so that only create/destroy can manage lifetime
+        QueryPool() = default;
+        ~QueryPool() = default;
+
+        native_query_pool* m_ptr = nullptr;
+        Device* m_device = nullptr;
+        void* m_deviceHandle = nullptr;
+        void* m_deviceFunctionTable = nullptr;
+
+        query_pool_desc m_desc;
+        uint32_t m_resultSize = 0;
+
+        void* m_validationCallbackMessenger = nullptr;
+
+        // DirectX12: query heaps can't be read by the host, so every written query is also resolved into this readback buffer when its CommandList ends
+        void* m_readback = nullptr;
+
+        result impl_getResults(uint32_t firstQuery, uint32_t numQueries, uint64_t* results) const;
+        result impl_getResults(uint32_t firstQuery, uint32_t numQueries, pipeline_statistics* results) const;
+        result impl_setName(const char* name);
+    };
+}
@@ -0,0 +1,134 @@
+/**
+ * @file query_pool.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    inline std::string to_string(query_type type)
+    {
+        switch(type)
+        {
+            case query_type::Timestamp:
+                return "Timestamp";
+            case query_type::PipelineStatistics:
+                return "PipelineStatistics";
+        }
+
+        return "Invalid query_type value";
+    }
+
+    inline std::string to_string(pipeline_statistic_flag_bits bits)
+    {
+        switch(bits)
+        {
+            case pipeline_statistic_flag_bits::None:
+                return "None";
+            case pipeline_statistic_flag_bits::InputAssemblyVertices:
+                return "InputAssemblyVertices";
+            case pipeline_statistic_flag_bits::InputAssemblyPrimitives:
+                return "InputAssemblyPrimitives";
+            case pipeline_statistic_flag_bits::VertexShaderInvocations:
+                return "VertexShaderInvocations";
+            case pipeline_statistic_flag_bits::ClippingInvocations:
+                return "ClippingInvocations";
+            case pipeline_statistic_flag_bits::ClippingPrimitives:
+                return "ClippingPrimitives";
+            case pipeline_statistic_flag_bits::FragmentShaderInvocations:
+                return "FragmentShaderInvocations";
+            case pipeline_statistic_flag_bits::ComputeShaderInvocations:
+                return "ComputeShaderInvocations";
+            case pipeline_statistic_flag_bits::All:
+                return to_string(static_cast<pipeline_statistic_flags>(bits));
+        }
+
+        return "Invalid pipeline_statistic_flag_bits value";
+    }
+
+    inline std::string to_string(pipeline_statistic_flags flags)
+    {
+        std::string out;
+
+        constexpr std::array<pipeline_statistic_flag_bits, 7> allBits = {
+            pipeline_statistic_flag_bits::InputAssemblyVertices,
+            pipeline_statistic_flag_bits::InputAssemblyPrimitives,
+            pipeline_statistic_flag_bits::VertexShaderInvocations,
+            pipeline_statistic_flag_bits::ClippingInvocations,
+            pipeline_statistic_flag_bits::ClippingPrimitives,
+            pipeline_statistic_flag_bits::FragmentShaderInvocations,
+            pipeline_statistic_flag_bits::ComputeShaderInvocations
+        };
+
+        for (auto elem : allBits)
+        {
+            if (flags.contains(elem))
+            {
+                out += " | " + to_string(elem);
+                flags.remove(elem);
+            }
+        }
+
+        // all flags should've been covered and removed
+        if (flags != pipeline_statistic_flag_bits::None)
+            return "Invalid pipeline_statistic_flags value";
+
+        // remove excessive initial " | "
+        if (!out.empty() && out[0] == ' ' && out[1] == '|' && out[2] == ' ')
+            out = out.substr(3);
+
+        return out;
+    }
+
+    inline query_pool_desc QueryPool::getDesc() const
+    {
+        return m_desc;
+    }
+
+    inline QueryPool::native_query_pool* QueryPool::getNative() const
+    {
+        return m_ptr;
+    }
+
+    inline result QueryPool::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_validationCallbackMessenger)
+#endif
+    }
+
+    inline uint32_t QueryPool::getResultSize() const
+    {
+        return m_resultSize;
+    }
+
+    inline result QueryPool::getResults(uint32_t firstQuery, uint32_t numQueries, uint64_t* results) const
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.type == query_type::Timestamp, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(numQueries > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(static_cast<uint64_t>(firstQuery) + numQueries <= m_desc.count, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(results != nullptr, result::ErrorInvalidUsage)
+
+        LLRI_DETAIL_CALL_IMPL(impl_getResults(firstQuery, numQueries, results), m_validationCallbackMessenger)
+    }
+
+    inline result QueryPool::getResults(uint32_t firstQuery, uint32_t numQueries, pipeline_statistics* results) const
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_desc.type == query_type::PipelineStatistics, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(numQueries > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(static_cast<uint64_t>(firstQuery) + numQueries <= m_desc.count, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(results != nullptr, result::ErrorInvalidUsage)
+
+        LLRI_DETAIL_CALL_IMPL(impl_getResults(firstQuery, numQueries, results), m_validationCallbackMessenger)
+    }
+}
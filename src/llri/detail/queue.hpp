@@ -12,6 +12,12 @@ namespace llri
     class CommandList;
     class Fence;
     class Semaphore;
+    class CommandContextPool;
+
+    namespace detail
+    {
+        struct fence_submission_state;
+    }
 
     /**
      * @brief Declare queue priority. Queues with a higher priority **may** be assigned more resources and processing time by the Adapter.
@@ -78,6 +84,34 @@ namespace llri
     */
     inline std::string to_string(queue_type type);
 
+    /**
+     * @brief Describes how a Queue passes its submissions to the driver.
+    */
+    enum struct queue_submit_mode : uint8_t
+    {
+        /**
+         * @brief Queue::submit() passes the CommandLists to the driver before it returns.
+        */
+        Immediate,
+        /**
+         * @brief Queue::submit() copies the submission into a lock-free ring and returns immediately, after which a dedicated submission thread passes it to the driver. Submissions that wait in the ring together are passed to the driver in a single call.
+         *
+         * Native submit calls **can** take a significant amount of time on some drivers, which this mode moves off of the thread that calls Queue::submit().
+         * Errors that occur on the submission thread are sent to the message callback, which **must** thus be thread-safe. They're also returned by Device::waitFences() for the submission's Fence, and by Queue::flush().
+        */
+        Background,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Background
+    };
+
+    /**
+     * @brief Converts a queue_submit_mode to a string.
+     * @return The enum value as a string, or "Invalid queue_submit_mode value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(queue_submit_mode mode);
+
     /**
      * @brief Describes the information needed to create a queue upon device creation.
      *
@@ -97,6 +131,12 @@ namespace llri
          * @note Valid usage (ErrorInvalidUsage):  priority must not be more than queue_priority::MaxEnum.
         */
         queue_priority priority;
+        /**
+         * @brief The way that the queue passes its submissions to the driver.
+         *
+         * @note Valid usage (ErrorInvalidUsage): submitMode must not be more than queue_submit_mode::MaxEnum.
+        */
+        queue_submit_mode submitMode;
     };
 
     /**
@@ -139,6 +179,24 @@ namespace llri
          * @note Valid usage (ErrorInvalidUsage): if numWaitSemaphores > 0 then each element in waitSemaphores **must** be a valid non-null Semaphore pointer.
         */
         Semaphore** waitSemaphores;
+        /**
+         * @brief An array of values, one for each Semaphore in waitSemaphores. The CommandLists wait until each semaphore_type::Timeline Semaphore reaches its value. Values for semaphore_type::Binary Semaphores are ignored.
+         *
+         * @note Valid usage: if none of the waitSemaphores are semaphore_type::Timeline Semaphores then waitSemaphoreValues **may** be nullptr.
+         * @note Valid usage (ErrorInvalidUsage): if any of the waitSemaphores is a semaphore_type::Timeline Semaphore then waitSemaphoreValues **must** be a valid non-null pointer to an array of size numWaitSemaphores (or more).
+        */
+        const uint64_t* waitSemaphoreValues;
+        /**
+         * @brief An array of pipeline stages, one for each Semaphore in waitSemaphores. Only the given stages of the CommandLists wait for the Semaphore, earlier stages **may** start executing before the Semaphore is signaled.
+         *
+         * If waitSemaphoreStages is nullptr, or an element is pipeline_stage_flag_bits::None, all stages wait for the Semaphore.
+         *
+         * @note Valid usage: waitSemaphoreStages **may** be nullptr.
+         * @note Valid usage (ErrorInvalidUsage): if waitSemaphoreStages is not nullptr then it **must** be a valid pointer to an array of size numWaitSemaphores (or more).
+         * @note Valid usage (ErrorInvalidUsage): each element in waitSemaphoreStages **must** be a valid combination of pipeline_stage_flag_bits.
+         * @note Valid usage (ErrorInvalidUsage): each element in waitSemaphoreStages **must** only contain stages that are supported by the Queue's queue_type. Compute Queues support ComputeShader, Transfer and Host, and Transfer Queues support Transfer and Host.
+        */
+        const pipeline_stage_flags* waitSemaphoreStages;
 
         /**
          * @brief The number of Semaphores in the submit_desc::signalSemaphores array.
@@ -152,6 +210,14 @@ namespace llri
          * @note Valid usage (ErrorInvalidUsage): if numSignalSemaphores > 0 then each element in signalSemaphores **must** be a valid non-null Semaphore pointer.
         */
         Semaphore** signalSemaphores;
+        /**
+         * @brief An array of values, one for each Semaphore in signalSemaphores. Each semaphore_type::Timeline Semaphore is set to its value after the CommandLists are done executing. Values for semaphore_type::Binary Semaphores are ignored.
+         *
+         * @note Valid usage: if none of the signalSemaphores are semaphore_type::Timeline Semaphores then signalSemaphoreValues **may** be nullptr.
+         * @note Valid usage (ErrorInvalidUsage): if any of the signalSemaphores is a semaphore_type::Timeline Semaphore then signalSemaphoreValues **must** be a valid non-null pointer to an array of size numSignalSemaphores (or more).
+         * @note Valid usage (ErrorInvalidUsage): the value for a semaphore_type::Timeline Semaphore **must** be more than the Semaphore's current value, and more than every value that a pending submission, an earlier submit_desc in the same call to Queue::submit() or Semaphore::signal() signals it with.
+        */
+        const uint64_t* signalSemaphoreValues;
 
         /**
          * @brief A fence to signal after the CommandLists are done executing.
@@ -162,6 +228,60 @@ namespace llri
         Fence* fence;
     };
 
+    namespace detail
+    {
+        /**
+         * @brief A slot in the submission ring of a queue_submit_mode::Background Queue. The submit_desc points into the slot's arrays, which keep their memory when the slot is reused.
+         *
+         * The implementation values of binary Semaphores and the Fence are resolved when the submission is enqueued, so the value arrays and fenceValue are always set and the submission thread never touches counters that other threads use.
+        */
+        struct queued_submission
+        {
+            std::atomic<uint64_t> sequence { 0 };
+            submit_desc desc {};
+
+            std::vector<CommandList*> commandLists;
+            std::vector<Semaphore*> waitSemaphores;
+            std::vector<uint64_t> waitSemaphoreValues;
+            std::vector<pipeline_stage_flags> waitSemaphoreStages;
+            std::vector<Semaphore*> signalSemaphores;
+            std::vector<uint64_t> signalSemaphoreValues;
+            // the value that the implementation signals desc.fence with
+            uint64_t fenceValue = 0;
+        };
+
+        /**
+         * @brief The submission thread of a queue_submit_mode::Background Queue.
+         *
+         * Submissions are passed through a bounded ring in which every slot has a sequence number. Queue::submit() reserves a slot by incrementing enqueuePosition, and the slot is handed over to the submission thread by setting its sequence, so no locks are taken to submit.
+         * Queue::submit() is externally synchronized, so the ring has a single producer, the thread that currently submits, and a single consumer, the submission thread.
+         * The mutex is only used to let the submission thread sleep while the ring is empty, and to wake up threads that wait for the ring to be flushed.
+        */
+        struct submission_thread
+        {
+            static constexpr uint64_t ringSize = 64;
+
+            std::array<queued_submission, ringSize> ring;
+            std::atomic<uint64_t> enqueuePosition { 0 };
+            std::atomic<uint64_t> numProcessed { 0 };
+            // the enqueue position after the last submission that waits on a binary Semaphore
+            std::atomic<uint64_t> binaryWaitPosition { 0 };
+            std::atomic<bool> sleeping { false };
+
+            std::mutex mutex;
+            std::condition_variable wakeCondition;
+            std::condition_variable flushCondition;
+            bool stopping = false;
+            // the first error since the last Queue::flush()
+            result error = result::Success;
+
+            // the submissions that are passed to the driver together and the values of their Fences, only used by the submission thread
+            std::vector<submit_desc> batch;
+            std::vector<uint64_t> batchFenceValues;
+            std::thread thread;
+        };
+    }
+
     /**
      * @brief Queues are used to send commands to the Adapter. This is done by submitting CommandLists and/or synchronization operations.
     */
@@ -169,6 +289,7 @@ namespace llri
     {
         friend class Instance;
         friend class Device;
+        friend class Fence;
 
     public:
         using native_queue = void;
@@ -187,16 +308,62 @@ namespace llri
          * @param index The index of the device node to get the queue of. The function returns nullptr if the index exceeds the number of nodes in the device.
          */
         [[nodiscard]] native_queue* getNative(size_t index = 0) const;
+
+        /**
+         * @brief Set the name of the Queue on all device nodes, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
+
+        /**
+         * @brief Query the number of nanoseconds that it takes for a timestamp that is written by CommandList::writeTimestamp() on this Queue to increment by 1.
+         *
+         * @return The timestamp period in nanoseconds, or 0.0 if the Queue doesn't support timestamp queries. Transfer queues never support timestamp queries.
+        */
+        [[nodiscard]] double queryTimestampPeriod() const;
         
         /**
          * @brief Submit CommandLists to the queue, which means the commands they contain will be executed.
+         *
+         * If device_desc::resourceStateTracking is enabled, CommandLists that expect their resources to be in a different state than the resources are in when the CommandList starts executing are preceded by internal CommandLists with fix-up barriers. Submissions to different Queues that use the same resources **must** be externally synchronized.
+         *
+         * If the Queue was created with queue_submit_mode::Background, desc and its arrays are copied and passed to the driver by the submission thread after this function returns. Validation still happens before this function returns.
+         *
          * @param desc Describes the CommandLists that get executed, and what synchronization they signal or wait upon.
          *
+         * @note Valid usage: Queue::submit() **must not** be called simultaneously from multiple threads on the same Queue, which includes queue_submit_mode::Background Queues.
+         *
          * @return Success upon correct execution of the operation.
          * @return submit_desc defined result values: ErrorInvalidUsage, ErrorInvalidNodeMask, ErrorIncompatibleNodeMask, ErrorInvalidState, ErrorAlreadySignaled.
         */
         result submit(const submit_desc& desc);
 
+        /**
+         * @brief Submit multiple batches of CommandLists to the queue in a single operation. The batches start executing in the order of the descs array, and each batch waits on and signals its own synchronization primitives.
+         *
+         * Submitting batches together is cheaper than calling submit() for each batch, because the implementation **may** pass them to the driver in a single call. After the first few submissions, this function doesn't allocate memory. If device_desc::resourceStateTracking is enabled, the batches are submitted one at a time.
+         *
+         * @param numDescs The number of submit_desc structures in the descs array.
+         * @param descs An array of submit_desc structures, each describing a batch of CommandLists and the synchronization that it signals or waits upon.
+         *
+         * @note Valid usage (ErrorInvalidUsage): numDescs **must** be more than 0.
+         * @note Valid usage (ErrorInvalidUsage): descs **must** be a valid non-null pointer to an array of numDescs submit_desc structures.
+         * @note Valid usage (ErrorAlreadySignaled): A Fence **must not** be used by more than one submit_desc in descs.
+         * @note Valid usage: Queue::submit() **must not** be called simultaneously from multiple threads on the same Queue, which includes queue_submit_mode::Background Queues.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return submit_desc defined result values: ErrorInvalidUsage, ErrorInvalidNodeMask, ErrorIncompatibleNodeMask, ErrorInvalidState, ErrorAlreadySignaled.
+        */
+        result submit(uint32_t numDescs, const submit_desc* descs);
+
         /**
          * @brief Wait for the queue to go idle. This function blocks the CPU thread until all of the commands on the queue are done.
          *
@@ -206,6 +373,16 @@ namespace llri
          * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory, ErrorDeviceLost.
         */
         result waitIdle();
+
+        /**
+         * @brief Wait until the submission thread of a queue_submit_mode::Background Queue has passed every submission that was made before this call to the driver. This doesn't wait for the GPU to execute them.
+         *
+         * Queue::waitIdle(), Device::waitFences() and Fence::getStatus() flush the Queues that they depend on automatically, and so does a Queue::submit() that waits on a semaphore_type::Binary Semaphore.
+         *
+         * @return Success upon correct execution of the operation, or if the Queue was created with queue_submit_mode::Immediate.
+         * @return The result of the first submission that failed on the submission thread since the last call to Queue::flush().
+        */
+        result flush();
     private:
         // Force private constructor/deconstructor so that only create/destroy can manage lifetime
         Queue() = default;
@@ -216,10 +393,47 @@ namespace llri
 
         queue_desc m_desc;
         Device* m_device = nullptr;
+        double m_timestampPeriod = 0.0;
 
         void* m_validationCallbackMessenger = nullptr;
 
-        result impl_submit(const submit_desc& desc);
+#ifndef LLRI_DISABLE_VALIDATION
+        // the submission states of the Fences that were signaled through this Queue, completed by waitIdle()
+        std::vector<std::shared_ptr<detail::fence_submission_state>> m_fenceSubmissionStates;
+#endif
+
+        // resource state tracking: the fix-up CommandLists that are recorded by submit(), and reused storage for building the patched submission
+        CommandContextPool* m_fixupPool = nullptr;
+        std::vector<CommandList*> m_submitLists;
+        std::vector<detail::pending_transition> m_fixupTransitions;
+        std::vector<resource_barrier> m_fixupBarriers;
+        // the states that the submission leaves the tracked Resources in, which are only committed to the Resources once it succeeded
+        std::unordered_map<Resource*, std::vector<resource_state>> m_stagedStates;
+
+        // implementation defined storage that impl_submit() reuses so that it doesn't allocate memory for every submission
+        void* m_submitScratch = nullptr;
+
+        // the submission thread of a queue_submit_mode::Background Queue, which is started when the Device is created
+        std::unique_ptr<detail::submission_thread> m_submissionThread;
+
+        result submitTrackedResourceStates(const submit_desc& desc);
+        // passes submissions to impl_submit() directly, or through the submission thread
+        result submitToImplementation(uint32_t numDescs, const submit_desc* descs);
+
+        void startSubmissionThread();
+        void stopSubmissionThread();
+        void runSubmissionThread();
+        // returns the position of the submission in the ring
+        uint64_t enqueueSubmission(const submit_desc& desc);
+        // waits until the submission thread is done with the submissions that were enqueued before the call
+        void waitForSubmissionThread();
+        // waits until the submission thread is done with the submissions that wait on a binary Semaphore
+        void waitForBinarySemaphoreWaits();
+        void waitForSubmissionPosition(uint64_t target);
+
+        result impl_setName(const char* name);
+        // fenceValues holds the value that each desc's Fence is signaled with if the values were resolved by enqueueSubmission(), or nullptr
+        result impl_submit(uint32_t numDescs, const submit_desc* descs, const uint64_t* fenceValues);
         result impl_waitIdle();
     };
 }
@@ -36,6 +36,19 @@ namespace llri
         return "Invalid queue_type value";
     }
 
+    inline std::string to_string(queue_submit_mode mode)
+    {
+        switch(mode)
+        {
+            case queue_submit_mode::Immediate:
+                return "Immediate";
+            case queue_submit_mode::Background:
+                return "Background";
+        }
+
+        return "Invalid queue_submit_mode value";
+    }
+
     inline queue_desc Queue::getDesc() const
     {
         return m_desc;
@@ -49,42 +62,569 @@ namespace llri
         return m_ptrs[index];
     }
 
+    inline result Queue::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_validationCallbackMessenger)
+#endif
+    }
+
+    inline double Queue::queryTimestampPeriod() const
+    {
+        return m_timestampPeriod;
+    }
+
     inline result Queue::submit(const submit_desc& desc)
     {
+        return submit(1, &desc);
+    }
+
+    inline result Queue::submit(uint32_t numDescs, const submit_desc* descs)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(numDescs > 0, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(descs != nullptr, result::ErrorInvalidUsage)
+
 #ifdef LLRI_DETAIL_ENABLE_VALIDATION
-        LLRI_DETAIL_VALIDATION_REQUIRE(detail::hasSingleBit(desc.nodeMask), result::ErrorInvalidNodeMask)
-        LLRI_DETAIL_VALIDATION_REQUIRE(desc.nodeMask < (1u << m_device->m_adapter->queryNodeCount()), result::ErrorInvalidNodeMask)
+        // non-graphics queues can't execute graphics stages, and transfer queues can't execute shaders
+        pipeline_stage_flags supportedStages = pipeline_stage_flag_bits::All;
+        if (m_desc.type == queue_type::Compute)
+            supportedStages = pipeline_stage_flag_bits::ComputeShader | pipeline_stage_flag_bits::Transfer | pipeline_stage_flag_bits::Host;
+        else if (m_desc.type == queue_type::Transfer)
+            supportedStages = pipeline_stage_flag_bits::Transfer | pipeline_stage_flag_bits::Host;
 
-        LLRI_DETAIL_VALIDATION_REQUIRE(desc.numCommandLists != 0, result::ErrorInvalidUsage)
-        LLRI_DETAIL_VALIDATION_REQUIRE(desc.commandLists != nullptr, result::ErrorInvalidUsage)
+        // the highest value that earlier descs in the batch signal each timeline Semaphore to, every signal must be above it
+        std::unordered_map<const Semaphore*, uint64_t> signaledValues;
 
-        for (size_t i = 0; i < desc.numCommandLists; i++)
+        for (size_t d = 0; d < numDescs; d++)
         {
-            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.commandLists[i] != nullptr, i, result::ErrorInvalidUsage)
-            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.commandLists[i]->getState() == llri::command_list_state::Ready, i, result::ErrorInvalidState)
+            const submit_desc& desc = descs[d];
+
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(detail::hasSingleBit(desc.nodeMask), d, result::ErrorInvalidNodeMask)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.nodeMask < (1u << m_device->m_adapter->queryNodeCount()), d, result::ErrorInvalidNodeMask)
+
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.numCommandLists != 0, d, result::ErrorInvalidUsage)
+            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.commandLists != nullptr, d, result::ErrorInvalidUsage)
 
-            const uint32_t descNodeMask = desc.nodeMask == 0 ? 1 : desc.nodeMask;
-            const uint32_t cmdListNodeMask = desc.commandLists[i]->m_desc.nodeMask == 0 ? 1 : desc.commandLists[i]->m_desc.nodeMask;
+            for (size_t i = 0; i < desc.numCommandLists; i++)
+            {
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.commandLists[i] != nullptr, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.commandLists[i]->getState() == llri::command_list_state::Ready, i, result::ErrorInvalidState)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.commandLists[i]->m_numSubmissions == 0 || desc.commandLists[i]->m_submitMode != command_list_submit_mode::OneTime, i, result::ErrorInvalidState)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.commandLists[i]->m_submitMode == command_list_submit_mode::Simultaneous || !desc.commandLists[i]->isInFlight(), i, result::ErrorInvalidState)
 
-            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(descNodeMask == cmdListNodeMask, i, result::ErrorIncompatibleNodeMask)
+                const uint32_t descNodeMask = desc.nodeMask == 0 ? 1 : desc.nodeMask;
+                const uint32_t cmdListNodeMask = desc.commandLists[i]->m_desc.nodeMask == 0 ? 1 : desc.commandLists[i]->m_desc.nodeMask;
+
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(descNodeMask == cmdListNodeMask, i, result::ErrorIncompatibleNodeMask)
+            }
+
+            LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.numWaitSemaphores > 0, desc.waitSemaphores != nullptr, result::ErrorInvalidUsage)
+            for (size_t i = 0; i < desc.numWaitSemaphores; i++)
+            {
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.waitSemaphores[i] != nullptr, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.waitSemaphores[i]->m_type != semaphore_type::Timeline || desc.waitSemaphoreValues != nullptr, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.waitSemaphoreStages == nullptr || supportedStages.all(desc.waitSemaphoreStages[i]), i, result::ErrorInvalidUsage)
+            }
+
+            LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.numSignalSemaphores > 0, desc.signalSemaphores != nullptr, result::ErrorInvalidUsage)
+            for (size_t i = 0; i < desc.numSignalSemaphores; i++)
+            {
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.signalSemaphores[i] != nullptr, i, result::ErrorInvalidUsage)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.signalSemaphores[i]->m_type != semaphore_type::Timeline || desc.signalSemaphoreValues != nullptr, i, result::ErrorInvalidUsage)
+
+                if (desc.signalSemaphores[i]->m_type == semaphore_type::Timeline)
+                {
+                    const auto it = signaledValues.find(desc.signalSemaphores[i]);
+                    const uint64_t signaled = it != signaledValues.end() ? it->second : desc.signalSemaphores[i]->m_counter;
+                    LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.signalSemaphoreValues[i] > signaled, i, result::ErrorInvalidUsage)
+
+                    signaledValues[desc.signalSemaphores[i]] = desc.signalSemaphoreValues[i];
+                }
+            }
+
+            LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.fence != nullptr, desc.fence->m_signaled == false, result::ErrorAlreadySignaled)
+            for (size_t i = d + 1; i < numDescs && desc.fence != nullptr; i++)
+                LLRI_DETAIL_VALIDATION_REQUIRE_ITER(descs[i].fence != desc.fence, i, result::ErrorAlreadySignaled)
+        }
+#endif
+
+#ifndef LLRI_DISABLE_CAPTURE
+        for (size_t d = 0; d < numDescs; d++)
+            LLRI_DETAIL_CAPTURE(m_device, submit(this, descs[d]))
+#endif
+
+        result r = result::Success;
+        if (m_device->m_desc.resourceStateTracking)
+        {
+            // fix-ups are resolved against the states that the previous batch left the resources in, so the batches are submitted one at a time
+            for (size_t d = 0; d < numDescs && r == result::Success; d++)
+                r = submitTrackedResourceStates(descs[d]);
+        }
+        else
+        {
+            r = submitToImplementation(numDescs, descs);
+        }
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+        if (r == result::Success)
+        {
+            for (size_t d = 0; d < numDescs; d++)
+            {
+                for (size_t i = 0; i < descs[d].numSignalSemaphores; i++)
+                {
+                    // without validation the values aren't guaranteed to increase, so the counter is never moved backwards
+                    if (descs[d].signalSemaphores[i]->m_type == semaphore_type::Timeline)
+                        descs[d].signalSemaphores[i]->m_counter = std::max(descs[d].signalSemaphores[i]->m_counter, descs[d].signalSemaphoreValues[i]);
+                }
+            }
         }
 
-        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.numWaitSemaphores > 0, desc.waitSemaphores != nullptr, result::ErrorInvalidUsage)
-        for (size_t i = 0; i < desc.numWaitSemaphores; i++)
-            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.waitSemaphores[i] != nullptr, i, result::ErrorInvalidUsage)
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        if (r == result::Success)
+        {
+            // states that are only referenced by this Queue belong to destroyed Fences
+            m_fenceSubmissionStates.erase(std::remove_if(m_fenceSubmissionStates.begin(), m_fenceSubmissionStates.end(), [](const auto& state) {
+                return state.use_count() == 1;
+            }), m_fenceSubmissionStates.end());
+
+            for (size_t d = 0; d < numDescs; d++)
+            {
+                const submit_desc& desc = descs[d];
+
+                // track the submission so that CommandLists can't be resubmitted or reset while they're in flight
+                std::shared_ptr<detail::fence_submission_state> fenceState;
+                if (desc.fence)
+                {
+                    if (!desc.fence->m_submissionState)
+                        desc.fence->m_submissionState = std::make_shared<detail::fence_submission_state>();
+
+                    fenceState = desc.fence->m_submissionState;
+                    fenceState->numSubmitted++;
 
-        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.numSignalSemaphores > 0, desc.signalSemaphores != nullptr, result::ErrorInvalidUsage)
-        for (size_t i = 0; i < desc.numSignalSemaphores; i++)
-            LLRI_DETAIL_VALIDATION_REQUIRE_ITER(desc.signalSemaphores[i] != nullptr, i, result::ErrorInvalidUsage)
+                    if (!detail::contains(m_fenceSubmissionStates, fenceState))
+                        m_fenceSubmissionStates.push_back(fenceState);
+                }
 
-        LLRI_DETAIL_VALIDATION_REQUIRE_IF(desc.fence != nullptr, desc.fence->m_signaled == false, result::ErrorAlreadySignaled)
+                for (size_t i = 0; i < desc.numCommandLists; i++)
+                {
+                    desc.commandLists[i]->m_numSubmissions++;
+                    if (fenceState)
+                        desc.commandLists[i]->trackSubmission(fenceState);
+                }
+            }
+        }
+#endif
+
+        return r;
+    }
+
+    inline result Queue::submitTrackedResourceStates(const submit_desc& desc)
+    {
+#ifndef LLRI_DISABLE_CAPTURE
+        // the fix-ups are recorded again when the submission is replayed
+        const detail::capture_writer::suspension captureSuspension;
 #endif
 
-        LLRI_DETAIL_CALL_IMPL(impl_submit(desc), m_validationCallbackMessenger)
+        // each CommandList whose resources aren't in the states that it expects is preceded by a CommandList with fix-up barriers
+        m_submitLists.clear();
+        m_stagedStates.clear();
+        bool recordedFixups = false;
+
+        for (size_t i = 0; i < desc.numCommandLists; i++)
+        {
+            CommandList* list = desc.commandLists[i];
+
+            m_fixupTransitions.clear();
+            list->resolveResourceStates(m_stagedStates, m_fixupTransitions);
+
+            if (!m_fixupTransitions.empty())
+            {
+                if (!m_fixupPool)
+                {
+                    const result r = m_device->createCommandContextPool({ m_desc.type, 1, 3, command_group_reset_mode::KeepMemory }, &m_fixupPool);
+                    if (r != result::Success)
+                        return r;
+                }
+
+                // every submission with fix-ups uses a new frame, which waits until the fix-up CommandLists of the submission that used the frame before are done executing
+                if (!recordedFixups)
+                {
+                    const result r = m_fixupPool->beginFrame(LLRI_TIMEOUT_MAX);
+                    if (r != result::Success)
+                        return r;
+
+                    recordedFixups = true;
+                }
+
+                CommandList* fixup;
+                result r = m_fixupPool->acquireCommandList(0, { list->m_desc.nodeMask, command_list_usage::Direct }, &fixup);
+                if (r != result::Success)
+                    return r;
+
+                m_fixupBarriers.clear();
+                detail::mergeTransitions(m_fixupTransitions, m_fixupBarriers);
+
+                r = fixup->begin({ nullptr, command_list_submit_mode::OneTime });
+                if (r != result::Success)
+                    return r;
+
+                r = fixup->impl_resourceBarrier(static_cast<uint32_t>(m_fixupBarriers.size()), m_fixupBarriers.data());
+                if (r != result::Success)
+                    return r;
+
+                r = fixup->end();
+                if (r != result::Success)
+                    return r;
+
+                m_submitLists.push_back(fixup);
+            }
+
+            m_submitLists.push_back(list);
+        }
+
+        result r;
+        if (!recordedFixups)
+        {
+            r = submitToImplementation(1, &desc);
+        }
+        else
+        {
+            submit_desc patched = desc;
+            patched.numCommandLists = static_cast<uint32_t>(m_submitLists.size());
+            patched.commandLists = m_submitLists.data();
+
+            // the frame Fence is signaled by a separate batch because desc.fence is owned by the user
+            const submit_desc batches[] = {
+                patched,
+                submit_desc { desc.nodeMask, 0, nullptr, 0, nullptr, nullptr, nullptr, 0, nullptr, nullptr, m_fixupPool->getFrameFence() }
+            };
+            r = submitToImplementation(2, batches);
+        }
+
+        // a failed submission doesn't execute its CommandLists, so the Resources remain in their previous states
+        if (r == result::Success)
+        {
+            for (auto& [resource, states] : m_stagedStates)
+                resource->m_trackedStates.swap(states);
+        }
+
+        return r;
+    }
+
+    inline result Queue::submitToImplementation(uint32_t numDescs, const submit_desc* descs)
+    {
+        // a binary Semaphore's signal must be passed to the driver before a wait on it, and it can only be signaled again once that wait was passed to the driver
+        // either may still be in the ring of another Background Queue, submissions in this Queue's own ring are passed to the driver in order
+        bool waitsOnBinarySemaphore = false;
+        bool signalsBinarySemaphore = false;
+        for (size_t d = 0; d < numDescs; d++)
+        {
+            for (size_t i = 0; i < descs[d].numWaitSemaphores; i++)
+                waitsOnBinarySemaphore |= descs[d].waitSemaphores[i]->m_type == semaphore_type::Binary;
+
+            for (size_t i = 0; i < descs[d].numSignalSemaphores; i++)
+                signalsBinarySemaphore |= descs[d].signalSemaphores[i]->m_type == semaphore_type::Binary;
+        }
+
+        if (waitsOnBinarySemaphore || signalsBinarySemaphore)
+        {
+            for (auto* queues : { &m_device->m_graphicsQueues, &m_device->m_computeQueues, &m_device->m_transferQueues })
+            {
+                for (auto* queue : *queues)
+                {
+                    if (queue == this)
+                        continue;
+
+                    if (waitsOnBinarySemaphore)
+                        queue->waitForSubmissionThread();
+                    else
+                        queue->waitForBinarySemaphoreWaits();
+                }
+            }
+        }
+
+        if (!m_submissionThread)
+        {
+            const result r = impl_submit(numDescs, descs, nullptr);
+            if (r != result::Success)
+                return r;
+
+            for (size_t d = 0; d < numDescs; d++)
+            {
+                if (descs[d].fence)
+                    descs[d].fence->m_signaled = true;
+            }
+
+            return result::Success;
+        }
+
+        // Fences are marked as signaled right away so that they can be waited on, waiting flushes the ring first
+        for (size_t d = 0; d < numDescs; d++)
+        {
+            if (descs[d].fence)
+            {
+                descs[d].fence->m_signaled = true;
+                descs[d].fence->m_submitQueue = this;
+                descs[d].fence->m_submitResult = result::Success;
+            }
+
+            const uint64_t position = enqueueSubmission(descs[d]);
+            if (descs[d].fence)
+                descs[d].fence->m_submitPosition = position;
+        }
+
+        return result::Success;
+    }
+
+    inline void Queue::startSubmissionThread()
+    {
+        m_submissionThread = std::make_unique<detail::submission_thread>();
+
+        // slot i is free for the enqueue position i
+        for (uint64_t i = 0; i < detail::submission_thread::ringSize; i++)
+            m_submissionThread->ring[i].sequence.store(i, std::memory_order_relaxed);
+
+        m_submissionThread->thread = std::thread(&Queue::runSubmissionThread, this);
+    }
+
+    inline void Queue::stopSubmissionThread()
+    {
+        if (!m_submissionThread)
+            return;
+
+        // the thread passes the remaining submissions to the driver before it exits
+        {
+            std::lock_guard<std::mutex> lock(m_submissionThread->mutex);
+            m_submissionThread->stopping = true;
+        }
+        m_submissionThread->wakeCondition.notify_one();
+
+        m_submissionThread->thread.join();
+        m_submissionThread.reset();
+    }
+
+    inline uint64_t Queue::enqueueSubmission(const submit_desc& desc)
+    {
+        auto& state = *m_submissionThread;
+        constexpr uint64_t ringSize = detail::submission_thread::ringSize;
+
+        // Queue::submit() is externally synchronized, so this is the only thread that reserves slots
+        // a slot is free once its sequence equals the position that it's reserved for, if it's still in use from the previous lap the ring is full
+        const uint64_t position = state.enqueuePosition.load(std::memory_order_relaxed);
+        detail::queued_submission* slot = &state.ring[position % ringSize];
+        while (slot->sequence.load(std::memory_order_acquire) != position)
+            std::this_thread::yield();
+        state.enqueuePosition.store(position + 1, std::memory_order_relaxed);
+
+        // the arrays are copied because the caller's arrays only have to remain valid until Queue::submit() returns
+        slot->commandLists.assign(desc.commandLists, desc.commandLists + desc.numCommandLists);
+        slot->desc = desc;
+        slot->desc.commandLists = slot->commandLists.data();
+
+        if (desc.waitSemaphores)
+        {
+            slot->waitSemaphores.assign(desc.waitSemaphores, desc.waitSemaphores + desc.numWaitSemaphores);
+            slot->desc.waitSemaphores = slot->waitSemaphores.data();
+        }
+
+        // binary Semaphores and Fences are resolved to the values that the implementation waits on and signals here, because the counters are shared with the other threads that submit and wait
+        // this follows the convention of the implementations: signaling a binary Semaphore or Fence increases its counter, and waits use the counter without modifying it
+        bool waitsOnBinarySemaphore = false;
+        if (desc.numWaitSemaphores > 0)
+        {
+            if (desc.waitSemaphoreValues)
+                slot->waitSemaphoreValues.assign(desc.waitSemaphoreValues, desc.waitSemaphoreValues + desc.numWaitSemaphores);
+            else
+                slot->waitSemaphoreValues.assign(desc.numWaitSemaphores, 0);
+
+            for (size_t i = 0; i < desc.numWaitSemaphores; i++)
+            {
+                if (desc.waitSemaphores[i]->m_type == semaphore_type::Binary)
+                {
+                    slot->waitSemaphoreValues[i] = desc.waitSemaphores[i]->m_counter;
+                    waitsOnBinarySemaphore = true;
+                }
+            }
+            slot->desc.waitSemaphoreValues = slot->waitSemaphoreValues.data();
+        }
+
+        if (desc.waitSemaphoreStages)
+        {
+            slot->waitSemaphoreStages.assign(desc.waitSemaphoreStages, desc.waitSemaphoreStages + desc.numWaitSemaphores);
+            slot->desc.waitSemaphoreStages = slot->waitSemaphoreStages.data();
+        }
+
+        if (desc.signalSemaphores)
+        {
+            slot->signalSemaphores.assign(desc.signalSemaphores, desc.signalSemaphores + desc.numSignalSemaphores);
+            slot->desc.signalSemaphores = slot->signalSemaphores.data();
+        }
+
+        if (desc.numSignalSemaphores > 0)
+        {
+            if (desc.signalSemaphoreValues)
+                slot->signalSemaphoreValues.assign(desc.signalSemaphoreValues, desc.signalSemaphoreValues + desc.numSignalSemaphores);
+            else
+                slot->signalSemaphoreValues.assign(desc.numSignalSemaphores, 0);
+
+            for (size_t i = 0; i < desc.numSignalSemaphores; i++)
+            {
+                if (desc.signalSemaphores[i]->m_type == semaphore_type::Binary)
+                    slot->signalSemaphoreValues[i] = ++desc.signalSemaphores[i]->m_counter;
+            }
+            slot->desc.signalSemaphoreValues = slot->signalSemaphoreValues.data();
+        }
+
+        slot->fenceValue = desc.fence ? ++desc.fence->m_counter : 0;
+
+        if (waitsOnBinarySemaphore)
+            state.binaryWaitPosition.store(position + 1, std::memory_order_relaxed);
+
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        // pairs with the fence in runSubmissionThread(), so that either the thread sees the slot before it sleeps, or this sees that it sleeps
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (state.sleeping.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.wakeCondition.notify_one();
+        }
+
+        return position;
+    }
+
+    inline void Queue::runSubmissionThread()
+    {
+        auto& state = *m_submissionThread;
+        constexpr uint64_t ringSize = detail::submission_thread::ringSize;
+
+        uint64_t position = 0;
+        while (true)
+        {
+            // all submissions that are ready are passed to the driver together, the implementation only splits them where a Fence is signaled
+            // batches on a single Queue start executing in submission order regardless, so this never changes the semantics of the submissions
+            state.batch.clear();
+            state.batchFenceValues.clear();
+            while (state.batch.size() < ringSize)
+            {
+                const uint64_t next = position + state.batch.size();
+                const auto& slot = state.ring[next % ringSize];
+                if (slot.sequence.load(std::memory_order_acquire) != next + 1)
+                    break;
+
+                state.batch.push_back(slot.desc);
+                state.batchFenceValues.push_back(slot.fenceValue);
+            }
+
+            if (state.batch.empty())
+            {
+                const auto& slot = state.ring[position % ringSize];
+                const auto ready = [&]() { return slot.sequence.load(std::memory_order_acquire) == position + 1; };
+
+                std::unique_lock<std::mutex> lock(state.mutex);
+                state.sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                state.wakeCondition.wait(lock, [&]() { return state.stopping || ready(); });
+                state.sleeping.store(false, std::memory_order_relaxed);
+
+                if (!ready())
+                    return;
+
+                continue;
+            }
+
+            const result r = impl_submit(static_cast<uint32_t>(state.batch.size()), state.batch.data(), state.batchFenceValues.data());
+            if (r != result::Success)
+            {
+                detail::apiError("Queue::submit()", r, "the submission thread failed to pass " + std::to_string(state.batch.size()) + " submission(s) to the driver.");
+
+                // it's unknown which of the batches reached the driver, so every Fence in them reports the error
+                for (const auto& desc : state.batch)
+                {
+                    if (desc.fence)
+                        desc.fence->m_submitResult = r;
+                }
+            }
+
+            // the slots are only freed after the submit because the batch points into their arrays
+            for (uint64_t i = 0; i < state.batch.size(); i++)
+                state.ring[(position + i) % ringSize].sequence.store(position + i + ringSize, std::memory_order_release);
+            position += state.batch.size();
+
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (r != result::Success && state.error == result::Success)
+                    state.error = r;
+
+                state.numProcessed.store(position, std::memory_order_release);
+            }
+            state.flushCondition.notify_all();
+        }
+    }
+
+    inline void Queue::waitForSubmissionThread()
+    {
+        if (!m_submissionThread)
+            return;
+
+        // slots that were reserved but aren't filled in yet are waited on as well, they're handed over shortly after
+        waitForSubmissionPosition(m_submissionThread->enqueuePosition.load(std::memory_order_acquire));
+    }
+
+    inline void Queue::waitForBinarySemaphoreWaits()
+    {
+        if (!m_submissionThread)
+            return;
+
+        waitForSubmissionPosition(m_submissionThread->binaryWaitPosition.load(std::memory_order_relaxed));
+    }
+
+    inline void Queue::waitForSubmissionPosition(uint64_t target)
+    {
+        auto& state = *m_submissionThread;
+        if (state.numProcessed.load(std::memory_order_acquire) >= target)
+            return;
+
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.flushCondition.wait(lock, [&]() { return state.numProcessed.load(std::memory_order_acquire) >= target; });
+    }
+
+    inline result Queue::flush()
+    {
+        if (!m_submissionThread)
+            return result::Success;
+
+        waitForSubmissionThread();
+
+        std::lock_guard<std::mutex> lock(m_submissionThread->mutex);
+        const result r = m_submissionThread->error;
+        m_submissionThread->error = result::Success;
+        return r;
     }
 
     inline result Queue::waitIdle()
     {
-        LLRI_DETAIL_CALL_IMPL(impl_waitIdle(), m_validationCallbackMessenger)
+        // the GPU can only go idle on the submissions that were passed to the driver
+        waitForSubmissionThread();
+
+        const result r = impl_waitIdle();
+        LLRI_DETAIL_POLL_API_MESSAGES(m_validationCallbackMessenger)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        if (r == result::Success)
+        {
+            for (auto& state : m_fenceSubmissionStates)
+                state->numCompleted = state->numSubmitted;
+        }
+#endif
+
+        return r;
     }
 }
@@ -0,0 +1,264 @@
+/**
+ * @file rendering.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    class Resource;
+
+    namespace detail
+    {
+        /**
+         * @brief The highest number of color attachments that LLRI supports in a single rendering scope, regardless of adapter_limits::maxColorAttachments.
+        */
+        constexpr uint32_t maxColorAttachments = 8;
+    }
+
+    /**
+     * @brief Describes what happens to the contents of an attachment at the start of CommandList::beginRendering().
+    */
+    enum struct attachment_load_op : uint8_t
+    {
+        /**
+         * @brief The previous contents of the attachment are preserved.
+        */
+        Load,
+        /**
+         * @brief The attachment is cleared to rendering_attachment_desc::clearValue.
+        */
+        Clear,
+        /**
+         * @brief The previous contents of the attachment are undefined and **may** be discarded.
+         * This is the cheapest option and **should** be used if every pixel in the render area is overwritten.
+        */
+        DontCare,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = DontCare
+    };
+
+    /**
+     * @brief Converts an attachment_load_op to a string.
+     * @return The enum value as a string, or "Invalid attachment_load_op value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(attachment_load_op op);
+
+    /**
+     * @brief Describes what happens to the contents of an attachment at CommandList::endRendering().
+    */
+    enum struct attachment_store_op : uint8_t
+    {
+        /**
+         * @brief The rendered contents are written to the attachment's memory.
+        */
+        Store,
+        /**
+         * @brief The rendered contents are not needed after rendering and **may** be discarded.
+         * Depth attachments that are only used during rendering **should** use DontCare, which allows tile-based GPUs to skip writing them back to memory.
+        */
+        DontCare,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = DontCare
+    };
+
+    /**
+     * @brief Converts an attachment_store_op to a string.
+     * @return The enum value as a string, or "Invalid attachment_store_op value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(attachment_store_op op);
+
+    /**
+     * @brief The value that a color attachment is cleared to.
+    */
+    struct clear_color_value
+    {
+        float r;
+        float g;
+        float b;
+        float a;
+    };
+
+    /**
+     * @brief The values that a depth stencil attachment is cleared to.
+    */
+    struct clear_depth_stencil_value
+    {
+        float depth;
+        uint8_t stencil;
+    };
+
+    /**
+     * @brief The value that an attachment is cleared to, which is interpreted as color or depthStencil depending on the attachment.
+    */
+    union clear_value
+    {
+        clear_color_value color;
+        clear_depth_stencil_value depthStencil;
+    };
+
+    /**
+     * @brief Describes a texture that is rendered to between CommandList::beginRendering() and CommandList::endRendering().
+     * Rendering always targets the first mip level and array layer of the texture.
+    */
+    struct rendering_attachment_desc
+    {
+        /**
+         * @brief The texture that is rendered to.
+         *
+         * @note Valid usage (ErrorInvalidUsage): texture **must** be a valid non-null pointer to a Resource with resource_type::Texture2D.
+         * @note Valid usage (ErrorInvalidUsage): texture **must** have been created with resource_usage_flag_bits::ColorAttachment if it's used as a color attachment, or resource_usage_flag_bits::DepthStencilAttachment if it's used as a depth stencil attachment.
+         * @note Valid usage: texture **must** be in the resource_state::ColorAttachment or resource_state::DepthStencilAttachment state respectively.
+        */
+        Resource* texture;
+        /**
+         * @brief What happens to the attachment's contents at the start of rendering. For depth stencil attachments this applies to both depth and stencil.
+         * @note Valid usage (ErrorInvalidUsage): loadOp **must** be less or equal to attachment_load_op::MaxEnum.
+        */
+        attachment_load_op loadOp;
+        /**
+         * @brief What happens to the attachment's contents at the end of rendering. For depth stencil attachments this applies to both depth and stencil.
+         * @note Valid usage (ErrorInvalidUsage): storeOp **must** be less or equal to attachment_store_op::MaxEnum.
+        */
+        attachment_store_op storeOp;
+        /**
+         * @brief The value that the attachment is cleared to if loadOp is attachment_load_op::Clear.
+        */
+        clear_value clearValue;
+    };
+
+    /**
+     * @brief Describes how the commands inside of a rendering scope are recorded.
+    */
+    enum struct rendering_contents : uint8_t
+    {
+        /**
+         * @brief Commands are recorded directly into the CommandList that started the rendering scope.
+        */
+        Inline,
+        /**
+         * @brief The rendering scope only executes Indirect CommandLists through CommandList::executeIndirectLists(). Other commands **can not** be recorded in the scope.
+        */
+        IndirectLists,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = IndirectLists
+    };
+
+    /**
+     * @brief Converts a rendering_contents to a string.
+     * @return The enum value as a string, or "Invalid rendering_contents value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(rendering_contents contents);
+
+    /**
+     * @brief Describes the attachments and area of a rendering scope started with CommandList::beginRendering().
+    */
+    struct rendering_desc
+    {
+        /**
+         * @brief The area of the attachments that is rendered to. The viewport and scissor are initialized to this area.
+         *
+         * @note Valid usage (ErrorInvalidUsage): area.extent.width and area.extent.height **must** be more than 0, area.offset **must not** be negative, and the area **must** fit within the dimensions of every attachment.
+        */
+        rect_2d area;
+
+        /**
+         * @brief The number of color attachments.
+         * @note Valid usage (ErrorExceededLimit): numColorAttachments **must** be less than or equal to adapter_limits::maxColorAttachments.
+        */
+        uint32_t numColorAttachments;
+        /**
+         * @brief An array of color attachments, which are written to by the fragment shader's outputs in order.
+         * @note Valid usage (ErrorInvalidUsage): If numColorAttachments is more than 0, colorAttachments **must** be a valid non-null pointer to an array of numColorAttachments elements.
+        */
+        const rendering_attachment_desc* colorAttachments;
+        /**
+         * @brief The depth stencil attachment, or nullptr if no depth stencil attachment is used.
+         * @note Valid usage (ErrorInvalidUsage): At least one color or depth stencil attachment **must** be used.
+        */
+        const rendering_attachment_desc* depthStencilAttachment;
+
+        /**
+         * @brief Describes if the scope's commands are recorded inline or through Indirect CommandLists.
+         * @note Valid usage (ErrorInvalidUsage): contents **must** be less or equal to rendering_contents::MaxEnum.
+        */
+        rendering_contents contents;
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief The attachment formats and sample count of a rendering scope. Indirect CommandLists can only be executed in rendering scopes with an identical layout.
+        */
+        struct rendering_layout
+        {
+            uint32_t numColorAttachments;
+            std::array<format, maxColorAttachments> colorFormats;
+            format depthStencilFormat;
+            sample_count sampleCount;
+
+            bool operator==(const rendering_layout& other) const
+            {
+                if (numColorAttachments != other.numColorAttachments || depthStencilFormat != other.depthStencilFormat || sampleCount != other.sampleCount)
+                    return false;
+
+                for (uint32_t i = 0; i < numColorAttachments; i++)
+                {
+                    if (colorFormats[i] != other.colorFormats[i])
+                        return false;
+                }
+
+                return true;
+            }
+
+            bool operator!=(const rendering_layout& other) const { return !(*this == other); }
+        };
+    }
+
+    /**
+     * @brief Describes the transformation from normalized device coordinates to attachment coordinates.
+    */
+    struct viewport
+    {
+        float x;
+        float y;
+        float width;
+        float height;
+        float minDepth;
+        float maxDepth;
+    };
+
+    /**
+     * @brief Describes the size of the indices in an index buffer.
+    */
+    enum struct index_type : uint8_t
+    {
+        /**
+         * @brief Indices are 16-bit unsigned integers.
+        */
+        UInt16,
+        /**
+         * @brief Indices are 32-bit unsigned integers.
+        */
+        UInt32,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = UInt32
+    };
+
+    /**
+     * @brief Converts an index_type to a string.
+     * @return The enum value as a string, or "Invalid index_type value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(index_type type);
+}
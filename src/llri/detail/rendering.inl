@@ -0,0 +1,65 @@
+/**
+ * @file rendering.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    inline std::string to_string(attachment_load_op op)
+    {
+        switch(op)
+        {
+            case attachment_load_op::Load:
+                return "Load";
+            case attachment_load_op::Clear:
+                return "Clear";
+            case attachment_load_op::DontCare:
+                return "DontCare";
+        }
+
+        return "Invalid attachment_load_op value";
+    }
+
+    inline std::string to_string(attachment_store_op op)
+    {
+        switch(op)
+        {
+            case attachment_store_op::Store:
+                return "Store";
+            case attachment_store_op::DontCare:
+                return "DontCare";
+        }
+
+        return "Invalid attachment_store_op value";
+    }
+
+    inline std::string to_string(rendering_contents contents)
+    {
+        switch(contents)
+        {
+            case rendering_contents::Inline:
+                return "Inline";
+            case rendering_contents::IndirectLists:
+                return "IndirectLists";
+        }
+
+        return "Invalid rendering_contents value";
+    }
+
+    inline std::string to_string(index_type type)
+    {
+        switch(type)
+        {
+            case index_type::UInt16:
+                return "UInt16";
+            case index_type::UInt32:
+                return "UInt32";
+        }
+
+        return "Invalid index_type value";
+    }
+}
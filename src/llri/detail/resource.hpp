@@ -447,6 +447,34 @@ namespace llri
     */
     std::string to_string(memory_type type);
 
+    /**
+     * @brief Describes how a resource is shared between the queue_types of a Device.
+    */
+    enum struct resource_sharing_mode : uint8_t
+    {
+        /**
+         * @brief The resource **may** be accessed by Queues of every queue_type without transferring ownership.
+        */
+        Concurrent,
+        /**
+         * @brief The resource is owned by one queue_type at a time, which is the queue_type of the first CommandList that accesses it.
+         * Before a Queue of another queue_type accesses the resource, ownership **must** be released by a queue_ownership_transfer::Release barrier on the owning queue_type, and acquired by a matching queue_ownership_transfer::Acquire barrier on the new queue_type.
+         *
+         * Exclusive resources **may** perform better, for example because some Adapters only compress textures that are owned by one queue_type.
+        */
+        Exclusive,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Exclusive
+    };
+
+    /**
+     * @brief Converts a resource_sharing_mode to a string.
+     * @return The enum value as a string, or "Invalid resource_sharing_mode value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(resource_sharing_mode mode);
+
     /**
      * @brief Resource description to be used in Device::createResource().
     */
@@ -460,6 +488,7 @@ namespace llri
         uint32_t createNodeMask;
         /**
          * @brief A mask with the device nodes on which the resource will be visible. Passing 0 is the equivalent of passing 1.
+         * The memory of the resource only exists on the node in createNodeMask, other visible nodes access it as peer memory, see Device::queryPeerMemoryFeatures().
          *
          * @note Valid usage (ErrorInvalidNodeMask): At least the same bit as createNodeMask **must** be set.
          * @note Valid usage (ErrorInvalidNodeMask): Any bits set to 1 in visibleNodeMask **must** be less than 1 << Adapter::queryNodeCount().
@@ -557,16 +586,24 @@ namespace llri
         */
         format textureFormat;
 
+        /**
+         * @brief Determines if the resource is shared by all queue_types, or if ownership **must** be transferred between them explicitly.
+         *
+         * @note Valid usage (ErrorInvalidUsage): sharingMode **must** be a valid resource_sharing_mode enum value.
+        */
+        resource_sharing_mode sharingMode;
+
         /**
          * @brief Convenience function for creating a buffer resource_desc.
         */
-        static constexpr resource_desc buffer(resource_usage_flags usage, memory_type memoryType, resource_state initialState, uint32_t sizeInBytes, uint32_t createNodeMask = 0, uint32_t visibleNodeMask = 0) noexcept;
+        static constexpr resource_desc buffer(resource_usage_flags usage, memory_type memoryType, resource_state initialState, uint32_t sizeInBytes, uint32_t createNodeMask = 0, uint32_t visibleNodeMask = 0, resource_sharing_mode sharingMode = resource_sharing_mode::Concurrent) noexcept;
     };
 
     class Resource
     {
         friend class Device;
         friend class CommandList;
+        friend class Queue;
 
     public:
         using native_resource = void;
@@ -584,6 +621,20 @@ namespace llri
          * Vulkan: VkImage OR VkBuffer depending on getDesc()::type
          */
         [[nodiscard]] native_resource* getNative() const;
+
+        /**
+         * @brief Set the name of the Resource and its memory, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
         
         /**
          * @brief Gets the native memory pointer, which depending on the llri::getImplementation() is a pointer to the following:
@@ -592,6 +643,21 @@ namespace llri
          * Vulkan: VkDeviceMemory
          */
         [[nodiscard]] native_memory* getNativeMemory() const;
+
+        /**
+         * @brief Query the state that resource state tracking has tracked a subresource in, which is the state that the CommandLists that were successfully submitted so far leave it in.
+         *
+         * @param mipLevel The mip level of the subresource, which **must** be 0 for buffers.
+         * @param arrayLayer The array layer of the subresource, which **must** be 0 for buffers and 3D textures.
+         * @param state A pointer to the resulting state.
+         *
+         * @note Valid usage (ErrorInvalidUsage): state **must** be a valid non-null pointer.
+         * @note Valid usage (ErrorInvalidState): device_desc::resourceStateTracking **must** have been enabled on the Device that created the Resource.
+         * @note Valid usage (ErrorInvalidUsage): mipLevel **must** be less than resource_desc::mipLevels, and arrayLayer **must** be less than resource_desc::depthOrArrayLayers.
+         *
+         * @return Success upon correct execution of the operation.
+        */
+        result queryTrackedState(uint32_t mipLevel, uint32_t arrayLayer, resource_state* state) const;
     private:
         // Force private constructor/deconstructor so that only create/destroy can manage lifetime
         Resource() = default;
@@ -601,5 +667,18 @@ namespace llri
         
         native_memory* m_memory = nullptr;
         native_resource* m_resource = nullptr;
+        Device* m_device = nullptr;
+
+        // the view that is used when the texture is rendered to, only present for textures with ColorAttachment or DepthStencilAttachment usage
+        // Vulkan: VkImageView, DirectX12: ID3D12DescriptorHeap* with a single RTV or DSV
+        void* m_attachmentView = nullptr;
+
+        // Vulkan: the VkImageAspectFlags of the texture's format, cached so that resource barriers don't need to inspect the format
+        uint32_t m_imageAspects = 0;
+
+        // the state of each subresource after all submitted CommandLists, only used if device_desc::resourceStateTracking is enabled
+        std::vector<resource_state> m_trackedStates;
+
+        result impl_setName(const char* name);
     };
 }
@@ -262,6 +262,19 @@ namespace llri
         return "Invalid memory_type value";
     }
 
+    inline std::string to_string(resource_sharing_mode mode)
+    {
+        switch(mode)
+        {
+            case resource_sharing_mode::Concurrent:
+                return "Concurrent";
+            case resource_sharing_mode::Exclusive:
+                return "Exclusive";
+        }
+
+        return "Invalid resource_sharing_mode value";
+    }
+
     inline resource_desc Resource::getDesc() const
     {
         return m_desc;
@@ -272,12 +285,42 @@ namespace llri
         return m_resource;
     }
 
+    inline result Resource::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_device->m_validationCallbackMessenger)
+#endif
+    }
+
     inline Resource::native_memory* Resource::getNativeMemory() const
     {
         return m_memory;
     }
 
-    constexpr resource_desc resource_desc::buffer(resource_usage_flags usage, memory_type memoryType, resource_state initialState, uint32_t sizeInBytes, uint32_t createNodeMask, uint32_t visibleNodeMask) noexcept
+    inline result Resource::queryTrackedState(uint32_t mipLevel, uint32_t arrayLayer, resource_state* state) const
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(state != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_device->m_desc.resourceStateTracking, result::ErrorInvalidState)
+
+#ifdef LLRI_DETAIL_ENABLE_VALIDATION
+        const uint32_t numMipLevels = m_desc.type == resource_type::Buffer ? 1 : m_desc.mipLevels;
+        const uint32_t numArrayLayers = m_desc.type == resource_type::Buffer || m_desc.type == resource_type::Texture3D ? 1 : m_desc.depthOrArrayLayers;
+        LLRI_DETAIL_VALIDATION_REQUIRE(mipLevel < numMipLevels, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(arrayLayer < numArrayLayers, result::ErrorInvalidUsage)
+#endif
+
+        *state = m_trackedStates[m_desc.type == resource_type::Buffer ? 0 : mipLevel + arrayLayer * m_desc.mipLevels];
+        return result::Success;
+    }
+
+    constexpr resource_desc resource_desc::buffer(resource_usage_flags usage, memory_type memoryType, resource_state initialState, uint32_t sizeInBytes, uint32_t createNodeMask, uint32_t visibleNodeMask, resource_sharing_mode sharingMode) noexcept
     {
         return {
             createNodeMask, visibleNodeMask,
@@ -285,7 +328,8 @@ namespace llri
             usage, memoryType, initialState,
             sizeInBytes, // width = size
             1, 1, 1, // texture sizes defaulted to 1
-            sample_count::Count1, format::Undefined // these parameters are ignored but we set them to reasonable defaults
+            sample_count::Count1, format::Undefined, // these parameters are ignored but we set them to reasonable defaults
+            sharingMode
         };
     }
 }
@@ -49,6 +49,234 @@ namespace llri
         return "Invalid resource_barrier_type value";
     }
 
+    /**
+     * @brief Pipeline stage flag bits describe the stages of the pipeline that access a resource before or after a resource_barrier.
+     * Narrowing the stages down allows the Adapter to overlap unrelated work with the barrier, instead of waiting for all work to complete.
+    */
+    enum struct pipeline_stage_flag_bits : uint32_t
+    {
+        /**
+         * @brief No stages are specified explicitly, the stages are derived from the resource states that the barrier applies to.
+        */
+        None = 0,
+        /**
+         * @brief The stage where vertex and index buffers are consumed.
+        */
+        VertexInput = 1 << 0,
+        /**
+         * @brief The vertex shader stage.
+        */
+        VertexShader = 1 << 1,
+        /**
+         * @brief The fragment shader stage.
+        */
+        FragmentShader = 1 << 2,
+        /**
+         * @brief The stages where depth and stencil tests are performed and depth stencil attachments are read and written.
+        */
+        DepthStencilAttachment = 1 << 3,
+        /**
+         * @brief The stage where color attachments are read and written.
+        */
+        ColorAttachment = 1 << 4,
+        /**
+         * @brief The compute shader stage.
+        */
+        ComputeShader = 1 << 5,
+        /**
+         * @brief The stage where transfer operations are executed.
+        */
+        Transfer = 1 << 6,
+        /**
+         * @brief Access by the CPU to mapped memory.
+        */
+        Host = 1 << 7,
+        /**
+         * @brief All graphics stages.
+        */
+        AllGraphics = VertexInput | VertexShader | FragmentShader | DepthStencilAttachment | ColorAttachment,
+        /**
+         * @brief All stages.
+        */
+        All = AllGraphics | ComputeShader | Transfer | Host
+    };
+    LLRI_DEFINE_FLAG_BIT_OPERATORS(pipeline_stage_flag_bits)
+
+    /**
+     * @brief Pipeline stage flags describe the stages of the pipeline that access a resource before or after a resource_barrier.
+     * pipeline_stage_flags are created by combining one or more pipeline_stage_flag_bits.
+    */
+    using pipeline_stage_flags = flags<pipeline_stage_flag_bits>;
+
+    /**
+     * @brief Converts pipeline_stage_flags to a string.
+     * @return The flags as a string, or "Invalid pipeline_stage_flags value" if the value was not recognized as a valid combination of pipeline_stage_flag_bits.
+    */
+    inline std::string to_string(pipeline_stage_flags flags);
+
+    /**
+     * @brief Converts a pipeline_stage_flag_bits to a string.
+     * @return The enum value as a string, or "Invalid pipeline_stage_flag_bits value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(pipeline_stage_flag_bits bits)
+    {
+        switch(bits)
+        {
+            case pipeline_stage_flag_bits::None:
+                return "None";
+            case pipeline_stage_flag_bits::VertexInput:
+                return "VertexInput";
+            case pipeline_stage_flag_bits::VertexShader:
+                return "VertexShader";
+            case pipeline_stage_flag_bits::FragmentShader:
+                return "FragmentShader";
+            case pipeline_stage_flag_bits::DepthStencilAttachment:
+                return "DepthStencilAttachment";
+            case pipeline_stage_flag_bits::ColorAttachment:
+                return "ColorAttachment";
+            case pipeline_stage_flag_bits::ComputeShader:
+                return "ComputeShader";
+            case pipeline_stage_flag_bits::Transfer:
+                return "Transfer";
+            case pipeline_stage_flag_bits::Host:
+                return "Host";
+            case pipeline_stage_flag_bits::AllGraphics:
+            case pipeline_stage_flag_bits::All:
+                return to_string(static_cast<pipeline_stage_flags>(bits));
+        }
+
+        return "Invalid pipeline_stage_flag_bits value";
+    }
+
+    inline std::string to_string(pipeline_stage_flags flags)
+    {
+        std::string out;
+
+        constexpr std::array<pipeline_stage_flag_bits, 8> allBits = {
+            pipeline_stage_flag_bits::VertexInput,
+            pipeline_stage_flag_bits::VertexShader,
+            pipeline_stage_flag_bits::FragmentShader,
+            pipeline_stage_flag_bits::DepthStencilAttachment,
+            pipeline_stage_flag_bits::ColorAttachment,
+            pipeline_stage_flag_bits::ComputeShader,
+            pipeline_stage_flag_bits::Transfer,
+            pipeline_stage_flag_bits::Host
+        };
+
+        for (auto elem : allBits)
+        {
+            if (flags.contains(elem))
+            {
+                out += " | " + to_string(elem);
+                flags.remove(elem);
+            }
+        }
+
+        // all flags should've been covered and removed
+        if (flags != pipeline_stage_flag_bits::None)
+            return "Invalid pipeline_stage_flags value";
+
+        // remove excessive initial " | "
+        if (!out.empty() && out[0] == ' ' && out[1] == '|' && out[2] == ' ')
+            out = out.substr(3);
+
+        return out;
+    }
+
+    /**
+     * @brief Describes if a resource_barrier is executed at once, or if it's split into a begin and an end barrier.
+     *
+     * Split barriers allow a transition to begin as soon as the last operation that accessed the resource in the old state has been recorded, and to end right before the first operation that accesses the resource in the new state.
+     * The Adapter **may** then overlap the transition with the unrelated work that is recorded in between.
+    */
+    enum struct resource_barrier_split : uint8_t
+    {
+        /**
+         * @brief The barrier is executed at once.
+        */
+        None,
+        /**
+         * @brief The barrier begins the transition. The resource **must not** be accessed until the transition is ended by a barrier with resource_barrier_split::EndOnly.
+        */
+        BeginOnly,
+        /**
+         * @brief The barrier ends a transition that was begun by a barrier with resource_barrier_split::BeginOnly.
+        */
+        EndOnly,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = EndOnly
+    };
+
+    /**
+     * @brief Converts a resource_barrier_split to a string.
+     * @return The enum value as a string, or "Invalid resource_barrier_split value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(resource_barrier_split split)
+    {
+        switch(split)
+        {
+            case resource_barrier_split::None:
+                return "None";
+            case resource_barrier_split::BeginOnly:
+                return "BeginOnly";
+            case resource_barrier_split::EndOnly:
+                return "EndOnly";
+            default:
+                break;
+        }
+
+        return "Invalid resource_barrier_split value";
+    }
+
+    /**
+     * @brief Describes if a resource_barrier transfers ownership of a resource_sharing_mode::Exclusive resource between queue_types.
+     *
+     * A transfer consists of a Release barrier that is recorded in a CommandList of the owning queue_type, and an Acquire barrier with the same resource, states and subresource range that is recorded in a CommandList of the new queue_type.
+     * The Acquire barrier **must** be submitted after the Release barrier, and **must** wait for it through a Semaphore.
+    */
+    enum struct queue_ownership_transfer : uint8_t
+    {
+        /**
+         * @brief The barrier doesn't transfer ownership.
+        */
+        None,
+        /**
+         * @brief The barrier releases ownership to resource_barrier::ownershipQueue. Accesses after the barrier don't wait for it, resource_barrier::dstStages is ignored.
+        */
+        Release,
+        /**
+         * @brief The barrier acquires ownership from resource_barrier::ownershipQueue. The barrier doesn't wait for accesses before it, resource_barrier::srcStages is ignored.
+        */
+        Acquire,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Acquire
+    };
+
+    /**
+     * @brief Converts a queue_ownership_transfer to a string.
+     * @return The enum value as a string, or "Invalid queue_ownership_transfer value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(queue_ownership_transfer transfer)
+    {
+        switch(transfer)
+        {
+            case queue_ownership_transfer::None:
+                return "None";
+            case queue_ownership_transfer::Release:
+                return "Release";
+            case queue_ownership_transfer::Acquire:
+                return "Acquire";
+            default:
+                break;
+        }
+
+        return "Invalid queue_ownership_transfer value";
+    }
+
     /**
      * @brief Transitions a resource from one state to another. Operations and memory dependencies on the resource are handled properly according to the transition.
      */
@@ -71,7 +299,7 @@ namespace llri
          *
          * @note Valid usage (ErrorInvalidUsage): newState **must not** be more than resource_state::MaxEnum.
          * @note Valid usage (ErrorInvalidState): the conditions described in the resource_state **must** be met.
-         * @note Valid usage (ErrorInvalidUsage): newState **must not** be the same as oldState.
+         * @note Valid usage (ErrorInvalidUsage): newState **must not** be the same as oldState, unless the barrier transfers ownership.
         */
         resource_state newState;
         
@@ -111,21 +339,306 @@ namespace llri
             resource_barrier_read_write rw;
             resource_barrier_transition trans;
         };
+
+        /**
+         * @brief The pipeline stages that **must** complete their access to the resource before the barrier executes.
+         * If this is pipeline_stage_flag_bits::None, the stages are derived from resource_barrier_transition::oldState, or from resource_state::ShaderReadWrite for ReadWrite barriers.
+         *
+         * @note Valid usage (ErrorInvalidUsage): srcStages **must** be a valid combination of pipeline_stage_flag_bits.
+         * @note Valid usage (ErrorInvalidUsage): srcStages **must** only contain stages that are supported by the CommandList's queue_type. Compute CommandLists support ComputeShader, Transfer and Host, and Transfer CommandLists support Transfer and Host.
+        */
+        pipeline_stage_flags srcStages;
+        /**
+         * @brief The pipeline stages that wait for the barrier before they access the resource.
+         * If this is pipeline_stage_flag_bits::None, the stages are derived from resource_barrier_transition::newState, or from resource_state::ShaderReadWrite for ReadWrite barriers.
+         *
+         * @note Valid usage (ErrorInvalidUsage): dstStages **must** be a valid combination of pipeline_stage_flag_bits.
+         * @note Valid usage (ErrorInvalidUsage): dstStages **must** only contain stages that are supported by the CommandList's queue_type.
+        */
+        pipeline_stage_flags dstStages;
+
+        /**
+         * @brief Describes if the barrier is executed at once, or if it begins or ends a split barrier.
+         *
+         * @note Valid usage (ErrorInvalidUsage): split **must** be less or equal to resource_barrier_split::MaxEnum.
+         * @note Valid usage (ErrorInvalidUsage): If split isn't resource_barrier_split::None, type **must** be resource_barrier_type::Transition.
+         * @note Valid usage (ErrorInvalidState): If split isn't resource_barrier_split::None, the CommandList **must not** be inside of a rendering scope.
+         * @note Valid usage (ErrorInvalidState): If split is resource_barrier_split::BeginOnly, the resource **must not** have another split barrier that has begun but not ended in the CommandList.
+         * @note Valid usage (ErrorInvalidState): If split is resource_barrier_split::EndOnly, an earlier CommandList::resourceBarrier() call in the same CommandList **must** have begun a split barrier with the same resource, states, subresource range and stages, which hasn't been ended yet.
+        */
+        resource_barrier_split split;
+
+        /**
+         * @brief Describes if the barrier releases or acquires ownership of a resource_sharing_mode::Exclusive resource.
+         *
+         * @note Valid usage (ErrorInvalidUsage): ownershipTransfer **must** be less or equal to queue_ownership_transfer::MaxEnum.
+         * @note Valid usage (ErrorInvalidUsage): If ownershipTransfer isn't queue_ownership_transfer::None, type **must** be resource_barrier_type::Transition and split **must** be resource_barrier_split::None.
+         * @note Valid usage (ErrorInvalidUsage): If ownershipTransfer isn't queue_ownership_transfer::None, the resource **must** have been created with resource_sharing_mode::Exclusive.
+        */
+        queue_ownership_transfer ownershipTransfer;
+        /**
+         * @brief The queue_type that ownership is released to, or acquired from. Ignored if ownershipTransfer is queue_ownership_transfer::None.
+         *
+         * @note Valid usage (ErrorInvalidUsage): If ownershipTransfer isn't queue_ownership_transfer::None, ownershipQueue **must** be less or equal to queue_type::MaxEnum.
+        */
+        queue_type ownershipQueue;
         
-        static resource_barrier read_write(Resource* resource)
+        static resource_barrier read_write(Resource* resource, pipeline_stage_flags srcStages = pipeline_stage_flag_bits::None, pipeline_stage_flags dstStages = pipeline_stage_flag_bits::None)
         {
             resource_barrier barrier {};
             barrier.type = resource_barrier_type::ReadWrite;
             barrier.rw = resource_barrier_read_write { resource };
+            barrier.srcStages = srcStages;
+            barrier.dstStages = dstStages;
             return barrier;
         }
         
-        static resource_barrier transition(Resource* resource, resource_state oldState, resource_state newState, texture_subresource_range range = texture_subresource_range::all())
+        static resource_barrier transition(Resource* resource, resource_state oldState, resource_state newState, texture_subresource_range range = texture_subresource_range::all(), pipeline_stage_flags srcStages = pipeline_stage_flag_bits::None, pipeline_stage_flags dstStages = pipeline_stage_flag_bits::None)
         {
             resource_barrier barrier {};
             barrier.type = resource_barrier_type::Transition;
             barrier.trans = resource_barrier_transition { resource, oldState, newState, range };
+            barrier.srcStages = srcStages;
+            barrier.dstStages = dstStages;
+            return barrier;
+        }
+
+        static resource_barrier begin_transition(Resource* resource, resource_state oldState, resource_state newState, texture_subresource_range range = texture_subresource_range::all(), pipeline_stage_flags srcStages = pipeline_stage_flag_bits::None, pipeline_stage_flags dstStages = pipeline_stage_flag_bits::None)
+        {
+            resource_barrier barrier = transition(resource, oldState, newState, range, srcStages, dstStages);
+            barrier.split = resource_barrier_split::BeginOnly;
+            return barrier;
+        }
+
+        static resource_barrier end_transition(Resource* resource, resource_state oldState, resource_state newState, texture_subresource_range range = texture_subresource_range::all(), pipeline_stage_flags srcStages = pipeline_stage_flag_bits::None, pipeline_stage_flags dstStages = pipeline_stage_flag_bits::None)
+        {
+            resource_barrier barrier = transition(resource, oldState, newState, range, srcStages, dstStages);
+            barrier.split = resource_barrier_split::EndOnly;
+            return barrier;
+        }
+
+        static resource_barrier release(Resource* resource, resource_state oldState, resource_state newState, queue_type dstQueue, texture_subresource_range range = texture_subresource_range::all(), pipeline_stage_flags srcStages = pipeline_stage_flag_bits::None)
+        {
+            resource_barrier barrier = transition(resource, oldState, newState, range, srcStages);
+            barrier.ownershipTransfer = queue_ownership_transfer::Release;
+            barrier.ownershipQueue = dstQueue;
+            return barrier;
+        }
+
+        static resource_barrier acquire(Resource* resource, resource_state oldState, resource_state newState, queue_type srcQueue, texture_subresource_range range = texture_subresource_range::all(), pipeline_stage_flags dstStages = pipeline_stage_flag_bits::None)
+        {
+            resource_barrier barrier = transition(resource, oldState, newState, range, pipeline_stage_flag_bits::None, dstStages);
+            barrier.ownershipTransfer = queue_ownership_transfer::Acquire;
+            barrier.ownershipQueue = srcQueue;
             return barrier;
         }
     };
+
+    namespace detail
+    {
+        /**
+         * @brief A split barrier that has begun but not ended yet.
+        */
+        struct split_barrier
+        {
+            resource_barrier barrier;
+
+            // Vulkan: the VkEvent that is set when the barrier begins and waited upon when it ends
+            void* event;
+        };
+
+        /**
+         * @brief Returns true if the state transition of an ownership transfer is executed by its barrier on a queue of the given type, for implementations that don't transfer ownership between the two queue types.
+         * The transition is then executed once, by the more capable queue type, which is the Release barrier if both types are the same.
+        */
+        inline bool executesOwnershipTransition(const resource_barrier& barrier, queue_type type)
+        {
+            return barrier.ownershipTransfer == queue_ownership_transfer::Release ? type <= barrier.ownershipQueue : type < barrier.ownershipQueue;
+        }
+
+        /**
+         * @brief Returns true if the transitions of both barriers are the same, which is required for the end of a split barrier to match its begin.
+        */
+        inline bool isSameTransition(const resource_barrier& lhs, const resource_barrier& rhs)
+        {
+            return lhs.trans.resource == rhs.trans.resource &&
+                lhs.trans.oldState == rhs.trans.oldState && lhs.trans.newState == rhs.trans.newState &&
+                lhs.trans.subresourceRange == rhs.trans.subresourceRange &&
+                lhs.srcStages == rhs.srcStages && lhs.dstStages == rhs.dstStages;
+        }
+
+        /**
+         * @brief Returns true if range is texture_subresource_range::all() or a valid range of the texture's subresources. Ranges are ignored for buffers.
+        */
+        inline bool isValidSubresourceRange(const resource_desc& desc, const texture_subresource_range& range)
+        {
+            if (desc.type == resource_type::Buffer || range == texture_subresource_range::all())
+                return true;
+
+            if (range.baseMipLevel >= desc.mipLevels || range.numMipLevels == 0 || range.baseMipLevel + range.numMipLevels > desc.mipLevels)
+                return false;
+
+            if (range.baseArrayLayer >= desc.depthOrArrayLayers)
+                return false;
+
+            if (desc.type == resource_type::Texture3D)
+                return range.baseArrayLayer == 0 && range.numArrayLayers == 1;
+
+            return range.numArrayLayers > 0 && range.baseArrayLayer + range.numArrayLayers <= desc.depthOrArrayLayers;
+        }
+
+        /**
+         * @brief Returns true if a resource with the given desc can be transitioned into state, as described in resource_state.
+        */
+        inline bool supportsResourceState(const resource_desc& desc, resource_state state)
+        {
+            switch (state)
+            {
+                case resource_state::General:
+                    return true;
+                case resource_state::Upload:
+                    return desc.memoryType == memory_type::Upload;
+                case resource_state::ColorAttachment:
+                    return desc.usage.contains(resource_usage_flag_bits::ColorAttachment);
+                case resource_state::DepthStencilAttachment:
+                case resource_state::DepthStencilAttachmentReadOnly:
+                    return desc.usage.contains(resource_usage_flag_bits::DepthStencilAttachment);
+                case resource_state::ShaderReadOnly:
+                    return desc.type == resource_type::Buffer || desc.usage.contains(resource_usage_flag_bits::Sampled);
+                case resource_state::ShaderReadWrite:
+                    return desc.usage.contains(resource_usage_flag_bits::ShaderWrite);
+                case resource_state::TransferSrc:
+                    return desc.usage.contains(resource_usage_flag_bits::TransferSrc);
+                case resource_state::TransferDst:
+                    return desc.usage.contains(resource_usage_flag_bits::TransferDst);
+                case resource_state::VertexBuffer:
+                case resource_state::IndexBuffer:
+                case resource_state::ConstantBuffer:
+                    return desc.type == resource_type::Buffer;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Placeholder for subresources whose state isn't known (yet) by resource state tracking.
+        */
+        constexpr resource_state unknownResourceState = static_cast<resource_state>(std::numeric_limits<uint8_t>::max());
+
+        /**
+         * @brief Placeholder for subresources that don't have a pending transition in resource_state_tracker::pendingTransitions.
+        */
+        constexpr uint32_t noPendingTransition = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @brief Returns the number of subresources whose states are tracked separately. Buffers consist of a single subresource, textures of a subresource for each mip level in each array layer.
+        */
+        inline uint32_t subresourceCount(const resource_desc& desc)
+        {
+            if (desc.type == resource_type::Buffer)
+                return 1;
+
+            const uint32_t numLayers = desc.type == resource_type::Texture3D ? 1 : desc.depthOrArrayLayers;
+            return desc.mipLevels * numLayers;
+        }
+
+        /**
+         * @brief Calls function with the index of each subresource in range. Subresources are indexed as mipLevel + arrayLayer * resource_desc::mipLevels.
+        */
+        template<typename Func>
+        void forEachSubresource(const resource_desc& desc, const texture_subresource_range& range, Func&& function)
+        {
+            if (desc.type == resource_type::Buffer || range == texture_subresource_range::all())
+            {
+                const uint32_t count = subresourceCount(desc);
+                for (uint32_t i = 0; i < count; i++)
+                    function(i);
+                return;
+            }
+
+            for (uint32_t layer = range.baseArrayLayer; layer < range.baseArrayLayer + range.numArrayLayers; layer++)
+            {
+                for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + range.numMipLevels; mip++)
+                    function(mip + layer * desc.mipLevels);
+            }
+        }
+
+        /**
+         * @brief The tracked states of a Resource's subresources within a single CommandList.
+        */
+        struct resource_state_tracker
+        {
+            // the state that each subresource must be in when the CommandList starts executing, or unknownResourceState if the CommandList doesn't use it
+            std::vector<resource_state> firstStates;
+            // the state that each subresource is in after the commands that have been recorded so far
+            std::vector<resource_state> currentStates;
+            // the index of each subresource's transition in the CommandList's pending transitions, or noPendingTransition if it has none
+            std::vector<uint32_t> pendingTransitions;
+        };
+
+        /**
+         * @brief A transition of a single subresource that hasn't been recorded yet.
+        */
+        struct pending_transition
+        {
+            Resource* resource;
+            uint32_t subresource;
+            resource_state oldState;
+            resource_state newState;
+        };
+
+        /**
+         * @brief Merges transitions into as few resource_barriers as possible, and appends them to barriers. Transitions are sorted in the process.
+         *
+         * Transitions between the same states that cover all of a Resource's subresources are merged into a single barrier, otherwise consecutive mip levels within an array layer are merged.
+        */
+        inline void mergeTransitions(std::vector<pending_transition>& transitions, std::vector<resource_barrier>& barriers)
+        {
+            const auto isSameGroup = [](const pending_transition& lhs, const pending_transition& rhs) {
+                return lhs.resource == rhs.resource && lhs.oldState == rhs.oldState && lhs.newState == rhs.newState;
+            };
+
+            std::sort(transitions.begin(), transitions.end(), [](const pending_transition& lhs, const pending_transition& rhs) {
+                if (lhs.resource != rhs.resource)
+                    return std::less<Resource*>()(lhs.resource, rhs.resource);
+                if (lhs.oldState != rhs.oldState)
+                    return lhs.oldState < rhs.oldState;
+                if (lhs.newState != rhs.newState)
+                    return lhs.newState < rhs.newState;
+                return lhs.subresource < rhs.subresource;
+            });
+
+            size_t begin = 0;
+            while (begin < transitions.size())
+            {
+                size_t end = begin + 1;
+                while (end < transitions.size() && isSameGroup(transitions[begin], transitions[end]))
+                    end++;
+
+                const pending_transition& group = transitions[begin];
+                const resource_desc desc = group.resource->getDesc();
+                if (end - begin == subresourceCount(desc))
+                {
+                    barriers.push_back(resource_barrier::transition(group.resource, group.oldState, group.newState));
+                }
+                else
+                {
+                    size_t first = begin;
+                    for (size_t i = begin + 1; i <= end; i++)
+                    {
+                        // extend the range while the next subresource is the next mip level in the same array layer
+                        if (i < end && transitions[i].subresource == transitions[i - 1].subresource + 1 && transitions[i].subresource % desc.mipLevels != 0)
+                            continue;
+
+                        const uint32_t subresource = transitions[first].subresource;
+                        const texture_subresource_range range { subresource % desc.mipLevels, static_cast<uint32_t>(i - first), subresource / desc.mipLevels, 1 };
+                        barriers.push_back(resource_barrier::transition(group.resource, group.oldState, group.newState, range));
+                        first = i;
+                    }
+                }
+
+                begin = end;
+            }
+        }
+    }
 }
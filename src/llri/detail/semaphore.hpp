@@ -9,9 +9,58 @@
 
 namespace llri
 {
+    /**
+     * @brief Describes how a Semaphore is signaled and waited upon.
+    */
+    enum struct semaphore_type : uint8_t
+    {
+        /**
+         * @brief The Semaphore is signaled by one submission and unsignaled by the submission that waits on it.
+        */
+        Binary,
+        /**
+         * @brief The Semaphore holds a monotonically increasing 64-bit value. Submissions signal and wait for specific values, and the value **can** be signaled and waited upon from the host.
+         * Timeline Semaphores **must** only be used if adapter_features::timelineSemaphores was enabled in device_desc::features.
+        */
+        Timeline,
+        /**
+         * @brief The highest value in this enum.
+        */
+        MaxEnum = Timeline
+    };
+
+    /**
+     * @brief Converts a semaphore_type to a string.
+     * @return The enum value as a string, or "Invalid semaphore_type value" if the value was not recognized as an enum member.
+    */
+    inline std::string to_string(semaphore_type type);
+
+    /**
+     * @brief Describes how a Semaphore should be created.
+    */
+    struct semaphore_desc
+    {
+        /**
+         * @brief The type of the Semaphore.
+         *
+         * @note Valid usage (ErrorInvalidUsage): type **must not** be more than semaphore_type::MaxEnum.
+         * @note Valid usage (ErrorFeatureNotSupported): If type is semaphore_type::Timeline, adapter_features::timelineSemaphores **must** have been enabled in device_desc::features.
+        */
+        semaphore_type type;
+
+        /**
+         * @brief The value of a semaphore_type::Timeline Semaphore after creation.
+         *
+         * @note Valid usage (ErrorInvalidUsage): If type is semaphore_type::Binary, initialValue **must** be 0.
+        */
+        uint64_t initialValue;
+    };
+
     /**
      * @brief Semaphore is a synchronization structure that enables synchronization between GPU events.
      * Semaphores are signaled by Queue and Swapchain, after which Queue can wait on them, enabling GPU event synchronization without CPU interference.
+     *
+     * semaphore_type::Timeline Semaphores additionally allow the host to signal the GPU through Semaphore::signal(), and to wait for the GPU through Device::waitSemaphores().
     */
     class Semaphore
     {
@@ -21,6 +70,14 @@ namespace llri
     public:
         using native_semaphore = void;
 
+        /**
+         * @brief Get the type that the Semaphore was created with.
+        */
+        [[nodiscard]] semaphore_type getType() const
+        {
+            return m_type;
+        }
+
         /**
          * @brief Gets the native Semaphore  pointer, which depending on the llri::getImplementation() is a pointer to the following:
          *
@@ -31,13 +88,62 @@ namespace llri
         {
             return m_ptr;
         }
-        
+
+        /**
+         * @brief Set the name of the Semaphore, which is shown in debugging and profiling tools such as RenderDoc, PIX and Nsight.
+         *
+         * The name is only applied if instance_extension::DebugLabels was enabled, otherwise this function does nothing. Defining LLRI_DISABLE_DEBUG_LABELS removes the call entirely.
+         *
+         * @param name The name as a null-terminated string, which is copied.
+         *
+         * @note Valid usage (ErrorInvalidUsage): name **must** be a valid non-null pointer to a null-terminated string.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory.
+        */
+        result setName(const char* name);
+
+        /**
+         * @brief Set the value of a semaphore_type::Timeline Semaphore from the host. Submissions that wait for a value less or equal to the new value **may** execute once the value is set.
+         *
+         * @param value The new value.
+         *
+         * @note Valid usage (ErrorInvalidState): The Semaphore **must** have been created with semaphore_type::Timeline.
+         * @note Valid usage (ErrorInvalidUsage): value **must** be more than the current value, and more than every value that a pending submission signals the Semaphore with.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory.
+        */
+        result signal(uint64_t value);
+
+        /**
+         * @brief Get the current value of a semaphore_type::Timeline Semaphore.
+         *
+         * @param value A pointer to the variable that receives the value.
+         *
+         * @note Valid usage (ErrorInvalidUsage): value **must** be a valid non-null pointer to a uint64_t variable.
+         * @note Valid usage (ErrorInvalidState): The Semaphore **must** have been created with semaphore_type::Timeline.
+         *
+         * @return Success upon correct execution of the operation.
+         * @return Implementation defined result values: ErrorOutOfHostMemory, ErrorOutOfDeviceMemory, ErrorDeviceLost.
+        */
+        result getValue(uint64_t* value) const;
+
     private:
         // Force private constructor/deconstructor so that only create/destroy can manage lifetime
         Semaphore() = default;
         ~Semaphore() = default;
 
         native_semaphore* m_ptr = nullptr;
+        Device* m_device = nullptr;
+        semaphore_type m_type = semaphore_type::Binary;
+
+        // Binary: the number of signals, which DirectX12 signals and waits for.
+        // Timeline: the highest value that was signaled by the host or a submission.
         uint64_t m_counter = 0;
+
+        result impl_setName(const char* name);
+        result impl_signal(uint64_t value);
+        result impl_getValue(uint64_t* value) const;
     };
 }
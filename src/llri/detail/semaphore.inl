@@ -0,0 +1,60 @@
+/**
+ * @file semaphore.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    inline std::string to_string(semaphore_type type)
+    {
+        switch (type)
+        {
+            case semaphore_type::Binary:
+                return "Binary";
+            case semaphore_type::Timeline:
+                return "Timeline";
+        }
+
+        return "Invalid semaphore_type value";
+    }
+
+    inline result Semaphore::setName([[maybe_unused]] const char* name)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(name != nullptr, result::ErrorInvalidUsage)
+
+#ifdef LLRI_DISABLE_DEBUG_LABELS
+        return result::Success;
+#else
+        if (!m_device->m_debugLabels)
+            return result::Success;
+
+        LLRI_DETAIL_CALL_IMPL(impl_setName(name), m_device->m_validationCallbackMessenger)
+#endif
+    }
+
+    inline result Semaphore::signal(uint64_t value)
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_type == semaphore_type::Timeline, result::ErrorInvalidState)
+        LLRI_DETAIL_VALIDATION_REQUIRE(value > m_counter, result::ErrorInvalidUsage)
+
+        const result r = impl_signal(value);
+        LLRI_DETAIL_POLL_API_MESSAGES(m_device->m_validationCallbackMessenger)
+
+        if (r == result::Success)
+            LLRI_DETAIL_CAPTURE(m_device, signalSemaphore(this, value))
+
+        return r;
+    }
+
+    inline result Semaphore::getValue(uint64_t* value) const
+    {
+        LLRI_DETAIL_VALIDATION_REQUIRE(value != nullptr, result::ErrorInvalidUsage)
+        LLRI_DETAIL_VALIDATION_REQUIRE(m_type == semaphore_type::Timeline, result::ErrorInvalidState)
+
+        LLRI_DETAIL_CALL_IMPL(impl_getValue(value), m_device->m_validationCallbackMessenger)
+    }
+}
@@ -19,6 +19,17 @@ namespace llri
             return (mask & (mask - 1)) == 0;
         }
 
+        /**
+         * @brief Returns the index of the lowest bit that is set to 1, which is the node index of a single node mask. mask **must not** be 0.
+        */
+        constexpr uint8_t nodeIndex(uint32_t mask) noexcept
+        {
+            uint8_t index = 0;
+            for (; (mask & 1) == 0; mask >>= 1)
+                index++;
+            return index;
+        }
+
         /**
          * @brief Returns true if the container contains the value
         */
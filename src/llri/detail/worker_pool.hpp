@@ -0,0 +1,61 @@
+/**
+ * @file worker_pool.hpp
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    namespace detail
+    {
+        /**
+         * @brief A fixed set of threads that run the jobs of a single call to run() together with the calling thread.
+         *
+         * The threads are started once and sleep between calls, so utilities that record or translate in parallel every frame don't create a thread per job.
+        */
+        class worker_pool
+        {
+        public:
+            worker_pool() = default;
+            ~worker_pool();
+
+            worker_pool(const worker_pool&) = delete;
+            worker_pool& operator=(const worker_pool&) = delete;
+
+            /**
+             * @brief Start the pool's threads. The calling thread of run() takes part in the work, so a pool for n simultaneous jobs needs n - 1 workers.
+            */
+            void start(uint32_t numWorkers);
+
+            /**
+             * @brief Call job with every index in [0, numJobs) and return once all calls are done. Jobs are picked up by the calling thread and the pool's threads in order of their index.
+             *
+             * @note run() **must not** be called simultaneously from multiple threads, and jobs **must not** call run() on the same pool.
+            */
+            void run(uint32_t numJobs, const std::function<void(uint32_t)>& job);
+
+        private:
+            std::vector<std::thread> m_threads;
+
+            std::mutex m_mutex;
+            std::condition_variable m_wakeCondition;
+            std::condition_variable m_doneCondition;
+
+            // the job of the current call to run(), which the threads stop referencing once every index has been picked up
+            const std::function<void(uint32_t)>* m_job = nullptr;
+            uint32_t m_numJobs = 0;
+            uint32_t m_nextJob = 0;
+            uint32_t m_numDone = 0;
+            // incremented by every call to run(), so that sleeping threads can tell new work from a spurious wakeup
+            uint64_t m_generation = 0;
+            bool m_stopping = false;
+
+            void runWorker();
+            // runs jobs until every index has been picked up, m_mutex must be locked by lock
+            void runJobs(std::unique_lock<std::mutex>& lock);
+        };
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * @file worker_pool.inl
+ * Copyright (c) 2021 Leon Brands, Rythe Interactive
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include <llri/llri.hpp> // unnecessary but helps intellisense
+
+namespace llri
+{
+    namespace detail
+    {
+        inline worker_pool::~worker_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_wakeCondition.notify_all();
+
+            for (auto& thread : m_threads)
+                thread.join();
+        }
+
+        inline void worker_pool::start(uint32_t numWorkers)
+        {
+            m_threads.reserve(numWorkers);
+            for (uint32_t i = 0; i < numWorkers; i++)
+                m_threads.emplace_back(&worker_pool::runWorker, this);
+        }
+
+        inline void worker_pool::run(uint32_t numJobs, const std::function<void(uint32_t)>& job)
+        {
+            // waking the threads costs more than a single job
+            if (m_threads.empty() || numJobs <= 1)
+            {
+                for (uint32_t i = 0; i < numJobs; i++)
+                    job(i);
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job = &job;
+            m_numJobs = numJobs;
+            m_nextJob = 0;
+            m_numDone = 0;
+            m_generation++;
+            m_wakeCondition.notify_all();
+
+            runJobs(lock);
+            m_doneCondition.wait(lock, [this]() { return m_numDone == m_numJobs; });
+            m_job = nullptr;
+        }
+
+        inline void worker_pool::runWorker()
+        {
+            uint64_t generation = 0;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true)
+            {
+                m_wakeCondition.wait(lock, [&]() { return m_stopping || m_generation != generation; });
+                if (m_stopping)
+                    return;
+
+                generation = m_generation;
+                runJobs(lock);
+            }
+        }
+
+        inline void worker_pool::runJobs(std::unique_lock<std::mutex>& lock)
+        {
+            while (m_nextJob < m_numJobs)
+            {
+                const uint32_t index = m_nextJob++;
+                const auto* job = m_job;
+
+                lock.unlock();
+                (*job)(index);
+                lock.lock();
+
+                if (++m_numDone == m_numJobs)
+                    m_doneCondition.notify_one();
+            }
+        }
+    }
+}
@@ -7,14 +7,23 @@
 #pragma once
 #include <cstdint>
 #include <cmath>
+#include <cstring>
 #include <climits>
 #include <limits>
 
 #include <string>
 #include <array>
 #include <vector>
+#include <memory>
+#include <algorithm>
 #include <iostream> // including iostream fixes std::string issues on osx
 #include <functional>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+#include <fstream>
+#include <atomic>
 
 #include <unordered_set>
 #include <unordered_map>
@@ -40,6 +49,19 @@
   * @note Disabling implementation message polling is not guaranteed to prevent implementations from sending messages through other means. Drivers often have their own way of forwarding messages and it's very possible that messages end up in stdout or visual studio's output window.
   */
 #define LLRI_DISABLE_IMPLEMENTATION_MESSAGE_POLLING
+
+/**
+ * @def LLRI_DISABLE_DEBUG_LABELS
+ * @brief Defining LLRI_DISABLE_DEBUG_LABELS turns all object names and CommandList labels into no-ops, regardless of whether instance_extension::DebugLabels is enabled.
+ * This allows release builds to keep naming and labelling code in place without paying for it.
+ */
+#define LLRI_DISABLE_DEBUG_LABELS
+
+/**
+ * @def LLRI_DISABLE_CAPTURE
+ * @brief Defining LLRI_DISABLE_CAPTURE removes the capture hooks from all LLRI calls, and makes Device::beginCapture() return result::ErrorFeatureNotSupported.
+ */
+#define LLRI_DISABLE_CAPTURE
 #endif
 
 /**
@@ -222,6 +244,7 @@ namespace llri
 #include <llri/detail/validation.hpp>
 #include <llri/detail/flags.hpp>
 #include <llri/detail/math.hpp>
+#include <llri/detail/worker_pool.hpp>
 
 #include <llri/detail/callback.hpp>
 
@@ -231,14 +254,25 @@ namespace llri
 #include <llri/detail/adapter.hpp>
 #include <llri/detail/adapter_extensions.hpp>
 
-#include <llri/detail/queue.hpp>
-#include <llri/detail/device.hpp>
-
 #include <llri/detail/resource.hpp>
 #include <llri/detail/resource_barrier.hpp>
 
+#include <llri/detail/pipeline.hpp>
+#include <llri/detail/pipeline_cache.hpp>
+
+#include <llri/detail/queue.hpp>
+#include <llri/detail/device.hpp>
+
+#include <llri/detail/rendering.hpp>
 #include <llri/detail/command_group.hpp>
 #include <llri/detail/command_list.hpp>
+#include <llri/detail/command_stream.hpp>
+#include <llri/detail/capture.hpp>
+#include <llri/detail/command_context_pool.hpp>
+#include <llri/detail/frame_graph.hpp>
+#include <llri/detail/frame_scheduler.hpp>
+#include <llri/detail/query_pool.hpp>
+#include <llri/detail/gpu_profiler.hpp>
 
 #include <llri/detail/fence.hpp>
 #include <llri/detail/semaphore.hpp>